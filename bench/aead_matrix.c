@@ -0,0 +1,151 @@
+/*
+ * aead_matrix.c - Per-size AEAD benchmark matrix (also the PGO training run)
+ * One sealed message per iteration: (re)key/reset -> 13B aad -> encrypt -> final
+ * for AES-256-GCM, ChaCha20-Poly1305 and AEGIS-128L across a small-message
+ * mix (64..1500B) plus bulk sizes (16K, 64K).
+ *
+ * Usage: ./bench/aead_matrix [--csv] [--train]
+ *   --csv    machine-readable rows: aead,size,cycles_per_msg,cpb
+ *   --train  run the workload once with no timing output (PGO profile run)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <x86intrin.h>
+
+#include "../include/soliton.h"
+
+#define CTX_SIZE 1024
+#define RUNS 5
+#define BYTES_PER_RUN (256 * 1024)
+#define MIN_ITERATIONS 64
+
+static const size_t sizes[] = { 64, 256, 576, 1500, 4096, 16384, 65536 };
+#define NSIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+static uint8_t key[32], iv[12], aad[13], tag[16];
+static uint8_t* pt;
+static uint8_t* ct;
+
+static inline uint64_t rdtscp(void) {
+    uint32_t aux;
+    return __rdtscp(&aux);
+}
+
+static void gcm_seal(void* buf, size_t len) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)buf;
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, len);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+}
+
+static void chacha_seal(void* buf, size_t len) {
+    soliton_chacha_ctx* ctx = (soliton_chacha_ctx*)buf;
+    soliton_chacha_init(ctx, key, iv);
+    soliton_chacha_aad_update(ctx, aad, sizeof(aad));
+    soliton_chacha_encrypt_update(ctx, pt, ct, len);
+    soliton_chacha_encrypt_final(ctx, tag);
+}
+
+static void aegis_seal(void* buf, size_t len) {
+    soliton_aegis_ctx* ctx = (soliton_aegis_ctx*)buf;
+    soliton_aegis_init(ctx, SOLITON_AEGIS_128L, key, key);
+    soliton_aegis_aad_update(ctx, aad, sizeof(aad));
+    soliton_aegis_encrypt_update(ctx, pt, ct, len);
+    soliton_aegis_encrypt_final(ctx, tag);
+}
+
+typedef struct {
+    const char* name;
+    void (*seal)(void* buf, size_t len);
+} aead_t;
+
+static const aead_t aeads[] = {
+    { "aes256gcm", gcm_seal },
+    { "chacha20poly1305", chacha_seal },
+    { "aegis128l", aegis_seal },
+};
+
+static int iterations_for(size_t len) {
+    size_t n = BYTES_PER_RUN / len;
+    return n < MIN_ITERATIONS ? MIN_ITERATIONS : (int)n;
+}
+
+/* Best-of-RUNS cycles per message */
+static double measure(const aead_t* a, void* buf, size_t len) {
+    int iterations = iterations_for(len);
+    uint64_t best = UINT64_MAX;
+
+    for (int i = 0; i < iterations / 10 + 1; i++) {
+        a->seal(buf, len);
+    }
+    for (int r = 0; r < RUNS; r++) {
+        uint64_t start = rdtscp();
+        for (int i = 0; i < iterations; i++) {
+            a->seal(buf, len);
+        }
+        uint64_t cycles = rdtscp() - start;
+        if (cycles < best) best = cycles;
+    }
+    return (double)best / iterations;
+}
+
+int main(int argc, char** argv) {
+    int csv = 0, train = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) csv = 1;
+        else if (strcmp(argv[i], "--train") == 0) train = 1;
+        else {
+            fprintf(stderr, "usage: %s [--csv] [--train]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    size_t max_len = sizes[NSIZES - 1];
+    void* buf = aligned_alloc(64, CTX_SIZE);
+    pt = malloc(max_len);
+    ct = malloc(max_len);
+    if (!buf || !pt || !ct) {
+        fprintf(stderr, "Allocation failed\n");
+        return 1;
+    }
+    for (size_t i = 0; i < max_len; i++) pt[i] = (uint8_t)i;
+    for (size_t i = 0; i < sizeof(key); i++) key[i] = (uint8_t)(0x3c ^ i);
+
+    if (csv) {
+        printf("aead,size,cycles_per_msg,cpb\n");
+    } else if (!train) {
+        printf("AEAD size matrix (best of %d, cycles per sealed message)\n", RUNS);
+        printf("  %-18s %8s %14s %10s\n", "aead", "size", "cycles/msg", "cpb");
+    }
+
+    for (size_t a = 0; a < sizeof(aeads) / sizeof(aeads[0]); a++) {
+        /* GCM rows measure the reset path; key setup is outside the loop */
+        soliton_aesgcm_init((soliton_aesgcm_ctx*)buf, key, iv, sizeof(iv));
+
+        for (size_t s = 0; s < NSIZES; s++) {
+            if (train) {
+                int iterations = iterations_for(sizes[s]);
+                for (int i = 0; i < iterations; i++) {
+                    aeads[a].seal(buf, sizes[s]);
+                }
+                continue;
+            }
+
+            double cycles = measure(&aeads[a], buf, sizes[s]);
+            if (csv) {
+                printf("%s,%zu,%.1f,%.3f\n", aeads[a].name, sizes[s], cycles, cycles / sizes[s]);
+            } else {
+                printf("  %-18s %8zu %14.1f %10.3f\n", aeads[a].name, sizes[s], cycles, cycles / sizes[s]);
+            }
+        }
+    }
+
+    free(pt);
+    free(ct);
+    free(buf);
+    return 0;
+}
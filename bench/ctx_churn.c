@@ -0,0 +1,122 @@
+/*
+ * ctx_churn.c - Context lifecycle (connection churn) microbenchmark
+ * Measures one full short-lived session per iteration:
+ *   init -> aad -> encrypt 64B -> final -> decrypt+verify -> context_wipe
+ * for AES-256-GCM (init and reset), ChaCha20-Poly1305 and AEGIS-128L.
+ * Setup/teardown dominates at this message size, so this tracks the cost
+ * of the ct_utils wipe/compare/copy primitives on the lifecycle path.
+ * Usage: ./bench/ctx_churn [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <x86intrin.h>
+
+#include "../include/soliton.h"
+
+#define CTX_SIZE 1024
+#define MSG_LEN 64
+#define DEFAULT_ITERATIONS 2000
+
+static inline uint64_t rdtscp(void) {
+    uint32_t aux;
+    return __rdtscp(&aux);
+}
+
+static uint8_t key[32], iv[12], aad[13], pt[MSG_LEN], ct[MSG_LEN], out[MSG_LEN], tag[16];
+
+static void gcm_session(void* buf) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)buf;
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, MSG_LEN);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_decrypt_update(ctx, ct, out, MSG_LEN);
+    soliton_aesgcm_decrypt_final(ctx, tag);
+    soliton_aesgcm_context_wipe(ctx);
+}
+
+static void gcm_reset_session(void* buf) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)buf;
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, MSG_LEN);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_decrypt_update(ctx, ct, out, MSG_LEN);
+    soliton_aesgcm_decrypt_final(ctx, tag);
+}
+
+static void chacha_session(void* buf) {
+    soliton_chacha_ctx* ctx = (soliton_chacha_ctx*)buf;
+    soliton_chacha_init(ctx, key, iv);
+    soliton_chacha_aad_update(ctx, aad, sizeof(aad));
+    soliton_chacha_encrypt_update(ctx, pt, ct, MSG_LEN);
+    soliton_chacha_encrypt_final(ctx, tag);
+    soliton_chacha_init(ctx, key, iv);
+    soliton_chacha_aad_update(ctx, aad, sizeof(aad));
+    soliton_chacha_decrypt_update(ctx, ct, out, MSG_LEN);
+    soliton_chacha_decrypt_final(ctx, tag);
+    soliton_chacha_context_wipe(ctx);
+}
+
+static void aegis_session(void* buf) {
+    soliton_aegis_ctx* ctx = (soliton_aegis_ctx*)buf;
+    soliton_aegis_init(ctx, SOLITON_AEGIS_128L, key, key);
+    soliton_aegis_aad_update(ctx, aad, sizeof(aad));
+    soliton_aegis_encrypt_update(ctx, pt, ct, MSG_LEN);
+    soliton_aegis_encrypt_final(ctx, tag);
+    soliton_aegis_init(ctx, SOLITON_AEGIS_128L, key, key);
+    soliton_aegis_aad_update(ctx, aad, sizeof(aad));
+    soliton_aegis_decrypt_update(ctx, ct, out, MSG_LEN);
+    soliton_aegis_decrypt_final(ctx, tag);
+    soliton_aegis_context_wipe(ctx);
+}
+
+static void run(const char* name, void (*session)(void*), void* buf, int iterations) {
+    /* Warmup */
+    for (int i = 0; i < iterations / 20 + 1; i++) {
+        session(buf);
+    }
+
+    /* Best of 5 runs to filter scheduler noise */
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < 5; r++) {
+        uint64_t start = rdtscp();
+        for (int i = 0; i < iterations; i++) {
+            session(buf);
+        }
+        uint64_t cycles = rdtscp() - start;
+        if (cycles < best) best = cycles;
+    }
+
+    printf("  %-28s %10.1f cycles/session\n", name, (double)best / iterations);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0) iterations = DEFAULT_ITERATIONS;
+
+    void* buf = aligned_alloc(64, CTX_SIZE);
+    if (!buf) {
+        fprintf(stderr, "Context allocation failed\n");
+        return 1;
+    }
+    for (size_t i = 0; i < sizeof(pt); i++) pt[i] = (uint8_t)i;
+    for (size_t i = 0; i < sizeof(key); i++) key[i] = (uint8_t)(0xa5 ^ i);
+
+    printf("Context churn (%d sessions, %d-byte message, best of 5)\n", iterations, MSG_LEN);
+    run("AES-256-GCM init..wipe", gcm_session, buf, iterations);
+    soliton_aesgcm_init((soliton_aesgcm_ctx*)buf, key, iv, sizeof(iv));
+    run("AES-256-GCM reset..final", gcm_reset_session, buf, iterations);
+    run("ChaCha20-Poly1305 init..wipe", chacha_session, buf, iterations);
+    run("AEGIS-128L init..wipe", aegis_session, buf, iterations);
+
+    free(buf);
+    return 0;
+}
@@ -0,0 +1,275 @@
+/*
+ * gso_loopback.c - UDP GSO send path: seal a batch of equal-size datagrams
+ * into one buffer, send it with UDP_SEGMENT, receive and open every
+ * datagram on 127.0.0.1. Compares per-datagram reset/aad/update/final
+ * against soliton_aesgcm_seal_gso, crypto alone and end to end (packets/s).
+ * Falls back to sendmmsg with one iovec per datagram where the kernel has
+ * no UDP_SEGMENT.
+ * Usage: ./bench/gso_loopback [packets] [segment_size] [datagrams_per_send]
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../include/soliton.h"
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#define CTX_SIZE 1024
+#define HDR_LEN 13          /* QUIC short header: flags, 8-byte DCID, 4-byte PN */
+#define MAX_BATCH 64
+#define MAX_SEG 1500
+#define MAX_SEND 65507      /* One UDP send, GSO or not: 64 KiB minus IPv4 + UDP headers */
+
+typedef struct {
+    uint8_t buf[CTX_SIZE] __attribute__((aligned(64)));
+} ctx_storage;
+
+static uint8_t key[32], iv[12];
+static uint8_t payloads[MAX_BATCH][MAX_SEG];
+static uint8_t hdrs[MAX_BATCH][HDR_LEN];
+static uint8_t sendbuf[MAX_BATCH * MAX_SEG];
+static uint8_t recvbufs[MAX_BATCH][MAX_SEG];
+
+static int tx_fd = -1, rx_fd = -1, use_gso = 0;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void packet_nonce(uint8_t nonce[12], uint64_t pn) {
+    memcpy(nonce, iv, 12);
+    for (int i = 0; i < 8; i++) {
+        nonce[4 + i] ^= (uint8_t)(pn >> (56 - 8 * i));
+    }
+}
+
+static void put_pn(uint8_t hdr[HDR_LEN], uint64_t pn) {
+    for (int i = 0; i < 4; i++) {
+        hdr[HDR_LEN - 1 - i] = (uint8_t)(pn >> (8 * i));
+    }
+}
+
+static uint64_t get_pn(const uint8_t* hdr) {
+    uint64_t pn = 0;
+    for (int i = 0; i < 4; i++) {
+        pn = (pn << 8) | hdr[9 + i];
+    }
+    return pn;
+}
+
+static void make_dgrams(soliton_datagram* d, size_t n, uint64_t pn, size_t seg) {
+    for (size_t i = 0; i < n; i++) {
+        put_pn(hdrs[i], pn + i);
+        d[i].hdr = hdrs[i];
+        d[i].hdr_len = HDR_LEN;
+        d[i].payload = payloads[i];
+        d[i].len = seg - HDR_LEN - 16;
+    }
+}
+
+/* Today's sender: one reset/aad/update/final per datagram, written in place */
+static size_t seal_separately(soliton_aesgcm_ctx* ctx, const soliton_datagram* d, size_t n, uint64_t pn) {
+    uint8_t* p = sendbuf;
+    for (size_t i = 0; i < n; i++) {
+        uint8_t nonce[12];
+        packet_nonce(nonce, pn + i);
+        soliton_aesgcm_reset(ctx, nonce, 12);
+        memcpy(p, d[i].hdr, d[i].hdr_len);
+        soliton_aesgcm_aad_update(ctx, d[i].hdr, d[i].hdr_len);
+        soliton_aesgcm_encrypt_update(ctx, d[i].payload, p + d[i].hdr_len, d[i].len);
+        soliton_aesgcm_encrypt_final(ctx, p + d[i].hdr_len + d[i].len);
+        p += d[i].hdr_len + d[i].len + 16;
+    }
+    return (size_t)(p - sendbuf);
+}
+
+static size_t seal_gso(soliton_aesgcm_ctx* ctx, const soliton_datagram* d, size_t n, uint64_t pn, size_t seg) {
+    size_t len = 0;
+    if (soliton_aesgcm_seal_gso(ctx, iv, pn, d, n, seg, sendbuf, sizeof(sendbuf), &len) != SOLITON_OK) {
+        fprintf(stderr, "seal_gso failed\n");
+        exit(1);
+    }
+    return len;
+}
+
+static int open_sockets(size_t seg) {
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    socklen_t alen = sizeof(addr);
+    int rcvbuf = 16 << 20;
+    struct timeval tv = { .tv_sec = 1 };
+
+    rx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    tx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (rx_fd < 0 || tx_fd < 0 ||
+        bind(rx_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        getsockname(rx_fd, (struct sockaddr*)&addr, &alen) != 0 ||
+        connect(tx_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        perror("loopback socket");
+        return -1;
+    }
+    setsockopt(rx_fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    setsockopt(rx_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    int gso = (int)seg;
+    use_gso = setsockopt(tx_fd, SOL_UDP, UDP_SEGMENT, &gso, sizeof(gso)) == 0;
+    return 0;
+}
+
+/* One buffer of n datagrams: a single GSO send, else sendmmsg */
+static int send_batch(size_t len, size_t seg) {
+    if (use_gso) {
+        return send(tx_fd, sendbuf, len, 0) == (ssize_t)len ? 0 : -1;
+    }
+    struct mmsghdr msgs[MAX_BATCH];
+    struct iovec iovs[MAX_BATCH];
+    size_t n = 0;
+    for (size_t off = 0; off < len; off += seg, n++) {
+        iovs[n].iov_base = sendbuf + off;
+        iovs[n].iov_len = len - off < seg ? len - off : seg;
+        memset(&msgs[n], 0, sizeof(msgs[n]));
+        msgs[n].msg_hdr.msg_iov = &iovs[n];
+        msgs[n].msg_hdr.msg_iovlen = 1;
+    }
+    for (size_t sent = 0; sent < n;) {
+        int r = sendmmsg(tx_fd, msgs + sent, (unsigned)(n - sent), 0);
+        if (r <= 0) {
+            return -1;
+        }
+        sent += (size_t)r;
+    }
+    return 0;
+}
+
+/* Receive n datagrams and open each under the nonce of its header's PN;
+ * returns the number that verified */
+static size_t recv_open(soliton_aesgcm_ctx* rx, size_t n, uint8_t* pt) {
+    struct mmsghdr msgs[MAX_BATCH];
+    struct iovec iovs[MAX_BATCH];
+    size_t got = 0, ok = 0;
+
+    while (got < n) {
+        for (size_t i = 0; i < n - got; i++) {
+            iovs[i].iov_base = recvbufs[i];
+            iovs[i].iov_len = MAX_SEG;
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int r = recvmmsg(rx_fd, msgs, (unsigned)(n - got), MSG_WAITFORONE, NULL);
+        if (r <= 0) {
+            break;      /* timeout: datagrams lost */
+        }
+        for (int i = 0; i < r; i++) {
+            const uint8_t* p = recvbufs[i];
+            const size_t len = msgs[i].msg_len;
+            uint8_t nonce[12];
+            if (len < HDR_LEN + 16) {
+                continue;
+            }
+            packet_nonce(nonce, get_pn(p));
+            soliton_aesgcm_reset(rx, nonce, 12);
+            soliton_aesgcm_aad_update(rx, p, HDR_LEN);
+            soliton_aesgcm_decrypt_update(rx, p + HDR_LEN, pt, len - HDR_LEN - 16);
+            ok += soliton_aesgcm_decrypt_final(rx, p + len - 16) == SOLITON_OK;
+        }
+        got += (size_t)r;
+    }
+    return ok;
+}
+
+typedef size_t (*seal_fn)(soliton_aesgcm_ctx*, const soliton_datagram*, size_t, uint64_t, size_t);
+
+static size_t seal_separately_fn(soliton_aesgcm_ctx* ctx, const soliton_datagram* d, size_t n,
+                                 uint64_t pn, size_t seg) {
+    (void)seg;
+    return seal_separately(ctx, d, n, pn);
+}
+
+static void run(const char* name, seal_fn seal, size_t packets, size_t seg, size_t batch) {
+    ctx_storage a, b;
+    soliton_aesgcm_ctx* tx = (soliton_aesgcm_ctx*)a.buf;
+    soliton_aesgcm_ctx* rx = (soliton_aesgcm_ctx*)b.buf;
+    soliton_datagram d[MAX_BATCH];
+    static uint8_t pt[MAX_SEG];
+    const size_t rounds = packets / batch;
+
+    soliton_aesgcm_init(tx, key, iv, 12);
+    soliton_aesgcm_init(rx, key, iv, 12);
+
+    /* Crypto only */
+    uint64_t pn = 0;
+    double t0 = now_sec();
+    for (size_t r = 0; r < rounds; r++, pn += batch) {
+        make_dgrams(d, batch, pn, seg);
+        seal(tx, d, batch, pn, seg);
+    }
+    const double seal_s = now_sec() - t0;
+
+    /* Seal, send, receive, open */
+    size_t opened = 0;
+    t0 = now_sec();
+    for (size_t r = 0; r < rounds; r++, pn += batch) {
+        make_dgrams(d, batch, pn, seg);
+        const size_t len = seal(tx, d, batch, pn, seg);
+        if (send_batch(len, seg) != 0) {
+            perror("send");
+            exit(1);
+        }
+        opened += recv_open(rx, batch, pt);
+    }
+    const double e2e_s = now_sec() - t0;
+    const double sent = (double)(rounds * batch);
+
+    printf("  %-22s seal %7.2f Mpps (%6.2f Gbit/s)   end-to-end %6.3f Mpps   opened %zu/%zu\n",
+           name, sent / seal_s / 1e6, sent * (double)seg * 8 / seal_s / 1e9,
+           sent / e2e_s / 1e6, opened, rounds * batch);
+
+    soliton_aesgcm_context_wipe(tx);
+    soliton_aesgcm_context_wipe(rx);
+}
+
+int main(int argc, char** argv) {
+    const size_t packets = argc > 1 ? strtoull(argv[1], NULL, 0) : 200000;
+    const size_t seg = argc > 2 ? strtoull(argv[2], NULL, 0) : 1200;
+    const size_t batch = argc > 3 ? strtoull(argv[3], NULL, 0) : 32;
+
+    if (seg < HDR_LEN + 16 || seg > MAX_SEG || batch == 0 || batch > MAX_BATCH || packets < batch ||
+        batch * seg > MAX_SEND) {
+        fprintf(stderr, "usage: %s [packets] [segment_size %d..%d] [datagrams_per_send 1..%d]\n"
+                "       (segment_size * datagrams_per_send <= %d)\n",
+                argv[0], HDR_LEN + 16, MAX_SEG, MAX_BATCH, MAX_SEND);
+        return 2;
+    }
+    for (size_t i = 0; i < sizeof(key); i++) key[i] = (uint8_t)(i * 7 + 1);
+    for (size_t i = 0; i < sizeof(iv); i++) iv[i] = (uint8_t)(i * 13 + 5);
+    for (size_t i = 0; i < MAX_BATCH; i++) {
+        memset(hdrs[i], 0x40, HDR_LEN);
+        for (size_t j = 0; j < MAX_SEG; j++) payloads[i][j] = (uint8_t)(i + j);
+    }
+    if (open_sockets(seg) != 0) {
+        return 1;
+    }
+
+    printf("UDP loopback, %zu packets of %zu bytes, %zu per send (%s)\n",
+           packets, seg, batch, use_gso ? "UDP_SEGMENT" : "sendmmsg, no GSO");
+    run("reset/aad/update/final", seal_separately_fn, packets, seg, batch);
+    run("seal_gso", seal_gso, packets, seg, batch);
+
+    close(tx_fd);
+    close(rx_fd);
+    return 0;
+}
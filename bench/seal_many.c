@@ -0,0 +1,169 @@
+/*
+ * seal_many.c - Bulk re-encryption on the seal_many/open_many pool
+ * A compaction-style job: open every block under the old key, then seal it
+ * under the new one, for a mix of 4..64 KiB blocks. Runs the same job on
+ * pools of 1, 2, 4, ... workers up to the CPUs in the affinity mask (one
+ * pinned worker per core) and reports GB/s, speedup over one worker and
+ * scaling efficiency. Per-worker totals show how evenly the bytes landed.
+ * Usage: ./bench/seal_many [blocks] [repetitions]
+ */
+
+#define _GNU_SOURCE
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "../include/soliton_hosted.h"
+
+#define MIN_BLOCK 4096
+#define MAX_BLOCK 65536
+
+static uint8_t old_key[32], new_key[32];
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* One re-encryption pass: ct -> pt under the old key, pt -> ct under the new */
+static int reencrypt(soliton_gcm_pool* pool, soliton_gcm_msg* open_msgs, soliton_gcm_msg* seal_msgs,
+                     size_t n, soliton_status* status) {
+    if (soliton_aesgcm_open_many(pool, old_key, open_msgs, n, status) != SOLITON_OK) {
+        return -1;
+    }
+    return soliton_aesgcm_seal_many(pool, new_key, seal_msgs, n, status) == SOLITON_OK ? 0 : -1;
+}
+
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? strtoull(argv[1], NULL, 0) : 8192;
+    const int reps = argc > 2 ? atoi(argv[2]) : 5;
+    cpu_set_t mask;
+    unsigned ncpus = 1;
+
+    if (n == 0 || reps <= 0) {
+        fprintf(stderr, "usage: %s [blocks] [repetitions]\n", argv[0]);
+        return 2;
+    }
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        ncpus = (unsigned)CPU_COUNT(&mask);
+        /* The calling thread is worker 0: keep it on the first CPU */
+        for (int c = 0; c < CPU_SETSIZE; c++) {
+            if (CPU_ISSET(c, &mask)) {
+                cpu_set_t one;
+                CPU_ZERO(&one);
+                CPU_SET(c, &one);
+                sched_setaffinity(0, sizeof(one), &one);
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(old_key); i++) {
+        old_key[i] = (uint8_t)(i * 7 + 1);
+        new_key[i] = (uint8_t)(i * 11 + 3);
+    }
+
+    soliton_gcm_msg* open_msgs = calloc(n, sizeof(*open_msgs));
+    soliton_gcm_msg* seal_msgs = calloc(n, sizeof(*seal_msgs));
+    soliton_status* status = calloc(n, sizeof(*status));
+    uint8_t** ct = calloc(n, sizeof(*ct));
+    uint8_t** pt = calloc(n, sizeof(*pt));
+    uint64_t bytes = 0, seed = 88172645463325252ull;
+
+    for (size_t i = 0; i < n; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        const size_t len = MIN_BLOCK + (size_t)(seed % (MAX_BLOCK - MIN_BLOCK + 1));
+        ct[i] = malloc(len);
+        pt[i] = malloc(len);
+        memset(pt[i], (int)i, len);
+        bytes += len;
+
+        /* Blocks start out sealed under the old key */
+        soliton_gcm_msg* s = &seal_msgs[i];
+        memcpy(s->iv, &i, sizeof(i) < 12 ? sizeof(i) : 12);
+        s->in = pt[i];
+        s->out = ct[i];
+        s->len = len;
+    }
+    if (soliton_aesgcm_seal_many(NULL, old_key, seal_msgs, n, status) != SOLITON_OK) {
+        fprintf(stderr, "initial seal failed\n");
+        return 1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        open_msgs[i] = seal_msgs[i];
+        open_msgs[i].in = ct[i];
+        open_msgs[i].out = pt[i];
+    }
+
+    printf("Re-encrypting %zu blocks (%.1f MiB, %d..%d bytes), %d reps, %u CPUs\n",
+           n, (double)bytes / (1 << 20), MIN_BLOCK, MAX_BLOCK, reps, ncpus);
+    printf("  workers      GB/s   speedup  efficiency   bytes/worker min..max\n");
+
+    double base = 0;
+    for (unsigned w = 1;; w = w * 2 > ncpus && w < ncpus ? ncpus : w * 2) {
+        soliton_gcm_pool* pool = NULL;
+        if (soliton_gcm_pool_create(w, 1, &pool) != SOLITON_OK) {
+            fprintf(stderr, "pool of %u failed\n", w);
+            return 1;
+        }
+
+        /* Warm-up job, then timed repetitions (each one open + one seal) */
+        double best = 1e30;
+        for (int r = 0; r <= reps; r++) {
+            const double t0 = now_sec();
+            if (reencrypt(pool, open_msgs, seal_msgs, n, status) != 0) {
+                fprintf(stderr, "re-encryption failed\n");
+                return 1;
+            }
+            const double dt = now_sec() - t0;
+            if (r > 0 && dt < best) {
+                best = dt;
+            }
+            /* The new ciphertext opens under the new key next round */
+            uint8_t tmp[32];
+            memcpy(tmp, old_key, 32);
+            memcpy(old_key, new_key, 32);
+            memcpy(new_key, tmp, 32);
+            for (size_t i = 0; i < n; i++) {
+                memcpy(open_msgs[i].tag, seal_msgs[i].tag, 16);
+            }
+        }
+
+        uint64_t lo = UINT64_MAX, hi = 0;
+        for (unsigned k = 0; k < w; k++) {
+            soliton_gcm_pool_stats s;
+            soliton_gcm_pool_stats_get(pool, k, &s);
+            lo = s.bytes < lo ? s.bytes : lo;
+            hi = s.bytes > hi ? s.bytes : hi;
+        }
+
+        const double gbps = 2.0 * (double)bytes / best / 1e9;
+        if (w == 1) {
+            base = gbps;
+        }
+        printf("  %7u  %8.2f  %7.2fx  %9.0f%%   %.1f..%.1f MiB\n", w, gbps, gbps / base,
+               100.0 * gbps / base / w, (double)lo / (1 << 20), (double)hi / (1 << 20));
+        soliton_gcm_pool_destroy(pool);
+
+        if (w >= ncpus) {
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        free(ct[i]);
+        free(pt[i]);
+    }
+    free(ct);
+    free(pt);
+    free(status);
+    free(open_msgs);
+    free(seal_msgs);
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * vwidth_mc.c - Multi-core AES-GCM vs co-tenant cost of each vector-width policy
+ * Every core alternates an AES-256-GCM open of one message (the bulk CTR is
+ * where the policy picks YMM or ZMM) with a fixed slice of scalar
+ * "application" work: a dependent dec/jnz chain that retires one iteration
+ * per cycle, so its rate is the core clock the crypto left behind.
+ *
+ * Reported per policy, summed over threads:
+ *   crypto GB/s  - AES-GCM throughput over the whole run
+ *   app Mops/s   - scalar chain iterations per second of wall time
+ *   app MHz      - mean clock while running the scalar slices
+ * A license-throttled part shows ZMM raising crypto GB/s while app MHz drops.
+ *
+ * Usage: ./bench/vwidth_mc [--threads N] [--size BYTES] [--ms MS] [--csv]
+ *   --csv  machine-readable rows: policy,threads,size,crypto_gbps,app_mops,app_mhz
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "../include/soliton.h"
+
+#define CTX_SIZE 1024
+#define APP_ITERS 200000u   /* ~0.1 ms of scalar work per message at 2 GHz */
+#define MAX_THREADS 256
+
+typedef struct {
+    size_t size;
+    uint64_t deadline_ns;
+    uint64_t crypto_bytes;
+    uint64_t app_iters;
+    uint64_t app_ns;
+} worker_t;
+
+static const struct {
+    soliton_vwidth_policy policy;
+    const char* name;
+} policies[] = {
+    { SOLITON_VWIDTH_PREFER_YMM, "prefer-ymm" },
+    { SOLITON_VWIDTH_ZMM_ABOVE,  "zmm-above" },
+    { SOLITON_VWIDTH_ALWAYS_ZMM, "always-zmm" },
+    { SOLITON_VWIDTH_AUTO,       "auto" },
+};
+#define NPOLICIES (sizeof(policies) / sizeof(policies[0]))
+
+static const char* policy_name(soliton_vwidth_policy p) {
+    for (size_t i = 0; i < NPOLICIES; i++) {
+        if (policies[i].policy == p) return policies[i].name;
+    }
+    return "?";
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* One iteration per cycle: dec + jnz macro-fuse on a single dependency */
+static inline void scalar_chain(uint64_t n) {
+    __asm__ volatile("1:\n\tdec %0\n\tjnz 1b" : "+r"(n) : : "cc");
+}
+
+static void* worker(void* arg) {
+    worker_t* w = (worker_t*)arg;
+    uint8_t key[32], iv[12], tag[16];
+    uint8_t buf[CTX_SIZE] __attribute__((aligned(64)));
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)buf;
+    uint8_t* pt = malloc(w->size);
+    uint8_t* ct = malloc(w->size);
+
+    memset(key, 0x42, sizeof(key));
+    memset(iv, 0x24, sizeof(iv));
+    memset(pt, 0x5a, w->size);
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, w->size);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+
+    while (now_ns() < w->deadline_ns) {
+        soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+        soliton_aesgcm_decrypt_update(ctx, ct, pt, w->size);
+        soliton_aesgcm_decrypt_final(ctx, tag);
+        w->crypto_bytes += w->size;
+
+        const uint64_t t0 = now_ns();
+        scalar_chain(APP_ITERS);
+        w->app_ns += now_ns() - t0;
+        w->app_iters += APP_ITERS;
+    }
+
+    soliton_aesgcm_context_wipe(ctx);
+    free(pt);
+    free(ct);
+    return NULL;
+}
+
+int main(int argc, char** argv) {
+    long nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t size = 16384;
+    unsigned ms = 500;
+    int csv = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+            nthreads = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--size") && i + 1 < argc) {
+            size = (size_t)atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--ms") && i + 1 < argc) {
+            ms = (unsigned)atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--csv")) {
+            csv = 1;
+        } else {
+            fprintf(stderr, "usage: %s [--threads N] [--size BYTES] [--ms MS] [--csv]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > MAX_THREADS) nthreads = MAX_THREADS;
+    if (size == 0) size = 16;
+
+    static worker_t workers[MAX_THREADS];
+    static pthread_t tids[MAX_THREADS];
+
+    if (csv) {
+        printf("policy,threads,size,crypto_gbps,app_mops,app_mhz\n");
+    } else {
+        soliton_set_vwidth_policy(SOLITON_VWIDTH_ALWAYS_ZMM, 0);
+        const int zmm = soliton_vwidth_uses_zmm(size);
+        soliton_set_vwidth_policy(SOLITON_VWIDTH_AUTO, 0);
+
+        printf("Vector-width policy: %ld threads, %zu-byte AES-GCM open + %u-iteration scalar slice, %u ms each\n",
+               nthreads, size, APP_ITERS, ms);
+        printf("  auto resolves to %s; ZMM kernels %s\n\n",
+               policy_name(soliton_get_vwidth_policy(NULL)),
+               zmm ? "available" : "not available (all rows run YMM)");
+        printf("%-12s %12s %12s %10s\n", "policy", "crypto GB/s", "app Mops/s", "app MHz");
+    }
+
+    for (size_t p = 0; p < NPOLICIES; p++) {
+        soliton_set_vwidth_policy(policies[p].policy, 0);
+
+        const uint64_t start = now_ns();
+        for (long t = 0; t < nthreads; t++) {
+            memset(&workers[t], 0, sizeof(workers[t]));
+            workers[t].size = size;
+            workers[t].deadline_ns = start + (uint64_t)ms * 1000000u;
+            pthread_create(&tids[t], NULL, worker, &workers[t]);
+        }
+
+        uint64_t bytes = 0, iters = 0;
+        double mhz = 0.0;
+        for (long t = 0; t < nthreads; t++) {
+            pthread_join(tids[t], NULL);
+            bytes += workers[t].crypto_bytes;
+            iters += workers[t].app_iters;
+            if (workers[t].app_ns) {
+                mhz += (double)workers[t].app_iters * 1e3 / (double)workers[t].app_ns;
+            }
+        }
+        const double secs = (double)(now_ns() - start) / 1e9;
+        const double gbps = (double)bytes / secs / 1e9;
+        const double mops = (double)iters / secs / 1e6;
+        mhz /= (double)nthreads;
+
+        if (csv) {
+            printf("%s,%ld,%zu,%.3f,%.1f,%.0f\n", policies[p].name, nthreads, size, gbps, mops, mhz);
+        } else {
+            printf("%-12s %12.3f %12.1f %10.0f\n", policies[p].name, gbps, mops, mhz);
+        }
+    }
+
+    soliton_set_vwidth_policy(SOLITON_VWIDTH_AUTO, 0);
+    return 0;
+}
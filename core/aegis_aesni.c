@@ -0,0 +1,277 @@
+/*
+ * aegis_aesni.c - AEGIS-128L / AEGIS-256 using AES-NI
+ * One AESENC per state word per update; the state stays in XMM registers
+ * for the duration of each call
+ */
+
+#include "common.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#ifdef __AES__
+
+#include <wmmintrin.h>  /* AES-NI */
+#include <emmintrin.h>  /* SSE2 */
+
+/* AEGIS initialization constants */
+#define AEGIS_C0 _mm_setr_epi8(0x00, 0x01, 0x01, 0x02, 0x03, 0x05, 0x08, 0x0d, \
+                               0x15, 0x22, 0x37, 0x59, (char)0x90, (char)0xe9, 0x79, 0x62)
+#define AEGIS_C1 _mm_setr_epi8((char)0xdb, 0x3d, 0x18, 0x55, 0x6d, (char)0xc2, 0x2f, (char)0xf1, \
+                               0x20, 0x11, 0x31, 0x42, 0x73, (char)0xb5, 0x28, (char)0xdd)
+
+/* ============================ AEGIS-128L ============================ */
+
+#define AEGIS128L_UPDATE(S, M0, M1) do { \
+    __m128i t7_ = S[7]; \
+    S[7] = _mm_aesenc_si128(S[6], S[7]); \
+    S[6] = _mm_aesenc_si128(S[5], S[6]); \
+    S[5] = _mm_aesenc_si128(S[4], S[5]); \
+    S[4] = _mm_aesenc_si128(S[3], _mm_xor_si128(S[4], (M1))); \
+    S[3] = _mm_aesenc_si128(S[2], S[3]); \
+    S[2] = _mm_aesenc_si128(S[1], S[2]); \
+    S[1] = _mm_aesenc_si128(S[0], S[1]); \
+    S[0] = _mm_aesenc_si128(t7_, _mm_xor_si128(S[0], (M0))); \
+} while (0)
+
+static SOLITON_INLINE void aegis128l_load(__m128i S[8], const uint8_t* state) {
+    for (int i = 0; i < 8; i++) {
+        S[i] = _mm_loadu_si128((const __m128i*)(state + i * 16));
+    }
+}
+
+static SOLITON_INLINE void aegis128l_store(uint8_t* state, const __m128i S[8]) {
+    for (int i = 0; i < 8; i++) {
+        _mm_storeu_si128((__m128i*)(state + i * 16), S[i]);
+    }
+}
+
+void aegis128l_init_aesni(uint8_t* state, const uint8_t key[16], const uint8_t nonce[16]) {
+    __m128i S[8];
+    __m128i k = _mm_loadu_si128((const __m128i*)key);
+    __m128i n = _mm_loadu_si128((const __m128i*)nonce);
+    __m128i c0 = AEGIS_C0;
+    __m128i c1 = AEGIS_C1;
+
+    S[0] = _mm_xor_si128(k, n);
+    S[1] = c1;
+    S[2] = c0;
+    S[3] = c1;
+    S[4] = _mm_xor_si128(k, n);
+    S[5] = _mm_xor_si128(k, c0);
+    S[6] = _mm_xor_si128(k, c1);
+    S[7] = _mm_xor_si128(k, c0);
+
+    for (int i = 0; i < 10; i++) {
+        AEGIS128L_UPDATE(S, n, k);
+    }
+
+    aegis128l_store(state, S);
+}
+
+void aegis128l_absorb_aesni(uint8_t* state, const uint8_t* ad, size_t blocks) {
+    __m128i S[8];
+    aegis128l_load(S, state);
+
+    for (size_t b = 0; b < blocks; b++) {
+        __m128i m0 = _mm_loadu_si128((const __m128i*)(ad + b * 32));
+        __m128i m1 = _mm_loadu_si128((const __m128i*)(ad + b * 32 + 16));
+        AEGIS128L_UPDATE(S, m0, m1);
+    }
+
+    aegis128l_store(state, S);
+}
+
+void aegis128l_encrypt_aesni(uint8_t* state, const uint8_t* pt, uint8_t* ct, size_t blocks) {
+    __m128i S[8];
+    aegis128l_load(S, state);
+
+    for (size_t b = 0; b < blocks; b++) {
+        __m128i m0 = _mm_loadu_si128((const __m128i*)(pt + b * 32));
+        __m128i m1 = _mm_loadu_si128((const __m128i*)(pt + b * 32 + 16));
+
+        __m128i z0 = _mm_xor_si128(_mm_xor_si128(S[6], S[1]), _mm_and_si128(S[2], S[3]));
+        __m128i z1 = _mm_xor_si128(_mm_xor_si128(S[2], S[5]), _mm_and_si128(S[6], S[7]));
+
+        _mm_storeu_si128((__m128i*)(ct + b * 32), _mm_xor_si128(m0, z0));
+        _mm_storeu_si128((__m128i*)(ct + b * 32 + 16), _mm_xor_si128(m1, z1));
+
+        AEGIS128L_UPDATE(S, m0, m1);
+    }
+
+    aegis128l_store(state, S);
+}
+
+void aegis128l_decrypt_aesni(uint8_t* state, const uint8_t* ct, uint8_t* pt, size_t blocks) {
+    __m128i S[8];
+    aegis128l_load(S, state);
+
+    for (size_t b = 0; b < blocks; b++) {
+        __m128i c0 = _mm_loadu_si128((const __m128i*)(ct + b * 32));
+        __m128i c1 = _mm_loadu_si128((const __m128i*)(ct + b * 32 + 16));
+
+        __m128i m0 = _mm_xor_si128(c0, _mm_xor_si128(_mm_xor_si128(S[6], S[1]), _mm_and_si128(S[2], S[3])));
+        __m128i m1 = _mm_xor_si128(c1, _mm_xor_si128(_mm_xor_si128(S[2], S[5]), _mm_and_si128(S[6], S[7])));
+
+        _mm_storeu_si128((__m128i*)(pt + b * 32), m0);
+        _mm_storeu_si128((__m128i*)(pt + b * 32 + 16), m1);
+
+        AEGIS128L_UPDATE(S, m0, m1);
+    }
+
+    aegis128l_store(state, S);
+}
+
+void aegis128l_final_aesni(uint8_t* state, uint64_t ad_len, uint64_t msg_len, uint8_t tag[16]) {
+    __m128i S[8];
+    aegis128l_load(S, state);
+
+    __m128i t = _mm_set_epi64x((long long)(msg_len * 8), (long long)(ad_len * 8));
+    t = _mm_xor_si128(t, S[2]);
+
+    for (int i = 0; i < 7; i++) {
+        AEGIS128L_UPDATE(S, t, t);
+    }
+
+    __m128i acc = _mm_xor_si128(S[0], S[1]);
+    acc = _mm_xor_si128(acc, _mm_xor_si128(S[2], S[3]));
+    acc = _mm_xor_si128(acc, _mm_xor_si128(S[4], S[5]));
+    acc = _mm_xor_si128(acc, S[6]);
+    _mm_storeu_si128((__m128i*)tag, acc);
+
+    aegis128l_store(state, S);
+}
+
+/* ============================= AEGIS-256 ============================ */
+
+#define AEGIS256_UPDATE(S, M) do { \
+    __m128i t5_ = S[5]; \
+    S[5] = _mm_aesenc_si128(S[4], S[5]); \
+    S[4] = _mm_aesenc_si128(S[3], S[4]); \
+    S[3] = _mm_aesenc_si128(S[2], S[3]); \
+    S[2] = _mm_aesenc_si128(S[1], S[2]); \
+    S[1] = _mm_aesenc_si128(S[0], S[1]); \
+    S[0] = _mm_aesenc_si128(t5_, _mm_xor_si128(S[0], (M))); \
+} while (0)
+
+static SOLITON_INLINE void aegis256_load(__m128i S[6], const uint8_t* state) {
+    for (int i = 0; i < 6; i++) {
+        S[i] = _mm_loadu_si128((const __m128i*)(state + i * 16));
+    }
+}
+
+static SOLITON_INLINE void aegis256_store(uint8_t* state, const __m128i S[6]) {
+    for (int i = 0; i < 6; i++) {
+        _mm_storeu_si128((__m128i*)(state + i * 16), S[i]);
+    }
+}
+
+void aegis256_init_aesni(uint8_t* state, const uint8_t key[32], const uint8_t nonce[32]) {
+    __m128i S[6];
+    __m128i k0 = _mm_loadu_si128((const __m128i*)key);
+    __m128i k1 = _mm_loadu_si128((const __m128i*)(key + 16));
+    __m128i kn0 = _mm_xor_si128(k0, _mm_loadu_si128((const __m128i*)nonce));
+    __m128i kn1 = _mm_xor_si128(k1, _mm_loadu_si128((const __m128i*)(nonce + 16)));
+    __m128i c0 = AEGIS_C0;
+    __m128i c1 = AEGIS_C1;
+
+    S[0] = kn0;
+    S[1] = kn1;
+    S[2] = c1;
+    S[3] = c0;
+    S[4] = _mm_xor_si128(k0, c0);
+    S[5] = _mm_xor_si128(k1, c1);
+
+    for (int i = 0; i < 4; i++) {
+        AEGIS256_UPDATE(S, k0);
+        AEGIS256_UPDATE(S, k1);
+        AEGIS256_UPDATE(S, kn0);
+        AEGIS256_UPDATE(S, kn1);
+    }
+
+    aegis256_store(state, S);
+}
+
+void aegis256_absorb_aesni(uint8_t* state, const uint8_t* ad, size_t blocks) {
+    __m128i S[6];
+    aegis256_load(S, state);
+
+    for (size_t b = 0; b < blocks; b++) {
+        __m128i m = _mm_loadu_si128((const __m128i*)(ad + b * 16));
+        AEGIS256_UPDATE(S, m);
+    }
+
+    aegis256_store(state, S);
+}
+
+void aegis256_encrypt_aesni(uint8_t* state, const uint8_t* pt, uint8_t* ct, size_t blocks) {
+    __m128i S[6];
+    aegis256_load(S, state);
+
+    for (size_t b = 0; b < blocks; b++) {
+        __m128i m = _mm_loadu_si128((const __m128i*)(pt + b * 16));
+        __m128i z = _mm_xor_si128(_mm_xor_si128(S[1], S[4]),
+                                  _mm_xor_si128(S[5], _mm_and_si128(S[2], S[3])));
+
+        _mm_storeu_si128((__m128i*)(ct + b * 16), _mm_xor_si128(m, z));
+
+        AEGIS256_UPDATE(S, m);
+    }
+
+    aegis256_store(state, S);
+}
+
+void aegis256_decrypt_aesni(uint8_t* state, const uint8_t* ct, uint8_t* pt, size_t blocks) {
+    __m128i S[6];
+    aegis256_load(S, state);
+
+    for (size_t b = 0; b < blocks; b++) {
+        __m128i c = _mm_loadu_si128((const __m128i*)(ct + b * 16));
+        __m128i z = _mm_xor_si128(_mm_xor_si128(S[1], S[4]),
+                                  _mm_xor_si128(S[5], _mm_and_si128(S[2], S[3])));
+        __m128i m = _mm_xor_si128(c, z);
+
+        _mm_storeu_si128((__m128i*)(pt + b * 16), m);
+
+        AEGIS256_UPDATE(S, m);
+    }
+
+    aegis256_store(state, S);
+}
+
+void aegis256_final_aesni(uint8_t* state, uint64_t ad_len, uint64_t msg_len, uint8_t tag[16]) {
+    __m128i S[6];
+    aegis256_load(S, state);
+
+    __m128i t = _mm_set_epi64x((long long)(msg_len * 8), (long long)(ad_len * 8));
+    t = _mm_xor_si128(t, S[3]);
+
+    for (int i = 0; i < 7; i++) {
+        AEGIS256_UPDATE(S, t);
+    }
+
+    __m128i acc = _mm_xor_si128(S[0], S[1]);
+    acc = _mm_xor_si128(acc, _mm_xor_si128(S[2], S[3]));
+    acc = _mm_xor_si128(acc, _mm_xor_si128(S[4], S[5]));
+    _mm_storeu_si128((__m128i*)tag, acc);
+
+    aegis256_store(state, S);
+}
+
+/* Backend for AES-NI AEGIS (single stream) */
+soliton_aegis_backend_t backend_aegis_aesni = {
+    .aegis128l_init = aegis128l_init_aesni,
+    .aegis128l_absorb = aegis128l_absorb_aesni,
+    .aegis128l_encrypt = aegis128l_encrypt_aesni,
+    .aegis128l_decrypt = aegis128l_decrypt_aesni,
+    .aegis128l_final = aegis128l_final_aesni,
+    .aegis256_init = aegis256_init_aesni,
+    .aegis256_absorb = aegis256_absorb_aesni,
+    .aegis256_encrypt = aegis256_encrypt_aesni,
+    .aegis256_decrypt = aegis256_decrypt_aesni,
+    .aegis256_final = aegis256_final_aesni,
+    .aegis128l_encrypt_x2 = NULL,
+    .aegis256_encrypt_x2 = NULL,
+    .name = "aesni"
+};
+
+#endif /* __AES__ */
+#endif /* __x86_64__ || __i386__ */
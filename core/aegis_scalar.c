@@ -0,0 +1,283 @@
+/*
+ * aegis_scalar.c - Portable AEGIS-128L / AEGIS-256 (draft-irtf-cfrg-aegis-aead)
+ * Freestanding C17 - built on the table-free AES round from aes_scalar.c
+ */
+
+#include "common.h"
+
+/* Single AES round from aes_scalar.c (AESENC semantics) */
+extern void aes_round_scalar(const uint8_t in[16], const uint8_t rk[16], uint8_t out[16]);
+
+/* AEGIS initialization constants (Fibonacci sequence mod 256) */
+static const uint8_t aegis_c0[16] = {
+    0x00, 0x01, 0x01, 0x02, 0x03, 0x05, 0x08, 0x0d,
+    0x15, 0x22, 0x37, 0x59, 0x90, 0xe9, 0x79, 0x62
+};
+static const uint8_t aegis_c1[16] = {
+    0xdb, 0x3d, 0x18, 0x55, 0x6d, 0xc2, 0x2f, 0xf1,
+    0x20, 0x11, 0x31, 0x42, 0x73, 0xb5, 0x28, 0xdd
+};
+
+static SOLITON_INLINE void blk_xor(uint8_t* out, const uint8_t* a, const uint8_t* b) {
+    for (int i = 0; i < 16; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+static SOLITON_INLINE void blk_copy(uint8_t* out, const uint8_t* a) {
+    for (int i = 0; i < 16; i++) {
+        out[i] = a[i];
+    }
+}
+
+/* ============================ AEGIS-128L ============================ */
+
+/* Update(M0, M1): S'i = AESRound(S(i-1), Si), message injected into S0 and S4 */
+static void aegis128l_update(uint8_t s[8][16], const uint8_t m0[16], const uint8_t m1[16]) {
+    uint8_t t[8][16];
+    uint8_t k[16];
+
+    blk_xor(k, s[0], m0);
+    aes_round_scalar(s[7], k, t[0]);
+    aes_round_scalar(s[0], s[1], t[1]);
+    aes_round_scalar(s[1], s[2], t[2]);
+    aes_round_scalar(s[2], s[3], t[3]);
+    blk_xor(k, s[4], m1);
+    aes_round_scalar(s[3], k, t[4]);
+    aes_round_scalar(s[4], s[5], t[5]);
+    aes_round_scalar(s[5], s[6], t[6]);
+    aes_round_scalar(s[6], s[7], t[7]);
+
+    for (int i = 0; i < 8; i++) {
+        blk_copy(s[i], t[i]);
+    }
+}
+
+/* Keystream z0 = S6 ^ S1 ^ (S2 & S3), z1 = S2 ^ S5 ^ (S6 & S7) */
+static SOLITON_INLINE void aegis128l_keystream(uint8_t s[8][16], uint8_t z[32]) {
+    for (int i = 0; i < 16; i++) {
+        z[i] = s[6][i] ^ s[1][i] ^ (s[2][i] & s[3][i]);
+        z[16 + i] = s[2][i] ^ s[5][i] ^ (s[6][i] & s[7][i]);
+    }
+}
+
+void aegis128l_init_scalar(uint8_t* state, const uint8_t key[16], const uint8_t nonce[16]) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+
+    blk_xor(s[0], key, nonce);
+    blk_copy(s[1], aegis_c1);
+    blk_copy(s[2], aegis_c0);
+    blk_copy(s[3], aegis_c1);
+    blk_xor(s[4], key, nonce);
+    blk_xor(s[5], key, aegis_c0);
+    blk_xor(s[6], key, aegis_c1);
+    blk_xor(s[7], key, aegis_c0);
+
+    for (int i = 0; i < 10; i++) {
+        aegis128l_update(s, nonce, key);
+    }
+}
+
+void aegis128l_absorb_scalar(uint8_t* state, const uint8_t* ad, size_t blocks) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+
+    for (size_t b = 0; b < blocks; b++) {
+        aegis128l_update(s, ad + b * 32, ad + b * 32 + 16);
+    }
+}
+
+void aegis128l_encrypt_scalar(uint8_t* state, const uint8_t* pt, uint8_t* ct, size_t blocks) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+    uint8_t z[32];
+    uint8_t m[32];
+
+    for (size_t b = 0; b < blocks; b++) {
+        aegis128l_keystream(s, z);
+        /* Copy plaintext first so in-place operation is safe */
+        for (int i = 0; i < 32; i++) {
+            m[i] = pt[b * 32 + i];
+        }
+        for (int i = 0; i < 32; i++) {
+            ct[b * 32 + i] = m[i] ^ z[i];
+        }
+        aegis128l_update(s, m, m + 16);
+    }
+
+    soliton_wipe(z, sizeof(z));
+    soliton_wipe(m, sizeof(m));
+}
+
+void aegis128l_decrypt_scalar(uint8_t* state, const uint8_t* ct, uint8_t* pt, size_t blocks) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+    uint8_t z[32];
+    uint8_t m[32];
+
+    for (size_t b = 0; b < blocks; b++) {
+        aegis128l_keystream(s, z);
+        for (int i = 0; i < 32; i++) {
+            m[i] = ct[b * 32 + i] ^ z[i];
+        }
+        for (int i = 0; i < 32; i++) {
+            pt[b * 32 + i] = m[i];
+        }
+        aegis128l_update(s, m, m + 16);
+    }
+
+    soliton_wipe(z, sizeof(z));
+    soliton_wipe(m, sizeof(m));
+}
+
+void aegis128l_final_scalar(uint8_t* state, uint64_t ad_len, uint64_t msg_len, uint8_t tag[16]) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+    uint8_t t[16];
+
+    /* t = S2 ^ (LE64(ad_len_bits) || LE64(msg_len_bits)) */
+    soliton_put_le64(t, ad_len * 8);
+    soliton_put_le64(t + 8, msg_len * 8);
+    blk_xor(t, t, s[2]);
+
+    for (int i = 0; i < 7; i++) {
+        aegis128l_update(s, t, t);
+    }
+
+    /* tag = S0 ^ S1 ^ S2 ^ S3 ^ S4 ^ S5 ^ S6 */
+    for (int i = 0; i < 16; i++) {
+        tag[i] = s[0][i] ^ s[1][i] ^ s[2][i] ^ s[3][i] ^ s[4][i] ^ s[5][i] ^ s[6][i];
+    }
+}
+
+/* ============================= AEGIS-256 ============================ */
+
+/* Update(M): S'i = AESRound(S(i-1), Si), message injected into S0 */
+static void aegis256_update(uint8_t s[6][16], const uint8_t m[16]) {
+    uint8_t t[6][16];
+    uint8_t k[16];
+
+    blk_xor(k, s[0], m);
+    aes_round_scalar(s[5], k, t[0]);
+    aes_round_scalar(s[0], s[1], t[1]);
+    aes_round_scalar(s[1], s[2], t[2]);
+    aes_round_scalar(s[2], s[3], t[3]);
+    aes_round_scalar(s[3], s[4], t[4]);
+    aes_round_scalar(s[4], s[5], t[5]);
+
+    for (int i = 0; i < 6; i++) {
+        blk_copy(s[i], t[i]);
+    }
+}
+
+/* Keystream z = S1 ^ S4 ^ S5 ^ (S2 & S3) */
+static SOLITON_INLINE void aegis256_keystream(uint8_t s[6][16], uint8_t z[16]) {
+    for (int i = 0; i < 16; i++) {
+        z[i] = s[1][i] ^ s[4][i] ^ s[5][i] ^ (s[2][i] & s[3][i]);
+    }
+}
+
+void aegis256_init_scalar(uint8_t* state, const uint8_t key[32], const uint8_t nonce[32]) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+    uint8_t kn0[16], kn1[16];
+
+    blk_xor(kn0, key, nonce);
+    blk_xor(kn1, key + 16, nonce + 16);
+
+    blk_copy(s[0], kn0);
+    blk_copy(s[1], kn1);
+    blk_copy(s[2], aegis_c1);
+    blk_copy(s[3], aegis_c0);
+    blk_xor(s[4], key, aegis_c0);
+    blk_xor(s[5], key + 16, aegis_c1);
+
+    for (int i = 0; i < 4; i++) {
+        aegis256_update(s, key);
+        aegis256_update(s, key + 16);
+        aegis256_update(s, kn0);
+        aegis256_update(s, kn1);
+    }
+
+    soliton_wipe(kn0, sizeof(kn0));
+    soliton_wipe(kn1, sizeof(kn1));
+}
+
+void aegis256_absorb_scalar(uint8_t* state, const uint8_t* ad, size_t blocks) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+
+    for (size_t b = 0; b < blocks; b++) {
+        aegis256_update(s, ad + b * 16);
+    }
+}
+
+void aegis256_encrypt_scalar(uint8_t* state, const uint8_t* pt, uint8_t* ct, size_t blocks) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+    uint8_t z[16];
+    uint8_t m[16];
+
+    for (size_t b = 0; b < blocks; b++) {
+        aegis256_keystream(s, z);
+        for (int i = 0; i < 16; i++) {
+            m[i] = pt[b * 16 + i];
+        }
+        for (int i = 0; i < 16; i++) {
+            ct[b * 16 + i] = m[i] ^ z[i];
+        }
+        aegis256_update(s, m);
+    }
+
+    soliton_wipe(z, sizeof(z));
+    soliton_wipe(m, sizeof(m));
+}
+
+void aegis256_decrypt_scalar(uint8_t* state, const uint8_t* ct, uint8_t* pt, size_t blocks) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+    uint8_t z[16];
+    uint8_t m[16];
+
+    for (size_t b = 0; b < blocks; b++) {
+        aegis256_keystream(s, z);
+        for (int i = 0; i < 16; i++) {
+            m[i] = ct[b * 16 + i] ^ z[i];
+        }
+        for (int i = 0; i < 16; i++) {
+            pt[b * 16 + i] = m[i];
+        }
+        aegis256_update(s, m);
+    }
+
+    soliton_wipe(z, sizeof(z));
+    soliton_wipe(m, sizeof(m));
+}
+
+void aegis256_final_scalar(uint8_t* state, uint64_t ad_len, uint64_t msg_len, uint8_t tag[16]) {
+    uint8_t (*s)[16] = (uint8_t (*)[16])state;
+    uint8_t t[16];
+
+    /* t = S3 ^ (LE64(ad_len_bits) || LE64(msg_len_bits)) */
+    soliton_put_le64(t, ad_len * 8);
+    soliton_put_le64(t + 8, msg_len * 8);
+    blk_xor(t, t, s[3]);
+
+    for (int i = 0; i < 7; i++) {
+        aegis256_update(s, t);
+    }
+
+    /* tag = S0 ^ S1 ^ S2 ^ S3 ^ S4 ^ S5 */
+    for (int i = 0; i < 16; i++) {
+        tag[i] = s[0][i] ^ s[1][i] ^ s[2][i] ^ s[3][i] ^ s[4][i] ^ s[5][i];
+    }
+}
+
+/* Backend for portable AEGIS */
+soliton_aegis_backend_t backend_aegis_scalar = {
+    .aegis128l_init = aegis128l_init_scalar,
+    .aegis128l_absorb = aegis128l_absorb_scalar,
+    .aegis128l_encrypt = aegis128l_encrypt_scalar,
+    .aegis128l_decrypt = aegis128l_decrypt_scalar,
+    .aegis128l_final = aegis128l_final_scalar,
+    .aegis256_init = aegis256_init_scalar,
+    .aegis256_absorb = aegis256_absorb_scalar,
+    .aegis256_encrypt = aegis256_encrypt_scalar,
+    .aegis256_decrypt = aegis256_decrypt_scalar,
+    .aegis256_final = aegis256_final_scalar,
+    .aegis128l_encrypt_x2 = NULL,
+    .aegis256_encrypt_x2 = NULL,
+    .name = "scalar"
+};
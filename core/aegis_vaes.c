@@ -0,0 +1,133 @@
+/*
+ * aegis_vaes.c - Two-stream AEGIS-128L / AEGIS-256 using VAES
+ * AEGIS updates are serial within a stream, so VAES width is spent across
+ * streams: lane 0 of every YMM register carries stream 0, lane 1 stream 1.
+ * Single-stream calls use the AES-NI kernels.
+ */
+
+#include "common.h"
+
+#ifdef __x86_64__
+
+#include <immintrin.h>
+
+#if defined(__VAES__) && defined(__AES__)
+
+/* ============================ AEGIS-128L ============================ */
+
+#define AEGIS128L_UPDATE_X2(S, M0, M1) do { \
+    __m256i t7_ = S[7]; \
+    S[7] = _mm256_aesenc_epi128(S[6], S[7]); \
+    S[6] = _mm256_aesenc_epi128(S[5], S[6]); \
+    S[5] = _mm256_aesenc_epi128(S[4], S[5]); \
+    S[4] = _mm256_aesenc_epi128(S[3], _mm256_xor_si256(S[4], (M1))); \
+    S[3] = _mm256_aesenc_epi128(S[2], S[3]); \
+    S[2] = _mm256_aesenc_epi128(S[1], S[2]); \
+    S[1] = _mm256_aesenc_epi128(S[0], S[1]); \
+    S[0] = _mm256_aesenc_epi128(t7_, _mm256_xor_si256(S[0], (M0))); \
+} while (0)
+
+static SOLITON_INLINE __m256i load_x2(const uint8_t* a, const uint8_t* b) {
+    return _mm256_setr_m128i(_mm_loadu_si128((const __m128i*)a),
+                             _mm_loadu_si128((const __m128i*)b));
+}
+
+static SOLITON_INLINE void store_x2(uint8_t* a, uint8_t* b, __m256i v) {
+    _mm_storeu_si128((__m128i*)a, _mm256_castsi256_si128(v));
+    _mm_storeu_si128((__m128i*)b, _mm256_extracti128_si256(v, 1));
+}
+
+void aegis128l_encrypt_x2_vaes(uint8_t* state0, uint8_t* state1,
+                               const uint8_t* pt0, uint8_t* ct0,
+                               const uint8_t* pt1, uint8_t* ct1, size_t blocks) {
+    __m256i S[8];
+    for (int i = 0; i < 8; i++) {
+        S[i] = load_x2(state0 + i * 16, state1 + i * 16);
+    }
+
+    for (size_t b = 0; b < blocks; b++) {
+        size_t off = b * 32;
+        __m256i m0 = load_x2(pt0 + off, pt1 + off);
+        __m256i m1 = load_x2(pt0 + off + 16, pt1 + off + 16);
+
+        __m256i z0 = _mm256_xor_si256(_mm256_xor_si256(S[6], S[1]), _mm256_and_si256(S[2], S[3]));
+        __m256i z1 = _mm256_xor_si256(_mm256_xor_si256(S[2], S[5]), _mm256_and_si256(S[6], S[7]));
+
+        store_x2(ct0 + off, ct1 + off, _mm256_xor_si256(m0, z0));
+        store_x2(ct0 + off + 16, ct1 + off + 16, _mm256_xor_si256(m1, z1));
+
+        AEGIS128L_UPDATE_X2(S, m0, m1);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        store_x2(state0 + i * 16, state1 + i * 16, S[i]);
+    }
+}
+
+/* ============================= AEGIS-256 ============================ */
+
+#define AEGIS256_UPDATE_X2(S, M) do { \
+    __m256i t5_ = S[5]; \
+    S[5] = _mm256_aesenc_epi128(S[4], S[5]); \
+    S[4] = _mm256_aesenc_epi128(S[3], S[4]); \
+    S[3] = _mm256_aesenc_epi128(S[2], S[3]); \
+    S[2] = _mm256_aesenc_epi128(S[1], S[2]); \
+    S[1] = _mm256_aesenc_epi128(S[0], S[1]); \
+    S[0] = _mm256_aesenc_epi128(t5_, _mm256_xor_si256(S[0], (M))); \
+} while (0)
+
+void aegis256_encrypt_x2_vaes(uint8_t* state0, uint8_t* state1,
+                              const uint8_t* pt0, uint8_t* ct0,
+                              const uint8_t* pt1, uint8_t* ct1, size_t blocks) {
+    __m256i S[6];
+    for (int i = 0; i < 6; i++) {
+        S[i] = load_x2(state0 + i * 16, state1 + i * 16);
+    }
+
+    for (size_t b = 0; b < blocks; b++) {
+        size_t off = b * 16;
+        __m256i m = load_x2(pt0 + off, pt1 + off);
+        __m256i z = _mm256_xor_si256(_mm256_xor_si256(S[1], S[4]),
+                                     _mm256_xor_si256(S[5], _mm256_and_si256(S[2], S[3])));
+
+        store_x2(ct0 + off, ct1 + off, _mm256_xor_si256(m, z));
+
+        AEGIS256_UPDATE_X2(S, m);
+    }
+
+    for (int i = 0; i < 6; i++) {
+        store_x2(state0 + i * 16, state1 + i * 16, S[i]);
+    }
+}
+
+/* Single-stream kernels from aegis_aesni.c */
+extern void aegis128l_init_aesni(uint8_t*, const uint8_t*, const uint8_t*);
+extern void aegis128l_absorb_aesni(uint8_t*, const uint8_t*, size_t);
+extern void aegis128l_encrypt_aesni(uint8_t*, const uint8_t*, uint8_t*, size_t);
+extern void aegis128l_decrypt_aesni(uint8_t*, const uint8_t*, uint8_t*, size_t);
+extern void aegis128l_final_aesni(uint8_t*, uint64_t, uint64_t, uint8_t*);
+extern void aegis256_init_aesni(uint8_t*, const uint8_t*, const uint8_t*);
+extern void aegis256_absorb_aesni(uint8_t*, const uint8_t*, size_t);
+extern void aegis256_encrypt_aesni(uint8_t*, const uint8_t*, uint8_t*, size_t);
+extern void aegis256_decrypt_aesni(uint8_t*, const uint8_t*, uint8_t*, size_t);
+extern void aegis256_final_aesni(uint8_t*, uint64_t, uint64_t, uint8_t*);
+
+/* Backend for VAES AEGIS (AES-NI single stream + VAES two-stream batch) */
+soliton_aegis_backend_t backend_aegis_vaes = {
+    .aegis128l_init = aegis128l_init_aesni,
+    .aegis128l_absorb = aegis128l_absorb_aesni,
+    .aegis128l_encrypt = aegis128l_encrypt_aesni,
+    .aegis128l_decrypt = aegis128l_decrypt_aesni,
+    .aegis128l_final = aegis128l_final_aesni,
+    .aegis256_init = aegis256_init_aesni,
+    .aegis256_absorb = aegis256_absorb_aesni,
+    .aegis256_encrypt = aegis256_encrypt_aesni,
+    .aegis256_decrypt = aegis256_decrypt_aesni,
+    .aegis256_final = aegis256_final_aesni,
+    .aegis128l_encrypt_x2 = aegis128l_encrypt_x2_vaes,
+    .aegis256_encrypt_x2 = aegis256_encrypt_x2_vaes,
+    .name = "vaes"
+};
+
+#endif /* __VAES__ && __AES__ */
+#endif /* __x86_64__ */
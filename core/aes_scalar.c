@@ -244,6 +244,143 @@ void aes256_encrypt_block_scalar(const uint32_t* round_keys, const uint8_t in[16
     soliton_put_le32(out + 12, state[3]);
 }
 
+/* Single AES encryption round: SubBytes, ShiftRows, MixColumns, AddRoundKey
+ * Same semantics as AESENC - building block for AEGIS scalar fallback */
+void aes_round_scalar(const uint8_t in[16], const uint8_t rk[16], uint8_t out[16]) {
+    uint32_t state[4];
+    uint32_t key[4];
+
+    for (int i = 0; i < 4; i++) {
+        state[i] = soliton_le32(in + i * 4);
+        key[i] = soliton_le32(rk + i * 4);
+    }
+
+    aes_sub_bytes(state);
+    aes_shift_rows(state);
+    aes_mix_columns(state);
+    aes_add_round_key(state, key);
+
+    for (int i = 0; i < 4; i++) {
+        soliton_put_le32(out + i * 4, state[i]);
+    }
+}
+
+/* Inverse cipher (XTS decryption)
+ * Same table-free approach: inverse affine map, then the x^254 inversion */
+static SOLITON_INLINE uint8_t aes_inv_sbox(uint8_t x) {
+    /* Inverse affine: b_i = x_{(i+2)%8} ^ x_{(i+5)%8} ^ x_{(i+7)%8} ^ d_i, d = 0x05 */
+    uint8_t s = 0x05;
+    for (int i = 0; i < 8; i++) {
+        uint8_t bit = ((x >> ((i + 2) % 8)) & 1) ^
+                      ((x >> ((i + 5) % 8)) & 1) ^
+                      ((x >> ((i + 7) % 8)) & 1);
+        s ^= (uint8_t)(bit << i);
+    }
+
+    /* s^254 = s^(-1), and 0 -> 0 without a branch */
+    uint8_t a2 = gf256_square(s);
+    uint8_t a3 = gf256_mul(s, a2);
+    uint8_t a6 = gf256_square(a3);
+    uint8_t a7 = gf256_mul(s, a6);
+    uint8_t a14 = gf256_square(a7);
+    uint8_t a15 = gf256_mul(s, a14);
+    uint8_t a30 = gf256_square(a15);
+    uint8_t a60 = gf256_square(a30);
+    uint8_t a120 = gf256_square(a60);
+    uint8_t a127 = gf256_mul(a7, a120);
+    return gf256_square(a127);
+}
+
+static void aes_inv_sub_bytes(uint32_t state[4]) {
+    for (int c = 0; c < 4; c++) {
+        uint32_t w = state[c];
+        state[c] = (uint32_t)aes_inv_sbox((uint8_t)(w >> 0)) |
+                   ((uint32_t)aes_inv_sbox((uint8_t)(w >> 8)) << 8) |
+                   ((uint32_t)aes_inv_sbox((uint8_t)(w >> 16)) << 16) |
+                   ((uint32_t)aes_inv_sbox((uint8_t)(w >> 24)) << 24);
+    }
+}
+
+static void aes_inv_shift_rows(uint32_t state[4]) {
+    /* Row r rotates right by r: byte (row r, column c) comes from column c - r */
+    uint32_t t[4];
+    for (int c = 0; c < 4; c++) {
+        t[c] = (state[c] & 0x000000FFu) |
+               (state[(c + 3) % 4] & 0x0000FF00u) |
+               (state[(c + 2) % 4] & 0x00FF0000u) |
+               (state[(c + 1) % 4] & 0xFF000000u);
+    }
+    for (int c = 0; c < 4; c++) {
+        state[c] = t[c];
+    }
+}
+
+/* InvMixColumns on a column: circulant (0e, 0b, 0d, 09) */
+static SOLITON_INLINE uint32_t aes_inv_mix_column(uint32_t col) {
+    uint8_t b0 = (uint8_t)(col >> 0);
+    uint8_t b1 = (uint8_t)(col >> 8);
+    uint8_t b2 = (uint8_t)(col >> 16);
+    uint8_t b3 = (uint8_t)(col >> 24);
+
+    uint8_t r0 = gf256_mul(b0, 14) ^ gf256_mul(b1, 11) ^ gf256_mul(b2, 13) ^ gf256_mul(b3, 9);
+    uint8_t r1 = gf256_mul(b0, 9) ^ gf256_mul(b1, 14) ^ gf256_mul(b2, 11) ^ gf256_mul(b3, 13);
+    uint8_t r2 = gf256_mul(b0, 13) ^ gf256_mul(b1, 9) ^ gf256_mul(b2, 14) ^ gf256_mul(b3, 11);
+    uint8_t r3 = gf256_mul(b0, 11) ^ gf256_mul(b1, 13) ^ gf256_mul(b2, 9) ^ gf256_mul(b3, 14);
+
+    return (uint32_t)r0 | ((uint32_t)r1 << 8) |
+           ((uint32_t)r2 << 16) | ((uint32_t)r3 << 24);
+}
+
+static void aes_inv_mix_columns(uint32_t state[4]) {
+    state[0] = aes_inv_mix_column(state[0]);
+    state[1] = aes_inv_mix_column(state[1]);
+    state[2] = aes_inv_mix_column(state[2]);
+    state[3] = aes_inv_mix_column(state[3]);
+}
+
+/* AES-256 decryption key schedule (equivalent inverse cipher, FIPS 197 5.3.5):
+ * dec[0] = K14, dec[r] = InvMixColumns(K(14-r)) for r = 1..13, dec[14] = K0.
+ * Same layout AESDEC / AESD+AESIMC consume, so every backend shares it. */
+void aes256_key_expand_dec_scalar(const uint32_t enc_keys[60], uint32_t dec_keys[60]) {
+    for (int w = 0; w < 4; w++) {
+        dec_keys[w] = enc_keys[56 + w];
+        dec_keys[56 + w] = enc_keys[w];
+    }
+    for (int r = 1; r < 14; r++) {
+        for (int w = 0; w < 4; w++) {
+            dec_keys[r * 4 + w] = aes_inv_mix_column(enc_keys[(14 - r) * 4 + w]);
+        }
+    }
+}
+
+/* AES-256 block decryption with the schedule above */
+void aes256_decrypt_block_scalar(const uint32_t* dec_keys, const uint8_t in[16], uint8_t out[16]) {
+    uint32_t state[4];
+
+    state[0] = soliton_le32(in + 0);
+    state[1] = soliton_le32(in + 4);
+    state[2] = soliton_le32(in + 8);
+    state[3] = soliton_le32(in + 12);
+
+    aes_add_round_key(state, dec_keys);
+
+    for (int round = 1; round < 14; round++) {
+        aes_inv_sub_bytes(state);
+        aes_inv_shift_rows(state);
+        aes_inv_mix_columns(state);
+        aes_add_round_key(state, dec_keys + round * 4);
+    }
+
+    aes_inv_sub_bytes(state);
+    aes_inv_shift_rows(state);
+    aes_add_round_key(state, dec_keys + 14 * 4);
+
+    soliton_put_le32(out + 0, state[0]);
+    soliton_put_le32(out + 4, state[1]);
+    soliton_put_le32(out + 8, state[2]);
+    soliton_put_le32(out + 12, state[3]);
+}
+
 /* AES-CTR mode for multiple blocks */
 void aes256_ctr_blocks_scalar(const uint32_t* round_keys, const uint8_t iv[16],
                               uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) {
@@ -4,6 +4,7 @@
  */
 
 #include "common.h"
+#include "ctr_engine.h"
 
 #ifdef __x86_64__
 
@@ -25,9 +26,26 @@ void aes256_key_expand_vaes(const uint8_t key[32], uint32_t* round_keys) {
     aes256_key_expand_aesni(key, round_keys);
 }
 
-/* AES-256 CTR mode using VAES - 8 blocks parallel */
-void aes256_ctr_blocks8_vaes(const uint32_t* round_keys, const uint8_t iv[16],
-                             uint32_t counter, const uint8_t* in, uint8_t* out) {
+/* AES-256 rounds on n YMM registers (two blocks each), round-major */
+static SOLITON_INLINE void aes256_enc_ymm(__m256i* s, int n, const __m256i rk[15]) {
+    for (int i = 0; i < n; i++) {
+        s[i] = _mm256_xor_si256(s[i], rk[0]);
+    }
+    for (int round = 1; round < 14; round++) {
+        for (int i = 0; i < n; i++) {
+            s[i] = _mm256_aesenc_epi128(s[i], rk[round]);
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        s[i] = _mm256_aesenclast_epi128(s[i], rk[14]);
+    }
+}
+
+/* AES-256 CTR mode using VAES - 8 blocks per iteration in 4 YMM registers.
+ * Counter blocks come from the shared engine (ctr_engine.h); the 2-block
+ * and final odd-block tails stay in YMM instead of dropping to scalar */
+void aes256_ctr_blocks_vaes(const uint32_t* round_keys, const uint8_t iv[16],
+                            uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) {
     /* Load round keys */
     __m256i rk[15];
     for (int i = 0; i < 15; i++) {
@@ -35,80 +53,83 @@ void aes256_ctr_blocks8_vaes(const uint32_t* round_keys, const uint8_t iv[16],
         rk[i] = _mm256_broadcastsi128_si256(k128);
     }
 
-    /* Prepare counter blocks using full 16-byte IV (loads all bytes including 8-11) */
-    __m128i iv_base = _mm_loadu_si128((const __m128i*)iv);
+    soliton_ctr_ymm ctr;
+    soliton_ctr_ymm_init(&ctr, iv, counter);
 
-    /* Prepare 8 counter blocks by setting counter field for each */
-    __m128i counters[8];
-    for (int i = 0; i < 8; i++) {
-        counters[i] = iv_base;
-        /* Set counter value (big-endian 32-bit at bytes 12-15) */
-        uint32_t ctr_val = counter + i;
-        counters[i] = _mm_insert_epi32(counters[i], __builtin_bswap32(ctr_val), 3);
-    }
+    while (blocks >= 8) {
+        __m256i state[4];
+        soliton_ctr_ymm_next(&ctr, state, 4);
+        aes256_enc_ymm(state, 4, rk);
 
-    /* Pack 8 counters into 4 YMM registers for VAES */
-    __m256i ctr_blocks[4];
-    ctr_blocks[0] = _mm256_setr_m128i(counters[0], counters[1]);
-    ctr_blocks[1] = _mm256_setr_m128i(counters[2], counters[3]);
-    ctr_blocks[2] = _mm256_setr_m128i(counters[4], counters[5]);
-    ctr_blocks[3] = _mm256_setr_m128i(counters[6], counters[7]);
+        for (int i = 0; i < 4; i++) {
+            __m256i p = _mm256_loadu_si256((const __m256i*)(in + i * 32));
+            _mm256_storeu_si256((__m256i*)(out + i * 32), _mm256_xor_si256(state[i], p));
+        }
 
-    /* AES encryption rounds */
-    __m256i state[4];
-    state[0] = _mm256_xor_si256(ctr_blocks[0], rk[0]);
-    state[1] = _mm256_xor_si256(ctr_blocks[1], rk[0]);
-    state[2] = _mm256_xor_si256(ctr_blocks[2], rk[0]);
-    state[3] = _mm256_xor_si256(ctr_blocks[3], rk[0]);
+        in += 128;
+        out += 128;
+        blocks -= 8;
+    }
 
-    for (int round = 1; round < 14; round++) {
-        state[0] = _mm256_aesenc_epi128(state[0], rk[round]);
-        state[1] = _mm256_aesenc_epi128(state[1], rk[round]);
-        state[2] = _mm256_aesenc_epi128(state[2], rk[round]);
-        state[3] = _mm256_aesenc_epi128(state[3], rk[round]);
+    while (blocks >= 2) {
+        __m256i state;
+        soliton_ctr_ymm_next(&ctr, &state, 1);
+        aes256_enc_ymm(&state, 1, rk);
+        _mm256_storeu_si256((__m256i*)out,
+                            _mm256_xor_si256(state, _mm256_loadu_si256((const __m256i*)in)));
+        in += 32;
+        out += 32;
+        blocks -= 2;
     }
 
-    state[0] = _mm256_aesenclast_epi128(state[0], rk[14]);
-    state[1] = _mm256_aesenclast_epi128(state[1], rk[14]);
-    state[2] = _mm256_aesenclast_epi128(state[2], rk[14]);
-    state[3] = _mm256_aesenclast_epi128(state[3], rk[14]);
-
-    /* XOR with input */
-    __m256i in_blocks[4];
-    in_blocks[0] = _mm256_loadu_si256((const __m256i*)in);
-    in_blocks[1] = _mm256_loadu_si256((const __m256i*)(in + 32));
-    in_blocks[2] = _mm256_loadu_si256((const __m256i*)(in + 64));
-    in_blocks[3] = _mm256_loadu_si256((const __m256i*)(in + 96));
-
-    state[0] = _mm256_xor_si256(state[0], in_blocks[0]);
-    state[1] = _mm256_xor_si256(state[1], in_blocks[1]);
-    state[2] = _mm256_xor_si256(state[2], in_blocks[2]);
-    state[3] = _mm256_xor_si256(state[3], in_blocks[3]);
-
-    /* Store output */
-    _mm256_storeu_si256((__m256i*)out, state[0]);
-    _mm256_storeu_si256((__m256i*)(out + 32), state[1]);
-    _mm256_storeu_si256((__m256i*)(out + 64), state[2]);
-    _mm256_storeu_si256((__m256i*)(out + 96), state[3]);
+    if (blocks > 0) {
+        /* Low lane carries the last block; the high lane is discarded */
+        __m256i state;
+        soliton_ctr_ymm_next(&ctr, &state, 1);
+        aes256_enc_ymm(&state, 1, rk);
+        _mm_storeu_si128((__m128i*)out,
+                         _mm_xor_si128(_mm256_castsi256_si128(state),
+                                       _mm_loadu_si128((const __m128i*)in)));
+    }
 }
 
-/* AES-256 CTR mode using VAES - variable blocks */
-void aes256_ctr_blocks_vaes(const uint32_t* round_keys, const uint8_t iv[16],
-                            uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) {
-    /* Process 8 blocks at a time */
+/* AES-256 over independent blocks (ECB), 8 per iteration like the CTR
+ * loop; the odd last block rides in the low lane */
+void aes256_ecb_blocks_vaes(const uint32_t* round_keys, const uint8_t* in, uint8_t* out,
+                            size_t blocks) {
+    __m256i rk[15];
+    for (int i = 0; i < 15; i++) {
+        __m128i k128 = _mm_loadu_si128((const __m128i*)(round_keys + i * 4));
+        rk[i] = _mm256_broadcastsi128_si256(k128);
+    }
+
     while (blocks >= 8) {
-        aes256_ctr_blocks8_vaes(round_keys, iv, counter, in, out);
-        counter += 8;
+        __m256i state[4];
+        for (int i = 0; i < 4; i++) {
+            state[i] = _mm256_loadu_si256((const __m256i*)(in + i * 32));
+        }
+        aes256_enc_ymm(state, 4, rk);
+        for (int i = 0; i < 4; i++) {
+            _mm256_storeu_si256((__m256i*)(out + i * 32), state[i]);
+        }
         in += 128;
         out += 128;
         blocks -= 8;
     }
 
-    /* Handle remaining blocks with scalar fallback */
+    while (blocks >= 2) {
+        __m256i state = _mm256_loadu_si256((const __m256i*)in);
+        aes256_enc_ymm(&state, 1, rk);
+        _mm256_storeu_si256((__m256i*)out, state);
+        in += 32;
+        out += 32;
+        blocks -= 2;
+    }
+
     if (blocks > 0) {
-        extern void aes256_ctr_blocks_scalar(const uint32_t*, const uint8_t*,
-                                            uint32_t, const uint8_t*, uint8_t*, size_t);
-        aes256_ctr_blocks_scalar(round_keys, iv, counter, in, out, blocks);
+        __m256i state = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)in));
+        aes256_enc_ymm(&state, 1, rk);
+        _mm_storeu_si128((__m128i*)out, _mm256_castsi256_si128(state));
     }
 }
 
@@ -132,6 +153,7 @@ soliton_backend_t backend_vaes = {
     .aes_key_expand = (void (*)(const uint8_t*, uint32_t*))aes256_key_expand_vaes,
     .aes_encrypt_block = (void (*)(const uint32_t*, const uint8_t*, uint8_t*))aes256_encrypt_block_aesni,  /* Use AES-NI for single blocks */
     .aes_ctr_blocks = (void (*)(const uint32_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t))aes256_ctr_blocks_vaes,
+    .aes_ecb_blocks = aes256_ecb_blocks_vaes,
     .ghash_init = (void (*)(uint8_t*, const uint32_t*))ghash_init_clmul,    /* CLMUL-accelerated GHASH */
     .ghash_update = (void (*)(uint8_t*, const uint8_t*, const uint8_t*, size_t))ghash_update_clmul,  /* CLMUL-accelerated GHASH */
     .chacha_blocks = NULL,
@@ -0,0 +1,85 @@
+/*
+ * aes_vaes512.c - AES-256 CTR using VAES on 512-bit (ZMM) registers
+ * Four blocks per register, 16 blocks per iteration; the < 4 block tail
+ * uses AVX-512BW byte-masked loads/stores, so there is no scalar fallback.
+ * Only selected when the vector-width policy allows ZMM for the request
+ * (see soliton_set_vwidth_policy): on some parts sustained 512-bit AES
+ * lowers the core clock for everything else running on it.
+ */
+
+#include "common.h"
+#include "ctr_engine.h"
+
+#ifdef __x86_64__
+
+#include <immintrin.h>
+
+#if defined(__VAES__) && defined(__AVX512F__) && defined(__AVX512BW__)
+
+/* Round-key broadcast: AES-NI schedule layout, one 128-bit key per lane */
+#define RK512(i) _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)(round_keys + (i) * 4)))
+
+static SOLITON_INLINE __m512i aes256_enc4_zmm(__m512i s, const __m512i rk[15]) {
+    s = _mm512_xor_si512(s, rk[0]);
+    for (int r = 1; r < 14; r++) {
+        s = _mm512_aesenc_epi128(s, rk[r]);
+    }
+    return _mm512_aesenclast_epi128(s, rk[14]);
+}
+
+void aes256_ctr_blocks_vaes512(const uint32_t* round_keys, const uint8_t iv[16],
+                               uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) {
+    __m512i rk[15];
+    for (int i = 0; i < 15; i++) {
+        rk[i] = RK512(i);
+    }
+
+    /* Lane i holds counter + i; wraps mod 2^32 like GCM inc32 */
+    soliton_ctr_zmm ctr;
+    soliton_ctr_zmm_init(&ctr, iv, counter);
+
+    while (blocks >= 16) {
+        __m512i s[4];
+        soliton_ctr_zmm_next(&ctr, s, 4);
+
+        for (int j = 0; j < 4; j++) {
+            s[j] = _mm512_xor_si512(s[j], rk[0]);
+        }
+        for (int r = 1; r < 14; r++) {
+            for (int j = 0; j < 4; j++) {
+                s[j] = _mm512_aesenc_epi128(s[j], rk[r]);
+            }
+        }
+        for (int j = 0; j < 4; j++) {
+            s[j] = _mm512_aesenclast_epi128(s[j], rk[14]);
+            _mm512_storeu_si512((void*)(out + j * 64),
+                                _mm512_xor_si512(s[j], _mm512_loadu_si512((const void*)(in + j * 64))));
+        }
+
+        in += 256;
+        out += 256;
+        blocks -= 16;
+    }
+
+    while (blocks >= 4) {
+        __m512i c;
+        soliton_ctr_zmm_next(&ctr, &c, 1);
+        const __m512i ks = aes256_enc4_zmm(c, rk);
+        _mm512_storeu_si512((void*)out, _mm512_xor_si512(ks, _mm512_loadu_si512((const void*)in)));
+        in += 64;
+        out += 64;
+        blocks -= 4;
+    }
+
+    if (blocks > 0) {
+        /* 1..3 blocks: byte-masked, never touches memory past the buffer */
+        const __mmask64 m = ((__mmask64)1 << (blocks * 16)) - 1;
+        __m512i c;
+        soliton_ctr_zmm_next(&ctr, &c, 1);
+        const __m512i ks = aes256_enc4_zmm(c, rk);
+        _mm512_mask_storeu_epi8(out, m, _mm512_xor_si512(ks, _mm512_maskz_loadu_epi8(m, in)));
+    }
+}
+
+#endif /* __VAES__ && __AVX512F__ && __AVX512BW__ */
+#endif /* __x86_64__ */
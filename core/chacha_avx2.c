@@ -1,6 +1,7 @@
 /*
- * chacha_avx2.c - ChaCha20 implementation using AVX2
+ * chacha_avx2.c - ChaCha20/12/8 implementation using AVX2
  * 8-way parallel processing for improved throughput
+ * One 8-block kernel, instantiated per round count at compile time
  */
 
 #include "common.h"
@@ -33,9 +34,10 @@
             _mm256_srli_epi32(b, 25));                \
     } while (0)
 
-/* ChaCha20 8-block parallel processing */
-void chacha20_blocks8_avx2(const uint8_t key[32], const uint8_t nonce[12],
-                           uint32_t counter, const uint8_t* in, uint8_t* out) {
+/* ChaCha 8-block parallel processing, rounds must be a compile-time constant */
+static SOLITON_INLINE void chacha_blocks8_avx2_impl(const uint8_t key[32], const uint8_t nonce[12],
+                                                    uint32_t counter, const uint8_t* in, uint8_t* out,
+                                                    const int rounds) {
     /* Rotation constants */
     const __m256i rot16 = _mm256_set_epi8(
         13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
@@ -57,25 +59,23 @@ void chacha20_blocks8_avx2(const uint8_t key[32], const uint8_t nonce[12],
     s3 = _mm256_set1_epi32(0x6b206574);
 
     /* Key (broadcast to all lanes) */
-    s4 = _mm256_set1_epi32(((uint32_t*)key)[0]);
-    s5 = _mm256_set1_epi32(((uint32_t*)key)[1]);
-    s6 = _mm256_set1_epi32(((uint32_t*)key)[2]);
-    s7 = _mm256_set1_epi32(((uint32_t*)key)[3]);
-    s8 = _mm256_set1_epi32(((uint32_t*)key)[4]);
-    s9 = _mm256_set1_epi32(((uint32_t*)key)[5]);
-    s10 = _mm256_set1_epi32(((uint32_t*)key)[6]);
-    s11 = _mm256_set1_epi32(((uint32_t*)key)[7]);
+    s4 = _mm256_set1_epi32((int)soliton_le32(key + 0));
+    s5 = _mm256_set1_epi32((int)soliton_le32(key + 4));
+    s6 = _mm256_set1_epi32((int)soliton_le32(key + 8));
+    s7 = _mm256_set1_epi32((int)soliton_le32(key + 12));
+    s8 = _mm256_set1_epi32((int)soliton_le32(key + 16));
+    s9 = _mm256_set1_epi32((int)soliton_le32(key + 20));
+    s10 = _mm256_set1_epi32((int)soliton_le32(key + 24));
+    s11 = _mm256_set1_epi32((int)soliton_le32(key + 28));
 
     /* Counter (different for each block) */
-    s12 = _mm256_setr_epi32(
-        counter, counter + 1, counter + 2, counter + 3,
-        counter + 4, counter + 5, counter + 6, counter + 7
-    );
+    s12 = _mm256_add_epi32(_mm256_set1_epi32((int)counter),
+                           _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
 
     /* Nonce (broadcast to all lanes) */
-    s13 = _mm256_set1_epi32(((uint32_t*)nonce)[0]);
-    s14 = _mm256_set1_epi32(((uint32_t*)nonce)[1]);
-    s15 = _mm256_set1_epi32(((uint32_t*)nonce)[2]);
+    s13 = _mm256_set1_epi32((int)soliton_le32(nonce + 0));
+    s14 = _mm256_set1_epi32((int)soliton_le32(nonce + 4));
+    s15 = _mm256_set1_epi32((int)soliton_le32(nonce + 8));
 
     /* Save initial state */
     __m256i init0 = s0, init1 = s1, init2 = s2, init3 = s3;
@@ -83,8 +83,8 @@ void chacha20_blocks8_avx2(const uint8_t key[32], const uint8_t nonce[12],
     __m256i init8 = s8, init9 = s9, init10 = s10, init11 = s11;
     __m256i init12 = s12, init13 = s13, init14 = s14, init15 = s15;
 
-    /* 20 rounds (10 double-rounds) */
-    for (int i = 0; i < 10; i++) {
+    /* rounds/2 double-rounds */
+    for (int i = 0; i < rounds / 2; i++) {
         /* Column rounds */
         CHACHA_QR_AVX2(s0, s4, s8, s12);
         CHACHA_QR_AVX2(s1, s5, s9, s13);
@@ -116,10 +116,10 @@ void chacha20_blocks8_avx2(const uint8_t key[32], const uint8_t nonce[12],
     s14 = _mm256_add_epi32(s14, init14);
     s15 = _mm256_add_epi32(s15, init15);
 
-    /* Transpose and XOR with input */
+    /* Transpose 4x4 within each 128-bit lane: afterwards s0..s3 hold words
+     * 0-3 of blocks {0|4, 1|5, 2|6, 3|7} and s4..s7 hold words 4-7 */
     __m256i t0, t1, t2, t3, t4, t5, t6, t7;
 
-    /* Transpose to get correct byte order for each block */
     t0 = _mm256_unpacklo_epi32(s0, s1);
     t1 = _mm256_unpacklo_epi32(s2, s3);
     t2 = _mm256_unpackhi_epi32(s0, s1);
@@ -138,7 +138,7 @@ void chacha20_blocks8_avx2(const uint8_t key[32], const uint8_t nonce[12],
     s6 = _mm256_unpacklo_epi64(t6, t7);
     s7 = _mm256_unpackhi_epi64(t6, t7);
 
-    /* Continue with remaining state */
+    /* Same for words 8-15 */
     t0 = _mm256_unpacklo_epi32(s8, s9);
     t1 = _mm256_unpacklo_epi32(s10, s11);
     t2 = _mm256_unpackhi_epi32(s8, s9);
@@ -157,77 +157,67 @@ void chacha20_blocks8_avx2(const uint8_t key[32], const uint8_t nonce[12],
     s14 = _mm256_unpacklo_epi64(t6, t7);
     s15 = _mm256_unpackhi_epi64(t6, t7);
 
-    /* Final transpose to get blocks in correct order */
-    /* After all the mixing, we need to arrange data so each 64-byte block is contiguous */
-
-    /* Permute to group data by blocks instead of by word position */
-    __m256i perm_idx = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
-
-    /* Process first half of state (words 0-7) */
-    __m256i w0 = _mm256_permutevar8x32_epi32(s0, perm_idx);
-    __m256i w1 = _mm256_permutevar8x32_epi32(s1, perm_idx);
-    __m256i w2 = _mm256_permutevar8x32_epi32(s2, perm_idx);
-    __m256i w3 = _mm256_permutevar8x32_epi32(s3, perm_idx);
-    __m256i w4 = _mm256_permutevar8x32_epi32(s4, perm_idx);
-    __m256i w5 = _mm256_permutevar8x32_epi32(s5, perm_idx);
-    __m256i w6 = _mm256_permutevar8x32_epi32(s6, perm_idx);
-    __m256i w7 = _mm256_permutevar8x32_epi32(s7, perm_idx);
-
-    /* Process second half of state (words 8-15) */
-    __m256i w8 = _mm256_permutevar8x32_epi32(s8, perm_idx);
-    __m256i w9 = _mm256_permutevar8x32_epi32(s9, perm_idx);
-    __m256i w10 = _mm256_permutevar8x32_epi32(s10, perm_idx);
-    __m256i w11 = _mm256_permutevar8x32_epi32(s11, perm_idx);
-    __m256i w12 = _mm256_permutevar8x32_epi32(s12, perm_idx);
-    __m256i w13 = _mm256_permutevar8x32_epi32(s13, perm_idx);
-    __m256i w14 = _mm256_permutevar8x32_epi32(s14, perm_idx);
-    __m256i w15 = _mm256_permutevar8x32_epi32(s15, perm_idx);
-
-    /* Store transposed state and XOR with input */
-    __m256i* output = (__m256i*)out;
+    /* Cross-lane step: low lanes form blocks 0-3, high lanes blocks 4-7,
+     * so each 64-byte block is two contiguous 32-byte stores */
     const __m256i* input = (const __m256i*)in;
+    __m256i* output = (__m256i*)out;
 
-    /* Store first 256 bytes (blocks 0-3) */
-    _mm256_storeu_si256(output + 0, _mm256_xor_si256(w0, _mm256_loadu_si256(input + 0)));
-    _mm256_storeu_si256(output + 1, _mm256_xor_si256(w1, _mm256_loadu_si256(input + 1)));
-    _mm256_storeu_si256(output + 2, _mm256_xor_si256(w2, _mm256_loadu_si256(input + 2)));
-    _mm256_storeu_si256(output + 3, _mm256_xor_si256(w3, _mm256_loadu_si256(input + 3)));
-    _mm256_storeu_si256(output + 4, _mm256_xor_si256(w4, _mm256_loadu_si256(input + 4)));
-    _mm256_storeu_si256(output + 5, _mm256_xor_si256(w5, _mm256_loadu_si256(input + 5)));
-    _mm256_storeu_si256(output + 6, _mm256_xor_si256(w6, _mm256_loadu_si256(input + 6)));
-    _mm256_storeu_si256(output + 7, _mm256_xor_si256(w7, _mm256_loadu_si256(input + 7)));
-
-    /* Store second 256 bytes (blocks 4-7) */
-    _mm256_storeu_si256(output + 8, _mm256_xor_si256(w8, _mm256_loadu_si256(input + 8)));
-    _mm256_storeu_si256(output + 9, _mm256_xor_si256(w9, _mm256_loadu_si256(input + 9)));
-    _mm256_storeu_si256(output + 10, _mm256_xor_si256(w10, _mm256_loadu_si256(input + 10)));
-    _mm256_storeu_si256(output + 11, _mm256_xor_si256(w11, _mm256_loadu_si256(input + 11)));
-    _mm256_storeu_si256(output + 12, _mm256_xor_si256(w12, _mm256_loadu_si256(input + 12)));
-    _mm256_storeu_si256(output + 13, _mm256_xor_si256(w13, _mm256_loadu_si256(input + 13)));
-    _mm256_storeu_si256(output + 14, _mm256_xor_si256(w14, _mm256_loadu_si256(input + 14)));
-    _mm256_storeu_si256(output + 15, _mm256_xor_si256(w15, _mm256_loadu_si256(input + 15)));
-}
+#define CHACHA_STORE_AVX2(blk, a, b, c, d, sel)                                   \
+    do {                                                                          \
+        _mm256_storeu_si256(output + 2 * (blk),                                   \
+            _mm256_xor_si256(_mm256_permute2x128_si256(a, b, sel),                \
+                             _mm256_loadu_si256(input + 2 * (blk))));             \
+        _mm256_storeu_si256(output + 2 * (blk) + 1,                               \
+            _mm256_xor_si256(_mm256_permute2x128_si256(c, d, sel),                \
+                             _mm256_loadu_si256(input + 2 * (blk) + 1)));         \
+    } while (0)
 
-/* ChaCha20 blocks using AVX2 */
-void chacha20_blocks_avx2(const uint8_t key[32], const uint8_t nonce[12],
-                         uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) {
-    /* Process 8 blocks at a time */
-    while (blocks >= 8) {
-        chacha20_blocks8_avx2(key, nonce, counter, in, out);
-        counter += 8;
-        in += 512;
-        out += 512;
-        blocks -= 8;
-    }
+    CHACHA_STORE_AVX2(0, s0, s4, s8, s12, 0x20);
+    CHACHA_STORE_AVX2(1, s1, s5, s9, s13, 0x20);
+    CHACHA_STORE_AVX2(2, s2, s6, s10, s14, 0x20);
+    CHACHA_STORE_AVX2(3, s3, s7, s11, s15, 0x20);
+    CHACHA_STORE_AVX2(4, s0, s4, s8, s12, 0x31);
+    CHACHA_STORE_AVX2(5, s1, s5, s9, s13, 0x31);
+    CHACHA_STORE_AVX2(6, s2, s6, s10, s14, 0x31);
+    CHACHA_STORE_AVX2(7, s3, s7, s11, s15, 0x31);
 
-    /* Handle remaining blocks with scalar fallback */
-    if (blocks > 0) {
-        extern void chacha20_blocks_scalar(const uint8_t*, const uint8_t*,
-                                          uint32_t, const uint8_t*, uint8_t*, size_t);
-        chacha20_blocks_scalar(key, nonce, counter, in, out, blocks);
-    }
+#undef CHACHA_STORE_AVX2
+}
+
+/* Round-specialized entry points: chachaR_blocks8_avx2 / chachaR_blocks_avx2,
+ * remainder blocks go to the matching scalar variant */
+#define CHACHA_AVX2_VARIANT(R) \
+extern void chacha##R##_blocks_scalar(const uint8_t*, const uint8_t*, \
+                                      uint32_t, const uint8_t*, uint8_t*, size_t); \
+void chacha##R##_blocks8_avx2(const uint8_t key[32], const uint8_t nonce[12], \
+                              uint32_t counter, const uint8_t* in, uint8_t* out) { \
+    chacha_blocks8_avx2_impl(key, nonce, counter, in, out, R); \
+} \
+void chacha##R##_blocks_avx2(const uint8_t key[32], const uint8_t nonce[12], \
+                             uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) { \
+    /* Process 8 blocks at a time */ \
+    while (blocks >= 8) { \
+        chacha_blocks8_avx2_impl(key, nonce, counter, in, out, R); \
+        counter += 8; \
+        in += 512; \
+        out += 512; \
+        blocks -= 8; \
+    } \
+    /* Handle remaining blocks with scalar fallback */ \
+    if (blocks > 0) { \
+        chacha##R##_blocks_scalar(key, nonce, counter, in, out, blocks); \
+    } \
 }
 
+CHACHA_AVX2_VARIANT(20)
+CHACHA_AVX2_VARIANT(12)
+CHACHA_AVX2_VARIANT(8)
+
+/* Poly1305: radix-2^64 engine (poly1305_64.c) */
+extern void poly1305_init_64(void* state, const uint8_t key[32]);
+extern void poly1305_update_64(void* state, const uint8_t* data, size_t len);
+extern void poly1305_final_64(void* state, uint8_t tag[16]);
+
 /* Backend structure for AVX2 */
 extern soliton_backend_t backend_avx2;
 soliton_backend_t backend_avx2 = {
@@ -236,10 +226,12 @@ soliton_backend_t backend_avx2 = {
     .aes_ctr_blocks = NULL,
     .ghash_init = NULL,
     .ghash_update = NULL,
-    .chacha_blocks = (void (*)(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t))chacha20_blocks_avx2,
-    .poly1305_init = NULL,
-    .poly1305_update = NULL,
-    .poly1305_final = NULL,
+    .chacha_blocks = chacha20_blocks_avx2,
+    .poly1305_init = poly1305_init_64,
+    .poly1305_update = poly1305_update_64,
+    .poly1305_final = poly1305_final_64,
+    .chacha12_blocks = chacha12_blocks_avx2,
+    .chacha8_blocks = chacha8_blocks_avx2,
     .name = "avx2"
 };
 
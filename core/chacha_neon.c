@@ -1,51 +1,53 @@
 /*
- * chacha_neon.c - ChaCha20 implementation using ARM NEON
+ * chacha_neon.c - ChaCha20/12/8 implementation using ARM NEON
  * 4-way parallel processing with NEON SIMD instructions
+ * One 4-block kernel, instantiated per round count at compile time
  */
 
+#include "common.h"
+
 #ifdef __aarch64__
 #ifdef __ARM_NEON
 
 #include <arm_neon.h>
-#include "../include/soliton.h"
 
 /* ChaCha20 constants */
 static const uint32_t CHACHA_CONST[4] = {
     0x61707865, 0x3320646e, 0x79622d32, 0x6b206574
 };
 
+/* Rotate left (shift counts must be immediates, so this is a macro) */
+#define ROTL_NEON(v, n) vorrq_u32(vshlq_n_u32(v, n), vshrq_n_u32(v, 32 - (n)))
+
 /* Quarter round on NEON vectors */
 #define QUARTER_ROUND(a, b, c, d) do { \
-    a = vaddq_u32(a, b); d = veorq_u32(d, a); d = vrorq_n_u32(d, 16); \
-    c = vaddq_u32(c, d); b = veorq_u32(b, c); b = vrorq_n_u32(b, 12); \
-    a = vaddq_u32(a, b); d = veorq_u32(d, a); d = vrorq_n_u32(d, 8); \
-    c = vaddq_u32(c, d); b = veorq_u32(b, c); b = vrorq_n_u32(b, 7); \
+    a = vaddq_u32(a, b); d = veorq_u32(d, a); d = ROTL_NEON(d, 16); \
+    c = vaddq_u32(c, d); b = veorq_u32(b, c); b = ROTL_NEON(b, 12); \
+    a = vaddq_u32(a, b); d = veorq_u32(d, a); d = ROTL_NEON(d, 8); \
+    c = vaddq_u32(c, d); b = veorq_u32(b, c); b = ROTL_NEON(b, 7); \
 } while(0)
 
-/* Rotate right for NEON (ARMv8 has vrorq) */
-static inline uint32x4_t vrorq_n_u32(uint32x4_t v, int n) {
-    return vorrq_u32(vshrq_n_u32(v, n), vshlq_n_u32(v, 32 - n));
-}
-
-/* Process 4 blocks in parallel */
-void chacha20_blocks4_neon(
-    const uint32_t key[8],
-    const uint32_t nonce[3],
+/* Process 4 blocks at a time, rounds must be a compile-time constant.
+ * Returns the number of blocks left for the scalar tail. */
+static SOLITON_INLINE size_t chacha_blocks4_neon_impl(
+    const uint8_t key[32],
+    const uint8_t nonce[12],
     uint32_t counter,
     const uint8_t* in,
     uint8_t* out,
-    size_t blocks
+    size_t blocks,
+    const int rounds
 ) {
-    /* Load key */
-    uint32x4_t k0 = vld1q_u32(&key[0]);
-    uint32x4_t k1 = vld1q_u32(&key[4]);
+    /* Load key (little-endian words) */
+    uint32x4_t k0 = vreinterpretq_u32_u8(vld1q_u8(key));
+    uint32x4_t k1 = vreinterpretq_u32_u8(vld1q_u8(key + 16));
 
     /* Prepare nonce and counter */
     uint32_t nc[4];
     nc[0] = counter;
-    nc[1] = nonce[0];
-    nc[2] = nonce[1];
-    nc[3] = nonce[2];
+    nc[1] = soliton_le32(nonce + 0);
+    nc[2] = soliton_le32(nonce + 4);
+    nc[3] = soliton_le32(nonce + 8);
 
     while (blocks >= 4) {
         /* Initialize states for 4 blocks */
@@ -84,8 +86,8 @@ void chacha20_blocks4_neon(
         uint32x4_t init2[4] = {s2[0], s2[1], s2[2], s2[3]};
         uint32x4_t init3[4] = {s3[0], s3[1], s3[2], s3[3]};
 
-        /* 20 rounds (10 double-rounds) */
-        for (int i = 0; i < 10; i++) {
+        /* rounds/2 double-rounds */
+        for (int i = 0; i < rounds / 2; i++) {
             /* Column rounds */
             QUARTER_ROUND(s0[0], s0[1], s0[2], s0[3]);
             QUARTER_ROUND(s1[0], s1[1], s1[2], s1[3]);
@@ -153,55 +155,51 @@ void chacha20_blocks4_neon(
         s3[2] = vaddq_u32(s3[2], init3[2]);
         s3[3] = vaddq_u32(s3[3], init3[3]);
 
-        /* XOR with input and write output */
-        if (in && out) {
-            for (int i = 0; i < 4; i++) {
-                uint32x4_t p = vld1q_u32((const uint32_t*)(in + i * 16));
-                vst1q_u32((uint32_t*)(out + i * 16), veorq_u32(s0[i], p));
-            }
-            for (int i = 0; i < 4; i++) {
-                uint32x4_t p = vld1q_u32((const uint32_t*)(in + 64 + i * 16));
-                vst1q_u32((uint32_t*)(out + 64 + i * 16), veorq_u32(s1[i], p));
-            }
-            for (int i = 0; i < 4; i++) {
-                uint32x4_t p = vld1q_u32((const uint32_t*)(in + 128 + i * 16));
-                vst1q_u32((uint32_t*)(out + 128 + i * 16), veorq_u32(s2[i], p));
-            }
-            for (int i = 0; i < 4; i++) {
-                uint32x4_t p = vld1q_u32((const uint32_t*)(in + 192 + i * 16));
-                vst1q_u32((uint32_t*)(out + 192 + i * 16), veorq_u32(s3[i], p));
-            }
+        /* XOR with input and write output (byte loads, no alignment assumed) */
+        for (int i = 0; i < 4; i++) {
+            uint8x16_t p = vld1q_u8(in + i * 16);
+            vst1q_u8(out + i * 16, veorq_u8(vreinterpretq_u8_u32(s0[i]), p));
+        }
+        for (int i = 0; i < 4; i++) {
+            uint8x16_t p = vld1q_u8(in + 64 + i * 16);
+            vst1q_u8(out + 64 + i * 16, veorq_u8(vreinterpretq_u8_u32(s1[i]), p));
+        }
+        for (int i = 0; i < 4; i++) {
+            uint8x16_t p = vld1q_u8(in + 128 + i * 16);
+            vst1q_u8(out + 128 + i * 16, veorq_u8(vreinterpretq_u8_u32(s2[i]), p));
+        }
+        for (int i = 0; i < 4; i++) {
+            uint8x16_t p = vld1q_u8(in + 192 + i * 16);
+            vst1q_u8(out + 192 + i * 16, veorq_u8(vreinterpretq_u8_u32(s3[i]), p));
         }
 
         blocks -= 4;
-        if (in) in += 256;
-        if (out) out += 256;
+        in += 256;
+        out += 256;
     }
 
-    /* Handle remaining blocks with scalar */
-    if (blocks > 0) {
-        extern void chacha20_blocks_scalar(const uint32_t*, const uint32_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
-        chacha20_blocks_scalar(key, nonce, counter, in, out, blocks);
-    }
+    return blocks;
 }
 
-/* Main entry point for ChaCha20 NEON */
-void chacha20_blocks_neon(
-    const uint32_t key[8],
-    const uint32_t nonce[3],
-    uint32_t counter,
-    const uint8_t* in,
-    uint8_t* out,
-    size_t blocks
-) {
-    if (blocks >= 4) {
-        chacha20_blocks4_neon(key, nonce, counter, in, out, blocks);
-    } else if (blocks > 0) {
-        extern void chacha20_blocks_scalar(const uint32_t*, const uint32_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
-        chacha20_blocks_scalar(key, nonce, counter, in, out, blocks);
-    }
+/* Round-specialized entry points: chachaR_blocks_neon, remainder blocks go
+ * to the matching scalar variant */
+#define CHACHA_NEON_VARIANT(R) \
+extern void chacha##R##_blocks_scalar(const uint8_t*, const uint8_t*, \
+                                      uint32_t, const uint8_t*, uint8_t*, size_t); \
+void chacha##R##_blocks_neon(const uint8_t key[32], const uint8_t nonce[12], \
+                             uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) { \
+    size_t done = blocks & ~(size_t)3; \
+    size_t rest = chacha_blocks4_neon_impl(key, nonce, counter, in, out, blocks, R); \
+    if (rest > 0) { \
+        chacha##R##_blocks_scalar(key, nonce, counter + (uint32_t)done, \
+                                  in + done * 64, out + done * 64, rest); \
+    } \
 }
 
+CHACHA_NEON_VARIANT(20)
+CHACHA_NEON_VARIANT(12)
+CHACHA_NEON_VARIANT(8)
+
 /* Backend structure for NEON ChaCha20 */
 extern soliton_backend_t backend_chacha_neon;
 soliton_backend_t backend_chacha_neon = {
@@ -210,10 +208,12 @@ soliton_backend_t backend_chacha_neon = {
     .aes_ctr_blocks = NULL,
     .ghash_init = NULL,
     .ghash_update = NULL,
-    .chacha_blocks = (void (*)(const uint32_t*, const uint32_t*, uint32_t, const uint8_t*, uint8_t*, size_t))chacha20_blocks_neon,
+    .chacha_blocks = chacha20_blocks_neon,
     .poly1305_init = NULL,
     .poly1305_update = NULL,
     .poly1305_final = NULL,
+    .chacha12_blocks = chacha12_blocks_neon,
+    .chacha8_blocks = chacha8_blocks_neon,
     .name = "chacha_neon"
 };
 
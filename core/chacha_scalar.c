@@ -1,6 +1,11 @@
 /*
  * chacha_scalar.c - ChaCha20 stream cipher implementation (RFC 8439)
  * Constant-time scalar implementation
+ *
+ * The core is specialized at compile time for 20, 12 and 8 rounds:
+ * chacha_core() is force-inlined with a constant round count into each
+ * chachaR_* entry point. Only ChaCha20 is RFC 8439; ChaCha12/ChaCha8 are
+ * the reduced-round variants from the original ChaCha paper.
  */
 
 #include "common.h"
@@ -19,8 +24,8 @@ static SOLITON_INLINE void chacha_qr(uint32_t* a, uint32_t* b, uint32_t* c, uint
     *c += *d; *b ^= *c; *b = SOLITON_ROTL32(*b, 7);
 }
 
-/* ChaCha20 block function */
-static void chacha20_block(uint32_t out[16], const uint32_t in[16]) {
+/* ChaCha block function, rounds must be a compile-time constant (8/12/20) */
+static SOLITON_INLINE void chacha_core(uint32_t out[16], const uint32_t in[16], const int rounds) {
     uint32_t x[16];
 
     /* Copy input to working state */
@@ -28,8 +33,8 @@ static void chacha20_block(uint32_t out[16], const uint32_t in[16]) {
         x[i] = in[i];
     }
 
-    /* 20 rounds (10 double-rounds) */
-    for (int i = 0; i < 10; i++) {
+    /* rounds/2 double-rounds */
+    for (int i = 0; i < rounds / 2; i++) {
         /* Column rounds */
         chacha_qr(&x[0], &x[4], &x[8],  &x[12]);
         chacha_qr(&x[1], &x[5], &x[9],  &x[13]);
@@ -49,8 +54,8 @@ static void chacha20_block(uint32_t out[16], const uint32_t in[16]) {
     }
 }
 
-/* Initialize ChaCha20 state */
-static void chacha20_init_state(uint32_t state[16], const uint8_t key[32],
+/* Initialize ChaCha state (RFC 8439 layout: 32-bit counter, 96-bit nonce) */
+static void chacha_init_state(uint32_t state[16], const uint8_t key[32],
                                 const uint8_t nonce[12], uint32_t counter) {
     /* Constants */
     state[0] = CHACHA_CONSTANTS[0];
@@ -77,18 +82,19 @@ static void chacha20_init_state(uint32_t state[16], const uint8_t key[32],
     state[15] = soliton_le32(nonce + 8);
 }
 
-/* Generate ChaCha20 keystream for multiple blocks */
-void chacha20_blocks_scalar(const uint8_t key[32], const uint8_t nonce[12],
-                           uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) {
+/* Generate keystream for multiple blocks */
+static SOLITON_INLINE void chacha_blocks_impl(const uint8_t key[32], const uint8_t nonce[12],
+                                              uint32_t counter, const uint8_t* in, uint8_t* out,
+                                              size_t blocks, const int rounds) {
     uint32_t state[16];
     uint32_t keystream[16];
 
     for (size_t i = 0; i < blocks; i++) {
         /* Initialize state for this block */
-        chacha20_init_state(state, key, nonce, counter + (uint32_t)i);
+        chacha_init_state(state, key, nonce, counter + (uint32_t)i);
 
         /* Generate keystream block */
-        chacha20_block(keystream, state);
+        chacha_core(keystream, state, rounds);
 
         /* XOR with input (handle both encryption and decryption) */
         if (in != NULL && out != NULL) {
@@ -105,15 +111,16 @@ void chacha20_blocks_scalar(const uint8_t key[32], const uint8_t nonce[12],
     soliton_wipe(keystream, sizeof(keystream));
 }
 
-/* Generate ChaCha20 keystream with partial block support */
-void chacha20_xor_scalar(const uint8_t key[32], const uint8_t nonce[12],
-                        uint32_t counter, const uint8_t* in, uint8_t* out, size_t len) {
+/* Generate keystream with partial block support */
+static SOLITON_INLINE void chacha_xor_impl(const uint8_t key[32], const uint8_t nonce[12],
+                                           uint32_t counter, const uint8_t* in, uint8_t* out,
+                                           size_t len, const int rounds) {
     size_t full_blocks = len / 64;
     size_t remainder = len % 64;
 
     /* Process full blocks */
     if (full_blocks > 0) {
-        chacha20_blocks_scalar(key, nonce, counter, in, out, full_blocks);
+        chacha_blocks_impl(key, nonce, counter, in, out, full_blocks, rounds);
         in += full_blocks * 64;
         out += full_blocks * 64;
         counter += (uint32_t)full_blocks;
@@ -126,8 +133,8 @@ void chacha20_xor_scalar(const uint8_t key[32], const uint8_t nonce[12],
         uint8_t ks_bytes[64];
 
         /* Generate keystream for partial block */
-        chacha20_init_state(state, key, nonce, counter);
-        chacha20_block(keystream, state);
+        chacha_init_state(state, key, nonce, counter);
+        chacha_core(keystream, state, rounds);
 
         /* Convert keystream to bytes */
         for (int i = 0; i < 16; i++) {
@@ -145,15 +152,15 @@ void chacha20_xor_scalar(const uint8_t key[32], const uint8_t nonce[12],
     }
 }
 
-/* ChaCha20-Poly1305 one-time key generation */
-void chacha20_poly1305_key_gen_scalar(uint8_t poly_key[32], const uint8_t key[32],
-                                      const uint8_t nonce[12]) {
+/* Poly1305 one-time key generation (first 32 bytes of block 0) */
+static SOLITON_INLINE void chacha_poly1305_key_gen_impl(uint8_t poly_key[32], const uint8_t key[32],
+                                                        const uint8_t nonce[12], const int rounds) {
     uint32_t state[16];
     uint32_t keystream[16];
 
-    /* Generate first ChaCha20 block with counter=0 */
-    chacha20_init_state(state, key, nonce, 0);
-    chacha20_block(keystream, state);
+    /* Generate first block with counter=0 */
+    chacha_init_state(state, key, nonce, 0);
+    chacha_core(keystream, state, rounds);
 
     /* Extract first 32 bytes as Poly1305 key */
     for (int i = 0; i < 8; i++) {
@@ -164,23 +171,24 @@ void chacha20_poly1305_key_gen_scalar(uint8_t poly_key[32], const uint8_t key[32
     soliton_wipe(keystream, sizeof(keystream));
 }
 
-/* 4-way parallel ChaCha20 for better throughput */
-void chacha20_blocks4_scalar(const uint8_t key[32], const uint8_t nonce[12],
-                            uint32_t counter, const uint8_t* in, uint8_t* out) {
+/* 4-way parallel ChaCha for better throughput */
+static SOLITON_INLINE void chacha_blocks4_impl(const uint8_t key[32], const uint8_t nonce[12],
+                                               uint32_t counter, const uint8_t* in, uint8_t* out,
+                                               const int rounds) {
     uint32_t state0[16], state1[16], state2[16], state3[16];
     uint32_t ks0[16], ks1[16], ks2[16], ks3[16];
 
     /* Initialize states with consecutive counters */
-    chacha20_init_state(state0, key, nonce, counter + 0);
-    chacha20_init_state(state1, key, nonce, counter + 1);
-    chacha20_init_state(state2, key, nonce, counter + 2);
-    chacha20_init_state(state3, key, nonce, counter + 3);
+    chacha_init_state(state0, key, nonce, counter + 0);
+    chacha_init_state(state1, key, nonce, counter + 1);
+    chacha_init_state(state2, key, nonce, counter + 2);
+    chacha_init_state(state3, key, nonce, counter + 3);
 
     /* Generate keystreams */
-    chacha20_block(ks0, state0);
-    chacha20_block(ks1, state1);
-    chacha20_block(ks2, state2);
-    chacha20_block(ks3, state3);
+    chacha_core(ks0, state0, rounds);
+    chacha_core(ks1, state1, rounds);
+    chacha_core(ks2, state2, rounds);
+    chacha_core(ks3, state3, rounds);
 
     /* XOR with input */
     for (int i = 0; i < 16; i++) {
@@ -202,12 +210,13 @@ void chacha20_blocks4_scalar(const uint8_t key[32], const uint8_t nonce[12],
     soliton_wipe(ks3, sizeof(ks3));
 }
 
-/* Optimized ChaCha20 for multiple blocks using 4-way parallelism */
-void chacha20_blocks_opt_scalar(const uint8_t key[32], const uint8_t nonce[12],
-                               uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) {
+/* Optimized ChaCha for multiple blocks using 4-way parallelism */
+static SOLITON_INLINE void chacha_blocks_opt_impl(const uint8_t key[32], const uint8_t nonce[12],
+                                                  uint32_t counter, const uint8_t* in, uint8_t* out,
+                                                  size_t blocks, const int rounds) {
     /* Process 4 blocks at a time */
     while (blocks >= 4) {
-        chacha20_blocks4_scalar(key, nonce, counter, in, out);
+        chacha_blocks4_impl(key, nonce, counter, in, out, rounds);
         counter += 4;
         in += 256;
         out += 256;
@@ -216,10 +225,37 @@ void chacha20_blocks_opt_scalar(const uint8_t key[32], const uint8_t nonce[12],
 
     /* Process remaining blocks */
     if (blocks > 0) {
-        chacha20_blocks_scalar(key, nonce, counter, in, out, blocks);
+        chacha_blocks_impl(key, nonce, counter, in, out, blocks, rounds);
     }
 }
 
+/* Round-specialized entry points: chachaR_{blocks,xor,poly1305_key_gen,blocks4,blocks_opt}_scalar */
+#define CHACHA_SCALAR_VARIANT(R) \
+void chacha##R##_blocks_scalar(const uint8_t key[32], const uint8_t nonce[12], \
+                               uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) { \
+    chacha_blocks_impl(key, nonce, counter, in, out, blocks, R); \
+} \
+void chacha##R##_xor_scalar(const uint8_t key[32], const uint8_t nonce[12], \
+                            uint32_t counter, const uint8_t* in, uint8_t* out, size_t len) { \
+    chacha_xor_impl(key, nonce, counter, in, out, len, R); \
+} \
+void chacha##R##_poly1305_key_gen_scalar(uint8_t poly_key[32], const uint8_t key[32], \
+                                         const uint8_t nonce[12]) { \
+    chacha_poly1305_key_gen_impl(poly_key, key, nonce, R); \
+} \
+void chacha##R##_blocks4_scalar(const uint8_t key[32], const uint8_t nonce[12], \
+                                uint32_t counter, const uint8_t* in, uint8_t* out) { \
+    chacha_blocks4_impl(key, nonce, counter, in, out, R); \
+} \
+void chacha##R##_blocks_opt_scalar(const uint8_t key[32], const uint8_t nonce[12], \
+                                   uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks) { \
+    chacha_blocks_opt_impl(key, nonce, counter, in, out, blocks, R); \
+}
+
+CHACHA_SCALAR_VARIANT(20)
+CHACHA_SCALAR_VARIANT(12)
+CHACHA_SCALAR_VARIANT(8)
+
 /* Backend structure for scalar ChaCha20 */
 soliton_backend_t backend_chacha_scalar = {
     .aes_key_expand = NULL,
@@ -231,5 +267,7 @@ soliton_backend_t backend_chacha_scalar = {
     .poly1305_init = NULL,
     .poly1305_update = NULL,
     .poly1305_final = NULL,
+    .chacha12_blocks = chacha12_blocks_opt_scalar,
+    .chacha8_blocks = chacha8_blocks_opt_scalar,
     .name = "chacha_scalar"
 };
\ No newline at end of file
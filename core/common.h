@@ -37,16 +37,42 @@
 /* Memory barriers for constant-time operations */
 #define SOLITON_BARRIER() __asm__ volatile("" ::: "memory")
 
-/* Constant-time memory comparison */
+/* Wide memory access for the constant-time helpers below.
+ * GCC/Clang vector extensions lower to SSE2 on x86-64 and NEON on AArch64
+ * without pulling in intrinsic headers; may_alias + aligned(1) make the
+ * unaligned, type-punned loads/stores well defined. Lengths are public,
+ * only the data is secret, so the 16/8/1-byte stepping is constant-time. */
+typedef uint8_t  soliton_v16 __attribute__((vector_size(16), may_alias, aligned(1)));
+typedef uint64_t soliton_u64a __attribute__((may_alias, aligned(1)));
+
+/* Constant-time memory comparison (0 if equal, non-zero otherwise) */
 static SOLITON_INLINE int soliton_ct_memcmp(const void* a, const void* b, size_t n) {
     const uint8_t* pa = (const uint8_t*)a;
     const uint8_t* pb = (const uint8_t*)b;
+    soliton_v16 vdiff = {0};
+    uint64_t wdiff = 0;
     uint8_t diff = 0;
+    size_t i = 0;
 
-    for (size_t i = 0; i < n; i++) {
+    for (; i + 16 <= n; i += 16) {
+        vdiff |= *(const soliton_v16*)(pa + i) ^ *(const soliton_v16*)(pb + i);
+    }
+    for (; i + 8 <= n; i += 8) {
+        wdiff |= *(const soliton_u64a*)(pa + i) ^ *(const soliton_u64a*)(pb + i);
+    }
+    for (; i < n; i++) {
         diff |= pa[i] ^ pb[i];
     }
 
+    for (int j = 0; j < 16; j++) {
+        diff |= vdiff[j];
+    }
+    wdiff |= wdiff >> 32;
+    wdiff |= wdiff >> 16;
+    wdiff |= wdiff >> 8;
+    diff |= (uint8_t)wdiff;
+    SOLITON_BARRIER();
+
     return diff;
 }
 
@@ -55,21 +81,58 @@ static SOLITON_INLINE void soliton_ct_cond_copy(void* dst, const void* src, size
     uint8_t* pd = (uint8_t*)dst;
     const uint8_t* ps = (const uint8_t*)src;
     uint8_t mask = (uint8_t)(-condition);
+    uint64_t wmask = (uint64_t)0 - (uint64_t)(condition & 1);
+    soliton_v16 vmask = (soliton_v16){0} + mask;
+    size_t i = 0;
 
-    for (size_t i = 0; i < n; i++) {
+    for (; i + 16 <= n; i += 16) {
+        soliton_v16* d = (soliton_v16*)(pd + i);
+        *d = (*d & ~vmask) | (*(const soliton_v16*)(ps + i) & vmask);
+    }
+    for (; i + 8 <= n; i += 8) {
+        soliton_u64a* d = (soliton_u64a*)(pd + i);
+        *d = (*d & ~wmask) | (*(const soliton_u64a*)(ps + i) & wmask);
+    }
+    for (; i < n; i++) {
         pd[i] = (pd[i] & ~mask) | (ps[i] & mask);
     }
 }
 
-/* Secure memory wipe */
+/* Secure memory wipe (volatile wide stores, never elided) */
 static SOLITON_INLINE void soliton_wipe(void* ptr, size_t n) {
     volatile uint8_t* p = (volatile uint8_t*)ptr;
-    while (n--) {
-        *p++ = 0;
+    const soliton_v16 zero = {0};
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        *(volatile soliton_v16*)(p + i) = zero;
+    }
+    for (; i + 8 <= n; i += 8) {
+        *(volatile soliton_u64a*)(p + i) = 0;
+    }
+    for (; i < n; i++) {
+        p[i] = 0;
     }
     SOLITON_BARRIER();
 }
 
+/* Non-secret-dependent copy (IVs, counters, key bytes); dst/src must not overlap */
+static SOLITON_INLINE void soliton_copy(void* dst, const void* src, size_t n) {
+    uint8_t* pd = (uint8_t*)dst;
+    const uint8_t* ps = (const uint8_t*)src;
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        *(soliton_v16*)(pd + i) = *(const soliton_v16*)(ps + i);
+    }
+    for (; i + 8 <= n; i += 8) {
+        *(soliton_u64a*)(pd + i) = *(const soliton_u64a*)(ps + i);
+    }
+    for (; i < n; i++) {
+        pd[i] = ps[i];
+    }
+}
+
 /* Byte order operations */
 static SOLITON_INLINE uint32_t soliton_le32(const uint8_t* p) {
     return ((uint32_t)p[0]) |
@@ -143,6 +206,25 @@ static SOLITON_INLINE void soliton_put_be64(uint8_t* p, uint64_t v) {
     p[7] = (uint8_t)(v);
 }
 
+/* Cycle/tick counter for sampled cost accounting (0 where unavailable) */
+static SOLITON_INLINE uint64_t soliton_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t lo, hi;
+    __asm__ volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+#elif defined(__aarch64__)
+    uint64_t val;
+    __asm__ volatile ("mrs %0, cntvct_el0" : "=r"(val));
+    return val;
+#elif defined(__riscv) && __riscv_xlen == 64
+    uint64_t val;
+    __asm__ volatile ("rdtime %0" : "=r"(val));
+    return val;
+#else
+    return 0;
+#endif
+}
+
 /* Rotate operations */
 #define SOLITON_ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
 #define SOLITON_ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
@@ -189,6 +271,22 @@ typedef struct {
     void (*poly1305_update)(void* ctx, const uint8_t* data, size_t len);
     void (*poly1305_final)(void* ctx, uint8_t tag[16]);
 
+    /* Reduced-round ChaCha (non-RFC, NULL if unavailable) */
+    void (*chacha12_blocks)(const uint8_t key[32], const uint8_t nonce[12],
+                            uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks);
+    void (*chacha8_blocks)(const uint8_t key[32], const uint8_t nonce[12],
+                           uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks);
+
+    /* Independent blocks under one key, e.g. GCM tag masks E_K(J0) of
+     * several messages (NULL if unavailable) */
+    void (*aes_ecb_blocks)(const uint32_t* round_keys, const uint8_t* in, uint8_t* out, size_t blocks);
+
+    /* Stitched AES-CTR + GHASH over full blocks (NULL if unavailable).
+     * Hashes the ciphertext side; state and h_powers in scalar GHASH order */
+    void (*gcm_blocks)(const uint32_t* round_keys, const uint8_t j0[16], uint32_t counter,
+                       const uint8_t* in, uint8_t* out, size_t blocks,
+                       uint8_t state[16], const uint8_t h_powers[16][16], int decrypt);
+
     /* Backend name for debugging */
     const char* name;
 } soliton_backend_t;
@@ -196,6 +294,81 @@ typedef struct {
 /* Global backend selection */
 extern const soliton_backend_t* soliton_get_backend(void);
 
+/* Build-dependent encoding of the AES-GCM key tables (round keys, H powers).
+ * Snapshots are only restorable into a build reporting the same value. */
+#define SOLITON_KEY_LAYOUT_HPOW_CLMUL 0x1u  /* H powers in CLMUL byte order */
+extern uint32_t soliton_aesgcm_key_layout(void);
+
+/* The two key setup stages of soliton_aesgcm_init, for callers that build
+ * a key off the hot path in slices (rekey.c). setup_key selects the
+ * backend, expands the round keys and caches the plan; setup_hash derives
+ * H and its powers from the round keys. Neither touches the IV. */
+extern void soliton_aesgcm_setup_key(soliton_aesgcm_ctx* ctx, const uint8_t key[32]);
+extern void soliton_aesgcm_setup_hash(soliton_aesgcm_ctx* ctx);
+
+/* AEGIS backend function pointers
+ * State is S0..S7 for AEGIS-128L (32-byte rate) and S0..S5 for AEGIS-256
+ * (16-byte rate), 16 bytes per word. Block counts are in units of the rate. */
+typedef struct {
+    /* AEGIS-128L */
+    void (*aegis128l_init)(uint8_t* state, const uint8_t key[16], const uint8_t nonce[16]);
+    void (*aegis128l_absorb)(uint8_t* state, const uint8_t* ad, size_t blocks);
+    void (*aegis128l_encrypt)(uint8_t* state, const uint8_t* pt, uint8_t* ct, size_t blocks);
+    void (*aegis128l_decrypt)(uint8_t* state, const uint8_t* ct, uint8_t* pt, size_t blocks);
+    void (*aegis128l_final)(uint8_t* state, uint64_t ad_len, uint64_t msg_len, uint8_t tag[16]);
+
+    /* AEGIS-256 */
+    void (*aegis256_init)(uint8_t* state, const uint8_t key[32], const uint8_t nonce[32]);
+    void (*aegis256_absorb)(uint8_t* state, const uint8_t* ad, size_t blocks);
+    void (*aegis256_encrypt)(uint8_t* state, const uint8_t* pt, uint8_t* ct, size_t blocks);
+    void (*aegis256_decrypt)(uint8_t* state, const uint8_t* ct, uint8_t* pt, size_t blocks);
+    void (*aegis256_final)(uint8_t* state, uint64_t ad_len, uint64_t msg_len, uint8_t tag[16]);
+
+    /* Two-stream kernels (one stream per 128-bit lane), NULL if unavailable */
+    void (*aegis128l_encrypt_x2)(uint8_t* state0, uint8_t* state1,
+                                 const uint8_t* pt0, uint8_t* ct0,
+                                 const uint8_t* pt1, uint8_t* ct1, size_t blocks);
+    void (*aegis256_encrypt_x2)(uint8_t* state0, uint8_t* state1,
+                                const uint8_t* pt0, uint8_t* ct0,
+                                const uint8_t* pt1, uint8_t* ct1, size_t blocks);
+
+    /* Backend name for debugging */
+    const char* name;
+} soliton_aegis_backend_t;
+
+extern const soliton_aegis_backend_t* soliton_get_aegis_backend(void);
+
+/* AES-256-XTS backend function pointers
+ * Round keys use the AES-NI byte layout; dec_keys is the equivalent inverse
+ * cipher schedule from key_expand_dec. The block kernels take whole blocks
+ * only and leave tweak[] (the encrypted tweak) advanced by alpha^blocks;
+ * ciphertext stealing is done by the caller. */
+typedef struct {
+    void (*key_expand)(const uint8_t key[32], uint32_t* round_keys);
+    void (*key_expand_dec)(const uint32_t* enc_keys, uint32_t* dec_keys);
+    void (*encrypt_block)(const uint32_t* round_keys, const uint8_t in[16], uint8_t out[16]);
+    void (*encrypt_blocks)(const uint32_t* round_keys, uint8_t tweak[16],
+                           const uint8_t* in, uint8_t* out, size_t blocks);
+    void (*decrypt_blocks)(const uint32_t* dec_keys, uint8_t tweak[16],
+                           const uint8_t* in, uint8_t* out, size_t blocks);
+
+    /* Backend name for debugging */
+    const char* name;
+} soliton_xts_backend_t;
+
+extern const soliton_xts_backend_t* soliton_get_xts_backend(void);
+
+/* XTS tweak update: t *= alpha in GF(2^128), little-endian (IEEE 1619) */
+static SOLITON_INLINE void soliton_xts_mul_alpha(uint8_t t[16]) {
+    uint64_t lo = soliton_le64(t);
+    uint64_t hi = soliton_le64(t + 8);
+    uint64_t carry = (0 - (hi >> 63)) & 0x87;
+    hi = (hi << 1) | (lo >> 63);
+    lo = (lo << 1) ^ carry;
+    soliton_put_le64(t, lo);
+    soliton_put_le64(t + 8, hi);
+}
+
 /* Plan structure (v1.8.1 lattice) */
 typedef struct {
     uint32_t lane_depth;      /* 8 or 16 blocks per batch */
@@ -252,6 +425,8 @@ struct soliton_aesgcm_ctx {
     uint8_t  h_powers[16][16] SOLITON_ALIGN(64);  /* H^16...H^1 (64B aligned for fused kernel) */
     uint8_t  j0[16];               /* Initial counter block */
     uint8_t  ghash_state[16];      /* Running GHASH accumulator */
+    uint8_t  aad_prefix_state[16]; /* GHASH after the bound AAD prefix */
+    uint64_t aad_prefix_len;       /* Bound AAD prefix bytes (0: none) */
     uint8_t  buffer[16];           /* Partial block buffer */
     uint64_t aad_len;              /* AAD byte count */
     uint64_t ct_len;               /* Ciphertext byte count */
@@ -261,7 +436,16 @@ struct soliton_aesgcm_ctx {
     int      h_powers_ready;       /* H-powers computed flag (lazy init) */
     const soliton_backend_t* backend; /* Selected backend */
     soliton_plan_t plan;           /* Cached execution plan (v1.8.1) */
+    soliton_aesgcm_cost cost;      /* Cost counters (soliton_aesgcm_cost_enable) */
+    uint32_t cost_on;              /* Counters maintained */
+    uint32_t cost_period;          /* Cycle sample every N calls (0: no sampling) */
+    uint32_t cost_countdown;       /* Calls until the next sample */
+    uint8_t  plan_variant;         /* soliton_gcm_plan (AUTO: use plan) */
+    uint8_t  ab_arm;               /* A/B sample arm + 1 (0: untagged) */
+    uint32_t ab_countdown;         /* Encrypt updates until the next A/B sample */
 } SOLITON_ALIGN(64);
+_Static_assert(sizeof(struct soliton_aesgcm_ctx) <= SOLITON_AESGCM_CTX_BYTES,
+               "soliton_aesgcm_ctx outgrew SOLITON_AESGCM_CTX_BYTES");
 
 /* ChaCha20-Poly1305 context state enum */
 typedef enum {
@@ -271,29 +455,72 @@ typedef enum {
     CHACHA_STATE_FINAL
 } chacha_state_t;
 
-/* Poly1305 internal state */
+/* Poly1305 internal state (26-bit limb scalar engine) */
 typedef struct {
     uint32_t r[5];                 /* Key part r (clamped) */
     uint32_t s[4];                 /* Key part s */
     uint32_t h[5];                 /* Accumulator */
     uint8_t  buffer[16];           /* Partial block buffer */
     size_t   buffer_len;           /* Bytes in buffer */
+    uint32_t final;                /* Final block flag */
 } poly1305_state_t;
 
+/* Poly1305 state for the radix-2^64 engine (poly1305_64.c) */
+typedef struct {
+    uint64_t r[2];                 /* Key part r (clamped) */
+    uint64_t s[2];                 /* Key part s */
+    uint64_t h[3];                 /* Accumulator, partially reduced (h[2] < 8) */
+    uint8_t  buffer[16];           /* Partial block buffer */
+    size_t   buffer_len;           /* Bytes in buffer */
+} poly1305_state_wide_t;
+
 /* ChaCha20-Poly1305 context structure (64B aligned for cache efficiency) */
 struct soliton_chacha_ctx {
     uint8_t  key[32];              /* ChaCha20 key */
     uint8_t  nonce[12];            /* Nonce */
-    poly1305_state_t poly;         /* Poly1305 state */
+    union {                        /* Poly1305 state, layout owned by the */
+        poly1305_state_t scalar;   /* backend's poly1305_* functions */
+        poly1305_state_wide_t wide;
+    } poly;
     uint8_t  buffer[64];           /* Partial block buffer */
     uint64_t aad_len;              /* AAD byte count */
     uint64_t ct_len;               /* Ciphertext byte count */
     uint32_t counter;              /* ChaCha20 counter */
     size_t   buffer_len;           /* Bytes in buffer */
     chacha_state_t state;          /* State machine state */
+    int      rounds;               /* 20, 12 or 8 (soliton_chacha_variant) */
     const soliton_backend_t* backend; /* Selected backend */
 } SOLITON_ALIGN(64);
 
+/* AEGIS context state enum */
+typedef enum {
+    AEGIS_STATE_INIT,
+    AEGIS_STATE_AAD,
+    AEGIS_STATE_UPDATE,
+    AEGIS_STATE_FINAL
+} aegis_state_t;
+
+/* AEGIS-128L / AEGIS-256 context structure (64B aligned for cache efficiency) */
+struct soliton_aegis_ctx {
+    uint8_t  s[8][16] SOLITON_ALIGN(64); /* State words (AEGIS-256 uses S0..S5) */
+    uint8_t  buffer[32];           /* Partial AAD / plaintext block */
+    uint64_t aad_len;              /* AAD byte count */
+    uint64_t msg_len;              /* Message byte count */
+    size_t   buffer_len;           /* Bytes in buffer */
+    size_t   rate;                 /* Block size: 32 (128L) or 16 (256) */
+    soliton_aegis_alg alg;         /* Variant */
+    aegis_state_t state;           /* State machine state */
+    const soliton_aegis_backend_t* backend; /* Selected backend */
+} SOLITON_ALIGN(64);
+
+/* AES-256-XTS context structure (64B aligned for cache efficiency) */
+struct soliton_xts_ctx {
+    uint32_t enc_keys[60];         /* Key1 encryption schedule (data) */
+    uint32_t dec_keys[60];         /* Key1 decryption schedule (data) */
+    uint32_t tweak_keys[60];       /* Key2 encryption schedule (tweak) */
+    const soliton_xts_backend_t* backend; /* Selected backend */
+} SOLITON_ALIGN(64);
+
 /* Batch context structure */
 struct soliton_batch_ctx {
     void* worker_state;            /* Platform-specific worker state */
@@ -0,0 +1,25 @@
+/*
+ * crc32c.h - CRC32C (Castagnoli) engines for the fused GCM update
+ *
+ * All functions work on the raw register state: callers invert on entry
+ * and exit, so the public value chains (soliton_crc32c(0, ...) is the
+ * standard CRC32C, 0xE3069283 for "123456789").
+ */
+
+#ifndef SOLITON_CRC32C_H
+#define SOLITON_CRC32C_H
+
+#include "common.h"
+
+/* Reflected polynomial 0x1EDC6F41 */
+#define CRC32C_POLY_REFLECTED 0x82F63B78u
+
+/* Byte-at-a-time table engine (crc32c.c) */
+uint32_t crc32c_update_scalar(uint32_t state, const uint8_t* p, size_t len);
+
+#if defined(__x86_64__)
+/* SSE4.2 crc32 instruction, 8 bytes per step (crc32c_sse42.c) */
+uint32_t crc32c_update_sse42(uint32_t state, const uint8_t* p, size_t len);
+#endif
+
+#endif /* SOLITON_CRC32C_H */
@@ -0,0 +1,26 @@
+/*
+ * crc32c_sse42.c - CRC32C with the SSE4.2 crc32 instruction
+ * Used for the unfused head/tail bytes of a CRC update and for
+ * soliton_crc32c; the resident GCM kernels issue crc32 inline.
+ */
+
+#include "crc32c.h"
+
+#if defined(__x86_64__) && defined(__SSE4_2__)
+
+#include <nmmintrin.h>
+
+uint32_t crc32c_update_sse42(uint32_t state, const uint8_t* p, size_t len) {
+    uint64_t c = state;
+
+    for (; len >= 8; len -= 8, p += 8) {
+        c = _mm_crc32_u64(c, soliton_le64(p));
+    }
+    state = (uint32_t)c;
+    for (; len > 0; len--, p++) {
+        state = _mm_crc32_u8(state, *p);
+    }
+    return state;
+}
+
+#endif /* __x86_64__ && __SSE4_2__ */
@@ -69,16 +69,13 @@ static SOLITON_INLINE uint64_t ct_mask_u64(int c) {
     return (uint64_t)(-c);
 }
 
-/* Constant-time memory operations */
+/* Constant-time memory operations
+ * 16-byte vector / 8-byte word stepping (soliton_v16, soliton_u64a from
+ * common.h) with a byte tail; the stepping depends only on n. */
 
 /* Copy n bytes from src to dst if condition is true */
 static SOLITON_INLINE void ct_cmov(void* dst, const void* src, size_t n, int condition) {
-    uint8_t* d = (uint8_t*)dst;
-    const uint8_t* s = (const uint8_t*)src;
-
-    for (size_t i = 0; i < n; i++) {
-        d[i] = ct_select_u8(s[i], d[i], condition);
-    }
+    soliton_ct_cond_copy(dst, src, n, condition);
     SOLITON_BARRIER();
 }
 
@@ -87,8 +84,17 @@ static SOLITON_INLINE void ct_cond_xor(void* dst, const void* src, size_t n, int
     uint8_t* d = (uint8_t*)dst;
     const uint8_t* s = (const uint8_t*)src;
     uint8_t mask = (uint8_t)(-condition);
+    uint64_t wmask = (uint64_t)0 - (uint64_t)(condition & 1);
+    soliton_v16 vmask = (soliton_v16){0} + mask;
+    size_t i = 0;
 
-    for (size_t i = 0; i < n; i++) {
+    for (; i + 16 <= n; i += 16) {
+        *(soliton_v16*)(d + i) ^= *(const soliton_v16*)(s + i) & vmask;
+    }
+    for (; i + 8 <= n; i += 8) {
+        *(soliton_u64a*)(d + i) ^= *(const soliton_u64a*)(s + i) & wmask;
+    }
+    for (; i < n; i++) {
         d[i] ^= s[i] & mask;
     }
     SOLITON_BARRIER();
@@ -99,8 +105,25 @@ static SOLITON_INLINE void ct_cswap(void* a, void* b, size_t n, int condition) {
     uint8_t* pa = (uint8_t*)a;
     uint8_t* pb = (uint8_t*)b;
     uint8_t mask = (uint8_t)(-condition);
-
-    for (size_t i = 0; i < n; i++) {
+    uint64_t wmask = (uint64_t)0 - (uint64_t)(condition & 1);
+    soliton_v16 vmask = (soliton_v16){0} + mask;
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        soliton_v16* va = (soliton_v16*)(pa + i);
+        soliton_v16* vb = (soliton_v16*)(pb + i);
+        soliton_v16 tmp = vmask & (*va ^ *vb);
+        *va ^= tmp;
+        *vb ^= tmp;
+    }
+    for (; i + 8 <= n; i += 8) {
+        soliton_u64a* wa = (soliton_u64a*)(pa + i);
+        soliton_u64a* wb = (soliton_u64a*)(pb + i);
+        uint64_t tmp = wmask & (*wa ^ *wb);
+        *wa ^= tmp;
+        *wb ^= tmp;
+    }
+    for (; i < n; i++) {
         uint8_t tmp = mask & (pa[i] ^ pb[i]);
         pa[i] ^= tmp;
         pb[i] ^= tmp;
@@ -110,26 +133,34 @@ static SOLITON_INLINE void ct_cswap(void* a, void* b, size_t n, int condition) {
 
 /* Constant-time memory comparison: return 0 if equal, non-zero otherwise */
 static SOLITON_INLINE int ct_memcmp(const void* a, const void* b, size_t n) {
-    const uint8_t* pa = (const uint8_t*)a;
-    const uint8_t* pb = (const uint8_t*)b;
-    uint8_t diff = 0;
-
-    for (size_t i = 0; i < n; i++) {
-        diff |= pa[i] ^ pb[i];
-    }
-    SOLITON_BARRIER();
-
-    return diff;
+    return soliton_ct_memcmp(a, b, n);
 }
 
 /* Check if all bytes are zero */
 static SOLITON_INLINE int ct_is_zero_mem(const void* p, size_t n) {
     const uint8_t* pp = (const uint8_t*)p;
+    soliton_v16 vacc = {0};
+    uint64_t wacc = 0;
     uint8_t acc = 0;
+    size_t i = 0;
 
-    for (size_t i = 0; i < n; i++) {
+    for (; i + 16 <= n; i += 16) {
+        vacc |= *(const soliton_v16*)(pp + i);
+    }
+    for (; i + 8 <= n; i += 8) {
+        wacc |= *(const soliton_u64a*)(pp + i);
+    }
+    for (; i < n; i++) {
         acc |= pp[i];
     }
+
+    for (int j = 0; j < 16; j++) {
+        acc |= vacc[j];
+    }
+    wacc |= wacc >> 32;
+    wacc |= wacc >> 16;
+    wacc |= wacc >> 8;
+    acc |= (uint8_t)wacc;
     SOLITON_BARRIER();
 
     return ct_is_zero_u8(acc);
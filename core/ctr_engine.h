@@ -0,0 +1,102 @@
+/*
+ * ctr_engine.h - Shared counter-block generation for the AES-CTR / GCM kernels
+ *
+ * Counters live in vector registers in native (little-endian) order in
+ * 32-bit word 3 of every 128-bit lane, the other words zero. Advancing a
+ * register is one 32-bit vector add, which wraps mod 2^32 without touching
+ * bytes 0..11 - exactly GCM inc32 - so there is no per-block branch or
+ * carry fix-up. A counter block is that register byte-reversed into
+ * bytes 12..15 and OR'd with the IV prefix (IV with word 3 cleared).
+ *
+ * Kernels seed an engine once per call and pull blocks from it batch by
+ * batch; the GCM fused kernels take the engine itself, so the dispatcher
+ * carries one state across all batches of an update. The 32-bit value in
+ * ctx->counter remains the source of truth between API calls.
+ *
+ * Each section is compiled only when the including file targets its ISA.
+ */
+
+#ifndef SOLITON_CTR_ENGINE_H
+#define SOLITON_CTR_ENGINE_H
+
+#include "common.h"
+
+/* ======================== x86-64: AVX2 / VAES (YMM) ======================= */
+
+#if defined(__x86_64__) && defined(__AVX2__)
+
+#include <immintrin.h>
+
+/* Two blocks per register: lane 0 = counter, lane 1 = counter + 1 */
+typedef struct {
+    __m256i ctr;      /* Native-order counters in word 3 of each lane */
+    __m256i prefix;   /* IV bytes 0..11 in both lanes, word 3 zero */
+    __m256i bswap;    /* Word 3 -> big-endian bytes 12..15, rest zeroed */
+} soliton_ctr_ymm;
+
+static SOLITON_INLINE void soliton_ctr_ymm_init(soliton_ctr_ymm* c, const uint8_t iv[16],
+                                                uint32_t counter) {
+    c->prefix = _mm256_broadcastsi128_si256(
+        _mm_insert_epi32(_mm_loadu_si128((const __m128i*)iv), 0, 3));
+    c->bswap = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        -128, -128, -128, -128, -128, -128, -128, -128,
+        -128, -128, -128, -128, 15, 14, 13, 12));
+    c->ctr = _mm256_set_epi32((int)(counter + 1), 0, 0, 0, (int)counter, 0, 0, 0);
+}
+
+/* Next 2*n counter blocks into blk[0..n), in order; one add per register */
+static SOLITON_INLINE void soliton_ctr_ymm_next(soliton_ctr_ymm* c, __m256i* blk, int n) {
+    const __m256i step = _mm256_set_epi32(2, 0, 0, 0, 2, 0, 0, 0);
+    __m256i v = c->ctr;
+
+    for (int i = 0; i < n; i++) {
+        blk[i] = _mm256_or_si256(c->prefix, _mm256_shuffle_epi8(v, c->bswap));
+        v = _mm256_add_epi32(v, step);
+    }
+    c->ctr = v;
+}
+
+/* Counter of the next block (for handing a tail to another kernel) */
+static SOLITON_INLINE uint32_t soliton_ctr_ymm_value(const soliton_ctr_ymm* c) {
+    return (uint32_t)_mm_extract_epi32(_mm256_castsi256_si128(c->ctr), 3);
+}
+
+#endif /* __x86_64__ && __AVX2__ */
+
+/* ====================== x86-64: AVX-512 / VAES (ZMM) ===================== */
+
+#if defined(__x86_64__) && defined(__AVX512F__) && defined(__AVX512BW__)
+
+/* Four blocks per register: lane i = counter + i */
+typedef struct {
+    __m512i ctr;
+    __m512i prefix;
+    __m512i bswap;
+} soliton_ctr_zmm;
+
+static SOLITON_INLINE void soliton_ctr_zmm_init(soliton_ctr_zmm* c, const uint8_t iv[16],
+                                                uint32_t counter) {
+    c->prefix = _mm512_broadcast_i32x4(
+        _mm_insert_epi32(_mm_loadu_si128((const __m128i*)iv), 0, 3));
+    c->bswap = _mm512_broadcast_i32x4(_mm_setr_epi8(
+        -128, -128, -128, -128, -128, -128, -128, -128,
+        -128, -128, -128, -128, 15, 14, 13, 12));
+    c->ctr = _mm512_add_epi32(_mm512_set_epi32(3, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0),
+                              _mm512_maskz_set1_epi32(0x8888, (int)counter));
+}
+
+/* Next 4*n counter blocks into blk[0..n), in order; one add per register */
+static SOLITON_INLINE void soliton_ctr_zmm_next(soliton_ctr_zmm* c, __m512i* blk, int n) {
+    const __m512i step = _mm512_maskz_set1_epi32(0x8888, 4);
+    __m512i v = c->ctr;
+
+    for (int i = 0; i < n; i++) {
+        blk[i] = _mm512_or_si512(c->prefix, _mm512_shuffle_epi8(v, c->bswap));
+        v = _mm512_add_epi32(v, step);
+    }
+    c->ctr = v;
+}
+
+#endif /* __x86_64__ && __AVX512F__ && __AVX512BW__ */
+
+#endif /* SOLITON_CTR_ENGINE_H */
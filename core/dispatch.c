@@ -4,8 +4,12 @@
  */
 
 #include "common.h"
+#include "crc32c.h"
+#include "ctr_engine.h"
 #include "ct_utils.h"
 #include "diagnostics.h"
+#include "soliton_fast.h"
+#include "usdt.h"
 
 /* Path logging for v0.3.1 (only in hosted builds with stdio) */
 #if defined(__STDC_HOSTED__) && __STDC_HOSTED__ == 1
@@ -27,6 +31,13 @@
 #if defined(__x86_64__) || defined(__i386__)
 #include <cpuid.h>
 
+/* XCR0: which register states the OS saves on context switch */
+static uint64_t x86_xgetbv0(void) {
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+}
+
 static void detect_x86_features(soliton_caps* caps) {
     unsigned int eax, ebx, ecx, edx;
 
@@ -53,14 +64,72 @@ static void detect_x86_features(soliton_caps* caps) {
         if (ecx & (1 << 1)) {  /* PCLMULQDQ */
             caps->bits |= SOLITON_FEAT_PCLMUL;
         }
+        if (ecx & (1 << 20)) { /* SSE4.2 */
+            caps->bits |= SOLITON_FEAT_SSE42;
+        }
     }
 
-    /* Check for AVX-512 Foundation */
-    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    /* Check for AVX-512 Foundation / Byte-Word, only if the OS saves ZMM state
+     * (XCR0 opmask, ZMM_Hi256, Hi16_ZMM plus SSE/AVX) */
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 27)) &&  /* OSXSAVE */
+        (x86_xgetbv0() & 0xE6) == 0xE6 &&
+        __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
         if (ebx & (1 << 16)) {
             caps->bits |= SOLITON_FEAT_AVX512F;
         }
+        if (ebx & (1u << 30)) {
+            caps->bits |= SOLITON_FEAT_AVX512BW;
+        }
+    }
+}
+
+/* Auto vector-width policy from CPUID vendor/family/model.
+ * Intel server and client cores before Sapphire Rapids drop to a lower turbo
+ * license under sustained 512-bit AES (Skylake-SP heavily, Ice Lake and
+ * later client parts by a bin or so); Sapphire Rapids and newer and AMD
+ * Zen 4+ run ZMM at the YMM clock. Unknown AVX-512 parts get the threshold. */
+static soliton_vwidth_policy x86_auto_vwidth_policy(void) {
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+        return SOLITON_VWIDTH_PREFER_YMM;
+    }
+    const unsigned int vendor = ebx;  /* "Genu" / "Auth" / "Hygo" */
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return SOLITON_VWIDTH_PREFER_YMM;
+    }
+
+    unsigned int family = (eax >> 8) & 0xF;
+    unsigned int model = (eax >> 4) & 0xF;
+    if (family == 0xF) {
+        family += (eax >> 20) & 0xFF;
+    }
+    if (family == 0x6 || family >= 0xF) {
+        model |= ((eax >> 16) & 0xF) << 4;
+    }
+
+    if (vendor == 0x756e6547u && family == 0x6) {  /* Intel */
+        switch (model) {
+        case 0x55:              /* Skylake-SP / Cascade Lake / Cooper Lake */
+        case 0x66:              /* Cannon Lake */
+            return SOLITON_VWIDTH_PREFER_YMM;
+        case 0x6A: case 0x6C:   /* Ice Lake-SP / -D */
+        case 0x7D: case 0x7E:   /* Ice Lake client */
+        case 0x8C: case 0x8D:   /* Tiger Lake */
+        case 0xA7:              /* Rocket Lake */
+            return SOLITON_VWIDTH_ZMM_ABOVE;
+        case 0x8F:              /* Sapphire Rapids */
+        case 0xCF:              /* Emerald Rapids */
+        case 0xAD: case 0xAE:   /* Granite Rapids */
+            return SOLITON_VWIDTH_ALWAYS_ZMM;
+        default:
+            return SOLITON_VWIDTH_ZMM_ABOVE;
+        }
+    }
+    if ((vendor == 0x68747541u || vendor == 0x6f677948u) && family >= 0x19) {  /* AMD / Hygon Zen 4+ */
+        return SOLITON_VWIDTH_ALWAYS_ZMM;
     }
+    return SOLITON_VWIDTH_ZMM_ABOVE;
 }
 
 #elif defined(__aarch64__) || defined(__arm__)
@@ -69,6 +138,20 @@ static void detect_x86_features(soliton_caps* caps) {
 #include <asm/hwcap.h>
 #endif
 
+/* Older kernel headers lack the SVE bits */
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+#ifndef HWCAP2_SVE2
+#define HWCAP2_SVE2 (1 << 1)
+#endif
+#ifndef HWCAP2_SVEAES
+#define HWCAP2_SVEAES (1 << 2)
+#endif
+#ifndef HWCAP2_SVEPMULL
+#define HWCAP2_SVEPMULL (1 << 3)
+#endif
+
 static void detect_arm_features(soliton_caps* caps) {
 #ifdef __linux__
     unsigned long hwcap = getauxval(AT_HWCAP);
@@ -79,12 +162,75 @@ static void detect_arm_features(soliton_caps* caps) {
 
     /* Check for crypto extensions */
     if (hwcap & HWCAP_AES) {
-        caps->bits |= SOLITON_FEAT_NEON;
+        caps->bits |= SOLITON_FEAT_AES;
     }
     if (hwcap & HWCAP_PMULL) {
         caps->bits |= SOLITON_FEAT_PMULL;
     }
+
+    /* Scalable vectors (SVE2 crypto bits live in AT_HWCAP2) */
+    unsigned long hwcap2 = getauxval(AT_HWCAP2);
+    if (hwcap & HWCAP_SVE) {
+        caps->bits |= SOLITON_FEAT_SVE;
+    }
+    if (hwcap2 & HWCAP2_SVE2) {
+        caps->bits |= SOLITON_FEAT_SVE2;
+    }
+    if (hwcap2 & HWCAP2_SVEAES) {
+        caps->bits |= SOLITON_FEAT_SVE_AES;
+    }
+    if (hwcap2 & HWCAP2_SVEPMULL) {
+        caps->bits |= SOLITON_FEAT_SVE_PMULL128;
+    }
+#endif
+#endif
+}
+
+#elif defined(__riscv)
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* riscv_hwprobe(2), Linux 6.4+ (values from <asm/hwprobe.h>) */
+#ifndef __NR_riscv_hwprobe
+#define __NR_riscv_hwprobe 258
 #endif
+#define SOLITON_HWPROBE_KEY_IMA_EXT_0 4
+#define SOLITON_HWPROBE_IMA_V         (1ULL << 2)
+#define SOLITON_HWPROBE_EXT_ZVBB      (1ULL << 17)
+#define SOLITON_HWPROBE_EXT_ZVKB      (1ULL << 19)
+#define SOLITON_HWPROBE_EXT_ZVKG      (1ULL << 20)
+#define SOLITON_HWPROBE_EXT_ZVKNED    (1ULL << 21)
+
+struct soliton_hwprobe {
+    int64_t key;
+    uint64_t value;
+};
+#endif
+
+static void detect_riscv_features(soliton_caps* caps) {
+#ifdef __linux__
+    struct soliton_hwprobe probe = { SOLITON_HWPROBE_KEY_IMA_EXT_0, 0 };
+
+    /* Older kernels: no syscall, no vector backends */
+    if (syscall(__NR_riscv_hwprobe, &probe, 1, 0, NULL, 0) != 0 || probe.key < 0) {
+        return;
+    }
+    if (!(probe.value & SOLITON_HWPROBE_IMA_V)) {
+        return;
+    }
+    caps->bits |= SOLITON_FEAT_RVV;
+    if (probe.value & SOLITON_HWPROBE_EXT_ZVKNED) {
+        caps->bits |= SOLITON_FEAT_ZVKNED;
+    }
+    if (probe.value & SOLITON_HWPROBE_EXT_ZVKG) {
+        caps->bits |= SOLITON_FEAT_ZVKG;
+    }
+    if (probe.value & (SOLITON_HWPROBE_EXT_ZVBB | SOLITON_HWPROBE_EXT_ZVKB)) {
+        caps->bits |= SOLITON_FEAT_ZVBB;
+    }
+#else
+    (void)caps;
 #endif
 }
 #endif
@@ -97,6 +243,8 @@ void soliton_query_caps(soliton_caps* out) {
     detect_x86_features(out);
 #elif defined(__aarch64__) || defined(__arm__)
     detect_arm_features(out);
+#elif defined(__riscv)
+    detect_riscv_features(out);
 #endif
 }
 
@@ -121,11 +269,160 @@ extern soliton_backend_t backend_clmul;
 extern soliton_backend_t backend_chacha_neon;
 #endif
 #ifdef __ARM_FEATURE_CRYPTO
-extern soliton_backend_t backend_neon;
 extern soliton_backend_t backend_pmull;
 #endif
 #endif
 
+#ifdef SOLITON_HAVE_VAES512
+/* 512-bit VAES CTR, built with AVX-512 flags; gated by the width policy */
+extern void aes256_ctr_blocks_vaes512(const uint32_t* round_keys, const uint8_t iv[16],
+                                      uint32_t counter, const uint8_t* in, uint8_t* out, size_t blocks);
+#endif
+
+/* Live statistics sink (soliton_stats_attach), NULL while detached, and
+ * the slots handed out so far. A thread keeps its slot number for life,
+ * across detach and re-attach; 1-based so 0 means not yet claimed. */
+static soliton_stats_block* stats_sink = NULL;
+static uint32_t stats_threads = 0;
+static _Thread_local uint32_t stats_thread = 0;
+
+/* Own slot: single writer, so a relaxed load and store (atomic only so
+ * soliton_stats_sum may read concurrently). Last slot: shared, so a
+ * relaxed fetch_add. */
+#define STATS_ADD(s, field, v) stats_add(&(s)->field, (uint64_t)(v))
+
+static inline void stats_add(uint64_t* counter, uint64_t v) {
+    if (SOLITON_UNLIKELY(stats_thread == SOLITON_STATS_SLOTS)) {
+        __atomic_fetch_add(counter, v, __ATOMIC_RELAXED);
+    } else {
+        __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + v, __ATOMIC_RELAXED);
+    }
+}
+
+void soliton_stats_attach(soliton_stats_block* block) {
+    __atomic_store_n(&stats_sink, block, __ATOMIC_RELEASE);
+}
+
+void soliton_stats_sum(const soliton_stats_block* block, soliton_stats* out) {
+    uint64_t* dst = (uint64_t*)out;
+    const size_t words = sizeof(soliton_stats) / sizeof(uint64_t);
+
+    for (size_t i = 0; i < words; i++) {
+        uint64_t v = 0;
+        for (unsigned t = 0; t < SOLITON_STATS_SLOTS; t++) {
+            v += __atomic_load_n(&((const uint64_t*)&block->slot[t].s)[i], __ATOMIC_RELAXED);
+        }
+        dst[i] = v;
+    }
+}
+
+/* The calling thread's slot in the attached block, NULL while detached */
+static soliton_stats* stats_get(void) {
+    soliton_stats_block* block = __atomic_load_n(&stats_sink, __ATOMIC_ACQUIRE);
+    if (SOLITON_LIKELY(block == NULL)) {
+        return NULL;
+    }
+    uint32_t t = stats_thread;
+    if (SOLITON_UNLIKELY(t == 0)) {
+        t = __atomic_add_fetch(&stats_threads, 1, __ATOMIC_RELAXED);
+        if (t == 0 || t > SOLITON_STATS_SLOTS) {
+            t = SOLITON_STATS_SLOTS;
+        }
+        stats_thread = t;
+    }
+    return &block->slot[t - 1].s;
+}
+
+/* Histogram bucket: bit length of v, capped at the last bucket */
+static unsigned stats_bucket(uint64_t v) {
+    const unsigned b = v ? 64u - (unsigned)__builtin_clzll(v) : 0u;
+    return b < SOLITON_STATS_BUCKETS ? b : SOLITON_STATS_BUCKETS - 1;
+}
+
+/* Vector-width policy. Process-wide, relaxed atomics: a racing update call
+ * sees either the old or the new policy, and both produce the same bytes. */
+static int vwidth_policy = SOLITON_VWIDTH_AUTO;
+static size_t vwidth_zmm_min = SOLITON_VWIDTH_ZMM_MIN_DEFAULT;
+
+/* ZMM kernels built in, and CPU + OS can run them (cached: -1 = not probed) */
+static int vwidth_zmm_capable(void) {
+    static int capable = -1;
+    int c = __atomic_load_n(&capable, __ATOMIC_RELAXED);
+
+    if (c < 0) {
+        c = 0;
+#ifdef SOLITON_HAVE_VAES512
+        soliton_caps caps;
+        soliton_query_caps(&caps);
+        const uint64_t need = SOLITON_FEAT_VAES | SOLITON_FEAT_AVX512F | SOLITON_FEAT_AVX512BW;
+        c = (caps.bits & need) == need;
+#endif
+        __atomic_store_n(&capable, c, __ATOMIC_RELAXED);
+    }
+    return c;
+}
+
+static soliton_vwidth_policy vwidth_effective(void) {
+    static int auto_policy = -1;
+    const int p = __atomic_load_n(&vwidth_policy, __ATOMIC_RELAXED);
+
+    if (p != SOLITON_VWIDTH_AUTO) {
+        return (soliton_vwidth_policy)p;
+    }
+
+    int a = __atomic_load_n(&auto_policy, __ATOMIC_RELAXED);
+    if (a < 0) {
+        a = SOLITON_VWIDTH_PREFER_YMM;
+#if defined(__x86_64__) || defined(__i386__)
+        if (vwidth_zmm_capable()) {
+            a = x86_auto_vwidth_policy();
+        }
+#endif
+        __atomic_store_n(&auto_policy, a, __ATOMIC_RELAXED);
+    }
+    return (soliton_vwidth_policy)a;
+}
+
+soliton_status soliton_set_vwidth_policy(soliton_vwidth_policy policy, size_t zmm_min_bytes) {
+    if ((unsigned)policy > SOLITON_VWIDTH_ALWAYS_ZMM) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    const soliton_vwidth_policy before = vwidth_effective();
+    __atomic_store_n(&vwidth_zmm_min,
+                     zmm_min_bytes ? zmm_min_bytes : (size_t)SOLITON_VWIDTH_ZMM_MIN_DEFAULT,
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&vwidth_policy, (int)policy, __ATOMIC_RELAXED);
+
+    soliton_stats* st = stats_get();
+    if (st && vwidth_effective() != before) {
+        STATS_ADD(st, plan_switches, 1);
+    }
+    return SOLITON_OK;
+}
+
+soliton_vwidth_policy soliton_get_vwidth_policy(size_t* zmm_min_bytes) {
+    if (zmm_min_bytes) {
+        *zmm_min_bytes = __atomic_load_n(&vwidth_zmm_min, __ATOMIC_RELAXED);
+    }
+    return vwidth_effective();
+}
+
+int soliton_vwidth_uses_zmm(size_t len) {
+    if (!vwidth_zmm_capable()) {
+        return 0;
+    }
+
+    switch (vwidth_effective()) {
+    case SOLITON_VWIDTH_ALWAYS_ZMM:
+        return 1;
+    case SOLITON_VWIDTH_ZMM_ABOVE:
+        return len >= __atomic_load_n(&vwidth_zmm_min, __ATOMIC_RELAXED);
+    default:
+        return 0;
+    }
+}
+
 /* Select best backend based on CPU features */
 const soliton_backend_t* soliton_get_backend(void) {
     static const soliton_backend_t* selected_backend = NULL;
@@ -142,14 +439,6 @@ const soliton_backend_t* soliton_get_backend(void) {
             selected_backend = &backend_vaes;
         } else
 #endif
-#endif
-#ifdef __aarch64__
-#ifdef __ARM_FEATURE_CRYPTO
-        /* Use ARM crypto extensions if available */
-        if (caps.bits & SOLITON_FEAT_AES) {
-            selected_backend = &backend_neon;
-        } else
-#endif
 #endif
         {
             /* Fallback to scalar backend */
@@ -157,6 +446,7 @@ const soliton_backend_t* soliton_get_backend(void) {
         }
 
         initialized = 1;
+        SOLITON_PROBE2(backend_select, selected_backend->name, SOLITON_BACKEND_AESGCM);
 
         /* Record selected backend for diagnostics */
         DIAG_SET_BACKEND(selected_backend->name);
@@ -196,6 +486,7 @@ const soliton_backend_t* soliton_get_ghash_backend(void) {
         }
 
         initialized = 1;
+        SOLITON_PROBE2(backend_select, ghash_backend->name, SOLITON_BACKEND_GHASH);
     }
 
     return ghash_backend;
@@ -232,11 +523,105 @@ const soliton_backend_t* soliton_get_chacha_backend(void) {
         }
 
         initialized = 1;
+        SOLITON_PROBE2(backend_select, chacha_backend->name, SOLITON_BACKEND_CHACHA);
     }
 
     return chacha_backend;
 }
 
+/* AEGIS backend declarations */
+extern soliton_aegis_backend_t backend_aegis_scalar;
+
+#ifdef __x86_64__
+#ifdef __AES__
+extern soliton_aegis_backend_t backend_aegis_aesni;
+#endif
+#ifdef __VAES__
+extern soliton_aegis_backend_t backend_aegis_vaes;
+#endif
+#endif
+
+/* Select best AEGIS backend */
+const soliton_aegis_backend_t* soliton_get_aegis_backend(void) {
+    static const soliton_aegis_backend_t* aegis_backend = NULL;
+    static int initialized = 0;
+
+    if (!initialized) {
+        soliton_caps caps;
+        soliton_query_caps(&caps);
+
+#ifdef __x86_64__
+#if defined(__VAES__) && defined(__AES__)
+        /* VAES adds two-stream batch kernels on top of AES-NI */
+        if ((caps.bits & SOLITON_FEAT_VAES) && (caps.bits & SOLITON_FEAT_AESNI)) {
+            aegis_backend = &backend_aegis_vaes;
+        } else
+#endif
+#ifdef __AES__
+        if (caps.bits & SOLITON_FEAT_AESNI) {
+            aegis_backend = &backend_aegis_aesni;
+        } else
+#endif
+#endif
+        {
+            /* Fallback to table-free scalar AES rounds */
+            aegis_backend = &backend_aegis_scalar;
+        }
+
+        initialized = 1;
+        SOLITON_PROBE2(backend_select, aegis_backend->name, SOLITON_BACKEND_AEGIS);
+    }
+
+    return aegis_backend;
+}
+
+/* XTS backend declarations */
+extern soliton_xts_backend_t backend_xts_scalar;
+
+#ifdef __x86_64__
+#ifdef __AES__
+extern soliton_xts_backend_t backend_xts_aesni;
+#endif
+#if defined(__VAES__) && defined(__AES__) && defined(__AVX2__)
+extern soliton_xts_backend_t backend_xts_vaes;
+#endif
+#endif
+
+/* Select best XTS backend */
+const soliton_xts_backend_t* soliton_get_xts_backend(void) {
+    static const soliton_xts_backend_t* xts_backend = NULL;
+    static int initialized = 0;
+
+    if (!initialized) {
+        soliton_caps caps;
+        soliton_query_caps(&caps);
+
+#ifdef __x86_64__
+#if defined(__VAES__) && defined(__AES__) && defined(__AVX2__)
+        /* Two blocks per YMM, 16 per iteration */
+        if ((caps.bits & SOLITON_FEAT_VAES) && (caps.bits & SOLITON_FEAT_AESNI) &&
+            (caps.bits & SOLITON_FEAT_AVX2)) {
+            xts_backend = &backend_xts_vaes;
+        } else
+#endif
+#ifdef __AES__
+        if (caps.bits & SOLITON_FEAT_AESNI) {
+            xts_backend = &backend_xts_aesni;
+        } else
+#endif
+#endif
+        {
+            /* Fallback to table-free scalar AES rounds */
+            xts_backend = &backend_xts_scalar;
+        }
+
+        initialized = 1;
+        SOLITON_PROBE2(backend_select, xts_backend->name, SOLITON_BACKEND_XTS);
+    }
+
+    return xts_backend;
+}
+
 /* Version string */
 const char* soliton_version_string(void) {
     return "soliton.c v0.1.1";
@@ -248,31 +633,43 @@ const char* soliton_version_string(void) {
 #define SOLITON_BATCH_CTX_SIZE  256
 
 /* AES-GCM API implementation */
-soliton_status soliton_aesgcm_init(
-    soliton_aesgcm_ctx* ctx,
-    const uint8_t key[SOLITON_AESGCM_KEY_BYTES],
-    const uint8_t* iv, size_t iv_len) {
-
-    DIAG_INC(gcm_init_calls);
-
-    /* Validate inputs */
-    if (!ctx || !key || !iv || iv_len == 0) {
-        return SOLITON_INVALID_INPUT;
-    }
-
+/* Key stage of init: backend, round keys and the cached execution plan */
+void soliton_aesgcm_setup_key(soliton_aesgcm_ctx* ctx, const uint8_t key[SOLITON_AESGCM_KEY_BYTES]) {
     /* Get backend (do this first, before any expensive operations) */
     ctx->backend = soliton_get_backend();
 
     /* Clear only sensitive state fields (not whole context - too slow!) */
     soliton_wipe(ctx->ghash_state, 16);
     soliton_wipe(ctx->buffer, 16);
+    soliton_wipe(ctx->aad_prefix_state, 16);
+    ctx->aad_prefix_len = 0;
+    soliton_wipe(&ctx->cost, sizeof(ctx->cost));
+    ctx->cost_on = 0;
+    ctx->cost_period = 0;
+    ctx->cost_countdown = 0;
+    ctx->plan_variant = SOLITON_GCM_PLAN_AUTO;
+    ctx->ab_arm = 0;
+    ctx->ab_countdown = 0;
     ctx->aad_len = 0;
     ctx->ct_len = 0;
     ctx->buffer_len = 0;
+    ctx->h_powers_ready = 0;
 
     /* Expand key */
     ctx->backend->aes_key_expand(key, ctx->round_keys);
 
+    /* Select and cache execution plan (v1.8.1 optimization) */
+    soliton_hw_caps_t hw_caps;
+    soliton_workload_t workload;
+
+    soliton_plan_query_hw_caps(&hw_caps);
+    /* Default to high-throughput workload (will adapt if needed) */
+    soliton_workload_default(&workload, 65536); /* Assume large messages */
+    soliton_plan_select(&ctx->plan, &hw_caps, &workload);
+}
+
+/* GHASH stage of init: H = AES_K(0) and H^1..H^16 (needs the round keys) */
+void soliton_aesgcm_setup_hash(soliton_aesgcm_ctx* ctx) {
     /* Initialize GHASH key H = AES_K(0) */
     ctx->backend->ghash_init(ctx->h, ctx->round_keys);
 
@@ -285,116 +682,289 @@ soliton_status soliton_aesgcm_init(
     ghash_precompute_powers_scalar(ctx->h_powers, ctx->h);
     #endif
     ctx->h_powers_ready = 1;
+}
 
-    /* Setup IV */
-    if (iv_len == 12) {
-        /* Standard 96-bit IV */
-        for (size_t i = 0; i < 12; i++) {
-            ctx->j0[i] = iv[i];
-        }
-        ctx->j0[12] = 0;
-        ctx->j0[13] = 0;
-        ctx->j0[14] = 0;
-        ctx->j0[15] = 1;
+/* J₀ = GHASH_H(IV || 0^(s+64) || [len(IV)]₆₄) for IVs other than 96 bits
+ * (NIST SP 800-38D Section 7.1); ghash_update zero-pads the last IV block */
+static void gcm_derive_j0(soliton_aesgcm_ctx* ctx, const uint8_t* iv, size_t iv_len) {
+    uint8_t len_block[16] = {0};
 
-        /* Zero GHASH state for fresh start */
-        soliton_wipe(ctx->ghash_state, 16);
-    } else {
-        /* Non-standard IV length - use GHASH per NIST SP 800-38D Section 7.1
-         * J₀ = GHASH_H(IV || 0^(s+64) || [len(IV)]₆₄)
-         * where s = 128⌈len(IV)/128⌉ – len(IV) */
-        soliton_wipe(ctx->ghash_state, 16);
+    soliton_wipe(ctx->ghash_state, 16);
+    ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], iv, iv_len);
+    soliton_put_be64(len_block + 8, (uint64_t)iv_len * 8);
+    ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], len_block, 16);
 
-        /* Process complete 16-byte blocks from IV */
-        size_t iv_full_blocks = iv_len / 16;
-        if (iv_full_blocks > 0) {
-            ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], iv, iv_full_blocks * 16);
-        }
+    #ifdef __PCLMUL__
+    /* CLMUL state is byte-reflected; J₀ is a spec-order counter block */
+    for (size_t i = 0; i < 16; i++) {
+        ctx->j0[i] = ctx->ghash_state[15 - i];
+    }
+    #else
+    soliton_copy(ctx->j0, ctx->ghash_state, 16);
+    #endif
+    soliton_wipe(ctx->ghash_state, 16);
+}
 
-        /* Remaining bytes and padding calculation */
-        size_t iv_remainder = iv_len % 16;
-        size_t len_bits = iv_len * 8;
+/* Start the message's GHASH at the bound AAD prefix (zero if none) */
+static void gcm_start_aad(soliton_aesgcm_ctx* ctx) {
+    soliton_copy(ctx->ghash_state, ctx->aad_prefix_state, 16);
+    ctx->aad_len = ctx->aad_prefix_len;
+}
 
-        /* s = 128⌈len(IV)/128⌉ – len(IV) in bits */
-        size_t s = (128 * ((len_bits + 127) / 128)) - len_bits;
+/* Cost accounting on entry to a checked aad/update/final call: returns the
+ * start timestamp if this call is sampled, else 0 */
+static uint64_t gcm_cost_begin(soliton_aesgcm_ctx* ctx) {
+    if (SOLITON_LIKELY(!ctx->cost_on)) {
+        return 0;
+    }
+    ctx->cost.calls++;
+    if (ctx->cost_period == 0 || --ctx->cost_countdown != 0) {
+        return 0;
+    }
+    ctx->cost_countdown = ctx->cost_period;
+    return soliton_cycles();
+}
 
-        /* Total padding needed: s + 64 bits for zeros, plus 64 bits for length */
-        /* This equals 128⌈len(IV)/128⌉ + 64 - len(IV) total bits after IV */
-        size_t total_padding_bits = s + 64 + 64;  /* s + 64 zeros + 64 for length field */
-        size_t total_padding_bytes = total_padding_bits / 8;
+/* Returns the cycles of a sampled call, else 0 */
+static uint64_t gcm_cost_end(soliton_aesgcm_ctx* ctx, uint64_t t0) {
+    if (SOLITON_LIKELY(t0 == 0)) {
+        return 0;
+    }
+    const uint64_t dt = soliton_cycles() - t0;
+    ctx->cost.sampled_cycles += dt;
+    ctx->cost.sampled_calls++;
 
-        /* Build padding blocks: partial IV remainder + zeros + length */
-        uint8_t padding[64] = {0};  /* Max padding needed */
+    soliton_stats* s = stats_get();
+    if (s) {
+        STATS_ADD(s, latency[stats_bucket(dt)], 1);
+    }
+    return dt;
+}
 
-        /* Copy any remaining IV bytes */
-        for (size_t i = 0; i < iv_remainder; i++) {
-            padding[i] = iv[iv_full_blocks * 16 + i];
+/* Message totals, once per final: live stats and the context's counters */
+static void gcm_account_message(soliton_aesgcm_ctx* ctx, int decrypt, soliton_status st) {
+    soliton_stats* s = stats_get();
+    if (SOLITON_UNLIKELY(s != NULL)) {
+        if (decrypt) {
+            STATS_ADD(s, dec_messages, 1);
+            STATS_ADD(s, auth_failures, st == SOLITON_AUTH_FAIL);
+        } else {
+            STATS_ADD(s, enc_messages, 1);
         }
+    }
 
-        /* Zeros are already there from memset */
-
-        /* Put 64-bit length at the end */
-        soliton_put_be64(padding + total_padding_bytes - 8, len_bits);
-
-        /* Process padding blocks */
-        ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], padding, total_padding_bytes);
-
-        /* j0 = GHASH result */
-        for (int i = 0; i < 16; i++) {
-            ctx->j0[i] = ctx->ghash_state[i];
-        }
-        soliton_wipe(ctx->ghash_state, 16);
+    if (SOLITON_LIKELY(!ctx->cost_on)) {
+        return;
+    }
+    ctx->cost.aad_bytes += ctx->aad_len - ctx->aad_prefix_len;
+    if (decrypt) {
+        ctx->cost.dec_messages++;
+        ctx->cost.dec_bytes += ctx->ct_len;
+        ctx->cost.auth_failures += st == SOLITON_AUTH_FAIL;
+    } else {
+        ctx->cost.enc_messages++;
+        ctx->cost.enc_bytes += ctx->ct_len;
     }
+}
 
-    /* Initialize counter and state */
-    ctx->counter = 2;  /* Start at 2 (1 is used for tag) */
-    ctx->aad_len = 0;
-    ctx->ct_len = 0;
-    ctx->buffer_len = 0;
-    ctx->state = AES_STATE_INIT;
+/* A bulk kernel ran over bytes: USDT probe and live stats */
+static void gcm_kernel_used(const soliton_aesgcm_ctx* ctx, unsigned kernel, size_t bytes) {
+    (void)ctx;
+    if (bytes == 0) {
+        return;
+    }
+    SOLITON_PROBE3(gcm_kernel, ctx, kernel, bytes);
 
-    /* Select and cache execution plan (v1.8.1 optimization) */
-    soliton_hw_caps_t hw_caps;
-    soliton_workload_t workload;
+    soliton_stats* s = stats_get();
+    if (SOLITON_UNLIKELY(s != NULL)) {
+        STATS_ADD(s, kernel_calls[kernel], 1);
+        STATS_ADD(s, kernel_bytes[kernel], bytes);
+    }
+}
 
-    soliton_plan_query_hw_caps(&hw_caps);
-    /* Default to high-throughput workload (will adapt if needed) */
-    soliton_workload_default(&workload, 65536); /* Assume large messages */
-    soliton_plan_select(&ctx->plan, &hw_caps, &workload);
+/* Shape of one checked-API encrypt/decrypt update */
+static void gcm_stats_update(size_t len) {
+    soliton_stats* s = stats_get();
+    if (SOLITON_UNLIKELY(s != NULL)) {
+        STATS_ADD(s, update_bytes[stats_bucket(len)], 1);
+        STATS_ADD(s, tail_blocks, (len / 16) % 8 != 0);
+        STATS_ADD(s, tail_partial, len % 16 != 0);
+    }
+}
 
+soliton_status soliton_aesgcm_cost_enable(soliton_aesgcm_ctx* ctx, uint32_t sample_every) {
+    if (!ctx || !ctx->backend || (sample_every & (sample_every - 1)) != 0) {
+        return SOLITON_INVALID_INPUT;
+    }
+    soliton_wipe(&ctx->cost, sizeof(ctx->cost));
+    ctx->cost_period = sample_every;
+    ctx->cost_countdown = sample_every;
+    ctx->cost_on = 1;
     return SOLITON_OK;
 }
 
-/* Reset AES-GCM context for new message (v0.4.4+)
- * Reuses key expansion and H-powers, only updates IV and state
- * This amortizes expensive init cost across multiple messages */
-soliton_status soliton_aesgcm_reset(
-    soliton_aesgcm_ctx* ctx,
-    const uint8_t* iv, size_t iv_len) {
+void soliton_aesgcm_cost_disable(soliton_aesgcm_ctx* ctx) {
+    if (ctx) {
+        ctx->cost_on = 0;
+    }
+}
 
-    /* Validate inputs */
-    if (!ctx || !iv || iv_len == 0) {
+soliton_status soliton_aesgcm_cost_read(const soliton_aesgcm_ctx* ctx, soliton_aesgcm_cost* out) {
+    if (!ctx || !out) {
         return SOLITON_INVALID_INPUT;
     }
+    *out = ctx->cost;
+    return SOLITON_OK;
+}
 
-    /* Verify context was previously initialized (backend must be set) */
-    if (!ctx->backend) {
+soliton_status soliton_aesgcm_cost_take(soliton_aesgcm_ctx* ctx, soliton_aesgcm_cost* out) {
+    if (!ctx || !out) {
         return SOLITON_INVALID_INPUT;
     }
+    *out = ctx->cost;
+    soliton_wipe(&ctx->cost, sizeof(ctx->cost));
+    return SOLITON_OK;
+}
 
-    /* Clear only message-specific state (NOT keys or H-powers!) */
-    soliton_wipe(ctx->ghash_state, 16);
-    soliton_wipe(ctx->buffer, 16);
-    ctx->aad_len = 0;
-    ctx->ct_len = 0;
-    ctx->buffer_len = 0;
+/* Plan variants: per-context encrypt plan overrides behind a process-wide
+ * kill switch, and the A/B sample sink (NULL while detached) with its
+ * sample period */
+static int plan_variants_on = 1;
+static soliton_ab_samples* ab_sink = NULL;
+static uint32_t ab_period = 0;
 
-    /* Setup IV (reuse exact logic from init) */
+/* A/B samples are taken 1 in ab_period, so one shared block suffices */
+#define AB_ADD(s, field, v) __atomic_fetch_add(&(s)->field, (uint64_t)(v), __ATOMIC_RELAXED)
+
+void soliton_plan_variants_enable(int enabled) {
+    const int before = __atomic_exchange_n(&plan_variants_on, enabled != 0, __ATOMIC_RELAXED);
+
+    soliton_stats* st = stats_get();
+    if (st && before != (enabled != 0)) {
+        STATS_ADD(st, plan_switches, 1);
+    }
+}
+
+soliton_status soliton_ab_samples_attach(soliton_ab_samples* samples, uint32_t sample_every) {
+    if (samples && (sample_every == 0 || (sample_every & (sample_every - 1)) != 0)) {
+        return SOLITON_INVALID_INPUT;
+    }
+    __atomic_store_n(&ab_period, samples ? sample_every : 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&ab_sink, samples, __ATOMIC_RELEASE);
+    return SOLITON_OK;
+}
+
+#if defined(__VAES__) && defined(__PCLMUL__)
+/* Encrypt plan for one update: the context's variant unless killed */
+static const soliton_plan_t* gcm_active_plan(const soliton_aesgcm_ctx* ctx) {
+    static const soliton_plan_t variants[] = {
+        [SOLITON_GCM_PLAN_RESIDENT8]   = { .lane_depth = 8,  .overlap = 0 },
+        [SOLITON_GCM_PLAN_FUSED16]     = { .lane_depth = 16, .overlap = 0 },
+        [SOLITON_GCM_PLAN_PIPELINED16] = { .lane_depth = 16, .overlap = 1 },
+    };
+
+    if (SOLITON_LIKELY(ctx->plan_variant == SOLITON_GCM_PLAN_AUTO) ||
+        !__atomic_load_n(&plan_variants_on, __ATOMIC_RELAXED)) {
+        return &ctx->plan;
+    }
+    return &variants[ctx->plan_variant];
+}
+#endif
+
+soliton_status soliton_aesgcm_set_plan(soliton_aesgcm_ctx* ctx, soliton_gcm_plan plan) {
+    if (!ctx || !ctx->backend || (unsigned)plan > SOLITON_GCM_PLAN_PIPELINED16) {
+        return SOLITON_INVALID_INPUT;
+    }
+#if defined(__VAES__) && defined(__PCLMUL__)
+    /* Stitched backends (gcm_blocks) have their own single kernel */
+    if (plan != SOLITON_GCM_PLAN_AUTO && ctx->backend->gcm_blocks) {
+        return SOLITON_UNSUPPORTED;
+    }
+#else
+    if (plan != SOLITON_GCM_PLAN_AUTO) {
+        return SOLITON_UNSUPPORTED;
+    }
+#endif
+    ctx->plan_variant = (uint8_t)plan;
+    return SOLITON_OK;
+}
+
+soliton_status soliton_aesgcm_set_ab_arm(soliton_aesgcm_ctx* ctx, unsigned arm) {
+    if (!ctx || (arm >= SOLITON_AB_ARMS && arm != SOLITON_AB_NONE)) {
+        return SOLITON_INVALID_INPUT;
+    }
+    ctx->ab_arm = arm == SOLITON_AB_NONE ? 0 : (uint8_t)(arm + 1);
+    return SOLITON_OK;
+}
+
+/* Entry to an encrypt update: the start timestamp if the A/B sampler
+ * times this call (1 in ab_period per tagged context), else 0. Independent
+ * of the context's cost sampling. */
+static uint64_t gcm_ab_begin(soliton_aesgcm_ctx* ctx) {
+    if (SOLITON_LIKELY(ctx->ab_arm == 0)) {
+        return 0;
+    }
+    const uint32_t period = __atomic_load_n(&ab_period, __ATOMIC_RELAXED);
+    if (period == 0 || !__atomic_load_n(&plan_variants_on, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    if (ctx->ab_countdown == 0 || ctx->ab_countdown > period) {
+        ctx->ab_countdown = period;
+    }
+    if (--ctx->ab_countdown != 0) {
+        return 0;
+    }
+    return soliton_cycles();
+}
+
+/* End of an encrypt update of len bytes started at t0 (0: not sampled) */
+static void gcm_ab_sample(const soliton_aesgcm_ctx* ctx, size_t len, uint64_t t0) {
+    if (SOLITON_LIKELY(t0 == 0)) {
+        return;
+    }
+    const uint64_t dt = soliton_cycles() - t0;
+    soliton_ab_samples* s = __atomic_load_n(&ab_sink, __ATOMIC_ACQUIRE);
+    if (!s || dt == 0 || !__atomic_load_n(&plan_variants_on, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    const unsigned arm = ctx->ab_arm - 1u;
+    if (dt >> 32) {
+        AB_ADD(s, outliers[arm], 1);
+        return;
+    }
+    unsigned c = stats_bucket(len) / 2;
+    if (c >= SOLITON_AB_CLASSES) {
+        c = SOLITON_AB_CLASSES - 1;
+    }
+    const uint64_t q = (dt + 8) >> 4;
+    AB_ADD(s, calls[arm][c], 1);
+    AB_ADD(s, bytes[arm][c], len);
+    AB_ADD(s, cycles[arm][c], dt);
+    AB_ADD(s, cycles_sq[arm][c], q * q);
+}
+
+soliton_status soliton_aesgcm_init(
+    soliton_aesgcm_ctx* ctx,
+    const uint8_t key[SOLITON_AESGCM_KEY_BYTES],
+    const uint8_t* iv, size_t iv_len) {
+
+    SOLITON_PROBE_ENTRY(aesgcm_init, ctx, iv_len);
+
+    DIAG_INC(gcm_init_calls);
+
+    /* Validate inputs */
+    if (!ctx || !key || !iv || iv_len == 0) {
+        SOLITON_RETURN(aesgcm_init, ctx, iv_len, SOLITON_INVALID_INPUT);
+    }
+
+    soliton_aesgcm_setup_key(ctx, key);
+    soliton_aesgcm_setup_hash(ctx);
+
+    /* Setup IV */
     if (iv_len == 12) {
         /* Standard 96-bit IV */
-        for (size_t i = 0; i < 12; i++) {
-            ctx->j0[i] = iv[i];
-        }
+        soliton_copy(ctx->j0, iv, 12);
         ctx->j0[12] = 0;
         ctx->j0[13] = 0;
         ctx->j0[14] = 0;
@@ -404,95 +974,141 @@ soliton_status soliton_aesgcm_reset(
         soliton_wipe(ctx->ghash_state, 16);
     } else {
         /* Non-standard IV length - use GHASH per NIST SP 800-38D Section 7.1 */
-        soliton_wipe(ctx->ghash_state, 16);
+        gcm_derive_j0(ctx, iv, iv_len);
+    }
 
-        /* Process complete 16-byte blocks from IV */
-        size_t iv_full_blocks = iv_len / 16;
-        if (iv_full_blocks > 0) {
-            ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], iv, iv_full_blocks * 16);
-        }
+    /* Initialize counter and state */
+    /* inc32(J0): 2 for a 96-bit IV; any value (and a later 2^32 wrap) for
+     * GHASH-derived J0. J0 itself is kept for the tag */
+    ctx->counter = soliton_be32(ctx->j0 + 12) + 1;
+    ctx->aad_len = 0;
+    ctx->ct_len = 0;
+    ctx->buffer_len = 0;
+    ctx->state = AES_STATE_INIT;
 
-        /* Remaining bytes and padding */
-        size_t iv_remainder = iv_len % 16;
-        size_t len_bits = iv_len * 8;
+    SOLITON_RETURN(aesgcm_init, ctx, iv_len, SOLITON_OK);
+}
 
-        /* Final block: remainder + padding + length */
-        uint8_t final_block[16] = {0};
-        if (iv_remainder > 0) {
-            for (size_t i = 0; i < iv_remainder; i++) {
-                final_block[i] = iv[iv_full_blocks * 16 + i];
-            }
-        }
+/* Key table encoding used by soliton_aesgcm_init in this build */
+uint32_t soliton_aesgcm_key_layout(void) {
+#ifdef __PCLMUL__
+    return SOLITON_KEY_LAYOUT_HPOW_CLMUL;
+#else
+    return 0;
+#endif
+}
+
+/* Reset AES-GCM context for new message (v0.4.4+)
+ * Reuses key expansion and H-powers, only updates IV and state
+ * This amortizes expensive init cost across multiple messages */
+soliton_status soliton_aesgcm_reset(
+    soliton_aesgcm_ctx* ctx,
+    const uint8_t* iv, size_t iv_len) {
 
-        /* Last 8 bytes: big-endian bit length */
-        final_block[8] = (uint8_t)(len_bits >> 56);
-        final_block[9] = (uint8_t)(len_bits >> 48);
-        final_block[10] = (uint8_t)(len_bits >> 40);
-        final_block[11] = (uint8_t)(len_bits >> 32);
-        final_block[12] = (uint8_t)(len_bits >> 24);
-        final_block[13] = (uint8_t)(len_bits >> 16);
-        final_block[14] = (uint8_t)(len_bits >> 8);
-        final_block[15] = (uint8_t)(len_bits);
+    SOLITON_PROBE_ENTRY(aesgcm_reset, ctx, iv_len);
 
-        /* Process final block */
-        ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], final_block, 16);
+    /* Validate inputs */
+    if (!ctx || !iv || iv_len == 0) {
+        SOLITON_RETURN(aesgcm_reset, ctx, iv_len, SOLITON_INVALID_INPUT);
+    }
 
-        /* J₀ is the final GHASH output */
-        for (size_t i = 0; i < 16; i++) {
-            ctx->j0[i] = ctx->ghash_state[i];
-        }
+    /* Verify context was previously initialized (backend must be set) */
+    if (!ctx->backend) {
+        SOLITON_RETURN(aesgcm_reset, ctx, iv_len, SOLITON_INVALID_INPUT);
+    }
+
+    /* Clear only message-specific state (NOT keys or H-powers!) */
+    soliton_wipe(ctx->ghash_state, 16);
+    soliton_wipe(ctx->buffer, 16);
+    ctx->aad_len = 0;
+    ctx->ct_len = 0;
+    ctx->buffer_len = 0;
 
-        /* Clear GHASH state for actual message processing */
+    /* Setup IV (reuse exact logic from init) */
+    if (iv_len == 12) {
+        /* Standard 96-bit IV */
+        soliton_copy(ctx->j0, iv, 12);
+        ctx->j0[12] = 0;
+        ctx->j0[13] = 0;
+        ctx->j0[14] = 0;
+        ctx->j0[15] = 1;
+
+        /* Zero GHASH state for fresh start */
         soliton_wipe(ctx->ghash_state, 16);
+    } else {
+        /* Non-standard IV length - use GHASH per NIST SP 800-38D Section 7.1 */
+        gcm_derive_j0(ctx, iv, iv_len);
     }
 
-    /* Initialize counter (counter 1 reserved for tag, start at 2) */
-    ctx->counter = 2;
+    /* Initialize counter at inc32(J0) (J0 itself is reserved for the tag) */
+    ctx->counter = soliton_be32(ctx->j0 + 12) + 1;
+
+    /* Resume from the bound AAD prefix, if any */
+    gcm_start_aad(ctx);
 
     /* Reset state machine */
     ctx->state = AES_STATE_INIT;
 
     /* Note: Execution plan reused from original init */
 
-    return SOLITON_OK;
+    SOLITON_RETURN(aesgcm_reset, ctx, iv_len, SOLITON_OK);
+}
+
+/* Hash a constant, block-aligned AAD prefix once; every later reset starts
+ * from its GHASH state so only the per-message suffix goes through
+ * aad_update. Applies to the current message too, so it must come before
+ * any AAD or data. prefix_len 0 clears the binding; init clears it too. */
+soliton_status soliton_aesgcm_aad_prefix_bind(
+    soliton_aesgcm_ctx* ctx, const uint8_t* prefix, size_t prefix_len) {
+
+    SOLITON_PROBE_ENTRY(aesgcm_aad_prefix_bind, ctx, prefix_len);
+
+    if (!ctx || (!prefix && prefix_len > 0) || (prefix_len & 15) != 0) {
+        SOLITON_RETURN(aesgcm_aad_prefix_bind, ctx, prefix_len, SOLITON_INVALID_INPUT);
+    }
+
+    if (!ctx->backend || ctx->state != AES_STATE_INIT) {
+        SOLITON_RETURN(aesgcm_aad_prefix_bind, ctx, prefix_len, SOLITON_INVALID_INPUT);
+    }
+
+    soliton_wipe(ctx->aad_prefix_state, 16);
+    ctx->backend->ghash_update(ctx->aad_prefix_state, ctx->h_powers[0], prefix, prefix_len);
+    ctx->aad_prefix_len = prefix_len;
+
+    gcm_start_aad(ctx);
+
+    SOLITON_RETURN(aesgcm_aad_prefix_bind, ctx, prefix_len, SOLITON_OK);
 }
 
 soliton_status soliton_aesgcm_aad_update(
     soliton_aesgcm_ctx* ctx, const uint8_t* aad, size_t aad_len) {
 
+    SOLITON_PROBE_ENTRY(aesgcm_aad_update, ctx, aad_len);
+
     DIAG_INC(gcm_aad_calls);
 
     if (!ctx || (!aad && aad_len > 0)) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(aesgcm_aad_update, ctx, aad_len, SOLITON_INVALID_INPUT);
     }
 
     if (ctx->state != AES_STATE_INIT && ctx->state != AES_STATE_AAD) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(aesgcm_aad_update, ctx, aad_len, SOLITON_INVALID_INPUT);
     }
 
+    const uint64_t t0 = gcm_cost_begin(ctx);
+
     ctx->state = AES_STATE_AAD;
     ctx->aad_len += aad_len;
 
     /* Update GHASH with AAD */
     ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], aad, aad_len);
 
-    return SOLITON_OK;
+    gcm_cost_end(ctx, t0);
+    SOLITON_RETURN(aesgcm_aad_update, ctx, aad_len, SOLITON_OK);
 }
 
-soliton_status soliton_aesgcm_encrypt_update(
-    soliton_aesgcm_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len) {
-
-    DIAG_INC(gcm_encrypt_calls);
-
-    if (!ctx || (!pt && len > 0) || (!ct && len > 0)) {
-        return SOLITON_INVALID_INPUT;
-    }
-
-    if (ctx->state == AES_STATE_FINAL) {
-        return SOLITON_INVALID_INPUT;
-    }
-
-    /* Lazy H-powers precomputation (deferred from init for performance) */
+/* Lazy H-powers precomputation (deferred from init for performance) */
+static void gcm_ensure_h_powers(soliton_aesgcm_ctx* ctx) {
     if (!ctx->h_powers_ready) {
         #ifdef __PCLMUL__
         extern void ghash_precompute_h_powers_clmul(uint8_t h_powers[16][16], const uint8_t h[16]);
@@ -503,6 +1119,56 @@ soliton_status soliton_aesgcm_encrypt_update(
         #endif
         ctx->h_powers_ready = 1;
     }
+}
+
+/* Last partial block (1..15 bytes) of an encrypt update */
+static void gcm_encrypt_partial(soliton_aesgcm_ctx* ctx, const uint8_t* pt, uint8_t* ct,
+                                size_t remainder) {
+    uint8_t keystream[16];
+    uint8_t ctr[16];
+
+    /* Track sub-block tail */
+    DIAG_ADD(tail_sub_block_bytes, remainder);
+
+    soliton_copy(ctr, ctx->j0, 12);
+    soliton_put_be32(ctr + 12, ctx->counter);
+
+    ctx->backend->aes_encrypt_block(ctx->round_keys, ctr, keystream);
+
+    for (size_t i = 0; i < remainder; i++) {
+        ct[i] = pt[i] ^ keystream[i];
+    }
+
+    /* Update GHASH with partial block */
+    ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct, remainder);
+
+    ctx->counter++;
+}
+
+/* Bulk CTR for one update call: the 512-bit kernel when the width policy
+ * allows it for this request size, else the backend's own */
+static void gcm_ctr_bulk(const soliton_aesgcm_ctx* ctx, const uint8_t ctr[16],
+                         const uint8_t* in, uint8_t* out, size_t blocks) {
+#if defined(SOLITON_HAVE_VAES512) && defined(__VAES__)
+    if (ctx->backend == &backend_vaes && soliton_vwidth_uses_zmm(blocks * 16)) {
+        aes256_ctr_blocks_vaes512(ctx->round_keys, ctr, ctx->counter, in, out, blocks);
+        return;
+    }
+#endif
+    ctx->backend->aes_ctr_blocks(ctx->round_keys, ctr, ctx->counter, in, out, blocks);
+}
+
+#if defined(__VAES__) && defined(__PCLMUL__)
+extern void gcm_resident_decrypt_vaes_clmul(
+    const uint32_t*, const uint8_t*, uint8_t*, soliton_ctr_ymm*,
+    uint8_t*, const uint8_t (*)[16], size_t);
+extern void gcm_resident_ghash_vaes_clmul(uint8_t*, const uint8_t (*)[16], const uint8_t*, size_t);
+#endif
+
+/* Encrypt update with arguments and state already checked: the body of
+ * soliton_aesgcm_encrypt_update and the bulk tier of soliton_fast.h */
+static void gcm_encrypt_body(
+    soliton_aesgcm_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len) {
 
     /* AAD padding is handled automatically by ghash_update - no explicit padding needed */
 
@@ -513,11 +1179,37 @@ soliton_status soliton_aesgcm_encrypt_update(
     size_t blocks = len / 16;
     size_t remainder = len % 16;
 
-    if (blocks > 0) {
+    if (blocks > 0 && ctx->backend->gcm_blocks) {
+        /* Backend has a stitched AES-CTR + GHASH kernel */
+        gcm_kernel_used(ctx, SOLITON_KERNEL_STITCHED, blocks * 16);
+        diag_record_batch(blocks);
+        ctx->backend->gcm_blocks(ctx->round_keys, ctx->j0, ctx->counter, pt, ct, blocks,
+                                 ctx->ghash_state, (const uint8_t (*)[16])ctx->h_powers, 0);
+        ctx->counter += (uint32_t)blocks;
+    }
+#if defined(__VAES__) && defined(__PCLMUL__)
+    else if (blocks >= 8 && ctx->backend == &backend_vaes && gcm_active_plan(ctx) == &ctx->plan &&
+             soliton_vwidth_uses_zmm(blocks * 16)) {
+        /* The decrypt ZMM path in reverse: 512-bit CTR over every block,
+         * then the resident GHASH over the ciphertext batches. A/B plan
+         * variants keep their own kernel. */
+        const size_t batches = blocks / 8;
         uint8_t ctr[16];
-        for (int i = 0; i < 16; i++) {
-            ctr[i] = ctx->j0[i];
-        }
+        soliton_copy(ctr, ctx->j0, 16);
+
+        gcm_kernel_used(ctx, SOLITON_KERNEL_CTR512, blocks * 16);
+        diag_record_batch(blocks);
+        gcm_ctr_bulk(ctx, ctr, pt, ct, blocks);
+        ctx->counter += (uint32_t)blocks;
+        gcm_resident_ghash_vaes_clmul(ctx->ghash_state, (const uint8_t (*)[16])ctx->h_powers,
+                                      ct, batches);
+        ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct + batches * 128,
+                                   (blocks - batches * 8) * 16);
+    }
+#endif
+    else if (blocks > 0) {
+        uint8_t ctr[16];
+        soliton_copy(ctr, ctx->j0, 16);
 
         /* Interleave AES and GHASH in batches to overlap execution */
         const size_t INTERLEAVE_DEPTH = 8;
@@ -527,19 +1219,26 @@ soliton_status soliton_aesgcm_encrypt_update(
         /* Process full batches with phase-locked pipeline when possible */
         #if 1 && defined(__VAES__) && defined(__PCLMUL__)  /* ENABLED - Session 9 fix applied */
         GHASH_PATH_LOG("[GHASH PATH] VAES fused kernel (8-block or 16-block)\n");
-        /* Declare all three VAES+CLMUL kernels */
+        /* Declare the VAES+CLMUL kernels */
         extern void gcm_fused_encrypt8_vaes_clmul(
             const uint32_t* restrict, const uint8_t* restrict, uint8_t* restrict,
-            const uint8_t[16], uint32_t, uint8_t* restrict, const uint8_t[8][16]);
+            soliton_ctr_ymm* restrict, uint8_t* restrict, const uint8_t[8][16]);
         extern void gcm_pipelined_encrypt16_vaes_clmul(
-            const uint32_t*, const uint8_t*, uint8_t*, const uint8_t[16],
-            uint32_t, uint8_t*, const uint8_t (*)[16]);
+            const uint32_t*, const uint8_t*, uint8_t*, soliton_ctr_ymm*,
+            uint8_t*, const uint8_t (*)[16]);
         extern void gcm_fused_encrypt16_vaes_clmul(
-            const uint32_t*, const uint8_t*, uint8_t*, const uint8_t[16],
-            uint32_t, uint8_t*, const uint8_t (*)[16]);
+            const uint32_t*, const uint8_t*, uint8_t*, soliton_ctr_ymm*,
+            uint8_t*, const uint8_t (*)[16]);
+        extern void gcm_resident_encrypt_vaes_clmul(
+            const uint32_t*, const uint8_t*, uint8_t*, soliton_ctr_ymm*,
+            uint8_t*, const uint8_t (*)[16], size_t);
+
+        /* One counter engine carried across every batch of this update */
+        soliton_ctr_ymm ctr_engine;
+        soliton_ctr_ymm_init(&ctr_engine, ctx->j0, ctx->counter);
 
-        /* Use cached plan from context (selected during init) */
-        soliton_plan_t *plan = &ctx->plan;
+        /* Cached plan from init, or the context's A/B plan variant */
+        const soliton_plan_t *plan = gcm_active_plan(ctx);
 
         /* Select kernel based on cached plan */
         if (plan->lane_depth == 16) {
@@ -549,26 +1248,28 @@ soliton_status soliton_aesgcm_encrypt_update(
 
             if (plan->overlap == 1) {
                 /* Use phase-locked pipeline (overlap AES k+1 with GHASH k) */
+                gcm_kernel_used(ctx, SOLITON_KERNEL_PIPELINED16, full_batches * 128);
                 for (size_t batch = 0; batch < batches_16; batch++) {
                     size_t offset = batch * 16 * 16;
                     diag_record_batch(16);
 
                     gcm_pipelined_encrypt16_vaes_clmul(
                         ctx->round_keys, pt + offset, ct + offset,
-                        ctx->j0, ctx->counter, ctx->ghash_state,
+                        &ctr_engine, ctx->ghash_state,
                         (const uint8_t (*)[16])ctx->h_powers
                     );
                     ctx->counter += 16;
                 }
             } else {
                 /* Use depth-16 fused kernel (single reduction per 16 blocks) */
+                gcm_kernel_used(ctx, SOLITON_KERNEL_FUSED16, full_batches * 128);
                 for (size_t batch = 0; batch < batches_16; batch++) {
                     size_t offset = batch * 16 * 16;
                     diag_record_batch(16);
 
                     gcm_fused_encrypt16_vaes_clmul(
                         ctx->round_keys, pt + offset, ct + offset,
-                        ctx->j0, ctx->counter, ctx->ghash_state,
+                        &ctr_engine, ctx->ghash_state,
                         (const uint8_t (*)[16])ctx->h_powers
                     );
                     ctx->counter += 16;
@@ -582,29 +1283,36 @@ soliton_status soliton_aesgcm_encrypt_update(
 
                 gcm_fused_encrypt8_vaes_clmul(
                     ctx->round_keys, pt + offset, ct + offset,
-                    ctx->j0, ctx->counter, ctx->ghash_state,
+                    &ctr_engine, ctx->ghash_state,
                     (const uint8_t (*)[16])ctx->h_powers
                 );
                 ctx->counter += INTERLEAVE_DEPTH;
             }
-        } else {
-            /* Depth-8 path (default for small messages) */
-            for (size_t batch = 0; batch < full_batches; batch++) {
-                size_t offset = batch * INTERLEAVE_DEPTH * 16;
-                diag_record_batch(INTERLEAVE_DEPTH);
+        } else if (full_batches > 1) {
+            /* Depth-8 path: one call for the whole span, keys/H-powers/Xi
+             * stay resident and GHASH of batch k overlaps AES of batch k+1 */
+            gcm_kernel_used(ctx, SOLITON_KERNEL_RESIDENT, full_batches * 128);
+            gcm_resident_encrypt_vaes_clmul(
+                ctx->round_keys, pt, ct, &ctr_engine, ctx->ghash_state,
+                (const uint8_t (*)[16])ctx->h_powers, full_batches
+            );
+            ctx->counter += (uint32_t)(full_batches * INTERLEAVE_DEPTH);
+        } else if (full_batches == 1) {
+            gcm_kernel_used(ctx, SOLITON_KERNEL_FUSED8, 128);
+            diag_record_batch(INTERLEAVE_DEPTH);
 
-                gcm_fused_encrypt8_vaes_clmul(
-                    ctx->round_keys, pt + offset, ct + offset,
-                    ctx->j0, ctx->counter, ctx->ghash_state,
-                    (const uint8_t (*)[16])ctx->h_powers
-                );
-                ctx->counter += INTERLEAVE_DEPTH;
-            }
+            gcm_fused_encrypt8_vaes_clmul(
+                ctx->round_keys, pt, ct,
+                &ctr_engine, ctx->ghash_state,
+                (const uint8_t (*)[16])ctx->h_powers
+            );
+            ctx->counter += INTERLEAVE_DEPTH;
         }
         #elif 1 && defined(__PCLMUL__)  /* ENABLED - Testing after Session 9 ghash_mul_reflected fix */
         GHASH_PATH_LOG("[GHASH PATH] PCLMUL 8-way (separate AES+GHASH)\n");
         /* Fallback: separate AES and GHASH (AES-NI without VAES) */
         extern void ghash_update_clmul8(uint8_t*, const uint8_t[8][16], const uint8_t*, size_t);
+        gcm_kernel_used(ctx, SOLITON_KERNEL_CLMUL8, full_batches * 128);
         for (size_t batch = 0; batch < full_batches; batch++) {
             size_t offset = batch * INTERLEAVE_DEPTH * 16;
 
@@ -621,6 +1329,7 @@ soliton_status soliton_aesgcm_encrypt_update(
         }
         #else
         GHASH_PATH_LOG("[GHASH PATH] Slow fallback (single-block scalar)\n");
+        gcm_kernel_used(ctx, SOLITON_KERNEL_GENERIC, full_batches * 128);
         for (size_t batch = 0; batch < full_batches; batch++) {
             size_t offset = batch * INTERLEAVE_DEPTH * 16;
 
@@ -651,45 +1360,38 @@ soliton_status soliton_aesgcm_encrypt_update(
 
     /* Handle partial block */
     if (remainder > 0) {
-        uint8_t keystream[16];
-        uint8_t ctr[16];
-
-        /* Track sub-block tail */
-        DIAG_ADD(tail_sub_block_bytes, remainder);
-
-        for (int i = 0; i < 12; i++) {
-            ctr[i] = ctx->j0[i];
-        }
-        soliton_put_be32(ctr + 12, ctx->counter);
-
-        ctx->backend->aes_encrypt_block(ctx->round_keys, ctr, keystream);
-
-        for (size_t i = 0; i < remainder; i++) {
-            ct[blocks * 16 + i] = pt[blocks * 16 + i] ^ keystream[i];
-        }
-
-        /* Update GHASH with partial block */
-        ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct + blocks * 16, remainder);
-
-        ctx->counter++;
+        gcm_encrypt_partial(ctx, pt + blocks * 16, ct + blocks * 16, remainder);
     }
-
-    return SOLITON_OK;
 }
 
-soliton_status soliton_aesgcm_encrypt_final(
-    soliton_aesgcm_ctx* ctx, uint8_t tag[SOLITON_AESGCM_TAG_BYTES]) {
+soliton_status soliton_aesgcm_encrypt_update(
+    soliton_aesgcm_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len) {
 
-    DIAG_INC(gcm_final_calls);
+    SOLITON_PROBE_ENTRY(aesgcm_encrypt_update, ctx, len);
 
-    if (!ctx || !tag) {
-        return SOLITON_INVALID_INPUT;
+    DIAG_INC(gcm_encrypt_calls);
+
+    if (!ctx || (!pt && len > 0) || (!ct && len > 0)) {
+        SOLITON_RETURN(aesgcm_encrypt_update, ctx, len, SOLITON_INVALID_INPUT);
     }
 
     if (ctx->state == AES_STATE_FINAL) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(aesgcm_encrypt_update, ctx, len, SOLITON_INVALID_INPUT);
     }
 
+    const uint64_t t0 = gcm_cost_begin(ctx);
+    const uint64_t ab_t0 = gcm_ab_begin(ctx);
+    gcm_stats_update(len);
+    gcm_ensure_h_powers(ctx);
+    gcm_encrypt_body(ctx, pt, ct, len);
+    gcm_ab_sample(ctx, len, ab_t0);
+    gcm_cost_end(ctx, t0);
+
+    SOLITON_RETURN(aesgcm_encrypt_update, ctx, len, SOLITON_OK);
+}
+
+/* GHASH(A, C, lengths), the tag before its E_K(J0) mask */
+static void gcm_ghash_final(const soliton_aesgcm_ctx* ctx, uint8_t tag[16]) {
     /* Ciphertext padding is handled automatically by ghash_update - no explicit padding needed */
 
     /* Finalize GHASH (use CLMUL version if available to match ghash_update format) */
@@ -700,139 +1402,769 @@ soliton_status soliton_aesgcm_encrypt_final(
     extern void ghash_final_scalar(uint8_t*, const uint8_t*, const uint8_t*, uint64_t, uint64_t);
     ghash_final_scalar(tag, ctx->ghash_state, ctx->h_powers[0], ctx->aad_len, ctx->ct_len);
     #endif
+}
+
+/* tag = GHASH(A, C, lengths) ^ E_K(J0) */
+static void gcm_compute_tag(const soliton_aesgcm_ctx* ctx, uint8_t tag[16]) {
+    gcm_ghash_final(ctx, tag);
 
     /* Encrypt GHASH output to get final tag */
     uint8_t ctr[16];
-    for (int i = 0; i < 12; i++) {
-        ctr[i] = ctx->j0[i];
-    }
-    soliton_put_be32(ctr + 12, 1);  /* Counter = 1 for tag */
+    soliton_copy(ctr, ctx->j0, 16);  /* Tag uses J0 unchanged */
 
     uint8_t encrypted_j0[16];
     ctx->backend->aes_encrypt_block(ctx->round_keys, ctr, encrypted_j0);
 
     /* XOR GHASH result with E(J0) - both should be in same byte order */
-    for (int i = 0; i < 16; i++) {
-        tag[i] ^= encrypted_j0[i];
+    *(soliton_v16*)tag ^= *(const soliton_v16*)encrypted_j0;
+}
+
+soliton_status soliton_aesgcm_encrypt_final(
+    soliton_aesgcm_ctx* ctx, uint8_t tag[SOLITON_AESGCM_TAG_BYTES]) {
+
+    SOLITON_PROBE_ENTRY(aesgcm_encrypt_final, ctx, 0);
+
+    DIAG_INC(gcm_final_calls);
+
+    if (!ctx || !tag) {
+        SOLITON_RETURN(aesgcm_encrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
+    }
+
+    if (ctx->state == AES_STATE_FINAL) {
+        SOLITON_RETURN(aesgcm_encrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
     }
 
+    const uint64_t t0 = gcm_cost_begin(ctx);
+    gcm_compute_tag(ctx, tag);
+    gcm_account_message(ctx, 0, SOLITON_OK);
+    gcm_cost_end(ctx, t0);
+
     ctx->state = AES_STATE_FINAL;
-    return SOLITON_OK;
+    SOLITON_RETURN(aesgcm_encrypt_final, ctx, 0, SOLITON_OK);
 }
 
-soliton_status soliton_aesgcm_decrypt_update(
-    soliton_aesgcm_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len) {
+/* Last partial block (1..15 bytes) of a decrypt update; GHASH already has it */
+static void gcm_decrypt_partial(soliton_aesgcm_ctx* ctx, const uint8_t* ct, uint8_t* pt,
+                                size_t remainder) {
+    uint8_t keystream[16];
+    uint8_t ctr[16];
 
-    DIAG_INC(gcm_decrypt_calls);
+    soliton_copy(ctr, ctx->j0, 12);
+    soliton_put_be32(ctr + 12, ctx->counter);
 
-    if (!ctx || (!ct && len > 0) || (!pt && len > 0)) {
-        return SOLITON_INVALID_INPUT;
-    }
+    ctx->backend->aes_encrypt_block(ctx->round_keys, ctr, keystream);
 
-    if (ctx->state == AES_STATE_FINAL) {
-        return SOLITON_INVALID_INPUT;
+    for (size_t i = 0; i < remainder; i++) {
+        pt[i] = ct[i] ^ keystream[i];
     }
 
+    ctx->counter++;
+}
+
+/* Decrypt update with arguments and state already checked: the body of
+ * soliton_aesgcm_decrypt_update and the bulk tier of soliton_fast.h */
+static void gcm_decrypt_body(
+    soliton_aesgcm_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len) {
+
     /* AAD padding is handled automatically by ghash_update - no explicit padding needed */
 
     ctx->state = AES_STATE_UPDATE;
     ctx->ct_len += len;
 
-    /* Update GHASH with ciphertext BEFORE decrypting (GCM requirement) */
-    ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct, len);
-
-    /* Decrypt using CTR mode */
     size_t blocks = len / 16;
     size_t remainder = len % 16;
 
-    if (blocks > 0) {
+    if (blocks > 0 && ctx->backend->gcm_blocks) {
+        /* Stitched kernel hashes the ciphertext as it decrypts */
+        gcm_kernel_used(ctx, SOLITON_KERNEL_STITCHED, blocks * 16);
+        ctx->backend->gcm_blocks(ctx->round_keys, ctx->j0, ctx->counter, ct, pt, blocks,
+                                 ctx->ghash_state, (const uint8_t (*)[16])ctx->h_powers, 1);
+        ctx->counter += (uint32_t)blocks;
+        if (remainder > 0) {
+            ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct + blocks * 16, remainder);
+        }
+    }
+#if defined(__VAES__) && defined(__PCLMUL__)
+    else if (blocks >= 8 && ctx->backend == &backend_vaes) {
+        /* Whole 8-block batches are folded exactly as the encrypt path does,
+         * so the tag does not depend on the vector-width policy */
+        const size_t batches = blocks / 8;
+
+        if (soliton_vwidth_uses_zmm(blocks * 16)) {
+            /* Hash here, 512-bit CTR over every block below */
+            gcm_kernel_used(ctx, SOLITON_KERNEL_CTR512, blocks * 16);
+            gcm_resident_ghash_vaes_clmul(ctx->ghash_state, (const uint8_t (*)[16])ctx->h_powers,
+                                          ct, batches);
+            ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct + batches * 128,
+                                       len - batches * 128);
+        } else {
+            /* One resident call decrypts and hashes the batches */
+            gcm_kernel_used(ctx, SOLITON_KERNEL_RESIDENT, batches * 128);
+            soliton_ctr_ymm ctr_engine;
+            soliton_ctr_ymm_init(&ctr_engine, ctx->j0, ctx->counter);
+            gcm_resident_decrypt_vaes_clmul(ctx->round_keys, ct, pt, &ctr_engine, ctx->ghash_state,
+                                            (const uint8_t (*)[16])ctx->h_powers, batches);
+            ctx->counter += (uint32_t)(batches * 8);
+            ct += batches * 128;
+            pt += batches * 128;
+            blocks -= batches * 8;
+            ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct, blocks * 16 + remainder);
+        }
+    }
+#endif
+    else {
+        /* Update GHASH with ciphertext BEFORE decrypting (GCM requirement) */
+        gcm_kernel_used(ctx, SOLITON_KERNEL_GENERIC, blocks * 16);
+        ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct, len);
+    }
+
+    /* Decrypt using CTR mode */
+    if (blocks > 0 && !ctx->backend->gcm_blocks) {
         /* CTR decrypt: Copy j0 to local buffer like encrypt does */
         uint8_t ctr[16];
-        for (int i = 0; i < 16; i++) {
-            ctr[i] = ctx->j0[i];
-        }
+        soliton_copy(ctr, ctx->j0, 16);
 
         /* Use the copy instead of j0 directly */
-        ctx->backend->aes_ctr_blocks(ctx->round_keys, ctr, ctx->counter, ct, pt, blocks);
+        gcm_ctr_bulk(ctx, ctr, ct, pt, blocks);
         ctx->counter += (uint32_t)blocks;
     }
 
     /* Handle partial block */
     if (remainder > 0) {
-        uint8_t keystream[16];
-        uint8_t ctr[16];
+        gcm_decrypt_partial(ctx, ct + blocks * 16, pt + blocks * 16, remainder);
+    }
+}
 
-        for (int i = 0; i < 12; i++) {
-            ctr[i] = ctx->j0[i];
-        }
-        soliton_put_be32(ctr + 12, ctx->counter);
+soliton_status soliton_aesgcm_decrypt_update(
+    soliton_aesgcm_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len) {
 
-        ctx->backend->aes_encrypt_block(ctx->round_keys, ctr, keystream);
+    SOLITON_PROBE_ENTRY(aesgcm_decrypt_update, ctx, len);
 
-        for (size_t i = 0; i < remainder; i++) {
-            pt[blocks * 16 + i] = ct[blocks * 16 + i] ^ keystream[i];
-        }
+    DIAG_INC(gcm_decrypt_calls);
 
-        ctx->counter++;
+    if (!ctx || (!ct && len > 0) || (!pt && len > 0)) {
+        SOLITON_RETURN(aesgcm_decrypt_update, ctx, len, SOLITON_INVALID_INPUT);
     }
 
-    return SOLITON_OK;
+    if (ctx->state == AES_STATE_FINAL) {
+        SOLITON_RETURN(aesgcm_decrypt_update, ctx, len, SOLITON_INVALID_INPUT);
+    }
+
+    const uint64_t t0 = gcm_cost_begin(ctx);
+    gcm_stats_update(len);
+    gcm_decrypt_body(ctx, ct, pt, len);
+    gcm_cost_end(ctx, t0);
+
+    SOLITON_RETURN(aesgcm_decrypt_update, ctx, len, SOLITON_OK);
+}
+
+/* Compute, compare in constant time and finalize (no argument checks) */
+static soliton_status gcm_verify_tag(soliton_aesgcm_ctx* ctx, const uint8_t tag[16]) {
+    uint8_t computed_tag[16];
+
+    gcm_compute_tag(ctx, computed_tag);
+
+    /* Constant-time tag comparison */
+    int valid = ct_memcmp(computed_tag, tag, 16);
+
+    ctx->state = AES_STATE_FINAL;
+
+    /* Wipe computed tag */
+    soliton_wipe(computed_tag, sizeof(computed_tag));
+
+    const soliton_status st = valid == 0 ? SOLITON_OK : SOLITON_AUTH_FAIL;
+    gcm_account_message(ctx, 1, st);
+    return st;
 }
 
 soliton_status soliton_aesgcm_decrypt_final(
     soliton_aesgcm_ctx* ctx, const uint8_t tag[SOLITON_AESGCM_TAG_BYTES]) {
 
+    SOLITON_PROBE_ENTRY(aesgcm_decrypt_final, ctx, 0);
+
     if (!ctx || !tag) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(aesgcm_decrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
     }
 
     if (ctx->state == AES_STATE_FINAL) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(aesgcm_decrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
     }
 
-    uint8_t computed_tag[16];
+    const uint64_t t0 = gcm_cost_begin(ctx);
+    const soliton_status st = gcm_verify_tag(ctx, tag);
+    gcm_cost_end(ctx, t0);
+    SOLITON_RETURN(aesgcm_decrypt_final, ctx, 0, st);
+}
 
-    /* Ciphertext padding is handled automatically by ghash_update - no explicit padding needed */
+void soliton_aesgcm_context_wipe(soliton_aesgcm_ctx* ctx) {
+    if (ctx) {
+        soliton_wipe(ctx, sizeof(*ctx));
+    }
+}
 
-    /* Finalize GHASH (use CLMUL version if available to match ghash_update format) */
-    #ifdef __PCLMUL__
-    extern void ghash_final_clmul(uint8_t*, const uint8_t*, const uint8_t*, uint64_t, uint64_t);
-    ghash_final_clmul(computed_tag, ctx->ghash_state, ctx->h_powers[0], ctx->aad_len, ctx->ct_len);
-    #else
-    extern void ghash_final_scalar(uint8_t*, const uint8_t*, const uint8_t*, uint64_t, uint64_t);
-    ghash_final_scalar(computed_tag, ctx->ghash_state, ctx->h_powers[0], ctx->aad_len, ctx->ct_len);
-    #endif
+/* ================ CRC32C fused into the GCM updates ================ */
 
-    /* Encrypt GHASH output to get final tag */
-    uint8_t ctr[16];
-    for (int i = 0; i < 12; i++) {
-        ctr[i] = ctx->j0[i];
+#if defined(__VAES__) && defined(__PCLMUL__)
+extern void gcm_resident_encrypt_crc_vaes_clmul(
+    const uint32_t*, const uint8_t*, uint8_t*, soliton_ctr_ymm*,
+    uint8_t*, const uint8_t (*)[16], size_t, uint32_t[2], unsigned);
+extern void gcm_resident_decrypt_crc_vaes_clmul(
+    const uint32_t*, const uint8_t*, uint8_t*, soliton_ctr_ymm*,
+    uint8_t*, const uint8_t (*)[16], size_t, uint32_t[2], unsigned);
+#endif
+
+/* Raw-state CRC32C for bytes outside the fused kernels (cached: -1 = not probed) */
+static uint32_t crc32c_update(uint32_t state, const uint8_t* p, size_t len) {
+#ifdef __x86_64__
+    static int hw = -1;
+    int h = __atomic_load_n(&hw, __ATOMIC_RELAXED);
+
+    if (h < 0) {
+        soliton_caps caps;
+        soliton_query_caps(&caps);
+        h = (caps.bits & SOLITON_FEAT_SSE42) != 0;
+        __atomic_store_n(&hw, h, __ATOMIC_RELAXED);
+    }
+    if (h) {
+        return crc32c_update_sse42(state, p, len);
+    }
+#endif
+    return crc32c_update_scalar(state, p, len);
+}
+
+uint32_t soliton_crc32c(uint32_t crc, const uint8_t* data, size_t len) {
+    if (!data) {
+        return crc;
     }
-    soliton_put_be32(ctr + 12, 1);  /* Counter = 1 for tag */
+    return ~crc32c_update(~crc, data, len);
+}
 
-    uint8_t encrypted_j0[16];
-    ctx->backend->aes_encrypt_block(ctx->round_keys, ctr, encrypted_j0);
+/* Checks shared by the CRC updates (state checks as the plain updates) */
+static int gcm_crc_args_ok(const soliton_aesgcm_ctx* ctx, const uint8_t* in, const uint8_t* out,
+                           size_t len, const soliton_crc32c_pair* crc) {
+    const uint32_t all = SOLITON_CRC_PLAINTEXT | SOLITON_CRC_CIPHERTEXT;
 
-    /* XOR GHASH result with E(J0) */
-    for (int i = 0; i < 16; i++) {
-        computed_tag[i] ^= encrypted_j0[i];
+    if (!ctx || !crc || (!in && len > 0) || (!out && len > 0)) {
+        return 0;
+    }
+    if (crc->which == 0 || (crc->which & ~all) != 0) {
+        return 0;
     }
+    return ctx->state != AES_STATE_FINAL;
+}
 
-    /* Constant-time tag comparison */
-    int valid = ct_memcmp(computed_tag, tag, 16);
+#if defined(__VAES__) && defined(__PCLMUL__)
+/* Whole 8-block batches the fused resident kernels take (0: another backend) */
+static size_t gcm_crc_fused_batches(const soliton_aesgcm_ctx* ctx, size_t len) {
+    if (ctx->backend == &backend_vaes) {
+        return len / 128;
+    }
+    return 0;
+}
+#endif
+
+soliton_status soliton_aesgcm_encrypt_update_crc(
+    soliton_aesgcm_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len,
+    soliton_crc32c_pair* crc) {
+
+    SOLITON_PROBE_ENTRY(aesgcm_encrypt_update_crc, ctx, len);
+
+    DIAG_INC(gcm_encrypt_calls);
+
+    if (!gcm_crc_args_ok(ctx, pt, ct, len, crc)) {
+        SOLITON_RETURN(aesgcm_encrypt_update_crc, ctx, len, SOLITON_INVALID_INPUT);
+    }
+
+    const uint64_t t0 = gcm_cost_begin(ctx);
+    gcm_stats_update(len);
+    gcm_ensure_h_powers(ctx);
+
+    uint32_t st[2] = { ~crc->pt, ~crc->ct };
+
+#if defined(__VAES__) && defined(__PCLMUL__)
+    const size_t batches = gcm_crc_fused_batches(ctx, len);
+    if (batches > 0) {
+        soliton_ctr_ymm ctr_engine;
+        soliton_ctr_ymm_init(&ctr_engine, ctx->j0, ctx->counter);
+        ctx->state = AES_STATE_UPDATE;
+        ctx->ct_len += batches * 128;
+        gcm_kernel_used(ctx, SOLITON_KERNEL_RESIDENT_CRC, batches * 128);
+        gcm_resident_encrypt_crc_vaes_clmul(ctx->round_keys, pt, ct, &ctr_engine, ctx->ghash_state,
+                                            (const uint8_t (*)[16])ctx->h_powers, batches,
+                                            st, crc->which);
+        ctx->counter += (uint32_t)(batches * 8);
+        pt += batches * 128;
+        ct += batches * 128;
+        len -= batches * 128;
+    }
+#endif
+
+    /* Remainder: plaintext summed before an in-place overwrite */
+    if (crc->which & SOLITON_CRC_PLAINTEXT) {
+        st[0] = crc32c_update(st[0], pt, len);
+    }
+    gcm_encrypt_body(ctx, pt, ct, len);
+    if (crc->which & SOLITON_CRC_CIPHERTEXT) {
+        st[1] = crc32c_update(st[1], ct, len);
+    }
+
+    if (crc->which & SOLITON_CRC_PLAINTEXT) {
+        crc->pt = ~st[0];
+    }
+    if (crc->which & SOLITON_CRC_CIPHERTEXT) {
+        crc->ct = ~st[1];
+    }
+    gcm_cost_end(ctx, t0);
+    SOLITON_RETURN(aesgcm_encrypt_update_crc, ctx, len, SOLITON_OK);
+}
+
+soliton_status soliton_aesgcm_decrypt_update_crc(
+    soliton_aesgcm_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len,
+    soliton_crc32c_pair* crc) {
+
+    SOLITON_PROBE_ENTRY(aesgcm_decrypt_update_crc, ctx, len);
+
+    DIAG_INC(gcm_decrypt_calls);
+
+    if (!gcm_crc_args_ok(ctx, ct, pt, len, crc)) {
+        SOLITON_RETURN(aesgcm_decrypt_update_crc, ctx, len, SOLITON_INVALID_INPUT);
+    }
+
+    const uint64_t t0 = gcm_cost_begin(ctx);
+    gcm_stats_update(len);
+    uint32_t st[2] = { ~crc->pt, ~crc->ct };
+
+#if defined(__VAES__) && defined(__PCLMUL__)
+    const size_t batches = gcm_crc_fused_batches(ctx, len);
+    if (batches > 0) {
+        soliton_ctr_ymm ctr_engine;
+        soliton_ctr_ymm_init(&ctr_engine, ctx->j0, ctx->counter);
+        ctx->state = AES_STATE_UPDATE;
+        ctx->ct_len += batches * 128;
+        gcm_kernel_used(ctx, SOLITON_KERNEL_RESIDENT_CRC, batches * 128);
+        gcm_resident_decrypt_crc_vaes_clmul(ctx->round_keys, ct, pt, &ctr_engine, ctx->ghash_state,
+                                            (const uint8_t (*)[16])ctx->h_powers, batches,
+                                            st, crc->which);
+        ctx->counter += (uint32_t)(batches * 8);
+        ct += batches * 128;
+        pt += batches * 128;
+        len -= batches * 128;
+    }
+#endif
+
+    /* Remainder: ciphertext summed before an in-place overwrite */
+    if (crc->which & SOLITON_CRC_CIPHERTEXT) {
+        st[1] = crc32c_update(st[1], ct, len);
+    }
+    gcm_decrypt_body(ctx, ct, pt, len);
+    if (crc->which & SOLITON_CRC_PLAINTEXT) {
+        st[0] = crc32c_update(st[0], pt, len);
+    }
+
+    if (crc->which & SOLITON_CRC_PLAINTEXT) {
+        crc->pt = ~st[0];
+    }
+    if (crc->which & SOLITON_CRC_CIPHERTEXT) {
+        crc->ct = ~st[1];
+    }
+    gcm_cost_end(ctx, t0);
+    SOLITON_RETURN(aesgcm_decrypt_update_crc, ctx, len, SOLITON_OK);
+}
+
+#if defined(__VAES__) && defined(__PCLMUL__)
+extern void gcm_duplex_vaes_clmul(
+    const uint32_t*, const uint8_t*, uint8_t*, soliton_ctr_ymm*, uint8_t*, const uint8_t (*)[16],
+    const uint32_t*, const uint8_t*, uint8_t*, soliton_ctr_ymm*, uint8_t*, const uint8_t (*)[16],
+    size_t);
+#endif
+
+/* One TX encrypt and one RX decrypt in a single pass: the leading 8-block
+ * batches both streams have run through the duplex kernel, whatever is
+ * left of either span goes through the ordinary update path. Results are
+ * identical to encrypt_update(tx) followed by decrypt_update(rx). */
+soliton_status soliton_aesgcm_duplex_update(
+    soliton_aesgcm_ctx* tx_ctx, const soliton_span* tx,
+    soliton_aesgcm_ctx* rx_ctx, const soliton_span* rx) {
+
+    SOLITON_PROBE_ENTRY(aesgcm_duplex_update, tx_ctx, tx ? tx->len : 0);
+
+    if (!tx_ctx || !rx_ctx || !tx || !rx || tx_ctx == rx_ctx) {
+        SOLITON_RETURN(aesgcm_duplex_update, tx_ctx, tx ? tx->len : 0, SOLITON_INVALID_INPUT);
+    }
+    if ((tx->len > 0 && (!tx->in || !tx->out)) || (rx->len > 0 && (!rx->in || !rx->out))) {
+        SOLITON_RETURN(aesgcm_duplex_update, tx_ctx, tx ? tx->len : 0, SOLITON_INVALID_INPUT);
+    }
+    if (tx_ctx->state == AES_STATE_FINAL || rx_ctx->state == AES_STATE_FINAL) {
+        SOLITON_RETURN(aesgcm_duplex_update, tx_ctx, tx ? tx->len : 0, SOLITON_INVALID_INPUT);
+    }
+
+    size_t done = 0;
+
+#if defined(__VAES__) && defined(__PCLMUL__)
+    const size_t batches = (tx->len < rx->len ? tx->len : rx->len) / 128;
+
+    if (batches > 0 && tx_ctx->backend == &backend_vaes && rx_ctx->backend == &backend_vaes) {
+        soliton_ctr_ymm tx_engine, rx_engine;
+
+        DIAG_INC(gcm_encrypt_calls);
+        DIAG_INC(gcm_decrypt_calls);
+        diag_record_batch(batches * 16);
+        gcm_kernel_used(tx_ctx, SOLITON_KERNEL_DUPLEX, batches * 128);
+
+        gcm_ensure_h_powers(tx_ctx);
+        gcm_ensure_h_powers(rx_ctx);
+        soliton_ctr_ymm_init(&tx_engine, tx_ctx->j0, tx_ctx->counter);
+        soliton_ctr_ymm_init(&rx_engine, rx_ctx->j0, rx_ctx->counter);
+
+        gcm_duplex_vaes_clmul(
+            tx_ctx->round_keys, tx->in, tx->out, &tx_engine, tx_ctx->ghash_state,
+            (const uint8_t (*)[16])tx_ctx->h_powers,
+            rx_ctx->round_keys, rx->in, rx->out, &rx_engine, rx_ctx->ghash_state,
+            (const uint8_t (*)[16])rx_ctx->h_powers,
+            batches);
+
+        done = batches * 128;
+        tx_ctx->state = AES_STATE_UPDATE;
+        rx_ctx->state = AES_STATE_UPDATE;
+        tx_ctx->ct_len += done;
+        rx_ctx->ct_len += done;
+        tx_ctx->counter += (uint32_t)(batches * 8);
+        rx_ctx->counter += (uint32_t)(batches * 8);
+
+        if (tx->len == done && rx->len == done) {
+            SOLITON_RETURN(aesgcm_duplex_update, tx_ctx, tx->len, SOLITON_OK);
+        }
+    }
+#endif
+
+    soliton_status st = soliton_aesgcm_encrypt_update(
+        tx_ctx, tx->in ? tx->in + done : NULL, tx->out ? tx->out + done : NULL, tx->len - done);
+    if (st != SOLITON_OK) {
+        SOLITON_RETURN(aesgcm_duplex_update, tx_ctx, tx->len, st);
+    }
+    st = soliton_aesgcm_decrypt_update(
+        rx_ctx, rx->in ? rx->in + done : NULL, rx->out ? rx->out + done : NULL, rx->len - done);
+    SOLITON_RETURN(aesgcm_duplex_update, tx_ctx, tx->len, st);
+}
+
+/* ============== Datagram batches for UDP GSO ============== */
+
+/* Datagrams whose tag masks E_K(J0) share one multi-block AES pass */
+#define GCM_GSO_MASK_BATCH 8
+
+/* J0 of datagram pn: the per-packet nonce iv ^ (0^32 || be64(pn)), then 1 */
+static void gcm_gso_j0(uint8_t j0[16], const uint8_t iv[12], uint64_t pn) {
+    soliton_copy(j0, iv, 12);
+    for (int i = 0; i < 8; i++) {
+        j0[4 + i] ^= (uint8_t)(pn >> (56 - 8 * i));
+    }
+    j0[12] = 0;
+    j0[13] = 0;
+    j0[14] = 0;
+    j0[15] = 1;
+}
+
+/* E_K(J0) for n datagrams: one ECB call where the backend has it */
+static void gcm_gso_masks(const soliton_aesgcm_ctx* ctx, const uint8_t j0s[][16],
+                          uint8_t masks[][16], size_t n) {
+    if (ctx->backend->aes_ecb_blocks) {
+        ctx->backend->aes_ecb_blocks(ctx->round_keys, j0s[0], masks[0], n);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        ctx->backend->aes_encrypt_block(ctx->round_keys, j0s[i], masks[i]);
+    }
+}
+
+/* Wire size of every datagram against the GSO layout and out_cap */
+static soliton_status gcm_gso_layout(const soliton_datagram* dgrams, size_t count,
+                                     size_t segment_size, size_t out_cap, size_t* total) {
+    size_t used = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const soliton_datagram* d = &dgrams[i];
+        if ((!d->hdr && d->hdr_len > 0) || (!d->payload && d->len > 0)) {
+            return SOLITON_INVALID_INPUT;
+        }
+        if (d->hdr_len > segment_size || d->len > segment_size - d->hdr_len ||
+            segment_size - d->hdr_len - d->len < SOLITON_AESGCM_TAG_BYTES) {
+            return SOLITON_INVALID_INPUT;
+        }
+        const size_t wire = d->hdr_len + d->len + SOLITON_AESGCM_TAG_BYTES;
+        if ((i + 1 < count && wire != segment_size) || wire > out_cap - used) {
+            return SOLITON_INVALID_INPUT;
+        }
+        used += wire;
+    }
+    *total = used;
+    return SOLITON_OK;
+}
+
+soliton_status soliton_aesgcm_seal_gso(
+    soliton_aesgcm_ctx* ctx, const uint8_t iv[12], uint64_t first_pn,
+    const soliton_datagram* dgrams, size_t count, size_t segment_size,
+    uint8_t* out, size_t out_cap, size_t* out_len) {
+
+    SOLITON_PROBE_ENTRY(aesgcm_seal_gso, ctx, count);
+
+    size_t total = 0;
+    if (!ctx || !ctx->backend || !iv || !out_len || (count > 0 && (!dgrams || !out)) ||
+        gcm_gso_layout(dgrams, count, segment_size, out_cap, &total) != SOLITON_OK) {
+        SOLITON_RETURN(aesgcm_seal_gso, ctx, count, SOLITON_INVALID_INPUT);
+    }
 
+    const uint64_t t0 = gcm_cost_begin(ctx);
+    gcm_ensure_h_powers(ctx);
+
+    uint8_t j0s[GCM_GSO_MASK_BATCH][16];
+    uint8_t masks[GCM_GSO_MASK_BATCH][16];
+    uint8_t* dst = out;
+
+    for (size_t base = 0; base < count; base += GCM_GSO_MASK_BATCH) {
+        const size_t n = count - base < GCM_GSO_MASK_BATCH ? count - base : GCM_GSO_MASK_BATCH;
+
+        for (size_t i = 0; i < n; i++) {
+            gcm_gso_j0(j0s[i], iv, first_pn + base + i);
+        }
+        gcm_gso_masks(ctx, (const uint8_t (*)[16])j0s, masks, n);
+
+        for (size_t i = 0; i < n; i++) {
+            const soliton_datagram* d = &dgrams[base + i];
+            uint8_t* ct = dst + d->hdr_len;
+            uint8_t* tag = ct + d->len;
+
+            /* Per-datagram reset: the bound prefix, then the header as AAD */
+            soliton_copy(ctx->j0, j0s[i], 16);
+            gcm_start_aad(ctx);
+            ctx->ct_len = 0;
+            ctx->counter = 2;
+            if (d->hdr_len > 0) {
+                if (d->hdr != dst) {
+                    soliton_copy(dst, d->hdr, d->hdr_len);
+                }
+                ctx->aad_len += d->hdr_len;
+                ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], dst, d->hdr_len);
+            }
+
+            gcm_stats_update(d->len);
+            gcm_encrypt_body(ctx, d->payload, ct, d->len);
+
+            gcm_ghash_final(ctx, tag);
+            *(soliton_v16*)tag ^= *(const soliton_v16*)masks[i];
+            gcm_account_message(ctx, 0, SOLITON_OK);
+
+            dst = tag + SOLITON_AESGCM_TAG_BYTES;
+        }
+    }
+
+    soliton_wipe(masks, sizeof(masks));
+    ctx->buffer_len = 0;
     ctx->state = AES_STATE_FINAL;
+    gcm_cost_end(ctx, t0);
 
-    /* Wipe computed tag */
-    soliton_wipe(computed_tag, sizeof(computed_tag));
+    *out_len = total;
+    SOLITON_RETURN(aesgcm_seal_gso, ctx, count, SOLITON_OK);
+}
 
-    return valid == 0 ? SOLITON_OK : SOLITON_AUTH_FAIL;
+/* ============== Unchecked entry points (soliton_fast.h) ============== */
+
+/* Reset for a 96-bit IV: J0 = IV || 1, first data counter 2 */
+static void fast_gcm_reset96(soliton_aesgcm_ctx* ctx, const uint8_t iv[12]) {
+    soliton_copy(ctx->j0, iv, 12);
+    ctx->j0[12] = 0;
+    ctx->j0[13] = 0;
+    ctx->j0[14] = 0;
+    ctx->j0[15] = 1;
+    gcm_start_aad(ctx);
+    soliton_wipe(ctx->buffer, 16);
+    ctx->ct_len = 0;
+    ctx->buffer_len = 0;
+    ctx->counter = 2;
+    ctx->state = AES_STATE_INIT;
 }
 
-void soliton_aesgcm_context_wipe(soliton_aesgcm_ctx* ctx) {
-    if (ctx) {
-        soliton_wipe(ctx, sizeof(*ctx));
+static void fast_gcm_aad(soliton_aesgcm_ctx* ctx, const uint8_t* aad, size_t len) {
+    ctx->state = AES_STATE_AAD;
+    ctx->aad_len += len;
+    ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], aad, len);
+}
+
+/* Below SOLITON_FAST_SMALL_MAX: no batch loop, plan or counter engine -
+ * straight to the backend's CTR and GHASH kernels */
+static void fast_gcm_seal_small(soliton_aesgcm_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len) {
+    size_t blocks = len / 16;
+
+    ctx->state = AES_STATE_UPDATE;
+    ctx->ct_len += len;
+
+    if (blocks > 0) {
+        ctx->backend->aes_ctr_blocks(ctx->round_keys, ctx->j0, ctx->counter, pt, ct, blocks);
+        ctx->counter += (uint32_t)blocks;
+        ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct, blocks * 16);
+    }
+    if (len % 16 > 0) {
+        gcm_encrypt_partial(ctx, pt + blocks * 16, ct + blocks * 16, len % 16);
+    }
+}
+
+static void fast_gcm_open_small(soliton_aesgcm_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len) {
+    size_t blocks = len / 16;
+
+    ctx->state = AES_STATE_UPDATE;
+    ctx->ct_len += len;
+    ctx->backend->ghash_update(ctx->ghash_state, ctx->h_powers[0], ct, len);
+
+    if (blocks > 0) {
+        ctx->backend->aes_ctr_blocks(ctx->round_keys, ctx->j0, ctx->counter, ct, pt, blocks);
+        ctx->counter += (uint32_t)blocks;
+    }
+    if (len % 16 > 0) {
+        gcm_decrypt_partial(ctx, ct + blocks * 16, pt + blocks * 16, len % 16);
+    }
+}
+
+static void fast_gcm_seal_final(soliton_aesgcm_ctx* ctx, uint8_t tag[16]) {
+    gcm_compute_tag(ctx, tag);
+    gcm_account_message(ctx, 0, SOLITON_OK);
+    ctx->state = AES_STATE_FINAL;
+}
+
+soliton_fast_table soliton_fast;
+
+void soliton_fast_init(void) {
+    /* Stitched backends (gcm_blocks) hash inside the CTR kernel at every size */
+    const int stitched = soliton_get_backend()->gcm_blocks != NULL;
+
+    soliton_fast.gcm_reset96 = fast_gcm_reset96;
+    soliton_fast.gcm_aad = fast_gcm_aad;
+    soliton_fast.gcm_seal_small = stitched ? gcm_encrypt_body : fast_gcm_seal_small;
+    soliton_fast.gcm_open_small = stitched ? gcm_decrypt_body : fast_gcm_open_small;
+    soliton_fast.gcm_seal_bulk = gcm_encrypt_body;
+    soliton_fast.gcm_open_bulk = gcm_decrypt_body;
+    soliton_fast.gcm_seal_final = fast_gcm_seal_final;
+    soliton_fast.gcm_open_final = gcm_verify_tag;
+}
+
+/* Debug-build precondition check behind SOLITON_FAST_CHECK: the same
+ * rules the checked API enforces, without side effects */
+int soliton_fast_gcm_valid(const soliton_aesgcm_ctx* ctx, unsigned op,
+                           const void* in, const void* out, size_t len) {
+    if (!soliton_fast.gcm_seal_bulk || !ctx || !ctx->backend || !ctx->h_powers_ready) {
+        return 0;
+    }
+    if (len > 0 && (!in || !out)) {
+        return 0;
+    }
+
+    switch (op) {
+    case SOLITON_FAST_OP_RESET:
+        return 1;
+    case SOLITON_FAST_OP_AAD:
+        return ctx->state == AES_STATE_INIT || ctx->state == AES_STATE_AAD;
+    case SOLITON_FAST_OP_UPDATE:
+    case SOLITON_FAST_OP_FINAL:
+        return ctx->state != AES_STATE_FINAL;
+    default:
+        return 0;
+    }
+}
+
+/* Round-specialized scalar ChaCha kernels (chacha_scalar.c) */
+extern void chacha20_xor_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+extern void chacha12_xor_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+extern void chacha8_xor_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+extern void chacha20_blocks_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+extern void chacha12_blocks_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+extern void chacha8_blocks_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+extern void chacha20_poly1305_key_gen_scalar(uint8_t*, const uint8_t*, const uint8_t*);
+extern void chacha12_poly1305_key_gen_scalar(uint8_t*, const uint8_t*, const uint8_t*);
+extern void chacha8_poly1305_key_gen_scalar(uint8_t*, const uint8_t*, const uint8_t*);
+
+/* Scalar Poly1305 (poly1305_scalar.c), used when the ChaCha backend has none */
+extern void poly1305_init_scalar(void*, const uint8_t*);
+extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
+extern void poly1305_final_scalar(void*, uint8_t*);
+
+/* Poly1305 through the context's backend; the backend chosen at init owns
+ * the layout of ctx->poly, so all calls for a context go the same way */
+static void chacha_poly_init(soliton_chacha_ctx* ctx, const uint8_t key[32]) {
+    if (ctx->backend->poly1305_init) {
+        ctx->backend->poly1305_init(&ctx->poly, key);
+    } else {
+        poly1305_init_scalar(&ctx->poly, key);
+    }
+}
+
+static void chacha_poly_update(soliton_chacha_ctx* ctx, const uint8_t* data, size_t len) {
+    if (ctx->backend->poly1305_update) {
+        ctx->backend->poly1305_update(&ctx->poly, data, len);
+    } else {
+        poly1305_update_scalar(&ctx->poly, data, len);
+    }
+}
+
+static void chacha_poly_final(soliton_chacha_ctx* ctx, uint8_t tag[16]) {
+    if (ctx->backend->poly1305_final) {
+        ctx->backend->poly1305_final(&ctx->poly, tag);
+    } else {
+        poly1305_final_scalar(&ctx->poly, tag);
+    }
+}
+
+/* Map public variant to round count (0 if invalid) */
+static int chacha_variant_rounds(soliton_chacha_variant variant) {
+    switch (variant) {
+        case SOLITON_CHACHA20: return 20;
+        case SOLITON_CHACHA12: return 12;
+        case SOLITON_CHACHA8:  return 8;
+        default:               return 0;
+    }
+}
+
+/* Keystream XOR: full blocks through the selected ChaCha backend for the
+ * round count, trailing partial block through the scalar kernel */
+static void chacha_stream(const soliton_backend_t* backend, int rounds,
+                          const uint8_t key[32], const uint8_t nonce[12],
+                          uint32_t counter, const uint8_t* in, uint8_t* out, size_t len) {
+    void (*blocks_fn)(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+    void (*xor_fn)(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+
+    if (rounds == 8) {
+        blocks_fn = backend->chacha8_blocks ? backend->chacha8_blocks : chacha8_blocks_scalar;
+        xor_fn = chacha8_xor_scalar;
+    } else if (rounds == 12) {
+        blocks_fn = backend->chacha12_blocks ? backend->chacha12_blocks : chacha12_blocks_scalar;
+        xor_fn = chacha12_xor_scalar;
+    } else {
+        blocks_fn = backend->chacha_blocks ? backend->chacha_blocks : chacha20_blocks_scalar;
+        xor_fn = chacha20_xor_scalar;
     }
+
+    size_t blocks = len / 64;
+    if (blocks > 0) {
+        blocks_fn(key, nonce, counter, in, out, blocks);
+    }
+    if (len % 64) {
+        xor_fn(key, nonce, counter + (uint32_t)blocks, in + blocks * 64, out + blocks * 64, len % 64);
+    }
+}
+
+soliton_status soliton_chacha_stream_xor(
+    soliton_chacha_variant variant,
+    const uint8_t key[SOLITON_CHACHA_KEY_BYTES],
+    const uint8_t nonce[SOLITON_CHACHA_NONCE_BYTES],
+    uint32_t counter,
+    const uint8_t* in, uint8_t* out, size_t len) {
+
+    SOLITON_PROBE_ENTRY(chacha_stream_xor, 0, len);
+
+    int rounds = chacha_variant_rounds(variant);
+    if (!rounds || !key || !nonce || ((!in || !out) && len > 0)) {
+        SOLITON_RETURN(chacha_stream_xor, 0, len, SOLITON_INVALID_INPUT);
+    }
+
+    chacha_stream(soliton_get_chacha_backend(), rounds, key, nonce, counter, in, out, len);
+    SOLITON_RETURN(chacha_stream_xor, 0, len, SOLITON_OK);
 }
 
 /* ChaCha20-Poly1305 API implementation */
@@ -840,34 +2172,47 @@ soliton_status soliton_chacha_init(
     soliton_chacha_ctx* ctx,
     const uint8_t key[SOLITON_CHACHA_KEY_BYTES],
     const uint8_t nonce[SOLITON_CHACHA_NONCE_BYTES]) {
+    return soliton_chacha_init_variant(ctx, SOLITON_CHACHA20, key, nonce);
+}
+
+soliton_status soliton_chacha_init_variant(
+    soliton_chacha_ctx* ctx,
+    soliton_chacha_variant variant,
+    const uint8_t key[SOLITON_CHACHA_KEY_BYTES],
+    const uint8_t nonce[SOLITON_CHACHA_NONCE_BYTES]) {
+
+    SOLITON_PROBE_ENTRY(chacha_init_variant, ctx, 0);
+
+    int rounds = chacha_variant_rounds(variant);
 
     /* Validate inputs */
-    if (!ctx || !key || !nonce) {
-        return SOLITON_INVALID_INPUT;
+    if (!ctx || !key || !nonce || !rounds) {
+        SOLITON_RETURN(chacha_init_variant, ctx, 0, SOLITON_INVALID_INPUT);
     }
 
     /* Clear context */
     soliton_wipe(ctx, sizeof(*ctx));
 
     /* Get backend */
-    ctx->backend = soliton_get_backend();
+    ctx->backend = soliton_get_chacha_backend();
+    ctx->rounds = rounds;
 
     /* Copy key and nonce */
-    for (int i = 0; i < 32; i++) {
-        ctx->key[i] = key[i];
-    }
-    for (int i = 0; i < 12; i++) {
-        ctx->nonce[i] = nonce[i];
-    }
+    soliton_copy(ctx->key, key, 32);
+    soliton_copy(ctx->nonce, nonce, 12);
 
-    /* Generate Poly1305 one-time key from ChaCha20(counter=0) */
+    /* Generate Poly1305 one-time key from ChaCha(counter=0) */
     uint8_t poly_key[32];
-    extern void chacha20_poly1305_key_gen_scalar(uint8_t*, const uint8_t*, const uint8_t*);
-    chacha20_poly1305_key_gen_scalar(poly_key, key, nonce);
+    if (rounds == 8) {
+        chacha8_poly1305_key_gen_scalar(poly_key, key, nonce);
+    } else if (rounds == 12) {
+        chacha12_poly1305_key_gen_scalar(poly_key, key, nonce);
+    } else {
+        chacha20_poly1305_key_gen_scalar(poly_key, key, nonce);
+    }
 
     /* Initialize Poly1305 */
-    extern void poly1305_init_scalar(void*, const uint8_t*);
-    poly1305_init_scalar(&ctx->poly, poly_key);
+    chacha_poly_init(ctx, poly_key);
 
     /* Wipe poly key */
     soliton_wipe(poly_key, sizeof(poly_key));
@@ -879,145 +2224,145 @@ soliton_status soliton_chacha_init(
     ctx->buffer_len = 0;
     ctx->state = CHACHA_STATE_INIT;
 
-    return SOLITON_OK;
+    SOLITON_RETURN(chacha_init_variant, ctx, 0, SOLITON_OK);
 }
 
 soliton_status soliton_chacha_aad_update(
     soliton_chacha_ctx* ctx, const uint8_t* aad, size_t aad_len) {
 
+    SOLITON_PROBE_ENTRY(chacha_aad_update, ctx, aad_len);
+
     if (!ctx || (!aad && aad_len > 0)) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_aad_update, ctx, aad_len, SOLITON_INVALID_INPUT);
     }
 
     if (ctx->state != CHACHA_STATE_INIT && ctx->state != CHACHA_STATE_AAD) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_aad_update, ctx, aad_len, SOLITON_INVALID_INPUT);
     }
 
     ctx->state = CHACHA_STATE_AAD;
     ctx->aad_len += aad_len;
 
     /* Update Poly1305 with AAD */
-    extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
-    poly1305_update_scalar(&ctx->poly, aad, aad_len);
+    chacha_poly_update(ctx, aad, aad_len);
 
-    return SOLITON_OK;
+    SOLITON_RETURN(chacha_aad_update, ctx, aad_len, SOLITON_OK);
 }
 
 soliton_status soliton_chacha_encrypt_update(
     soliton_chacha_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len) {
 
+    SOLITON_PROBE_ENTRY(chacha_encrypt_update, ctx, len);
+
     if (!ctx || (!pt && len > 0) || (!ct && len > 0)) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_encrypt_update, ctx, len, SOLITON_INVALID_INPUT);
     }
 
     if (ctx->state == CHACHA_STATE_FINAL) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_encrypt_update, ctx, len, SOLITON_INVALID_INPUT);
     }
 
     /* Pad AAD to 16-byte boundary if needed */
     if (ctx->state == CHACHA_STATE_AAD && ctx->aad_len % 16 != 0) {
         uint8_t zeros[16] = {0};
         size_t pad = 16 - (ctx->aad_len % 16);
-        extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
-        poly1305_update_scalar(&ctx->poly, zeros, pad);
+        chacha_poly_update(ctx, zeros, pad);
     }
 
     ctx->state = CHACHA_STATE_UPDATE;
     ctx->ct_len += len;
 
-    /* Encrypt with ChaCha20 */
-    extern void chacha20_xor_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
-    chacha20_xor_scalar(ctx->key, ctx->nonce, ctx->counter, pt, ct, len);
+    /* Encrypt with ChaCha */
+    chacha_stream(ctx->backend, ctx->rounds, ctx->key, ctx->nonce, ctx->counter, pt, ct, len);
 
     /* Update counter */
     ctx->counter += (uint32_t)((len + 63) / 64);
 
     /* Update Poly1305 with ciphertext */
-    extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
-    poly1305_update_scalar(&ctx->poly, ct, len);
+    chacha_poly_update(ctx, ct, len);
 
-    return SOLITON_OK;
+    SOLITON_RETURN(chacha_encrypt_update, ctx, len, SOLITON_OK);
 }
 
 soliton_status soliton_chacha_encrypt_final(
     soliton_chacha_ctx* ctx, uint8_t tag[SOLITON_CHACHA_TAG_BYTES]) {
 
+    SOLITON_PROBE_ENTRY(chacha_encrypt_final, ctx, 0);
+
     if (!ctx || !tag) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_encrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
     }
 
     if (ctx->state == CHACHA_STATE_FINAL) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_encrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
     }
 
     /* Pad ciphertext to 16-byte boundary if needed */
     if (ctx->ct_len % 16 != 0) {
         uint8_t zeros[16] = {0};
         size_t pad = 16 - (ctx->ct_len % 16);
-        extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
-        poly1305_update_scalar(&ctx->poly, zeros, pad);
+        chacha_poly_update(ctx, zeros, pad);
     }
 
     /* Add lengths */
     uint8_t lengths[16];
     soliton_put_le64(lengths, ctx->aad_len);
     soliton_put_le64(lengths + 8, ctx->ct_len);
-    extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
-    poly1305_update_scalar(&ctx->poly, lengths, 16);
+    chacha_poly_update(ctx, lengths, 16);
 
     /* Finalize Poly1305 */
-    extern void poly1305_final_scalar(void*, uint8_t*);
-    poly1305_final_scalar(&ctx->poly, tag);
+    chacha_poly_final(ctx, tag);
 
     ctx->state = CHACHA_STATE_FINAL;
-    return SOLITON_OK;
+    SOLITON_RETURN(chacha_encrypt_final, ctx, 0, SOLITON_OK);
 }
 
 soliton_status soliton_chacha_decrypt_update(
     soliton_chacha_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len) {
 
+    SOLITON_PROBE_ENTRY(chacha_decrypt_update, ctx, len);
+
     if (!ctx || (!ct && len > 0) || (!pt && len > 0)) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_decrypt_update, ctx, len, SOLITON_INVALID_INPUT);
     }
 
     if (ctx->state == CHACHA_STATE_FINAL) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_decrypt_update, ctx, len, SOLITON_INVALID_INPUT);
     }
 
     /* Pad AAD to 16-byte boundary if needed */
     if (ctx->state == CHACHA_STATE_AAD && ctx->aad_len % 16 != 0) {
         uint8_t zeros[16] = {0};
         size_t pad = 16 - (ctx->aad_len % 16);
-        extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
-        poly1305_update_scalar(&ctx->poly, zeros, pad);
+        chacha_poly_update(ctx, zeros, pad);
     }
 
     ctx->state = CHACHA_STATE_UPDATE;
     ctx->ct_len += len;
 
     /* Update Poly1305 with ciphertext BEFORE decrypting */
-    extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
-    poly1305_update_scalar(&ctx->poly, ct, len);
+    chacha_poly_update(ctx, ct, len);
 
-    /* Decrypt with ChaCha20 */
-    extern void chacha20_xor_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
-    chacha20_xor_scalar(ctx->key, ctx->nonce, ctx->counter, ct, pt, len);
+    /* Decrypt with ChaCha */
+    chacha_stream(ctx->backend, ctx->rounds, ctx->key, ctx->nonce, ctx->counter, ct, pt, len);
 
     /* Update counter */
     ctx->counter += (uint32_t)((len + 63) / 64);
 
-    return SOLITON_OK;
+    SOLITON_RETURN(chacha_decrypt_update, ctx, len, SOLITON_OK);
 }
 
 soliton_status soliton_chacha_decrypt_final(
     soliton_chacha_ctx* ctx, const uint8_t tag[SOLITON_CHACHA_TAG_BYTES]) {
 
+    SOLITON_PROBE_ENTRY(chacha_decrypt_final, ctx, 0);
+
     if (!ctx || !tag) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_decrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
     }
 
     if (ctx->state == CHACHA_STATE_FINAL) {
-        return SOLITON_INVALID_INPUT;
+        SOLITON_RETURN(chacha_decrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
     }
 
     uint8_t computed_tag[16];
@@ -1026,20 +2371,17 @@ soliton_status soliton_chacha_decrypt_final(
     if (ctx->ct_len % 16 != 0) {
         uint8_t zeros[16] = {0};
         size_t pad = 16 - (ctx->ct_len % 16);
-        extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
-        poly1305_update_scalar(&ctx->poly, zeros, pad);
+        chacha_poly_update(ctx, zeros, pad);
     }
 
     /* Add lengths */
     uint8_t lengths[16];
     soliton_put_le64(lengths, ctx->aad_len);
     soliton_put_le64(lengths + 8, ctx->ct_len);
-    extern void poly1305_update_scalar(void*, const uint8_t*, size_t);
-    poly1305_update_scalar(&ctx->poly, lengths, 16);
+    chacha_poly_update(ctx, lengths, 16);
 
     /* Finalize Poly1305 */
-    extern void poly1305_final_scalar(void*, uint8_t*);
-    poly1305_final_scalar(&ctx->poly, computed_tag);
+    chacha_poly_final(ctx, computed_tag);
 
     /* Constant-time tag comparison */
     int valid = ct_memcmp(computed_tag, tag, 16);
@@ -1049,7 +2391,7 @@ soliton_status soliton_chacha_decrypt_final(
     /* Wipe computed tag */
     soliton_wipe(computed_tag, sizeof(computed_tag));
 
-    return valid == 0 ? SOLITON_OK : SOLITON_AUTH_FAIL;
+    SOLITON_RETURN(chacha_decrypt_final, ctx, 0, valid == 0 ? SOLITON_OK : SOLITON_AUTH_FAIL);
 }
 
 void soliton_chacha_context_wipe(soliton_chacha_ctx* ctx) {
@@ -1058,9 +2400,568 @@ void soliton_chacha_context_wipe(soliton_chacha_ctx* ctx) {
     }
 }
 
-/* Batch API stubs */
-soliton_status soliton_batch_init(soliton_batch_ctx* bctx) {
-    (void)bctx;
+/* AEGIS-128L / AEGIS-256 API implementation */
+
+/* Keystream for the current state (partial blocks only; full blocks
+ * go through the backend kernels) */
+static void aegis_keystream(const soliton_aegis_ctx* ctx, uint8_t z[32]) {
+    const uint8_t (*s)[16] = ctx->s;
+
+    if (ctx->alg == SOLITON_AEGIS_128L) {
+        for (int i = 0; i < 16; i++) {
+            z[i] = s[6][i] ^ s[1][i] ^ (s[2][i] & s[3][i]);
+            z[16 + i] = s[2][i] ^ s[5][i] ^ (s[6][i] & s[7][i]);
+        }
+    } else {
+        for (int i = 0; i < 16; i++) {
+            z[i] = s[1][i] ^ s[4][i] ^ s[5][i] ^ (s[2][i] & s[3][i]);
+        }
+    }
+}
+
+static void aegis_absorb(soliton_aegis_ctx* ctx, const uint8_t* data, size_t blocks) {
+    if (ctx->alg == SOLITON_AEGIS_128L) {
+        ctx->backend->aegis128l_absorb(&ctx->s[0][0], data, blocks);
+    } else {
+        ctx->backend->aegis256_absorb(&ctx->s[0][0], data, blocks);
+    }
+}
+
+/* Pad and absorb a trailing partial AAD block before the message starts */
+static void aegis_finish_aad(soliton_aegis_ctx* ctx) {
+    if (ctx->state == AEGIS_STATE_AAD && ctx->buffer_len > 0) {
+        for (size_t i = ctx->buffer_len; i < ctx->rate; i++) {
+            ctx->buffer[i] = 0;
+        }
+        aegis_absorb(ctx, ctx->buffer, 1);
+        ctx->buffer_len = 0;
+    }
+}
+
+/* Shared body of encrypt_update/decrypt_update
+ * The buffer always holds plaintext: AEGIS absorbs the plaintext of each
+ * block, so a partial block is completed (or zero-padded at final) and
+ * absorbed exactly as a full one would be. */
+static void aegis_process(soliton_aegis_ctx* ctx, const uint8_t* in, uint8_t* out,
+                          size_t len, int decrypt) {
+    uint8_t z[32];
+    size_t off = 0;
+    size_t rate = ctx->rate;
+
+    /* Complete a pending partial block */
+    if (ctx->buffer_len > 0) {
+        aegis_keystream(ctx, z);
+        while (off < len && ctx->buffer_len < rate) {
+            uint8_t m = decrypt ? (uint8_t)(in[off] ^ z[ctx->buffer_len]) : in[off];
+            out[off] = decrypt ? m : (uint8_t)(m ^ z[ctx->buffer_len]);
+            ctx->buffer[ctx->buffer_len++] = m;
+            off++;
+        }
+        if (ctx->buffer_len == rate) {
+            aegis_absorb(ctx, ctx->buffer, 1);
+            ctx->buffer_len = 0;
+        }
+    }
+
+    /* Full blocks through the backend kernel */
+    size_t blocks = (len - off) / rate;
+    if (blocks > 0) {
+        uint8_t* s = &ctx->s[0][0];
+        if (ctx->alg == SOLITON_AEGIS_128L) {
+            if (decrypt) {
+                ctx->backend->aegis128l_decrypt(s, in + off, out + off, blocks);
+            } else {
+                ctx->backend->aegis128l_encrypt(s, in + off, out + off, blocks);
+            }
+        } else {
+            if (decrypt) {
+                ctx->backend->aegis256_decrypt(s, in + off, out + off, blocks);
+            } else {
+                ctx->backend->aegis256_encrypt(s, in + off, out + off, blocks);
+            }
+        }
+        off += blocks * rate;
+    }
+
+    /* Start a new partial block */
+    if (off < len) {
+        aegis_keystream(ctx, z);
+        while (off < len) {
+            uint8_t m = decrypt ? (uint8_t)(in[off] ^ z[ctx->buffer_len]) : in[off];
+            out[off] = decrypt ? m : (uint8_t)(m ^ z[ctx->buffer_len]);
+            ctx->buffer[ctx->buffer_len++] = m;
+            off++;
+        }
+    }
+
+    soliton_wipe(z, sizeof(z));
+}
+
+/* Absorb trailing partial block and produce the tag */
+static void aegis_tag(soliton_aegis_ctx* ctx, uint8_t tag[16]) {
+    aegis_finish_aad(ctx);
+
+    if (ctx->buffer_len > 0) {
+        for (size_t i = ctx->buffer_len; i < ctx->rate; i++) {
+            ctx->buffer[i] = 0;
+        }
+        aegis_absorb(ctx, ctx->buffer, 1);
+        ctx->buffer_len = 0;
+    }
+
+    if (ctx->alg == SOLITON_AEGIS_128L) {
+        ctx->backend->aegis128l_final(&ctx->s[0][0], ctx->aad_len, ctx->msg_len, tag);
+    } else {
+        ctx->backend->aegis256_final(&ctx->s[0][0], ctx->aad_len, ctx->msg_len, tag);
+    }
+
+    soliton_wipe(ctx->buffer, sizeof(ctx->buffer));
+}
+
+soliton_status soliton_aegis_init(
+    soliton_aegis_ctx* ctx,
+    soliton_aegis_alg alg,
+    const uint8_t* key,
+    const uint8_t* nonce) {
+
+    SOLITON_PROBE_ENTRY(aegis_init, ctx, 0);
+
+    /* Validate inputs */
+    if (!ctx || !key || !nonce) {
+        SOLITON_RETURN(aegis_init, ctx, 0, SOLITON_INVALID_INPUT);
+    }
+    if (alg != SOLITON_AEGIS_128L && alg != SOLITON_AEGIS_256) {
+        SOLITON_RETURN(aegis_init, ctx, 0, SOLITON_INVALID_INPUT);
+    }
+
+    ctx->backend = soliton_get_aegis_backend();
+    ctx->alg = alg;
+
+    soliton_wipe(ctx->buffer, sizeof(ctx->buffer));
+    ctx->aad_len = 0;
+    ctx->msg_len = 0;
+    ctx->buffer_len = 0;
+
+    if (alg == SOLITON_AEGIS_128L) {
+        ctx->rate = 32;
+        ctx->backend->aegis128l_init(&ctx->s[0][0], key, nonce);
+    } else {
+        ctx->rate = 16;
+        ctx->backend->aegis256_init(&ctx->s[0][0], key, nonce);
+    }
+
+    ctx->state = AEGIS_STATE_INIT;
+    SOLITON_RETURN(aegis_init, ctx, 0, SOLITON_OK);
+}
+
+soliton_status soliton_aegis_aad_update(
+    soliton_aegis_ctx* ctx, const uint8_t* aad, size_t aad_len) {
+
+    SOLITON_PROBE_ENTRY(aegis_aad_update, ctx, aad_len);
+
+    if (!ctx || (!aad && aad_len > 0)) {
+        SOLITON_RETURN(aegis_aad_update, ctx, aad_len, SOLITON_INVALID_INPUT);
+    }
+
+    if (ctx->state != AEGIS_STATE_INIT && ctx->state != AEGIS_STATE_AAD) {
+        SOLITON_RETURN(aegis_aad_update, ctx, aad_len, SOLITON_INVALID_INPUT);
+    }
+
+    ctx->state = AEGIS_STATE_AAD;
+    ctx->aad_len += aad_len;
+
+    size_t off = 0;
+    size_t rate = ctx->rate;
+
+    /* Complete a pending partial block */
+    if (ctx->buffer_len > 0) {
+        while (off < aad_len && ctx->buffer_len < rate) {
+            ctx->buffer[ctx->buffer_len++] = aad[off++];
+        }
+        if (ctx->buffer_len < rate) {
+            SOLITON_RETURN(aegis_aad_update, ctx, aad_len, SOLITON_OK);
+        }
+        aegis_absorb(ctx, ctx->buffer, 1);
+        ctx->buffer_len = 0;
+    }
+
+    size_t blocks = (aad_len - off) / rate;
+    if (blocks > 0) {
+        aegis_absorb(ctx, aad + off, blocks);
+        off += blocks * rate;
+    }
+
+    while (off < aad_len) {
+        ctx->buffer[ctx->buffer_len++] = aad[off++];
+    }
+
+    SOLITON_RETURN(aegis_aad_update, ctx, aad_len, SOLITON_OK);
+}
+
+soliton_status soliton_aegis_encrypt_update(
+    soliton_aegis_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len) {
+
+    SOLITON_PROBE_ENTRY(aegis_encrypt_update, ctx, len);
+
+    if (!ctx || (!pt && len > 0) || (!ct && len > 0)) {
+        SOLITON_RETURN(aegis_encrypt_update, ctx, len, SOLITON_INVALID_INPUT);
+    }
+
+    if (ctx->state == AEGIS_STATE_FINAL) {
+        SOLITON_RETURN(aegis_encrypt_update, ctx, len, SOLITON_INVALID_INPUT);
+    }
+
+    aegis_finish_aad(ctx);
+    ctx->state = AEGIS_STATE_UPDATE;
+    ctx->msg_len += len;
+
+    aegis_process(ctx, pt, ct, len, 0);
+
+    SOLITON_RETURN(aegis_encrypt_update, ctx, len, SOLITON_OK);
+}
+
+soliton_status soliton_aegis_encrypt_final(
+    soliton_aegis_ctx* ctx, uint8_t tag[SOLITON_AEGIS_TAG_BYTES]) {
+
+    SOLITON_PROBE_ENTRY(aegis_encrypt_final, ctx, 0);
+
+    if (!ctx || !tag) {
+        SOLITON_RETURN(aegis_encrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
+    }
+
+    if (ctx->state == AEGIS_STATE_FINAL) {
+        SOLITON_RETURN(aegis_encrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
+    }
+
+    aegis_tag(ctx, tag);
+
+    ctx->state = AEGIS_STATE_FINAL;
+    SOLITON_RETURN(aegis_encrypt_final, ctx, 0, SOLITON_OK);
+}
+
+soliton_status soliton_aegis_decrypt_update(
+    soliton_aegis_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len) {
+
+    SOLITON_PROBE_ENTRY(aegis_decrypt_update, ctx, len);
+
+    if (!ctx || (!ct && len > 0) || (!pt && len > 0)) {
+        SOLITON_RETURN(aegis_decrypt_update, ctx, len, SOLITON_INVALID_INPUT);
+    }
+
+    if (ctx->state == AEGIS_STATE_FINAL) {
+        SOLITON_RETURN(aegis_decrypt_update, ctx, len, SOLITON_INVALID_INPUT);
+    }
+
+    aegis_finish_aad(ctx);
+    ctx->state = AEGIS_STATE_UPDATE;
+    ctx->msg_len += len;
+
+    aegis_process(ctx, ct, pt, len, 1);
+
+    SOLITON_RETURN(aegis_decrypt_update, ctx, len, SOLITON_OK);
+}
+
+soliton_status soliton_aegis_decrypt_final(
+    soliton_aegis_ctx* ctx, const uint8_t tag[SOLITON_AEGIS_TAG_BYTES]) {
+
+    SOLITON_PROBE_ENTRY(aegis_decrypt_final, ctx, 0);
+
+    if (!ctx || !tag) {
+        SOLITON_RETURN(aegis_decrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
+    }
+
+    if (ctx->state == AEGIS_STATE_FINAL) {
+        SOLITON_RETURN(aegis_decrypt_final, ctx, 0, SOLITON_INVALID_INPUT);
+    }
+
+    uint8_t computed_tag[16];
+    aegis_tag(ctx, computed_tag);
+
+    /* Constant-time tag comparison */
+    int valid = ct_memcmp(computed_tag, tag, 16);
+
+    ctx->state = AEGIS_STATE_FINAL;
+
+    /* Wipe computed tag */
+    soliton_wipe(computed_tag, sizeof(computed_tag));
+
+    SOLITON_RETURN(aegis_decrypt_final, ctx, 0, valid == 0 ? SOLITON_OK : SOLITON_AUTH_FAIL);
+}
+
+void soliton_aegis_context_wipe(soliton_aegis_ctx* ctx) {
+    if (ctx) {
+        soliton_wipe(ctx, sizeof(*ctx));
+    }
+}
+
+soliton_status soliton_aegis_encrypt(
+    soliton_aegis_alg alg,
+    const uint8_t* key, const uint8_t* nonce,
+    const uint8_t* aad, size_t aad_len,
+    const uint8_t* pt, uint8_t* ct, size_t len,
+    uint8_t tag[SOLITON_AEGIS_TAG_BYTES]) {
+
+    SOLITON_PROBE_ENTRY(aegis_encrypt, 0, len);
+
+    soliton_aegis_ctx ctx;
+    soliton_status st = soliton_aegis_init(&ctx, alg, key, nonce);
+
+    if (st == SOLITON_OK) {
+        st = soliton_aegis_aad_update(&ctx, aad, aad_len);
+    }
+    if (st == SOLITON_OK) {
+        st = soliton_aegis_encrypt_update(&ctx, pt, ct, len);
+    }
+    if (st == SOLITON_OK) {
+        st = soliton_aegis_encrypt_final(&ctx, tag);
+    }
+
+    soliton_wipe(&ctx, sizeof(ctx));
+    SOLITON_RETURN(aegis_encrypt, 0, len, st);
+}
+
+soliton_status soliton_aegis_decrypt(
+    soliton_aegis_alg alg,
+    const uint8_t* key, const uint8_t* nonce,
+    const uint8_t* aad, size_t aad_len,
+    const uint8_t* ct, uint8_t* pt, size_t len,
+    const uint8_t tag[SOLITON_AEGIS_TAG_BYTES]) {
+
+    SOLITON_PROBE_ENTRY(aegis_decrypt, 0, len);
+
+    soliton_aegis_ctx ctx;
+    soliton_status st = soliton_aegis_init(&ctx, alg, key, nonce);
+
+    if (st == SOLITON_OK) {
+        st = soliton_aegis_aad_update(&ctx, aad, aad_len);
+    }
+    if (st == SOLITON_OK) {
+        st = soliton_aegis_decrypt_update(&ctx, ct, pt, len);
+    }
+    if (st == SOLITON_OK) {
+        st = soliton_aegis_decrypt_final(&ctx, tag);
+    }
+
+    /* Never release unauthenticated plaintext from the one-shot API */
+    if (st == SOLITON_AUTH_FAIL) {
+        soliton_wipe(pt, len);
+    }
+
+    soliton_wipe(&ctx, sizeof(ctx));
+    SOLITON_RETURN(aegis_decrypt, 0, len, st);
+}
+
+/* AES-256-XTS API implementation */
+soliton_status soliton_xts_init(
+    soliton_xts_ctx* ctx,
+    const uint8_t key[SOLITON_XTS_KEY_BYTES]) {
+
+    SOLITON_PROBE_ENTRY(xts_init, ctx, 0);
+
+    if (!ctx || !key) {
+        SOLITON_RETURN(xts_init, ctx, 0, SOLITON_INVALID_INPUT);
+    }
+
+    /* Key1 == Key2 collapses the tweak into the data key */
+    if (ct_memcmp(key, key + 32, 32) == 0) {
+        SOLITON_RETURN(xts_init, ctx, 0, SOLITON_INVALID_INPUT);
+    }
+
+    const soliton_xts_backend_t* backend = soliton_get_xts_backend();
+
+    backend->key_expand(key, ctx->enc_keys);
+    backend->key_expand_dec(ctx->enc_keys, ctx->dec_keys);
+    backend->key_expand(key + 32, ctx->tweak_keys);
+    ctx->backend = backend;
+
+    SOLITON_RETURN(xts_init, ctx, 0, SOLITON_OK);
+}
+
+/*
+ * One data unit under an already-encrypted tweak t (clobbered).
+ * A partial last block steals the tail of the previous ciphertext block
+ * (IEEE 1619 5.3.2); the stolen blocks go through local buffers so that
+ * in == out works.
+ */
+static void xts_crypt_unit(const soliton_xts_ctx* ctx, uint8_t t[16],
+                           const uint8_t* in, uint8_t* out, size_t len, int decrypt) {
+    const soliton_xts_backend_t* backend = ctx->backend;
+    size_t blocks = len / 16;
+    size_t r = len % 16;
+
+    if (r == 0) {
+        if (decrypt) {
+            backend->decrypt_blocks(ctx->dec_keys, t, in, out, blocks);
+        } else {
+            backend->encrypt_blocks(ctx->enc_keys, t, in, out, blocks);
+        }
+        return;
+    }
+
+    const size_t last = (blocks - 1) * 16;
+    uint8_t pp[16], cc[16];
+
+    if (!decrypt) {
+        backend->encrypt_blocks(ctx->enc_keys, t, in, out, blocks);
+
+        /* t is now T_m: re-encrypt tail || stolen bytes into block m-1 */
+        for (size_t i = 0; i < 16; i++) {
+            cc[i] = out[last + i];
+        }
+        for (size_t i = 0; i < r; i++) {
+            pp[i] = in[blocks * 16 + i];
+        }
+        for (size_t i = r; i < 16; i++) {
+            pp[i] = cc[i];
+        }
+        for (size_t i = 0; i < r; i++) {
+            out[blocks * 16 + i] = cc[i];
+        }
+        backend->encrypt_blocks(ctx->enc_keys, t, pp, out + last, 1);
+    } else {
+        uint8_t t_prev[16];
+
+        backend->decrypt_blocks(ctx->dec_keys, t, in, out, blocks - 1);
+
+        /* Block m-1 was encrypted under T_m, the stolen block under T_{m-1} */
+        for (size_t i = 0; i < 16; i++) {
+            t_prev[i] = t[i];
+        }
+        soliton_xts_mul_alpha(t);
+        backend->decrypt_blocks(ctx->dec_keys, t, in + last, pp, 1);
+
+        for (size_t i = 0; i < r; i++) {
+            cc[i] = in[blocks * 16 + i];
+        }
+        for (size_t i = r; i < 16; i++) {
+            cc[i] = pp[i];
+        }
+        for (size_t i = 0; i < r; i++) {
+            out[blocks * 16 + i] = pp[i];
+        }
+        backend->decrypt_blocks(ctx->dec_keys, t_prev, cc, out + last, 1);
+
+        soliton_wipe(t_prev, sizeof(t_prev));
+    }
+
+    soliton_wipe(pp, sizeof(pp));
+    soliton_wipe(cc, sizeof(cc));
+}
+
+static soliton_status xts_crypt(const soliton_xts_ctx* ctx, const uint8_t tweak[16],
+                                const uint8_t* in, uint8_t* out, size_t len, int decrypt) {
+    if (!ctx || !ctx->backend || !tweak || !in || !out) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    if (len < 16 || len > SOLITON_XTS_MAX_BYTES) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    uint8_t t[16];
+    ctx->backend->encrypt_block(ctx->tweak_keys, tweak, t);
+    xts_crypt_unit(ctx, t, in, out, len, decrypt);
+    soliton_wipe(t, sizeof(t));
+
+    return SOLITON_OK;
+}
+
+soliton_status soliton_xts_encrypt(
+    const soliton_xts_ctx* ctx,
+    const uint8_t tweak[SOLITON_XTS_TWEAK_BYTES],
+    const uint8_t* pt, uint8_t* ct, size_t len) {
+    SOLITON_PROBE_ENTRY(xts_encrypt, ctx, len);
+    SOLITON_RETURN(xts_encrypt, ctx, len, xts_crypt(ctx, tweak, pt, ct, len, 0));
+}
+
+soliton_status soliton_xts_decrypt(
+    const soliton_xts_ctx* ctx,
+    const uint8_t tweak[SOLITON_XTS_TWEAK_BYTES],
+    const uint8_t* ct, uint8_t* pt, size_t len) {
+    SOLITON_PROBE_ENTRY(xts_decrypt, ctx, len);
+    SOLITON_RETURN(xts_decrypt, ctx, len, xts_crypt(ctx, tweak, ct, pt, len, 1));
+}
+
+/* Sector tweaks encrypted per pass of the block kernel */
+#define XTS_SECTOR_BATCH 16
+
+/*
+ * Multi-sector batch. With an all-zero tweak the XTS block kernel is plain
+ * ECB (0 * alpha stays 0), so the sector numbers of a batch are encrypted
+ * under Key2 in one wide kernel call instead of one block at a time.
+ */
+static soliton_status xts_crypt_sectors(const soliton_xts_ctx* ctx,
+                                        uint64_t first_sector, size_t sector_size,
+                                        const uint8_t* in, uint8_t* out,
+                                        size_t count, int decrypt) {
+    if (!ctx || !ctx->backend || (count > 0 && (!in || !out))) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    if (sector_size < 16 || sector_size > SOLITON_XTS_MAX_BYTES) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    if (count > SIZE_MAX / sector_size) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    uint8_t tweaks[XTS_SECTOR_BATCH * 16];
+    uint8_t zero[16];
+    uint64_t sector = first_sector;
+
+    while (count > 0) {
+        size_t n = count < XTS_SECTOR_BATCH ? count : XTS_SECTOR_BATCH;
+
+        /* Little-endian 128-bit data unit sequence numbers */
+        for (size_t s = 0; s < n; s++) {
+            soliton_put_le64(tweaks + s * 16, sector + s);
+            soliton_put_le64(tweaks + s * 16 + 8, 0);
+        }
+        for (size_t i = 0; i < 16; i++) {
+            zero[i] = 0;
+        }
+        ctx->backend->encrypt_blocks(ctx->tweak_keys, zero, tweaks, tweaks, n);
+
+        for (size_t s = 0; s < n; s++) {
+            xts_crypt_unit(ctx, tweaks + s * 16, in, out, sector_size, decrypt);
+            in += sector_size;
+            out += sector_size;
+        }
+
+        sector += n;
+        count -= n;
+    }
+
+    soliton_wipe(tweaks, sizeof(tweaks));
+    return SOLITON_OK;
+}
+
+soliton_status soliton_xts_encrypt_sectors(
+    const soliton_xts_ctx* ctx,
+    uint64_t first_sector, size_t sector_size,
+    const uint8_t* pt, uint8_t* ct, size_t count) {
+    SOLITON_PROBE_ENTRY(xts_encrypt_sectors, ctx, count);
+    SOLITON_RETURN(xts_encrypt_sectors, ctx, count, xts_crypt_sectors(ctx, first_sector, sector_size, pt, ct, count, 0));
+}
+
+soliton_status soliton_xts_decrypt_sectors(
+    const soliton_xts_ctx* ctx,
+    uint64_t first_sector, size_t sector_size,
+    const uint8_t* ct, uint8_t* pt, size_t count) {
+    SOLITON_PROBE_ENTRY(xts_decrypt_sectors, ctx, count);
+    SOLITON_RETURN(xts_decrypt_sectors, ctx, count, xts_crypt_sectors(ctx, first_sector, sector_size, ct, pt, count, 1));
+}
+
+void soliton_xts_context_wipe(soliton_xts_ctx* ctx) {
+    if (ctx) {
+        soliton_wipe(ctx, sizeof(*ctx));
+    }
+}
+
+/* Batch API stubs */
+soliton_status soliton_batch_init(soliton_batch_ctx* bctx) {
+    (void)bctx;
     return SOLITON_UNSUPPORTED;
 }
 
@@ -1069,11 +2970,13 @@ soliton_status soliton_aesgcm_batch_update(
     soliton_aesgcm_ctx** ctxs,
     soliton_span* spans,
     size_t N) {
+    SOLITON_PROBE_ENTRY(aesgcm_batch_update, ctxs, N);
+
     (void)bctx;
     (void)ctxs;
     (void)spans;
     (void)N;
-    return SOLITON_UNSUPPORTED;
+    SOLITON_RETURN(aesgcm_batch_update, ctxs, N, SOLITON_UNSUPPORTED);
 }
 
 soliton_status soliton_chacha_batch_update(
@@ -1081,11 +2984,84 @@ soliton_status soliton_chacha_batch_update(
     soliton_chacha_ctx** ctxs,
     soliton_span* spans,
     size_t N) {
+    SOLITON_PROBE_ENTRY(chacha_batch_update, ctxs, N);
+
     (void)bctx;
     (void)ctxs;
     (void)spans;
     (void)N;
-    return SOLITON_UNSUPPORTED;
+    SOLITON_RETURN(chacha_batch_update, ctxs, N, SOLITON_UNSUPPORTED);
+}
+
+soliton_status soliton_aegis_batch_update(
+    soliton_batch_ctx* bctx,
+    soliton_aegis_ctx** ctxs,
+    soliton_span* spans,
+    size_t N) {
+    SOLITON_PROBE_ENTRY(aegis_batch_update, ctxs, N);
+
+    (void)bctx;
+
+    if (!ctxs || !spans || N > SOLITON_MAX_BATCH_SIZE) {
+        SOLITON_RETURN(aegis_batch_update, ctxs, N, SOLITON_INVALID_INPUT);
+    }
+
+    /* Validate every stream first so a bad entry leaves all streams untouched */
+    for (size_t i = 0; i < N; i++) {
+        if (!ctxs[i] || ctxs[i]->state == AEGIS_STATE_FINAL ||
+            ((!spans[i].in || !spans[i].out) && spans[i].len > 0)) {
+            SOLITON_RETURN(aegis_batch_update, ctxs, N, SOLITON_INVALID_INPUT);
+        }
+    }
+
+    size_t i = 0;
+    while (i < N) {
+        soliton_aegis_ctx* a = ctxs[i];
+
+        if (i + 1 < N) {
+            soliton_aegis_ctx* b = ctxs[i + 1];
+            void (*x2)(uint8_t*, uint8_t*, const uint8_t*, uint8_t*,
+                       const uint8_t*, uint8_t*, size_t) =
+                (a->alg == SOLITON_AEGIS_128L) ? a->backend->aegis128l_encrypt_x2
+                                               : a->backend->aegis256_encrypt_x2;
+
+            if (x2 && b != a && b->alg == a->alg && b->backend == a->backend) {
+                aegis_finish_aad(a);
+                aegis_finish_aad(b);
+
+                /* Lane-pair only block-aligned streams; a pending partial
+                 * block would misalign the shared keystream schedule */
+                if (a->buffer_len == 0 && b->buffer_len == 0) {
+                    size_t rate = a->rate;
+                    size_t blocks = soliton_min(spans[i].len, spans[i + 1].len) / rate;
+                    size_t done = blocks * rate;
+
+                    a->state = AEGIS_STATE_UPDATE;
+                    b->state = AEGIS_STATE_UPDATE;
+
+                    if (blocks > 0) {
+                        x2(&a->s[0][0], &b->s[0][0],
+                           spans[i].in, spans[i].out,
+                           spans[i + 1].in, spans[i + 1].out, blocks);
+                        a->msg_len += done;
+                        b->msg_len += done;
+                    }
+
+                    soliton_aegis_encrypt_update(a, spans[i].in + done, spans[i].out + done,
+                                                 spans[i].len - done);
+                    soliton_aegis_encrypt_update(b, spans[i + 1].in + done, spans[i + 1].out + done,
+                                                 spans[i + 1].len - done);
+                    i += 2;
+                    continue;
+                }
+            }
+        }
+
+        soliton_aegis_encrypt_update(a, spans[i].in, spans[i].out, spans[i].len);
+        i++;
+    }
+
+    SOLITON_RETURN(aegis_batch_update, ctxs, N, SOLITON_OK);
 }
 
 void soliton_batch_context_wipe(soliton_batch_ctx* bctx) {
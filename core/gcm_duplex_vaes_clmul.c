@@ -0,0 +1,185 @@
+/*
+ * gcm_duplex_vaes_clmul.c - Two-stream AES-GCM kernel (TX encrypt + RX decrypt)
+ *
+ * One connection's outbound encrypt and inbound decrypt advance together,
+ * 8 blocks of each per iteration, under independent keys, counters and
+ * GHASH states. The 16 AES blocks give VAES a wide independent batch, and
+ * one block of each GHASH fold is issued per AES round, so the CLMUL work
+ * of both streams hides under the AES latency instead of serialising on a
+ * single stream's reduction chain.
+ *
+ * RX hashes its input ciphertext in the same iteration that decrypts it.
+ * TX ciphertext only exists after the last AES round, so TX batch k is
+ * hashed during iteration k+1 and the final TX batch after the loop.
+ *
+ * Both folds are reduced together, TX in lane 0 and RX in lane 1 of one
+ * 256-bit two-multiply reduction (ghash_reduce.h).
+ *
+ * Domain contract as gcm_fused_vaes_clmul.c: Xi and H^i in CLMUL domain,
+ * ciphertext converted with to_lepoly_128() on ingress.
+ */
+
+#include "common.h"
+#include "ctr_engine.h"
+#include "diagnostics.h"
+#include "ghash_reduce.h"
+
+#if defined(__x86_64__) && defined(__VAES__) && defined(__PCLMUL__)
+
+#include <immintrin.h>
+
+static inline __m128i to_lepoly_128(__m128i x_spec) {
+    const __m128i bswap_mask = _mm_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
+    return _mm_shuffle_epi8(x_spec, bswap_mask);
+}
+
+/* Unreduced Karatsuba sums for one 8-block fold */
+typedef struct {
+    __m128i lo, hi, mid;
+} duplex_acc;
+
+/* Per-stream H^8..H^1 and their Karatsuba halves-XOR */
+typedef struct {
+    __m128i h[8];
+    __m128i hx[8];
+} duplex_hpow;
+
+static SOLITON_INLINE void duplex_hpow_load(duplex_hpow* p, const uint8_t (*h_powers)[16]) {
+    for (int i = 0; i < 8; i++) {
+        p->h[i] = _mm_loadu_si128((const __m128i*)h_powers[7 - i]);  /* h[0] = H^8 */
+        p->hx[i] = _mm_xor_si128(_mm_shuffle_epi32(p->h[i], 0x4E), p->h[i]);
+    }
+}
+
+/* acc += c * h (three CLMULs; mid terms are corrected once in duplex_reduce) */
+static SOLITON_INLINE void duplex_mul_acc(duplex_acc* a, __m128i c, __m128i h, __m128i hx) {
+    const __m128i cx = _mm_xor_si128(_mm_shuffle_epi32(c, 0x4E), c);
+    a->lo = _mm_xor_si128(a->lo, _mm_clmulepi64_si128(c, h, 0x00));
+    a->hi = _mm_xor_si128(a->hi, _mm_clmulepi64_si128(c, h, 0x11));
+    a->mid = _mm_xor_si128(a->mid, _mm_clmulepi64_si128(cx, hx, 0x00));
+}
+
+static SOLITON_INLINE __m128i duplex_reduce(duplex_acc a) {
+    return ghash_reduce_karatsuba(a.lo, a.mid, a.hi);
+}
+
+/* Both streams' folds at once: *xt from t (lane 0), *xr from r (lane 1) */
+static SOLITON_INLINE void duplex_reduce2(duplex_acc t, duplex_acc r, __m128i* xt, __m128i* xr) {
+#if defined(__VPCLMULQDQ__)
+    const __m256i lo = _mm256_set_m128i(r.lo, t.lo);
+    const __m256i hi = _mm256_set_m128i(r.hi, t.hi);
+    const __m256i mid = _mm256_xor_si256(_mm256_set_m128i(r.mid, t.mid), _mm256_xor_si256(lo, hi));
+    const __m256i x = ghash_reduce_clmul2_256(_mm256_xor_si256(lo, _mm256_bslli_epi128(mid, 8)),
+                                              _mm256_xor_si256(hi, _mm256_bsrli_epi128(mid, 8)));
+    *xt = _mm256_castsi256_si128(x);
+    *xr = _mm256_extracti128_si256(x, 1);
+#else
+    *xt = duplex_reduce(t);
+    *xr = duplex_reduce(r);
+#endif
+}
+
+void gcm_duplex_vaes_clmul(
+    const uint32_t* tx_keys, const uint8_t* tx_in, uint8_t* tx_out,
+    soliton_ctr_ymm* tx_ctr, uint8_t* tx_ghash, const uint8_t (*tx_h)[16],
+    const uint32_t* rx_keys, const uint8_t* rx_in, uint8_t* rx_out,
+    soliton_ctr_ymm* rx_ctr, uint8_t* rx_ghash, const uint8_t (*rx_h)[16],
+    size_t batches) {
+
+    DIAG_INC(aes_vaes_calls);
+    DIAG_ADD(aes_total_blocks, batches * 16);
+
+    __m256i tk[15], rk[15];
+    for (int i = 0; i < 15; i++) {
+        tk[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)tx_keys + i));
+        rk[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)rx_keys + i));
+    }
+
+    duplex_hpow th, rh;
+    duplex_hpow_load(&th, tx_h);
+    duplex_hpow_load(&rh, rx_h);
+
+    __m128i xt = _mm_loadu_si128((const __m128i*)tx_ghash);
+    __m128i xr = _mm_loadu_si128((const __m128i*)rx_ghash);
+    __m128i tprev[8];  /* Previous TX ciphertext batch, CLMUL domain */
+    int have_prev = 0;
+
+    for (size_t b = 0; b < batches; b++) {
+        __m256i t[4], r[4];
+        __m128i rc[8];
+        duplex_acc ta = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+        duplex_acc ra = ta;
+
+        soliton_ctr_ymm_next(tx_ctr, t, 4);
+        soliton_ctr_ymm_next(rx_ctr, r, 4);
+        for (int j = 0; j < 8; j++) {
+            rc[j] = to_lepoly_128(_mm_loadu_si128((const __m128i*)rx_in + j));
+        }
+        rc[0] = _mm_xor_si128(rc[0], xr);
+        if (have_prev) {
+            tprev[0] = _mm_xor_si128(tprev[0], xt);
+        }
+
+        for (int j = 0; j < 4; j++) {
+            t[j] = _mm256_xor_si256(t[j], tk[0]);
+            r[j] = _mm256_xor_si256(r[j], rk[0]);
+        }
+
+        /* Rounds 1..8 each carry one block of both folds */
+        for (int round = 1; round < 14; round++) {
+            for (int j = 0; j < 4; j++) {
+                t[j] = _mm256_aesenc_epi128(t[j], tk[round]);
+                r[j] = _mm256_aesenc_epi128(r[j], rk[round]);
+            }
+            if (round <= 8) {
+                const int j = round - 1;
+                duplex_mul_acc(&ra, rc[j], rh.h[j], rh.hx[j]);
+                if (have_prev) {
+                    duplex_mul_acc(&ta, tprev[j], th.h[j], th.hx[j]);
+                }
+            }
+        }
+
+        for (int j = 0; j < 4; j++) {
+            t[j] = _mm256_aesenclast_epi128(t[j], tk[14]);
+            r[j] = _mm256_aesenclast_epi128(r[j], rk[14]);
+        }
+
+        /* RX input is loaded above, so in-place per stream is safe */
+        for (int j = 0; j < 4; j++) {
+            const __m256i c = _mm256_xor_si256(t[j], _mm256_loadu_si256((const __m256i*)tx_in + j));
+            _mm256_storeu_si256((__m256i*)tx_out + j, c);
+            _mm256_storeu_si256((__m256i*)rx_out + j,
+                                _mm256_xor_si256(r[j], _mm256_loadu_si256((const __m256i*)rx_in + j)));
+            tprev[2 * j] = to_lepoly_128(_mm256_castsi256_si128(c));
+            tprev[2 * j + 1] = to_lepoly_128(_mm256_extracti128_si256(c, 1));
+        }
+
+        if (have_prev) {
+            duplex_reduce2(ta, ra, &xt, &xr);
+        } else {
+            xr = duplex_reduce(ra);
+        }
+        have_prev = 1;
+
+        tx_in += 128;
+        tx_out += 128;
+        rx_in += 128;
+        rx_out += 128;
+    }
+
+    /* Drain: last TX batch */
+    if (have_prev) {
+        duplex_acc ta = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+        tprev[0] = _mm_xor_si128(tprev[0], xt);
+        for (int j = 0; j < 8; j++) {
+            duplex_mul_acc(&ta, tprev[j], th.h[j], th.hx[j]);
+        }
+        xt = duplex_reduce(ta);
+    }
+
+    _mm_storeu_si128((__m128i*)tx_ghash, xt);
+    _mm_storeu_si128((__m128i*)rx_ghash, xr);
+}
+
+#endif /* __x86_64__ && __VAES__ && __PCLMUL__ */
@@ -7,7 +7,9 @@
  */
 
 #include "common.h"
+#include "ctr_engine.h"
 #include "diagnostics.h"
+#include "ghash_reduce.h"
 
 #if defined(__x86_64__) && defined(__VAES__) && defined(__PCLMUL__)
 
@@ -27,9 +29,8 @@ static inline __m128i from_lepoly_128(__m128i x_kernel) {
     return _mm_shuffle_epi8(x_kernel, bswap_mask);
 }
 
-/* Import unified primitives from ghash_clmul.c */
+/* Reference multiply by a twisted H power (ghash_clmul.c) */
 extern __m128i ghash_mul_lepoly_clmul(__m128i a_le, __m128i b_le);
-extern __m128i ghash_reduce_256_to_128_lepoly(__m128i lo, __m128i hi);
 
 /* External scalar AES helpers */
 extern void aes256_encrypt_block_scalar(const uint32_t* round_keys, const uint8_t in[16], uint8_t out[16]);
@@ -117,8 +118,7 @@ void gcm_fused_encrypt8_vaes_clmul(
     const uint32_t* restrict round_keys,      /* AES-256 expanded keys */
     const uint8_t* restrict plaintext,        /* 128 bytes (8 blocks) */
     uint8_t* restrict ciphertext,             /* 128 bytes output */
-    const uint8_t j0[16],                     /* Initial counter block */
-    uint32_t counter_start,                   /* Starting counter value */
+    soliton_ctr_ymm* restrict ctr,            /* Counter engine, advanced by 8 */
     uint8_t* restrict ghash_state,            /* 16 bytes GHASH accumulator */
     const uint8_t h_powers[8][16]             /* H^8...H^1 (64B aligned) */
 ) {
@@ -135,22 +135,9 @@ void gcm_fused_encrypt8_vaes_clmul(
         rk[i] = _mm256_broadcastsi128_si256(rk_xmm);
     }
 
-    /* Prepare 8 counter blocks */
-    __m128i ctr_base = _mm_loadu_si128((const __m128i*)j0);
-    __m128i counters[8];
-    for (int i = 0; i < 8; i++) {
-        counters[i] = ctr_base;
-        /* Set counter value (big-endian 32-bit at bytes 12-15) */
-        uint32_t ctr_val = counter_start + i;
-        counters[i] = _mm_insert_epi32(counters[i], __builtin_bswap32(ctr_val), 3);
-    }
-
-    /* Pack 8 counters into 4 YMM registers for VAES */
+    /* Next 8 counter blocks (2 per YMM) from the caller's engine */
     __m256i ctr_ymm[4];
-    ctr_ymm[0] = _mm256_setr_m128i(counters[0], counters[1]);
-    ctr_ymm[1] = _mm256_setr_m128i(counters[2], counters[3]);
-    ctr_ymm[2] = _mm256_setr_m128i(counters[4], counters[5]);
-    ctr_ymm[3] = _mm256_setr_m128i(counters[6], counters[7]);
+    soliton_ctr_ymm_next(ctr, ctr_ymm, 4);
 
     /* AES-256 encryption: 14 rounds (XOR + 13 AESENC + AESENCLAST) */
     /* Round 0: AddRoundKey */
@@ -379,8 +366,8 @@ void gcm_fused_encrypt8_vaes_clmul(
     lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
     hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
 
-    /* Single polynomial reduction using unified reducer (result remains in CLMUL domain) */
-    Xi = ghash_reduce_256_to_128_lepoly(lo, hi);
+    /* Single two-multiply reduction (result remains in CLMUL domain) */
+    Xi = ghash_reduce_clmul2(lo, hi);
 
     #ifdef FUSED_DEBUG_REF
     printf("HOT PATH result:\n");
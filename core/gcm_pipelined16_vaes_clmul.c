@@ -8,40 +8,19 @@
  */
 
 #include "common.h"
+#include "ctr_engine.h"
+#include "ghash_reduce.h"
 
 #ifdef __x86_64__
 
 #include <immintrin.h>
 
-/* Helper: GF(2^128) reduction (extracted for reuse) */
-static inline __m128i ghash_reduce(__m128i lo, __m128i mid, __m128i hi) {
-    /* Combine middle terms */
-    __m128i tmp_lo = _mm_slli_si128(mid, 8);
-    __m128i tmp_hi = _mm_srli_si128(mid, 8);
-    lo = _mm_xor_si128(lo, tmp_lo);
-    hi = _mm_xor_si128(hi, tmp_hi);
-
-    /* GF(2^128) reduction polynomial: x^128 + x^7 + x^2 + x + 1 */
-    __m128i poly = _mm_setr_epi32(1, 0, 0, 0xC2000000);
-
-    __m128i tmp1 = _mm_clmulepi64_si128(lo, poly, 0x10);
-    __m128i tmp2 = _mm_shuffle_epi32(lo, 0x4E);
-    __m128i tmp3 = _mm_xor_si128(tmp2, tmp1);
-
-    __m128i tmp4 = _mm_clmulepi64_si128(tmp3, poly, 0x10);
-    __m128i tmp5 = _mm_shuffle_epi32(tmp3, 0x4E);
-    __m128i tmp6 = _mm_xor_si128(tmp5, tmp4);
-
-    return _mm_xor_si128(tmp6, hi);
-}
-
 /* Phase-locked 16-block encrypt with AABB rhythm */
 void gcm_pipelined_encrypt16_vaes_clmul(
     const uint32_t round_keys[60],
     const uint8_t pt[256],
     uint8_t ct[256],
-    const uint8_t j0[16],
-    uint32_t counter_start,
+    soliton_ctr_ymm* ctr,           /* Counter engine, advanced by 16 */
     uint8_t ghash_state[16],
     const uint8_t (*h_powers)[16]
 ) {
@@ -52,37 +31,26 @@ void gcm_pipelined_encrypt16_vaes_clmul(
         rk[r] = _mm256_broadcastsi128_si256(rk_lo);
     }
 
-    /* Prepare counter blocks */
+    /* Next 16 counter blocks (8 ymm registers x 2 blocks) */
     __m256i ctrs[8];
-    uint32_t j0_prefix[3];
-    for (int i = 0; i < 3; i++) {
-        j0_prefix[i] = ((uint32_t)j0[i*4] << 24) |
-                       ((uint32_t)j0[i*4+1] << 16) |
-                       ((uint32_t)j0[i*4+2] << 8) |
-                       ((uint32_t)j0[i*4+3]);
-    }
+    soliton_ctr_ymm_next(ctr, ctrs, 8);
 
-    for (int i = 0; i < 8; i++) {
-        uint32_t ctr1 = __builtin_bswap32(counter_start + i*2);
-        uint32_t ctr2 = __builtin_bswap32(counter_start + i*2 + 1);
-
-        __m128i ctr_lo = _mm_set_epi32((int)ctr1, (int)j0_prefix[2], (int)j0_prefix[1], (int)j0_prefix[0]);
-        __m128i ctr_hi = _mm_set_epi32((int)ctr2, (int)j0_prefix[2], (int)j0_prefix[1], (int)j0_prefix[0]);
+    /* ========== PHASE-LOCKED WAVE: AABB rhythm ========== */
 
-        ctrs[i] = _mm256_setr_m128i(ctr_lo, ctr_hi);
+    /* Round 0 (whitening) for all 16 blocks */
+    for (int i = 0; i < 8; i++) {
+        ctrs[i] = _mm256_xor_si256(ctrs[i], rk[0]);
     }
 
-    /* ========== PHASE-LOCKED WAVE: AABB rhythm ========== */
-
-    /* A1: AES rounds 0-13 for blocks 0-7 */
-    for (int r = 0; r < 14; r++) {
+    /* A1: AES rounds 1-13 for blocks 0-7 */
+    for (int r = 1; r < 14; r++) {
         for (int i = 0; i < 4; i++) {
             ctrs[i] = _mm256_aesenc_epi128(ctrs[i], rk[r]);
         }
     }
 
-    /* A2: AES rounds 0-13 for blocks 8-15 (interleaved start) */
-    for (int r = 0; r < 14; r++) {
+    /* A2: AES rounds 1-13 for blocks 8-15 (interleaved start) */
+    for (int r = 1; r < 14; r++) {
         for (int i = 4; i < 8; i++) {
             ctrs[i] = _mm256_aesenc_epi128(ctrs[i], rk[r]);
         }
@@ -94,16 +62,20 @@ void gcm_pipelined_encrypt16_vaes_clmul(
     }
 
     /* XOR with plaintext and store ciphertext */
+    const __m128i bswap = _mm_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
     __m128i C[16];
     for (int i = 0; i < 8; i++) {
         __m256i pt_blocks = _mm256_loadu_si256((const __m256i*)&pt[i * 32]);
         __m256i ct_blocks = _mm256_xor_si256(ctrs[i], pt_blocks);
         _mm256_storeu_si256((__m256i*)&ct[i * 32], ct_blocks);
 
-        C[i*2] = _mm256_castsi256_si128(ct_blocks);
-        C[i*2+1] = _mm256_extracti128_si256(ct_blocks, 1);
+        C[i*2] = _mm_shuffle_epi8(_mm256_castsi256_si128(ct_blocks), bswap);
+        C[i*2+1] = _mm_shuffle_epi8(_mm256_extracti128_si256(ct_blocks, 1), bswap);
     }
 
+    /* Xi folds into the first block (CLMUL domain) */
+    C[0] = _mm_xor_si128(C[0], _mm_loadu_si128((const __m128i*)ghash_state));
+
     /* B1: GHASH Karatsuba multiply for blocks 0-7 */
     __m128i H[16];
     for (int i = 0; i < 16; i++) {
@@ -167,13 +139,10 @@ void gcm_pipelined_encrypt16_vaes_clmul(
     __m128i final_hi = _mm_xor_si128(acc_hi[0], acc_hi[1]);
     __m128i final_mid = _mm_xor_si128(acc_mid[0], acc_mid[1]);
 
-    /* Final GF(2^128) reduction */
-    __m128i result = ghash_reduce(final_lo, final_mid, final_hi);
-
-    /* XOR with previous GHASH state and store */
-    __m128i state = _mm_loadu_si128((const __m128i*)ghash_state);
-    result = _mm_xor_si128(result, state);
-    _mm_storeu_si128((__m128i*)ghash_state, result);
+    /* Combine Karatsuba halves, then the two-multiply reduction */
+    final_lo = _mm_xor_si128(final_lo, _mm_slli_si128(final_mid, 8));
+    final_hi = _mm_xor_si128(final_hi, _mm_srli_si128(final_mid, 8));
+    _mm_storeu_si128((__m128i*)ghash_state, ghash_reduce_clmul2(final_lo, final_hi));
 }
 
 #endif /* __x86_64__ */
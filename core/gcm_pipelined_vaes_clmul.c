@@ -7,7 +7,9 @@
  */
 
 #include "common.h"
+#include "ctr_engine.h"
 #include "diagnostics.h"
+#include "ghash_reduce.h"
 
 #if defined(__x86_64__) && defined(__VAES__) && defined(__PCLMUL__)
 
@@ -15,38 +17,10 @@
 
 /* Byte reversal for GHASH */
 static inline __m128i ghash_reverse(__m128i x) {
-    const __m128i brev = _mm_set_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
+    const __m128i brev = _mm_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
     return _mm_shuffle_epi8(x, brev);
 }
 
-/* GHASH reduction */
-static inline __m128i ghash_reduce(__m128i x0, __m128i x1, __m128i x2) {
-    /* Phase 1 */
-    __m128i t1 = _mm_slli_epi32(x0, 31);
-    __m128i t2 = _mm_slli_epi32(x0, 30);
-    __m128i t3 = _mm_slli_epi32(x0, 25);
-    t1 = _mm_xor_si128(t1, t2);
-    t1 = _mm_xor_si128(t1, t3);
-    __m128i t4 = _mm_srli_epi32(t1, 32);
-    t1 = _mm_shuffle_epi32(t1, 0x93);
-    __m128i t5 = _mm_xor_si128(x0, t1);
-    x1 = _mm_xor_si128(x1, t4);
-
-    /* Phase 2 */
-    __m128i t6 = _mm_srli_epi32(x1, 1);
-    __m128i t7 = _mm_srli_epi32(x1, 2);
-    __m128i t8 = _mm_srli_epi32(x1, 7);
-    t6 = _mm_xor_si128(t6, t7);
-    t6 = _mm_xor_si128(t6, t8);
-    t6 = _mm_xor_si128(t6, x1);
-    __m128i t9 = _mm_slli_epi32(t6, 32);
-    t6 = _mm_shuffle_epi32(t6, 0x4E);
-    x1 = _mm_xor_si128(x1, t9);
-    x2 = _mm_xor_si128(x2, t6);
-
-    return _mm_xor_si128(t5, x2);
-}
-
 /*
  * Phase-locked 16-block GCM pipeline
  *
@@ -65,8 +39,7 @@ void gcm_pipelined_encrypt16_vaes_clmul(
     const uint32_t* restrict round_keys,
     const uint8_t* restrict plaintext,        /* 256 bytes (16 blocks) */
     uint8_t* restrict ciphertext,
-    const uint8_t j0[16],
-    uint32_t counter_start,
+    soliton_ctr_ymm* restrict ctr,            /* Counter engine, advanced by 16 */
     uint8_t* restrict ghash_state,
     const uint8_t h_powers[8][16]             /* H^8..H^1 (already reversed) */
 ) {
@@ -88,29 +61,16 @@ void gcm_pipelined_encrypt16_vaes_clmul(
         H[i] = _mm_loadu_si128((const __m128i*)h_powers[7 - i]);
     }
 
-    /* Load GHASH state */
+    /* Load GHASH state (CLMUL domain, as stored) */
     __m128i Xi = _mm_loadu_si128((const __m128i*)ghash_state);
-    Xi = ghash_reverse(Xi);
 
     /* ====================================================================
      * BATCH 0: Full AES-CTR (no overlap yet - first batch)
      * ==================================================================== */
 
-    /* Prepare counters for batch 0 */
-    __m128i ctr_base = _mm_loadu_si128((const __m128i*)j0);
-    __m128i counters0[8];
-    for (int i = 0; i < 8; i++) {
-        counters0[i] = ctr_base;
-        uint32_t ctr_val = counter_start + i;
-        counters0[i] = _mm_insert_epi32(counters0[i], __builtin_bswap32(ctr_val), 3);
-    }
-
-    /* Pack into YMM */
+    /* Counters for batch 0 */
     __m256i ctr0_ymm[4];
-    ctr0_ymm[0] = _mm256_setr_m128i(counters0[0], counters0[1]);
-    ctr0_ymm[1] = _mm256_setr_m128i(counters0[2], counters0[3]);
-    ctr0_ymm[2] = _mm256_setr_m128i(counters0[4], counters0[5]);
-    ctr0_ymm[3] = _mm256_setr_m128i(counters0[6], counters0[7]);
+    soliton_ctr_ymm_next(ctr, ctr0_ymm, 4);
 
     /* AES rounds for batch 0 (fully unrolled) */
     ctr0_ymm[0] = _mm256_xor_si256(ctr0_ymm[0], rk[0]);
@@ -168,19 +128,9 @@ void gcm_pipelined_encrypt16_vaes_clmul(
      * BATCH 1: START AES-CTR (Phase A begins)
      * ==================================================================== */
 
-    /* Prepare counters for batch 1 */
-    __m128i counters1[8];
-    for (int i = 0; i < 8; i++) {
-        counters1[i] = ctr_base;
-        uint32_t ctr_val = counter_start + 8 + i;
-        counters1[i] = _mm_insert_epi32(counters1[i], __builtin_bswap32(ctr_val), 3);
-    }
-
+    /* Counters for batch 1 */
     __m256i ctr1_ymm[4];
-    ctr1_ymm[0] = _mm256_setr_m128i(counters1[0], counters1[1]);
-    ctr1_ymm[1] = _mm256_setr_m128i(counters1[2], counters1[3]);
-    ctr1_ymm[2] = _mm256_setr_m128i(counters1[4], counters1[5]);
-    ctr1_ymm[3] = _mm256_setr_m128i(counters1[6], counters1[7]);
+    soliton_ctr_ymm_next(ctr, ctr1_ymm, 4);
 
     /* Start AES for batch 1 (rounds 0-7) */
     ctr1_ymm[0] = _mm256_xor_si256(ctr1_ymm[0], rk[0]);
@@ -367,7 +317,7 @@ void gcm_pipelined_encrypt16_vaes_clmul(
     hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
 
     /* Reduce */
-    Xi = ghash_reduce(lo, _mm_setzero_si128(), hi);
+    Xi = ghash_reduce_clmul2(lo, hi);
 
     /* Final AES round for batch 1 */
     ctr1_ymm[0] = _mm256_aesenclast_epi128(ctr1_ymm[0], rk[14]);
@@ -437,7 +387,7 @@ void gcm_pipelined_encrypt16_vaes_clmul(
 
     lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
     hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
-    Xi = ghash_reduce(lo, _mm_setzero_si128(), hi);
+    Xi = ghash_reduce_clmul2(lo, hi);
 
     /* ====================================================================
      * STORE ciphertext (ONCE, after all GHASH consumption)
@@ -466,7 +416,6 @@ void gcm_pipelined_encrypt16_vaes_clmul(
     }
 
     /* Store updated GHASH state */
-    Xi = ghash_reverse(Xi);
     _mm_storeu_si128((__m128i*)ghash_state, Xi);
 
     #undef AES_ROUND
@@ -0,0 +1,350 @@
+/*
+ * gcm_resident_vaes_clmul.c - Whole-span AES-GCM kernels (VAES + CLMUL)
+ *
+ * gcm_fused_encrypt8_vaes_clmul is called once per 128-byte batch, and every
+ * call re-broadcasts the 15 round keys, reloads H^8..H^1, and loads/stores
+ * Xi through memory. These kernels take all full batches of an update in
+ * one call: round keys, H-powers (with their Karatsuba halves-XOR), the
+ * counter vector and Xi are set up once and carried across batches.
+ *
+ * Software pipelining across batch boundaries:
+ *   encrypt - batch k's ciphertext is hashed during batch k+1's AES rounds
+ *             (one block per round), the last batch after the loop
+ *   decrypt - the input ciphertext is hashed during its own AES rounds
+ * The Xi-dependent block is multiplied last (round 8), so the previous
+ * reduction has seven AES rounds to complete.
+ *
+ * Same fold and reduction as gcm_fused_vaes_clmul.c, so results are
+ * bit-identical to per-batch calls. Domain contract as that file: Xi and
+ * H^i in CLMUL domain, ciphertext converted with to_lepoly_128() on ingress.
+ *
+ * The _crc variants also run CRC32C over the plaintext and/or ciphertext
+ * (SOLITON_CRC_* bits) with the crc32 instruction, which issues on a port
+ * the AES rounds and CLMULs leave idle. Two qwords per stream in rounds
+ * 1..8, on the same lag as GHASH: the stream not known until aesenclast
+ * (ciphertext on encrypt, plaintext on decrypt) is summed from memory
+ * during the next batch. crc[] holds raw register state (pt, ct).
+ */
+
+#include "common.h"
+#include "ctr_engine.h"
+#include "diagnostics.h"
+#include "ghash_reduce.h"
+#include "crc32c.h"
+
+#if defined(__x86_64__) && defined(__VAES__) && defined(__PCLMUL__)
+
+#include <immintrin.h>
+#include <nmmintrin.h>
+
+static inline __m128i to_lepoly_128(__m128i x_spec) {
+    const __m128i bswap_mask = _mm_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
+    return _mm_shuffle_epi8(x_spec, bswap_mask);
+}
+
+/* Unreduced Karatsuba sums for one 8-block fold */
+typedef struct {
+    __m128i lo, hi, mid;
+} resident_acc;
+
+/* H^8..H^1 and their Karatsuba halves-XOR, built once per call */
+typedef struct {
+    __m128i h[8];
+    __m128i hx[8];
+} resident_hpow;
+
+static SOLITON_INLINE void resident_hpow_load(resident_hpow* p, const uint8_t (*h_powers)[16]) {
+    for (int i = 0; i < 8; i++) {
+        p->h[i] = _mm_loadu_si128((const __m128i*)h_powers[7 - i]);  /* h[0] = H^8 */
+        p->hx[i] = _mm_xor_si128(_mm_shuffle_epi32(p->h[i], 0x4E), p->h[i]);
+    }
+}
+
+static SOLITON_INLINE void resident_mul_acc(resident_acc* a, __m128i c, __m128i h, __m128i hx) {
+    const __m128i cx = _mm_xor_si128(_mm_shuffle_epi32(c, 0x4E), c);
+    a->lo = _mm_xor_si128(a->lo, _mm_clmulepi64_si128(c, h, 0x00));
+    a->hi = _mm_xor_si128(a->hi, _mm_clmulepi64_si128(c, h, 0x11));
+    a->mid = _mm_xor_si128(a->mid, _mm_clmulepi64_si128(cx, hx, 0x00));
+}
+
+static SOLITON_INLINE __m128i resident_reduce(resident_acc a) {
+    return ghash_reduce_karatsuba(a.lo, a.mid, a.hi);
+}
+
+/* Block j of the fold in AES round j (1..7); block 0 carries Xi, so round 8 */
+static SOLITON_INLINE void resident_fold_step(resident_acc* a, const __m128i c[8], __m128i xi,
+                                              const resident_hpow* hp, int round) {
+    if (round < 8) {
+        resident_mul_acc(a, c[round], hp->h[round], hp->hx[round]);
+    } else if (round == 8) {
+        resident_mul_acc(a, _mm_xor_si128(c[0], xi), hp->h[0], hp->hx[0]);
+    }
+}
+
+/* CRC32C of bytes 16*(round-1)..16*round-1 of a 128-byte batch (rounds 1..8) */
+static SOLITON_INLINE uint32_t resident_crc_step(uint32_t c, const uint8_t* batch, int round) {
+    if (round <= 8) {
+        const uint8_t* p = batch + 16 * (round - 1);
+        c = (uint32_t)_mm_crc32_u64(c, soliton_le64(p));
+        c = (uint32_t)_mm_crc32_u64(c, soliton_le64(p + 8));
+    }
+    return c;
+}
+
+static SOLITON_INLINE void resident_load_keys(__m256i rk[15], const uint32_t* round_keys) {
+    for (int i = 0; i < 15; i++) {
+        rk[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)round_keys + i));
+    }
+}
+
+/* which: SOLITON_CRC_* streams to sum into crc[] (constant per caller) */
+static SOLITON_INLINE void resident_encrypt(
+    const uint32_t* round_keys, const uint8_t* pt, uint8_t* ct,
+    soliton_ctr_ymm* ctr, uint8_t* ghash_state, const uint8_t (*h_powers)[16],
+    size_t batches, uint32_t crc[2], const unsigned which) {
+
+    DIAG_INC(aes_vaes_calls);
+    DIAG_ADD(aes_total_blocks, batches * 8);
+    DIAG_ADD(batch_8block_hits, batches);
+    DIAG_ADD(total_blocks_processed, batches * 8);
+
+    __m256i rk[15];
+    resident_load_keys(rk, round_keys);
+
+    resident_hpow hp;
+    resident_hpow_load(&hp, h_powers);
+
+    __m128i xi = _mm_loadu_si128((const __m128i*)ghash_state);
+    __m128i prev[8];  /* Previous ciphertext batch, CLMUL domain */
+    for (int j = 0; j < 8; j++) {
+        prev[j] = _mm_setzero_si128();
+    }
+    uint32_t crc_pt = (which & SOLITON_CRC_PLAINTEXT) ? crc[0] : 0;
+    uint32_t crc_ct = (which & SOLITON_CRC_CIPHERTEXT) ? crc[1] : 0;
+
+    for (size_t b = 0; b < batches; b++) {
+        __m256i s[4];
+        resident_acc acc = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+        soliton_ctr_ymm_next(ctr, s, 4);
+        for (int j = 0; j < 4; j++) {
+            s[j] = _mm256_xor_si256(s[j], rk[0]);
+        }
+
+        for (int round = 1; round < 14; round++) {
+            for (int j = 0; j < 4; j++) {
+                s[j] = _mm256_aesenc_epi128(s[j], rk[round]);
+            }
+            if (b > 0) {
+                resident_fold_step(&acc, prev, xi, &hp, round);
+            }
+            if (which & SOLITON_CRC_PLAINTEXT) {
+                crc_pt = resident_crc_step(crc_pt, pt, round);
+            }
+            if ((which & SOLITON_CRC_CIPHERTEXT) && b > 0) {
+                crc_ct = resident_crc_step(crc_ct, ct - 128, round);
+            }
+        }
+
+        for (int j = 0; j < 4; j++) {
+            s[j] = _mm256_aesenclast_epi128(s[j], rk[14]);
+            const __m256i c = _mm256_xor_si256(s[j], _mm256_loadu_si256((const __m256i*)pt + j));
+            _mm256_storeu_si256((__m256i*)ct + j, c);
+            prev[2 * j] = to_lepoly_128(_mm256_castsi256_si128(c));
+            prev[2 * j + 1] = to_lepoly_128(_mm256_extracti128_si256(c, 1));
+        }
+
+        if (b > 0) {
+            xi = resident_reduce(acc);
+        }
+
+        pt += 128;
+        ct += 128;
+    }
+
+    /* Drain: last batch */
+    if (batches > 0) {
+        resident_acc acc = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+        for (int round = 1; round <= 8; round++) {
+            resident_fold_step(&acc, prev, xi, &hp, round);
+            if (which & SOLITON_CRC_CIPHERTEXT) {
+                crc_ct = resident_crc_step(crc_ct, ct - 128, round);
+            }
+        }
+        xi = resident_reduce(acc);
+    }
+
+    _mm_storeu_si128((__m128i*)ghash_state, xi);
+    if (which & SOLITON_CRC_PLAINTEXT) {
+        crc[0] = crc_pt;
+    }
+    if (which & SOLITON_CRC_CIPHERTEXT) {
+        crc[1] = crc_ct;
+    }
+}
+
+static SOLITON_INLINE void resident_decrypt(
+    const uint32_t* round_keys, const uint8_t* ct, uint8_t* pt,
+    soliton_ctr_ymm* ctr, uint8_t* ghash_state, const uint8_t (*h_powers)[16],
+    size_t batches, uint32_t crc[2], const unsigned which) {
+
+    DIAG_INC(aes_vaes_calls);
+    DIAG_ADD(aes_total_blocks, batches * 8);
+    DIAG_ADD(batch_8block_hits, batches);
+    DIAG_ADD(total_blocks_processed, batches * 8);
+
+    __m256i rk[15];
+    resident_load_keys(rk, round_keys);
+
+    resident_hpow hp;
+    resident_hpow_load(&hp, h_powers);
+
+    __m128i xi = _mm_loadu_si128((const __m128i*)ghash_state);
+    uint32_t crc_pt = (which & SOLITON_CRC_PLAINTEXT) ? crc[0] : 0;
+    uint32_t crc_ct = (which & SOLITON_CRC_CIPHERTEXT) ? crc[1] : 0;
+
+    for (size_t b = 0; b < batches; b++) {
+        __m256i s[4], in[4];
+        __m128i c[8];
+        resident_acc acc = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+        /* Input loaded before any store, so in-place is safe */
+        for (int j = 0; j < 4; j++) {
+            in[j] = _mm256_loadu_si256((const __m256i*)ct + j);
+            c[2 * j] = to_lepoly_128(_mm256_castsi256_si128(in[j]));
+            c[2 * j + 1] = to_lepoly_128(_mm256_extracti128_si256(in[j], 1));
+        }
+
+        soliton_ctr_ymm_next(ctr, s, 4);
+        for (int j = 0; j < 4; j++) {
+            s[j] = _mm256_xor_si256(s[j], rk[0]);
+        }
+
+        for (int round = 1; round < 14; round++) {
+            for (int j = 0; j < 4; j++) {
+                s[j] = _mm256_aesenc_epi128(s[j], rk[round]);
+            }
+            resident_fold_step(&acc, c, xi, &hp, round);
+            if (which & SOLITON_CRC_CIPHERTEXT) {
+                crc_ct = resident_crc_step(crc_ct, ct, round);
+            }
+            if ((which & SOLITON_CRC_PLAINTEXT) && b > 0) {
+                crc_pt = resident_crc_step(crc_pt, pt - 128, round);
+            }
+        }
+
+        for (int j = 0; j < 4; j++) {
+            s[j] = _mm256_aesenclast_epi128(s[j], rk[14]);
+            _mm256_storeu_si256((__m256i*)pt + j, _mm256_xor_si256(s[j], in[j]));
+        }
+
+        xi = resident_reduce(acc);
+
+        ct += 128;
+        pt += 128;
+    }
+
+    /* Drain: plaintext of the last batch */
+    if ((which & SOLITON_CRC_PLAINTEXT) && batches > 0) {
+        for (int round = 1; round <= 8; round++) {
+            crc_pt = resident_crc_step(crc_pt, pt - 128, round);
+        }
+    }
+
+    _mm_storeu_si128((__m128i*)ghash_state, xi);
+    if (which & SOLITON_CRC_PLAINTEXT) {
+        crc[0] = crc_pt;
+    }
+    if (which & SOLITON_CRC_CIPHERTEXT) {
+        crc[1] = crc_ct;
+    }
+}
+
+void gcm_resident_encrypt_vaes_clmul(
+    const uint32_t* round_keys, const uint8_t* pt, uint8_t* ct,
+    soliton_ctr_ymm* ctr, uint8_t* ghash_state, const uint8_t (*h_powers)[16],
+    size_t batches) {
+
+    resident_encrypt(round_keys, pt, ct, ctr, ghash_state, h_powers, batches, NULL, 0);
+}
+
+void gcm_resident_decrypt_vaes_clmul(
+    const uint32_t* round_keys, const uint8_t* ct, uint8_t* pt,
+    soliton_ctr_ymm* ctr, uint8_t* ghash_state, const uint8_t (*h_powers)[16],
+    size_t batches) {
+
+    resident_decrypt(round_keys, ct, pt, ctr, ghash_state, h_powers, batches, NULL, 0);
+}
+
+/* One specialization per stream set, so unused CRC chains compile out */
+void gcm_resident_encrypt_crc_vaes_clmul(
+    const uint32_t* round_keys, const uint8_t* pt, uint8_t* ct,
+    soliton_ctr_ymm* ctr, uint8_t* ghash_state, const uint8_t (*h_powers)[16],
+    size_t batches, uint32_t crc[2], unsigned which) {
+
+    switch (which) {
+    case SOLITON_CRC_PLAINTEXT:
+        resident_encrypt(round_keys, pt, ct, ctr, ghash_state, h_powers, batches, crc,
+                         SOLITON_CRC_PLAINTEXT);
+        break;
+    case SOLITON_CRC_CIPHERTEXT:
+        resident_encrypt(round_keys, pt, ct, ctr, ghash_state, h_powers, batches, crc,
+                         SOLITON_CRC_CIPHERTEXT);
+        break;
+    default:
+        resident_encrypt(round_keys, pt, ct, ctr, ghash_state, h_powers, batches, crc,
+                         SOLITON_CRC_PLAINTEXT | SOLITON_CRC_CIPHERTEXT);
+        break;
+    }
+}
+
+void gcm_resident_decrypt_crc_vaes_clmul(
+    const uint32_t* round_keys, const uint8_t* ct, uint8_t* pt,
+    soliton_ctr_ymm* ctr, uint8_t* ghash_state, const uint8_t (*h_powers)[16],
+    size_t batches, uint32_t crc[2], unsigned which) {
+
+    switch (which) {
+    case SOLITON_CRC_PLAINTEXT:
+        resident_decrypt(round_keys, ct, pt, ctr, ghash_state, h_powers, batches, crc,
+                         SOLITON_CRC_PLAINTEXT);
+        break;
+    case SOLITON_CRC_CIPHERTEXT:
+        resident_decrypt(round_keys, ct, pt, ctr, ghash_state, h_powers, batches, crc,
+                         SOLITON_CRC_CIPHERTEXT);
+        break;
+    default:
+        resident_decrypt(round_keys, ct, pt, ctr, ghash_state, h_powers, batches, crc,
+                         SOLITON_CRC_PLAINTEXT | SOLITON_CRC_CIPHERTEXT);
+        break;
+    }
+}
+
+/* GHASH-only fold over whole 8-block batches, for decrypt paths that run
+ * CTR separately (ZMM width policy); same result as the decrypt kernel */
+void gcm_resident_ghash_vaes_clmul(
+    uint8_t* ghash_state, const uint8_t (*h_powers)[16],
+    const uint8_t* data, size_t batches) {
+
+    resident_hpow hp;
+    resident_hpow_load(&hp, h_powers);
+
+    __m128i xi = _mm_loadu_si128((const __m128i*)ghash_state);
+
+    for (size_t b = 0; b < batches; b++) {
+        __m128i c[8];
+        resident_acc acc = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+        for (int j = 0; j < 8; j++) {
+            c[j] = to_lepoly_128(_mm_loadu_si128((const __m128i*)data + j));
+        }
+        for (int round = 1; round <= 8; round++) {
+            resident_fold_step(&acc, c, xi, &hp, round);
+        }
+        xi = resident_reduce(acc);
+        data += 128;
+    }
+
+    _mm_storeu_si128((__m128i*)ghash_state, xi);
+}
+
+#endif /* __x86_64__ && __VAES__ && __PCLMUL__ */
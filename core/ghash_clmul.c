@@ -5,6 +5,7 @@
 
 #include "common.h"
 #include "diagnostics.h"
+#include "ghash_reduce.h"
 
 #ifdef __x86_64__
 
@@ -66,46 +67,16 @@ SOLITON_INLINE __m128i ghash_reflect_bytes(__m128i x) {
     return _mm_shuffle_epi8(x, rev);
 }
 
-/* Multiply by x mod (x^128 + x^7 + x^2 + x + 1) in kernel domain
- * x · h with carry propagation and polynomial reduction */
-SOLITON_INLINE __m128i ghash_mul_x_reflected(__m128i h) {
-    // Shift the 128-bit value left by 1 with carry between lanes
-    __m128i carry = _mm_srli_epi64(h, 63);                 // per-lane MSB → LSB
-    __m128i h2    = _mm_slli_epi64(h, 1);
-    // bring lower-lane carry into higher lane (cross-lane propagation)
-    __m128i carry_xlane = _mm_slli_si128(carry, 8);        // carry from low→high lane
-    h2 = _mm_or_si128(h2, carry_xlane);
-
-    // if the global MSB (bit127) was set, XOR with reflected poly 0x87
-    // Shift carry right by 8 bytes to move high qword to low qword position
-    __m128i high_carry = _mm_srli_si128(carry, 8);
-    // AND with polynomial to get conditional 0x87: if high_carry is nonzero, result is 0x87
-    // (since high_carry will be 0x01 when bit 127 was set, and 0x01 & 0x87 = 0x01, not what we want)
-    // We need a full mask, so let's negate and use that to select
-    // Actually, simpler: just AND the shifted carry (which is 0 or 1) with 0x87
-    // No wait - if high_carry is 0x01, we need output to be 0x87, not 0x01
-    // We need: (0-high_carry) & 0x87, which gives us 0x87 when high_carry=1, 0 when high_carry=0
-    // But (0-1) in unsigned = 0xFFFFFFFFFFFFFFFF, so (0-high_carry) & 0x87 works!
-    __m128i mask = _mm_sub_epi64(_mm_setzero_si128(), high_carry); // 0 - carry = -carry
-    const __m128i poly = _mm_set_epi64x(0, 0x87);
-    mask = _mm_and_si128(mask, poly);  // -1 & 0x87 = 0x87 when carry, else 0
-
-    return _mm_xor_si128(h2, mask);
-}
-
-/* Setkey preprocessing: byte-swap + multiply by x like Linux kernel expects
- * Linux kernel comment says: "hash_key << 1 mod poly" */
+/* Setkey preprocessing: byte-swap to kernel domain, then H·x mod P so the
+ * two-multiply reduction (ghash_reduce.h) needs no per-product shift */
 static __m128i ghash_setkey_preprocess(const uint8_t h_spec[16]) {
     __m128i h = _mm_loadu_si128((const __m128i*)h_spec);  // spec domain
     dump128("H_spec(input)", h);
     // Byte-swap to kernel domain (PCLMULQDQ native format)
     const __m128i rev = _mm_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
     h = _mm_shuffle_epi8(h, rev);
-    dump128("H_kern (GCM: no ·x)", h);
-
-    // GCM spec (NIST SP 800-38D) uses H = E_K(0) directly, NO preprocessing.
-    // Linux kernel's shash API required H·x; we don't. EVP benchmark wins here.
-    // REMOVED: h = ghash_mul_x_reflected(h);
+    h = ghash_twist_h(h);
+    dump128("H_kern (twisted)", h);
 
     return h;
 }
@@ -150,58 +121,12 @@ SOLITON_INLINE __m256i from_lepoly_256(__m256i x_kernel) {
 
 /* =============================================================================
  * GF(2^128) reduction: 256-bit product → 128-bit (modulo x^128+x^7+x^2+x+1)
- * Known-good Intel/OpenSSL-style reduction (battle-tested)
+ * Two-multiply fold from ghash_reduce.h; expects one operand twisted (H·x)
  * ============================================================================= */
 
-/* Byte-reverse per 128-bit value (for Intel domain mapping) */
-SOLITON_INLINE __m128i byte_reverse_128(__m128i x) {
-    const __m128i rev = _mm_set_epi8(
-        0x0f,0x0e,0x0d,0x0c,0x0b,0x0a,0x09,0x08,
-        0x07,0x06,0x05,0x04,0x03,0x02,0x01,0x00);
-    return _mm_shuffle_epi8(x, rev);
-}
-
-/*
- * Linux kernel / OpenSSL Karatsuba + reduction
- * polynomial: x^128 + x^7 + x^2 + x + 1  (0xE1)
- *
- * This is transcribed literally from ghash-clmulni-intel_asm.S
- * The reduction sequence is: left-shifts → cross-lane → right-shifts
- * Input: lo, hi = 256-bit product (lo = low 128, hi = high 128) in BIG-ENDIAN domain
- * Output: 128-bit reduced result in BIG-ENDIAN domain
- */
-SOLITON_INLINE __m128i ghash_reduce_intel(__m128i lo, __m128i hi) {
-    // 1. hi << 1,2,7 → xor into lo
-    __m128i v1 = _mm_slli_epi64(hi, 1);
-    __m128i v2 = _mm_slli_epi64(hi, 2);
-    __m128i v7 = _mm_slli_epi64(hi, 7);
-    lo = _mm_xor_si128(lo, _mm_xor_si128(v1, _mm_xor_si128(v2, v7)));
-
-    // 2. hi shifted by 8 bytes (cross-lane) then << 1,2,7 → xor into lo
-    __m128i hi_shift = _mm_slli_si128(hi, 8);
-    v1 = _mm_slli_epi64(hi_shift, 1);
-    v2 = _mm_slli_epi64(hi_shift, 2);
-    v7 = _mm_slli_epi64(hi_shift, 7);
-    lo = _mm_xor_si128(lo, _mm_xor_si128(v1, _mm_xor_si128(v2, v7)));
-
-    // 3. hi >> 63,62,57 → fold → xor into lo (final fold)
-    __m128i t1 = _mm_srli_epi64(hi, 63);
-    __m128i t2 = _mm_srli_epi64(hi, 62);
-    __m128i t7 = _mm_srli_epi64(hi, 57);
-    __m128i fold = _mm_xor_si128(t1, _mm_xor_si128(t2, t7));
-    lo = _mm_xor_si128(lo, _mm_xor_si128(hi, fold));
-
-    return lo;
-}
-
-/* Reducer wrapper for reflected domain (maintains external contract) */
-SOLITON_INLINE __m128i ghash_reduce_reflected(__m128i lo, __m128i hi) {
-    return ghash_reduce_intel(lo, hi);
-}
-
-/* Legacy name for compatibility */
+/* Exported for kernels and debug tools that link against the core */
 __m128i ghash_reduce_256_to_128_lepoly(__m128i lo, __m128i hi) {
-    return ghash_reduce_reflected(lo, hi);
+    return ghash_reduce_clmul2(lo, hi);
 }
 
 /* Forward declaration for legacy scalar multiply */
@@ -224,85 +149,28 @@ static inline void clmul_x4_256(__m128i a, __m128i b, __m128i *lo, __m128i *hi)
     *hi = _mm_xor_si128(p11, _mm_srli_si128(mid, 8));  // hi = p11 XOR (mid >> 64 bits)
 }
 
-/*
- * GCM Reduction for 0xE1 Polynomial (Standard Representation)
- * Algorithm: OpenSSL/Intel two-phase reduction with exact shift sequence
- *
- * Reduces 256-bit product (lo:hi) modulo P(x) = x^128 + x^7 + x^2 + x + 1
- *
- * Based on OpenSSL's ghash-x86_64.pl implementation
- * Uses reduction constant 0x1c2 (= 0xE1 << 1)
- *
- * Input:  lo (bits 0-127), hi (bits 128-255) in kernel byte order
- * Output: 128-bit result reduced mod P(x)
- */
-static inline __m128i ghash_reduce_kerneldomain(__m128i lo, __m128i hi) {
-    /*
-     * Phase 1: Barrett-style reduction using shifts 57, 62, 63
-     * This folds the high part into both low and high components
-     */
-
-    // Compute T1 = hi << 57 ⊕ hi << 62 ⊕ hi << 63
-    __m128i t1 = _mm_slli_epi64(hi, 57);
-    __m128i t2 = _mm_slli_epi64(hi, 62);
-    __m128i t3 = _mm_slli_epi64(hi, 63);
-    __m128i t = _mm_xor_si128(_mm_xor_si128(t1, t2), t3);
-
-    // Split T into low and high 64-bit halves and fold
-    __m128i t_lo = _mm_slli_si128(t, 8);   // Move low 64 bits to high position
-    __m128i t_hi = _mm_srli_si128(t, 8);   // Move high 64 bits to low position
-
-    lo = _mm_xor_si128(lo, t_lo);
-    hi = _mm_xor_si128(hi, t_hi);
-
-    /*
-     * Phase 2: Final reduction using CUMULATIVE shifts (1, then +1, then +5)
-     * This completes the modular reduction: hi >> 1, >> 2, >> 7
-     */
-
-    // Cumulative right shifts: 1, 2 (=1+1), 7 (=2+5)
-    __m128i r = _mm_srli_epi64(hi, 1);          // hi >> 1
-    r = _mm_xor_si128(r, _mm_srli_epi64(r, 1)); // (hi>>1) XOR (hi>>2)
-    r = _mm_xor_si128(r, _mm_srli_epi64(r, 5)); // previous XOR (hi>>7)
-
-    // Also XOR with original hi
-    r = _mm_xor_si128(r, hi);
-
-    // Final result
-    return _mm_xor_si128(lo, r);
-}
-
-/* Reference multiply using 4-partials (for testing) */
-static inline __m128i ghash_mul_ref_kernel(__m128i a, __m128i b) {
-    __m128i lo, hi;
-    clmul_x4_256(a, b, &lo, &hi);
-    return ghash_reduce_kerneldomain(lo, hi);
-}
-
 /* =============================================================================
- * ghash_mul_reflected: Correct GHASH multiply for reflected domain
- * Inputs: a_ref, b_ref in reflected domain (your canonical storage)
- * Output: (a*b mod poly) in reflected domain
+ * ghash_mul_reflected: GHASH multiply of two plain kernel-domain elements
+ * Inputs: a, b byte-reflected (to_lepoly_128 of the spec values), neither twisted
+ * Output: a*b mod poly, kernel domain
  *
- * Strategy: Swap to Intel/BE domain, use known-good reduction, swap back
- * This ensures correctness while maintaining your reflected storage contract
- * EXPORTED for use by fused kernels
+ * The product is shifted left one bit to stand in for the twist, then
+ * reduced with the same two-multiply fold as the kernels. This is the
+ * contract checked by Gate A (test_commute, test_ghash_edges).
+ * EXPORTED
  * ============================================================================= */
-/* Multiply two kernel-domain 128-bit polynomials with CLMUL and reduce
- * TEMPORARY: Using scalar multiply until CLMUL reducer is validated
- * Gate P0 passed (256-bit product correct), but reducer needs work */
 __m128i ghash_mul_reflected(__m128i a, __m128i b) {
-    /* Session 9 FIX: Use CLMUL instead of buggy scalar multiply
-     * Gate P0 verified that clmul_x4_256 + ghash_reduce_intel is correct.
-     * Scalar path had subtle big-endian bugs that corrupted H-power table. */
     __m128i lo, hi;
     clmul_x4_256(a, b, &lo, &hi);
-    return ghash_reduce_intel(lo, hi);
+    ghash_shl1_256(&lo, &hi);
+    return ghash_reduce_clmul2(lo, hi);
 }
 
-/* Legacy name for compatibility - will be removed */
-__m128i ghash_mul_lepoly_clmul(__m128i a, __m128i b) {
-    return ghash_mul_reflected(a, b);
+/* Multiply by a stored (twisted) H power: Xi·H^i, no shift needed */
+__m128i ghash_mul_lepoly_clmul(__m128i a, __m128i h_twisted) {
+    __m128i lo, hi;
+    clmul_x4_256(a, h_twisted, &lo, &hi);
+    return ghash_reduce_clmul2(lo, hi);
 }
 
 /* =============================================================================
@@ -433,30 +301,23 @@ void ghash_init_clmul(uint8_t h[16], const uint32_t* round_keys) {
 void ghash_precompute_h_powers_clmul(uint8_t h_powers[16][16], const uint8_t h_spec_bytes[16]) {
     /* Setkey preprocessing: byte-reverse + multiply by x mod poly
      * This is the ONLY place we swap - happens once per key */
-    __m128i h = ghash_setkey_preprocess(h_spec_bytes);
+    const __m128i h = ghash_setkey_preprocess(h_spec_bytes);
 
-    /* Store H^1 in reflected domain */
+    /* Store H^1 (twisted) */
     _mm_storeu_si128((__m128i*)h_powers[0], h);
 
-    /* Compute H^2, H^3, ..., H^16 - all stay in reflected domain */
-    __m128i hp = h;
+    /* H^2..H^16: plain power times twisted H gives the plain next power,
+     * which is twisted again for storage */
+    __m128i hp = to_lepoly_128(_mm_loadu_si128((const __m128i*)h_spec_bytes));
     for (int i = 1; i < 16; i++) {
-        #if defined(__PCLMUL__)
-        hp = ghash_mul_reflected(hp, h);
-        #else
-        hp = ghash_mul_lepoly_scalar(hp, h);  /* Scalar fallback when no PCLMUL */
-        #endif
-        _mm_storeu_si128((__m128i*)h_powers[i], hp);
+        hp = ghash_mul_lepoly_clmul(hp, h);
+        _mm_storeu_si128((__m128i*)h_powers[i], ghash_twist_h(hp));
     }
 
     /* TRIPWIRE: Verify H^2 = H*H (catches domain corruption early) */
     #ifdef SOLITON_DEBUG
-    __m128i h2_check;
-    #if defined(__PCLMUL__)
-    h2_check = ghash_mul_reflected(h, h);
-    #else
-    h2_check = ghash_mul_lepoly_scalar(h, h);
-    #endif
+    const __m128i h_plain = to_lepoly_128(_mm_loadu_si128((const __m128i*)h_spec_bytes));
+    __m128i h2_check = ghash_twist_h(ghash_mul_reflected(h_plain, h_plain));
     __m128i h2_stored = _mm_loadu_si128((const __m128i*)h_powers[1]);
 
     /* Compare all 128 bits */
@@ -527,42 +388,6 @@ void ghash_update_clmul(uint8_t* state, const uint8_t* h_bytes, const uint8_t* d
     _mm_storeu_si128((__m128i*)state, y);
 }
 
-/* GCM reduction matching fused kernel (imported from gcm_fused_vaes_clmul.c) */
-static SOLITON_INLINE __m128i ghash_reduce_clmul(__m128i x0, __m128i x1, __m128i x2) {
-    /* GCM reduction polynomial: x^128 + x^7 + x^2 + x + 1 */
-
-    /* First phase */
-    __m128i t1 = _mm_slli_epi32(x0, 31);
-    __m128i t2 = _mm_slli_epi32(x0, 30);
-    __m128i t3 = _mm_slli_epi32(x0, 25);
-
-    t1 = _mm_xor_si128(t1, t2);
-    t1 = _mm_xor_si128(t1, t3);
-
-    __m128i t4 = _mm_srli_epi32(t1, 32);
-    t1 = _mm_shuffle_epi32(t1, 0x93);
-
-    __m128i t5 = _mm_xor_si128(x0, t1);
-    x1 = _mm_xor_si128(x1, t4);
-
-    /* Second phase */
-    __m128i t6 = _mm_srli_epi32(x1, 1);
-    __m128i t7 = _mm_srli_epi32(x1, 2);
-    __m128i t8 = _mm_srli_epi32(x1, 7);
-
-    t6 = _mm_xor_si128(t6, t7);
-    t6 = _mm_xor_si128(t6, t8);
-    t6 = _mm_xor_si128(t6, x1);
-
-    __m128i t9 = _mm_slli_epi32(t6, 32);
-    t6 = _mm_shuffle_epi32(t6, 0x4E);
-
-    x1 = _mm_xor_si128(x1, t9);
-    x2 = _mm_xor_si128(x2, t6);
-
-    return _mm_xor_si128(t5, x2);
-}
-
 /* 8-way parallel GHASH with deferred reduction and Karatsuba optimization */
 void ghash_update_clmul8(uint8_t* state, const uint8_t h_powers[8][16],
                          const uint8_t* data, size_t len) {
@@ -635,7 +460,7 @@ void ghash_update_clmul8(uint8_t* state, const uint8_t h_powers[8][16],
         hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
 
         /* Single polynomial reduction: 256-bit (lo, hi) → 128-bit result */
-        Xi = ghash_reduce_256_to_128_lepoly(lo, hi);
+        Xi = ghash_reduce_clmul2(lo, hi);
 
         data += 128;
         len -= 128;
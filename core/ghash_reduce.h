@@ -0,0 +1,84 @@
+/*
+ * ghash_reduce.h - GHASH reduction by two carry-less multiplies
+ *
+ * Reduces a 256-bit carry-less product hi:lo (CLMUL domain) modulo
+ * x^128 + x^7 + x^2 + x + 1. Each fold multiplies the low qword by the
+ * folded polynomial constant 0xC200000000000000 and swaps the halves, so
+ * the dependent chain is two clmul + shuffle + xor steps instead of the
+ * shift/xor ladder (~20 uops) used previously.
+ *
+ * The fold divides by x once, so the multiplicand must carry a factor x:
+ *   - H powers are stored pre-multiplied by x ("twisted", see
+ *     ghash_twist_h) - kernels multiply by the table and reduce directly
+ *   - Products of two plain elements are shifted left one bit first
+ *     (ghash_shl1_256), as ghash_mul_reflected does for the gate tests
+ *
+ * The 256-bit form reduces two independent products, one per 128-bit
+ * lane, with the same instruction sequence.
+ *
+ * Each section is compiled only when the including file targets its ISA.
+ */
+
+#ifndef SOLITON_GHASH_REDUCE_H
+#define SOLITON_GHASH_REDUCE_H
+
+#include "common.h"
+
+#if defined(__x86_64__) && defined(__PCLMUL__)
+
+#include <immintrin.h>
+
+/* x^128 + x^7 + x^2 + x + 1 folded for reflected operands; the low 1 is
+ * used only by ghash_twist_h */
+#define GHASH_REDUCE_POLY_128() _mm_setr_epi32(1, 0, 0, (int)0xC2000000)
+
+static SOLITON_INLINE __m128i ghash_reduce_clmul2(__m128i lo, __m128i hi) {
+    const __m128i poly = GHASH_REDUCE_POLY_128();
+    __m128i t = _mm_clmulepi64_si128(lo, poly, 0x10);
+    lo = _mm_xor_si128(_mm_shuffle_epi32(lo, 0x4E), t);
+    t = _mm_clmulepi64_si128(lo, poly, 0x10);
+    lo = _mm_xor_si128(_mm_shuffle_epi32(lo, 0x4E), t);
+    return _mm_xor_si128(lo, hi);
+}
+
+/* Karatsuba sums (lo, mid, hi with mid still holding lo ^ hi) -> reduced */
+static SOLITON_INLINE __m128i ghash_reduce_karatsuba(__m128i lo, __m128i mid, __m128i hi) {
+    mid = _mm_xor_si128(mid, _mm_xor_si128(lo, hi));
+    return ghash_reduce_clmul2(_mm_xor_si128(lo, _mm_slli_si128(mid, 8)),
+                               _mm_xor_si128(hi, _mm_srli_si128(mid, 8)));
+}
+
+/* hi:lo <<= 1 (multiply a plain product by x before ghash_reduce_clmul2) */
+static SOLITON_INLINE void ghash_shl1_256(__m128i* lo, __m128i* hi) {
+    const __m128i cl = _mm_srli_epi64(*lo, 63);
+    const __m128i ch = _mm_srli_epi64(*hi, 63);
+    *hi = _mm_or_si128(_mm_or_si128(_mm_slli_epi64(*hi, 1), _mm_slli_si128(ch, 8)),
+                       _mm_srli_si128(cl, 8));
+    *lo = _mm_or_si128(_mm_slli_epi64(*lo, 1), _mm_slli_si128(cl, 8));
+}
+
+/* H -> H·x mod P (CLMUL domain), the form stored in h_powers[] */
+static SOLITON_INLINE __m128i ghash_twist_h(__m128i h) {
+    const __m128i carry = _mm_srli_epi64(h, 63);
+    const __m128i top = _mm_shuffle_epi32(_mm_srai_epi32(h, 31), 0xFF);
+    h = _mm_or_si128(_mm_slli_epi64(h, 1), _mm_slli_si128(carry, 8));
+    return _mm_xor_si128(h, _mm_and_si128(top, GHASH_REDUCE_POLY_128()));
+}
+
+#if defined(__AVX2__) && defined(__VPCLMULQDQ__)
+
+/* Two independent reductions, one per 128-bit lane */
+static SOLITON_INLINE __m256i ghash_reduce_clmul2_256(__m256i lo, __m256i hi) {
+    const __m256i poly = _mm256_broadcastsi128_si256(GHASH_REDUCE_POLY_128());
+    __m256i t = _mm256_clmulepi64_epi128(lo, poly, 0x10);
+    lo = _mm256_xor_si256(_mm256_shuffle_epi32(lo, 0x4E), t);
+    t = _mm256_clmulepi64_epi128(lo, poly, 0x10);
+    lo = _mm256_xor_si256(_mm256_shuffle_epi32(lo, 0x4E), t);
+    return _mm256_xor_si256(lo, hi);
+}
+
+#endif /* __AVX2__ && __VPCLMULQDQ__ */
+
+#endif /* __x86_64__ && __PCLMUL__ */
+
+#endif /* SOLITON_GHASH_REDUCE_H */
@@ -0,0 +1,211 @@
+/*
+ * keysnap.c - Encrypted snapshot/restore of expanded AES-GCM key tables
+ * Freestanding C17 - the caller owns the buffer (see hosted/keysnap_mmap.c
+ * for the mmap-based loader)
+ *
+ * Layout (little-endian):
+ *   [  0] magic "SKSN"          [ 4] u32 version
+ *   [  8] u32 record bytes      [12] u32 key layout flags
+ *   [ 16] u64 CPU feature bits  [24] u64 record count
+ *   [ 32] nonce[12]             [44] backend name[16]
+ *   [ 60] u32 opened flag (0 in the file, set by soliton_keysnap_open)
+ *   [ 64] count * soliton_aesgcm_ctx records (64B aligned)
+ *   [end] Poly1305 tag[16]
+ *
+ * Records are sealed with ChaCha20-Poly1305 under a caller-supplied wrap
+ * key, with bytes 0..59 of the header as AAD. The seal deliberately does
+ * not depend on the AES/GHASH tables it protects.
+ */
+
+#include "common.h"
+
+#define KEYSNAP_MAGIC       0x4e534b53u  /* "SKSN" */
+#define KEYSNAP_OFF_VERSION 4
+#define KEYSNAP_OFF_RECORD  8
+#define KEYSNAP_OFF_LAYOUT  12
+#define KEYSNAP_OFF_CAPS    16
+#define KEYSNAP_OFF_COUNT   24
+#define KEYSNAP_OFF_NONCE   32
+#define KEYSNAP_OFF_BACKEND 44
+#define KEYSNAP_OFF_OPENED  60
+#define KEYSNAP_AAD_BYTES   60
+#define KEYSNAP_NAME_BYTES  16
+
+/* ChaCha20 block counter is 32-bit, counter 0 feeds Poly1305 */
+#define KEYSNAP_MAX_PAYLOAD ((uint64_t)0xffffffffu * 64u)
+
+/* Backend name, truncated/NUL-padded to a fixed field */
+static void keysnap_put_name(uint8_t out[KEYSNAP_NAME_BYTES], const char* name) {
+    size_t i = 0;
+    for (; name && name[i] && i < KEYSNAP_NAME_BYTES; i++) {
+        out[i] = (uint8_t)name[i];
+    }
+    for (; i < KEYSNAP_NAME_BYTES; i++) {
+        out[i] = 0;
+    }
+}
+
+/* Header fields that must match the running process */
+static void keysnap_fill_header(uint8_t hdr[SOLITON_KEYSNAP_HEADER_BYTES], uint64_t caps,
+                                uint64_t count, const uint8_t nonce[12]) {
+    soliton_put_le32(hdr, KEYSNAP_MAGIC);
+    soliton_put_le32(hdr + KEYSNAP_OFF_VERSION, SOLITON_KEYSNAP_VERSION);
+    soliton_put_le32(hdr + KEYSNAP_OFF_RECORD, (uint32_t)sizeof(soliton_aesgcm_ctx));
+    soliton_put_le32(hdr + KEYSNAP_OFF_LAYOUT, soliton_aesgcm_key_layout());
+    soliton_put_le64(hdr + KEYSNAP_OFF_CAPS, caps);
+    soliton_put_le64(hdr + KEYSNAP_OFF_COUNT, count);
+    for (int i = 0; i < 12; i++) {
+        hdr[KEYSNAP_OFF_NONCE + i] = nonce[i];
+    }
+    keysnap_put_name(hdr + KEYSNAP_OFF_BACKEND, soliton_get_backend()->name);
+    soliton_put_le32(hdr + KEYSNAP_OFF_OPENED, 0);
+}
+
+size_t soliton_keysnap_bytes(size_t count) {
+    const size_t rec = sizeof(soliton_aesgcm_ctx);
+
+    if (count > (SIZE_MAX - SOLITON_KEYSNAP_HEADER_BYTES - SOLITON_KEYSNAP_TAG_BYTES) / rec) {
+        return 0;
+    }
+    return SOLITON_KEYSNAP_HEADER_BYTES + count * rec + SOLITON_KEYSNAP_TAG_BYTES;
+}
+
+soliton_status soliton_keysnap_export(
+    const soliton_aesgcm_ctx* const* ctxs, size_t count,
+    const uint8_t wrap_key[SOLITON_KEYSNAP_WRAP_KEY_BYTES],
+    const uint8_t nonce[SOLITON_KEYSNAP_NONCE_BYTES],
+    uint8_t* out, size_t out_len) {
+
+    size_t total = soliton_keysnap_bytes(count);
+    size_t payload = count * sizeof(soliton_aesgcm_ctx);
+
+    if (!wrap_key || !nonce || !out || (!ctxs && count > 0) || total == 0 ||
+        out_len < total || (uint64_t)payload > KEYSNAP_MAX_PAYLOAD) {
+        return SOLITON_INVALID_INPUT;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!ctxs[i] || !ctxs[i]->backend || !ctxs[i]->h_powers_ready) {
+            return SOLITON_INVALID_INPUT;
+        }
+    }
+
+    soliton_caps caps;
+    soliton_query_caps(&caps);
+    keysnap_fill_header(out, caps.bits, count, nonce);
+
+    /* Copy key material only; per-message state and process-local
+     * pointers are left zero and rebuilt by soliton_keysnap_open */
+    uint8_t* rec = out + SOLITON_KEYSNAP_HEADER_BYTES;
+    for (size_t i = 0; i < count; i++, rec += sizeof(soliton_aesgcm_ctx)) {
+        const soliton_aesgcm_ctx* src = ctxs[i];
+        soliton_aesgcm_ctx* dst = (soliton_aesgcm_ctx*)rec;
+
+        soliton_wipe(rec, sizeof(soliton_aesgcm_ctx));
+        for (int w = 0; w < 60; w++) {
+            dst->round_keys[w] = src->round_keys[w];
+        }
+        for (int b = 0; b < 16; b++) {
+            dst->h[b] = src->h[b];
+        }
+        for (int p = 0; p < 16; p++) {
+            for (int b = 0; b < 16; b++) {
+                dst->h_powers[p][b] = src->h_powers[p][b];
+            }
+        }
+        dst->h_powers_ready = 1;
+        dst->state = AES_STATE_INIT;
+    }
+
+    /* Seal records in place */
+    soliton_chacha_ctx seal;
+    soliton_chacha_init(&seal, wrap_key, nonce);
+    soliton_chacha_aad_update(&seal, out, KEYSNAP_AAD_BYTES);
+    soliton_chacha_encrypt_update(&seal, out + SOLITON_KEYSNAP_HEADER_BYTES,
+                                  out + SOLITON_KEYSNAP_HEADER_BYTES, payload);
+    soliton_chacha_encrypt_final(&seal, out + SOLITON_KEYSNAP_HEADER_BYTES + payload);
+    soliton_chacha_context_wipe(&seal);
+
+    return SOLITON_OK;
+}
+
+soliton_status soliton_keysnap_open(
+    uint8_t* snap, size_t snap_len,
+    const uint8_t wrap_key[SOLITON_KEYSNAP_WRAP_KEY_BYTES],
+    size_t* count) {
+
+    if (!snap || !wrap_key || snap_len < soliton_keysnap_bytes(0) ||
+        ((uintptr_t)snap & (SOLITON_CACHE_LINE - 1)) != 0) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    /* Reject foreign or incompatible snapshots before touching the payload */
+    if (soliton_le32(snap) != KEYSNAP_MAGIC ||
+        soliton_le32(snap + KEYSNAP_OFF_OPENED) != 0) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    soliton_caps caps;
+    soliton_query_caps(&caps);
+    uint64_t snap_caps = soliton_le64(snap + KEYSNAP_OFF_CAPS);
+    uint8_t name[KEYSNAP_NAME_BYTES];
+    keysnap_put_name(name, soliton_get_backend()->name);
+
+    if (soliton_le32(snap + KEYSNAP_OFF_VERSION) != SOLITON_KEYSNAP_VERSION ||
+        soliton_le32(snap + KEYSNAP_OFF_RECORD) != (uint32_t)sizeof(soliton_aesgcm_ctx) ||
+        soliton_le32(snap + KEYSNAP_OFF_LAYOUT) != soliton_aesgcm_key_layout() ||
+        (snap_caps & ~caps.bits) != 0 ||
+        soliton_ct_memcmp(snap + KEYSNAP_OFF_BACKEND, name, KEYSNAP_NAME_BYTES) != 0) {
+        return SOLITON_UNSUPPORTED;
+    }
+
+    uint64_t n = soliton_le64(snap + KEYSNAP_OFF_COUNT);
+    if (n > SIZE_MAX || soliton_keysnap_bytes((size_t)n) == 0 ||
+        snap_len < soliton_keysnap_bytes((size_t)n)) {
+        return SOLITON_INVALID_INPUT;
+    }
+    size_t payload = (size_t)n * sizeof(soliton_aesgcm_ctx);
+    uint8_t* records = snap + SOLITON_KEYSNAP_HEADER_BYTES;
+
+    /* Authenticate and decrypt in place */
+    soliton_chacha_ctx seal;
+    soliton_chacha_init(&seal, wrap_key, snap + KEYSNAP_OFF_NONCE);
+    soliton_chacha_aad_update(&seal, snap, KEYSNAP_AAD_BYTES);
+    soliton_chacha_decrypt_update(&seal, records, records, payload);
+    soliton_status st = soliton_chacha_decrypt_final(&seal, records + payload);
+    soliton_chacha_context_wipe(&seal);
+
+    if (st != SOLITON_OK) {
+        soliton_wipe(records, payload);
+        return st;
+    }
+
+    /* Rebind process-local state */
+    const soliton_backend_t* backend = soliton_get_backend();
+    soliton_hw_caps_t hw_caps;
+    soliton_workload_t workload;
+    soliton_plan_t plan;
+    soliton_plan_query_hw_caps(&hw_caps);
+    soliton_workload_default(&workload, 65536);
+    soliton_plan_select(&plan, &hw_caps, &workload);
+
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)records;
+    for (size_t i = 0; i < (size_t)n; i++) {
+        ctx[i].backend = backend;
+        ctx[i].plan = plan;
+    }
+
+    soliton_put_le32(snap + KEYSNAP_OFF_OPENED, 1);
+    if (count) {
+        *count = (size_t)n;
+    }
+    return SOLITON_OK;
+}
+
+soliton_aesgcm_ctx* soliton_keysnap_ctx(uint8_t* snap, size_t index) {
+    if (!snap || soliton_le32(snap) != KEYSNAP_MAGIC ||
+        soliton_le32(snap + KEYSNAP_OFF_OPENED) != 1 ||
+        index >= soliton_le64(snap + KEYSNAP_OFF_COUNT)) {
+        return NULL;
+    }
+    return (soliton_aesgcm_ctx*)(snap + SOLITON_KEYSNAP_HEADER_BYTES) + index;
+}
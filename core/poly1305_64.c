@@ -0,0 +1,137 @@
+/*
+ * poly1305_64.c - Poly1305 (RFC 8439) with radix-2^64 limbs
+ * Constant-time, 64x64->128 multiplies (mul/umulh), for 64-bit targets
+ *
+ * h = h0 + h1*2^64 + h2*2^128 is kept partially reduced (h2 < 8) between
+ * blocks; r is two 64-bit limbs. Clamping makes r1 a multiple of 4, so
+ * r1*2^128 = (r1/4)*2^130 == 5*(r1/4) (mod 2^130-5) and the high partial
+ * products fold in with s1 = r1 + (r1 >> 2).
+ */
+
+#include "common.h"
+
+#if defined(__SIZEOF_INT128__)
+
+__extension__ typedef unsigned __int128 poly1305_u128;
+
+/* h = h * r (mod 2^130 - 5), partially reduced */
+static SOLITON_INLINE void poly1305_mul_64(uint64_t h[3], uint64_t r0, uint64_t r1, uint64_t s1) {
+    poly1305_u128 t0 = (poly1305_u128)h[0] * r0 + (poly1305_u128)h[1] * s1;
+    poly1305_u128 t1 = (poly1305_u128)h[0] * r1 + (poly1305_u128)h[1] * r0 +
+                       (poly1305_u128)h[2] * s1;
+    uint64_t t2 = h[2] * r0;
+
+    t1 += (uint64_t)(t0 >> 64);
+    t2 += (uint64_t)(t1 >> 64);
+
+    /* Fold bits >= 130 back in: c * 2^130 == 5c */
+    uint64_t c = (t2 >> 2) + (t2 & ~(uint64_t)3);
+    poly1305_u128 acc = (poly1305_u128)(uint64_t)t0 + c;
+    h[0] = (uint64_t)acc;
+    acc = (poly1305_u128)(uint64_t)t1 + (uint64_t)(acc >> 64);
+    h[1] = (uint64_t)acc;
+    h[2] = (t2 & 3) + (uint64_t)(acc >> 64);
+}
+
+/* Canonical h mod 2^130 - 5 (constant time) */
+static SOLITON_INLINE void poly1305_reduce_64(uint64_t h[3]) {
+    /* h < 2^131 here; g = h + 5 - 2^130 is the reduced value when h >= p */
+    poly1305_u128 t = (poly1305_u128)h[0] + 5;
+    uint64_t g0 = (uint64_t)t;
+    t = (poly1305_u128)h[1] + (uint64_t)(t >> 64);
+    uint64_t g1 = (uint64_t)t;
+    uint64_t g2 = h[2] + (uint64_t)(t >> 64);
+
+    uint64_t mask = 0 - (g2 >> 2);   /* all ones if h >= p */
+    h[0] = (h[0] & ~mask) | (g0 & mask);
+    h[1] = (h[1] & ~mask) | (g1 & mask);
+    h[2] = (h[2] & ~mask) | ((g2 & 3) & mask);
+}
+
+void poly1305_init_64(void* state, const uint8_t key[32]) {
+    poly1305_state_wide_t* st = (poly1305_state_wide_t*)state;
+
+    soliton_wipe(st, sizeof(*st));
+    st->r[0] = soliton_le64(key) & 0x0ffffffc0fffffffull;
+    st->r[1] = soliton_le64(key + 8) & 0x0ffffffc0ffffffcull;
+    st->s[0] = soliton_le64(key + 16);
+    st->s[1] = soliton_le64(key + 24);
+}
+
+/* Absorb full 16-byte blocks (hibit = 1 for message blocks) */
+static void poly1305_blocks_64(poly1305_state_wide_t* st, const uint8_t* data, size_t blocks,
+                               uint64_t hibit) {
+    const uint64_t r0 = st->r[0];
+    const uint64_t r1 = st->r[1];
+    const uint64_t s1 = r1 + (r1 >> 2);
+    uint64_t h[3] = { st->h[0], st->h[1], st->h[2] };
+
+    while (blocks--) {
+        poly1305_u128 t = (poly1305_u128)h[0] + soliton_le64(data);
+        h[0] = (uint64_t)t;
+        t = (poly1305_u128)h[1] + soliton_le64(data + 8) + (uint64_t)(t >> 64);
+        h[1] = (uint64_t)t;
+        h[2] += (uint64_t)(t >> 64) + hibit;
+
+        poly1305_mul_64(h, r0, r1, s1);
+        data += 16;
+    }
+
+    st->h[0] = h[0];
+    st->h[1] = h[1];
+    st->h[2] = h[2];
+}
+
+void poly1305_update_64(void* state, const uint8_t* data, size_t len) {
+    poly1305_state_wide_t* st = (poly1305_state_wide_t*)state;
+
+    if (st->buffer_len > 0) {
+        size_t need = 16 - st->buffer_len;
+        size_t take = len < need ? len : need;
+        soliton_copy(st->buffer + st->buffer_len, data, take);
+        st->buffer_len += take;
+        data += take;
+        len -= take;
+        if (st->buffer_len < 16) {
+            return;
+        }
+        poly1305_blocks_64(st, st->buffer, 1, 1);
+        st->buffer_len = 0;
+    }
+
+    if (len >= 16) {
+        poly1305_blocks_64(st, data, len / 16, 1);
+        data += len & ~(size_t)15;
+        len &= 15;
+    }
+
+    if (len > 0) {
+        soliton_copy(st->buffer, data, len);
+        st->buffer_len = len;
+    }
+}
+
+void poly1305_final_64(void* state, uint8_t tag[16]) {
+    poly1305_state_wide_t* st = (poly1305_state_wide_t*)state;
+
+    /* Trailing partial block: 0x01 terminator, no 2^128 bit */
+    if (st->buffer_len > 0) {
+        st->buffer[st->buffer_len] = 1;
+        for (size_t i = st->buffer_len + 1; i < 16; i++) {
+            st->buffer[i] = 0;
+        }
+        poly1305_blocks_64(st, st->buffer, 1, 0);
+    }
+
+    uint64_t h[3] = { st->h[0], st->h[1], st->h[2] };
+    poly1305_reduce_64(h);
+
+    /* tag = (h + s) mod 2^128 */
+    poly1305_u128 t = (poly1305_u128)h[0] + st->s[0];
+    soliton_put_le64(tag, (uint64_t)t);
+    soliton_put_le64(tag + 8, h[1] + st->s[1] + (uint64_t)(t >> 64));
+
+    soliton_wipe(st, sizeof(*st));
+}
+
+#endif /* __SIZEOF_INT128__ */
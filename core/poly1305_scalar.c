@@ -116,7 +116,7 @@ static void poly1305_block_scalar(poly1305_state_scalar_t* st, const uint8_t dat
 /* Update Poly1305 with data */
 void poly1305_update_scalar(poly1305_state_scalar_t* st, const uint8_t* data, size_t len) {
     /* Handle buffered data */
-    if (st->buffer_len > 0) {
+    if (st->buffer_len > 0 && st->buffer_len < 16) {
         size_t need = 16 - st->buffer_len;
         if (len < need) {
             /* Not enough to fill buffer */
@@ -157,12 +157,12 @@ void poly1305_update_scalar(poly1305_state_scalar_t* st, const uint8_t* data, si
 void poly1305_final_scalar(poly1305_state_scalar_t* st, uint8_t tag[16]) {
     /* Process final partial block if any */
     if (st->buffer_len > 0) {
-        /* Pad with zeros */
-        for (size_t i = st->buffer_len; i < 16; i++) {
+        /* 0x01 terminator at position 8*len, then zeros; no 2^128 bit */
+        st->buffer[st->buffer_len] = 1;
+        for (size_t i = st->buffer_len + 1; i < 16; i++) {
             st->buffer[i] = 0;
         }
-        /* Set final bit at position 8*len */
-        poly1305_block_scalar(st, st->buffer, (st->buffer_len < 16) ? 1 : 0);
+        poly1305_block_scalar(st, st->buffer, 0);
     }
 
     /* Fully reduce h */
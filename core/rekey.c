@@ -0,0 +1,149 @@
+/*
+ * rekey.c - Double-buffered AES-GCM key rotation
+ * Freestanding C17 - the caller owns both contexts
+ *
+ * Standby slot states (kr->standby):
+ *   EMPTY     -> PREPARING   prepare/begin (helper)
+ *   PREPARING -> READY       prepare/step  (helper, release)
+ *   READY     -> RETIRED     commit        (data path: swap kr->active first)
+ *   RETIRED   -> EMPTY       retire        (helper, after wiping the slot)
+ *
+ * Each state is written by one side only, so plain acquire/release
+ * ordering is enough: the helper publishes a finished key with a release
+ * store of READY, and commit publishes the new active index before the
+ * retired slot is handed back.
+ */
+
+#include "common.h"
+
+#define KR_EMPTY     0u
+#define KR_PREPARING 1u
+#define KR_READY     2u
+#define KR_RETIRED   3u
+
+static soliton_aesgcm_ctx* keyring_standby(soliton_aesgcm_keyring* kr) {
+    return kr->slot[__atomic_load_n(&kr->active, __ATOMIC_ACQUIRE) ^ 1u];
+}
+
+/* A keyed context with no IV: updates fail until soliton_aesgcm_reset */
+static void keyring_park(soliton_aesgcm_ctx* ctx) {
+    soliton_wipe(ctx->j0, 16);
+    ctx->counter = 0;
+    ctx->state = AES_STATE_FINAL;
+}
+
+soliton_status soliton_aesgcm_keyring_init(
+    soliton_aesgcm_keyring* kr,
+    soliton_aesgcm_ctx* ctx0, soliton_aesgcm_ctx* ctx1,
+    const uint8_t key[SOLITON_AESGCM_KEY_BYTES]) {
+
+    if (!kr || !ctx0 || !ctx1 || ctx0 == ctx1 || !key) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    soliton_wipe(ctx1, sizeof(*ctx1));
+    soliton_aesgcm_setup_key(ctx0, key);
+    soliton_aesgcm_setup_hash(ctx0);
+    keyring_park(ctx0);
+
+    kr->slot[0] = ctx0;
+    kr->slot[1] = ctx1;
+    __atomic_store_n(&kr->active, 0u, __ATOMIC_RELAXED);
+    __atomic_store_n(&kr->standby, KR_EMPTY, __ATOMIC_RELEASE);
+    return SOLITON_OK;
+}
+
+soliton_aesgcm_ctx* soliton_aesgcm_keyring_active(soliton_aesgcm_keyring* kr) {
+    return kr->slot[__atomic_load_n(&kr->active, __ATOMIC_ACQUIRE)];
+}
+
+soliton_status soliton_aesgcm_keyring_prepare_begin(
+    soliton_aesgcm_keyring* kr,
+    const uint8_t next_key[SOLITON_AESGCM_KEY_BYTES]) {
+
+    if (!kr || !next_key) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    /* A READY key belongs to the data path until it commits */
+    uint32_t state = __atomic_load_n(&kr->standby, __ATOMIC_ACQUIRE);
+    if (state == KR_READY) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    soliton_aesgcm_ctx* ctx = keyring_standby(kr);
+    if (state == KR_RETIRED) {
+        soliton_wipe(ctx, sizeof(*ctx));
+    }
+    __atomic_store_n(&kr->standby, KR_PREPARING, __ATOMIC_RELAXED);
+    soliton_aesgcm_setup_key(ctx, next_key);
+    return SOLITON_OK;
+}
+
+soliton_status soliton_aesgcm_keyring_prepare_step(soliton_aesgcm_keyring* kr) {
+    if (!kr || __atomic_load_n(&kr->standby, __ATOMIC_ACQUIRE) != KR_PREPARING) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    soliton_aesgcm_ctx* ctx = keyring_standby(kr);
+    soliton_aesgcm_setup_hash(ctx);
+    keyring_park(ctx);
+    __atomic_store_n(&kr->standby, KR_READY, __ATOMIC_RELEASE);
+    return SOLITON_OK;
+}
+
+/* Per-context settings that outlive a key: cost counters and sampling,
+ * the plan variant and the A/B arm. setup_key resets them on the standby
+ * slot, so commit copies them over from the outgoing key. */
+static void keyring_carry(soliton_aesgcm_ctx* to, const soliton_aesgcm_ctx* from) {
+    to->cost = from->cost;
+    to->cost_on = from->cost_on;
+    to->cost_period = from->cost_period;
+    to->cost_countdown = from->cost_countdown;
+    to->plan_variant = from->plan_variant;
+    to->ab_arm = from->ab_arm;
+    to->ab_countdown = from->ab_countdown;
+}
+
+soliton_status soliton_aesgcm_keyring_prepare(
+    soliton_aesgcm_keyring* kr,
+    const uint8_t next_key[SOLITON_AESGCM_KEY_BYTES]) {
+
+    soliton_status status = soliton_aesgcm_keyring_prepare_begin(kr, next_key);
+    if (status != SOLITON_OK) {
+        return status;
+    }
+    return soliton_aesgcm_keyring_prepare_step(kr);
+}
+
+soliton_status soliton_aesgcm_keyring_commit(soliton_aesgcm_keyring* kr) {
+    if (!kr || __atomic_load_n(&kr->standby, __ATOMIC_ACQUIRE) != KR_READY) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    /* Only the data path moves the index, so a relaxed read is current */
+    uint32_t active = __atomic_load_n(&kr->active, __ATOMIC_RELAXED);
+    keyring_carry(kr->slot[active ^ 1u], kr->slot[active]);
+    __atomic_store_n(&kr->active, active ^ 1u, __ATOMIC_RELEASE);
+    __atomic_store_n(&kr->standby, KR_RETIRED, __ATOMIC_RELEASE);
+    return SOLITON_OK;
+}
+
+void soliton_aesgcm_keyring_retire(soliton_aesgcm_keyring* kr) {
+    if (kr && __atomic_load_n(&kr->standby, __ATOMIC_ACQUIRE) == KR_RETIRED) {
+        soliton_aesgcm_ctx* ctx = keyring_standby(kr);
+        soliton_wipe(ctx, sizeof(*ctx));
+        __atomic_store_n(&kr->standby, KR_EMPTY, __ATOMIC_RELEASE);
+    }
+}
+
+void soliton_aesgcm_keyring_wipe(soliton_aesgcm_keyring* kr) {
+    if (kr) {
+        for (int i = 0; i < 2; i++) {
+            if (kr->slot[i]) {
+                soliton_wipe(kr->slot[i], sizeof(*kr->slot[i]));
+            }
+        }
+        soliton_wipe(kr, sizeof(*kr));
+    }
+}
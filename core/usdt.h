@@ -0,0 +1,89 @@
+/*
+ * usdt.h - USDT static tracepoints (provider "soliton")
+ * Compile with -DSOLITON_USDT to enable (make usdt)
+ *
+ * Each probe is a single nop plus a .note.stapsdt record giving the probe
+ * name and its argument locations, in the layout <sys/sdt.h> emits, so
+ * bpftrace, perf probe and SystemTap attach to it with no rebuild, no
+ * header dependency and no libc. An unattached probe costs the nop; with
+ * SOLITON_USDT undefined every macro here expands to nothing.
+ *
+ * Probes (all arguments are 64-bit):
+ *   <api>_entry   (ctx, len)                 every checked public call
+ *   <api>_return  (ctx, len, status)         same call, every return path
+ *   gcm_kernel    (ctx, kernel id, bytes)    GCM bulk kernel picked per update
+ *                                            (SOLITON_KERNEL_* in soliton.h)
+ *   backend_select(name, family)             one-time backend selection
+ * ctx is the context (the context array for batch calls, 0 for calls
+ * without one); len is the byte, sector or stream count the call was
+ * given (IV length for init/reset, 0 for final).
+ */
+
+#ifndef SOLITON_USDT_H
+#define SOLITON_USDT_H
+
+#include <stdint.h>
+
+/* backend_select probe: family ids */
+#define SOLITON_BACKEND_AESGCM  0
+#define SOLITON_BACKEND_GHASH   1
+#define SOLITON_BACKEND_CHACHA  2
+#define SOLITON_BACKEND_AEGIS   3
+#define SOLITON_BACKEND_XTS     4
+
+#if defined(SOLITON_USDT) && defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__))
+
+/* Note record: nop address, base for prelink adjustment, no semaphore */
+#define SOLITON_USDT_NOTE(name, args)                                       \
+    "990: nop\n"                                                            \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n"                           \
+    ".balign 4\n"                                                           \
+    ".4byte 992f-991f, 994f-993f, 3\n"                                      \
+    "991: .asciz \"stapsdt\"\n"                                             \
+    "992: .balign 4\n"                                                      \
+    "993: .8byte 990b\n"                                                    \
+    ".8byte _.stapsdt.base\n"                                               \
+    ".8byte 0\n"                                                            \
+    ".asciz \"soliton\"\n"                                                  \
+    ".asciz \"" #name "\"\n"                                                \
+    ".asciz \"" args "\"\n"                                                 \
+    "994: .balign 4\n"                                                      \
+    ".popsection\n"                                                         \
+    ".ifndef _.stapsdt.base\n"                                              \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+    ".weak _.stapsdt.base\n"                                                \
+    ".hidden _.stapsdt.base\n"                                              \
+    "_.stapsdt.base: .space 1\n"                                            \
+    ".size _.stapsdt.base, 1\n"                                             \
+    ".popsection\n"                                                         \
+    ".endif\n"
+
+#define SOLITON_USDT_ARG(x) "nor" ((uint64_t)(uintptr_t)(x))
+
+#define SOLITON_PROBE2(name, x1, x2)                                        \
+    __asm__ __volatile__(SOLITON_USDT_NOTE(name, "8@%[a1] 8@%[a2]")         \
+                         :: [a1] SOLITON_USDT_ARG(x1), [a2] SOLITON_USDT_ARG(x2))
+
+#define SOLITON_PROBE3(name, x1, x2, x3)                                    \
+    __asm__ __volatile__(SOLITON_USDT_NOTE(name, "8@%[a1] 8@%[a2] 8@%[a3]") \
+                         :: [a1] SOLITON_USDT_ARG(x1), [a2] SOLITON_USDT_ARG(x2), \
+                            [a3] SOLITON_USDT_ARG(x3))
+
+/* Return through the <api>_return probe */
+#define SOLITON_RETURN(api, ctx, len, expr) do {                            \
+    const soliton_status usdt_st_ = (expr);                                 \
+    SOLITON_PROBE3(api##_return, ctx, len, usdt_st_);                       \
+    return usdt_st_;                                                        \
+} while (0)
+
+#else
+
+#define SOLITON_PROBE2(name, x1, x2) do { } while (0)
+#define SOLITON_PROBE3(name, x1, x2, x3) do { } while (0)
+#define SOLITON_RETURN(api, ctx, len, expr) return (expr)
+
+#endif
+
+#define SOLITON_PROBE_ENTRY(api, ctx, len) SOLITON_PROBE2(api##_entry, ctx, len)
+
+#endif /* SOLITON_USDT_H */
@@ -0,0 +1,100 @@
+/*
+ * xts_aesni.c - AES-256-XTS block kernels using AES-NI
+ * Eight independent blocks per iteration to cover the AESENC/AESDEC latency;
+ * tweaks are advanced in registers with the srai/shuffle carry trick.
+ * Also provides the AESIMC decryption key schedule shared with VAES
+ */
+
+#include "common.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#ifdef __AES__
+
+#include <wmmintrin.h>  /* AES-NI */
+#include <emmintrin.h>  /* SSE2 */
+
+/* t *= alpha: shift each qword left, carry bit 63 -> 64 and bit 127 -> 0x87 */
+static SOLITON_INLINE __m128i xts_mul_alpha_sse(__m128i t) {
+    const __m128i poly = _mm_set_epi32(0, 1, 0, 0x87);
+    __m128i carry = _mm_shuffle_epi32(_mm_srai_epi32(t, 31), 0x13);
+    return _mm_xor_si128(_mm_add_epi64(t, t), _mm_and_si128(carry, poly));
+}
+
+/* Decryption schedule for AESDEC: K14, IMC(K13) .. IMC(K1), K0 */
+void aes256_key_expand_dec_aesni(const uint32_t* enc_keys, uint32_t* dec_keys) {
+    const __m128i* rk = (const __m128i*)enc_keys;
+    __m128i* dk = (__m128i*)dec_keys;
+
+    _mm_storeu_si128(dk + 0, _mm_loadu_si128(rk + 14));
+    for (int r = 1; r < 14; r++) {
+        _mm_storeu_si128(dk + r, _mm_aesimc_si128(_mm_loadu_si128(rk + 14 - r)));
+    }
+    _mm_storeu_si128(dk + 14, _mm_loadu_si128(rk + 0));
+}
+
+#define XTS_AESNI_KERNEL(NAME, ROUND, LAST)                                          \
+void NAME(const uint32_t* round_keys, uint8_t tweak[16],                              \
+          const uint8_t* in, uint8_t* out, size_t blocks) {                           \
+    __m128i rk[15];                                                                   \
+    for (int i = 0; i < 15; i++) {                                                    \
+        rk[i] = _mm_loadu_si128((const __m128i*)(round_keys + i * 4));                \
+    }                                                                                 \
+    __m128i t = _mm_loadu_si128((const __m128i*)tweak);                               \
+                                                                                      \
+    while (blocks >= 8) {                                                             \
+        __m128i tw[8], s[8];                                                          \
+        for (int j = 0; j < 8; j++) {                                                 \
+            tw[j] = t;                                                                \
+            t = xts_mul_alpha_sse(t);                                                 \
+            s[j] = _mm_xor_si128(_mm_xor_si128(                                       \
+                _mm_loadu_si128((const __m128i*)(in + j * 16)), tw[j]), rk[0]);       \
+        }                                                                             \
+        for (int r = 1; r < 14; r++) {                                                \
+            for (int j = 0; j < 8; j++) {                                             \
+                s[j] = ROUND(s[j], rk[r]);                                            \
+            }                                                                         \
+        }                                                                             \
+        for (int j = 0; j < 8; j++) {                                                 \
+            s[j] = _mm_xor_si128(LAST(s[j], rk[14]), tw[j]);                          \
+            _mm_storeu_si128((__m128i*)(out + j * 16), s[j]);                         \
+        }                                                                             \
+        in += 128;                                                                    \
+        out += 128;                                                                   \
+        blocks -= 8;                                                                  \
+    }                                                                                 \
+                                                                                      \
+    while (blocks > 0) {                                                              \
+        __m128i s = _mm_xor_si128(_mm_xor_si128(                                      \
+            _mm_loadu_si128((const __m128i*)in), t), rk[0]);                          \
+        for (int r = 1; r < 14; r++) {                                                \
+            s = ROUND(s, rk[r]);                                                      \
+        }                                                                             \
+        _mm_storeu_si128((__m128i*)out, _mm_xor_si128(LAST(s, rk[14]), t));           \
+        t = xts_mul_alpha_sse(t);                                                     \
+        in += 16;                                                                     \
+        out += 16;                                                                    \
+        blocks--;                                                                     \
+    }                                                                                 \
+                                                                                      \
+    _mm_storeu_si128((__m128i*)tweak, t);                                             \
+}
+
+XTS_AESNI_KERNEL(aes256_xts_encrypt_blocks_aesni, _mm_aesenc_si128, _mm_aesenclast_si128)
+XTS_AESNI_KERNEL(aes256_xts_decrypt_blocks_aesni, _mm_aesdec_si128, _mm_aesdeclast_si128)
+
+extern void aes256_key_expand_aesni(const uint8_t key[32], uint32_t* round_keys);
+extern void aes256_encrypt_block_aesni(const uint32_t* round_keys, const uint8_t in[16], uint8_t out[16]);
+
+/* Backend structure for AES-NI XTS */
+extern soliton_xts_backend_t backend_xts_aesni;
+soliton_xts_backend_t backend_xts_aesni = {
+    .key_expand = aes256_key_expand_aesni,
+    .key_expand_dec = aes256_key_expand_dec_aesni,
+    .encrypt_block = aes256_encrypt_block_aesni,
+    .encrypt_blocks = aes256_xts_encrypt_blocks_aesni,
+    .decrypt_blocks = aes256_xts_decrypt_blocks_aesni,
+    .name = "xts_aesni"
+};
+
+#endif /* __AES__ */
+#endif /* __x86_64__ || __i386__ */
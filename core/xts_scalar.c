@@ -0,0 +1,59 @@
+/*
+ * xts_scalar.c - AES-256-XTS block kernels on the table-free scalar AES
+ * One block at a time: C = E_K1(P ^ T) ^ T, then T *= alpha.
+ * Freestanding C17 - reference for the vector backends
+ */
+
+#include "common.h"
+
+extern void aes256_key_expand_scalar(const uint8_t key[32], uint32_t round_keys[60]);
+extern void aes256_key_expand_dec_scalar(const uint32_t enc_keys[60], uint32_t dec_keys[60]);
+extern void aes256_encrypt_block_scalar(const uint32_t* round_keys, const uint8_t in[16], uint8_t out[16]);
+extern void aes256_decrypt_block_scalar(const uint32_t* dec_keys, const uint8_t in[16], uint8_t out[16]);
+
+void aes256_xts_encrypt_blocks_scalar(const uint32_t* round_keys, uint8_t tweak[16],
+                                      const uint8_t* in, uint8_t* out, size_t blocks) {
+    uint8_t x[16];
+
+    for (size_t b = 0; b < blocks; b++) {
+        for (int i = 0; i < 16; i++) {
+            x[i] = in[b * 16 + i] ^ tweak[i];
+        }
+        aes256_encrypt_block_scalar(round_keys, x, x);
+        for (int i = 0; i < 16; i++) {
+            out[b * 16 + i] = x[i] ^ tweak[i];
+        }
+        soliton_xts_mul_alpha(tweak);
+    }
+
+    soliton_wipe(x, sizeof(x));
+}
+
+void aes256_xts_decrypt_blocks_scalar(const uint32_t* dec_keys, uint8_t tweak[16],
+                                      const uint8_t* in, uint8_t* out, size_t blocks) {
+    uint8_t x[16];
+
+    for (size_t b = 0; b < blocks; b++) {
+        for (int i = 0; i < 16; i++) {
+            x[i] = in[b * 16 + i] ^ tweak[i];
+        }
+        aes256_decrypt_block_scalar(dec_keys, x, x);
+        for (int i = 0; i < 16; i++) {
+            out[b * 16 + i] = x[i] ^ tweak[i];
+        }
+        soliton_xts_mul_alpha(tweak);
+    }
+
+    soliton_wipe(x, sizeof(x));
+}
+
+/* Backend structure for scalar XTS */
+extern soliton_xts_backend_t backend_xts_scalar;
+soliton_xts_backend_t backend_xts_scalar = {
+    .key_expand = aes256_key_expand_scalar,
+    .key_expand_dec = aes256_key_expand_dec_scalar,
+    .encrypt_block = aes256_encrypt_block_scalar,
+    .encrypt_blocks = aes256_xts_encrypt_blocks_scalar,
+    .decrypt_blocks = aes256_xts_decrypt_blocks_scalar,
+    .name = "xts_scalar"
+};
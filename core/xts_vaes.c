@@ -0,0 +1,96 @@
+/*
+ * xts_vaes.c - AES-256-XTS block kernels using VAES (YMM)
+ * Two blocks per register, 16 blocks per iteration in 8 YMM registers.
+ * Tweaks for the next register are T * alpha^2, two in-register alpha
+ * steps on both lanes; the < 16 block tail runs on the AES-NI kernel
+ */
+
+#include "common.h"
+
+#ifdef __x86_64__
+
+#include <immintrin.h>
+
+#if defined(__VAES__) && defined(__AES__) && defined(__AVX2__)
+
+/* Both lanes *= alpha (same carry trick as the SSE version, per 128-bit lane) */
+static SOLITON_INLINE __m256i xts_mul_alpha_avx2(__m256i t) {
+    const __m256i poly = _mm256_set_epi32(0, 1, 0, 0x87, 0, 1, 0, 0x87);
+    __m256i carry = _mm256_shuffle_epi32(_mm256_srai_epi32(t, 31), 0x13);
+    return _mm256_xor_si256(_mm256_add_epi64(t, t), _mm256_and_si256(carry, poly));
+}
+
+static SOLITON_INLINE __m128i xts_mul_alpha_sse(__m128i t) {
+    const __m128i poly = _mm_set_epi32(0, 1, 0, 0x87);
+    __m128i carry = _mm_shuffle_epi32(_mm_srai_epi32(t, 31), 0x13);
+    return _mm_xor_si128(_mm_add_epi64(t, t), _mm_and_si128(carry, poly));
+}
+
+extern void aes256_xts_encrypt_blocks_aesni(const uint32_t*, uint8_t*, const uint8_t*, uint8_t*, size_t);
+extern void aes256_xts_decrypt_blocks_aesni(const uint32_t*, uint8_t*, const uint8_t*, uint8_t*, size_t);
+
+#define XTS_VAES_KERNEL(NAME, ROUND, LAST, TAIL)                                      \
+void NAME(const uint32_t* round_keys, uint8_t tweak[16],                              \
+          const uint8_t* in, uint8_t* out, size_t blocks) {                           \
+    if (blocks >= 16) {                                                               \
+        __m256i rk[15];                                                               \
+        for (int i = 0; i < 15; i++) {                                                \
+            rk[i] = _mm256_broadcastsi128_si256(                                      \
+                _mm_loadu_si128((const __m128i*)(round_keys + i * 4)));               \
+        }                                                                             \
+        const __m128i t0 = _mm_loadu_si128((const __m128i*)tweak);                    \
+        __m256i t = _mm256_setr_m128i(t0, xts_mul_alpha_sse(t0));                     \
+                                                                                      \
+        while (blocks >= 16) {                                                        \
+            __m256i tw[8], s[8];                                                      \
+            for (int j = 0; j < 8; j++) {                                             \
+                tw[j] = t;                                                            \
+                t = xts_mul_alpha_avx2(xts_mul_alpha_avx2(t));                        \
+                s[j] = _mm256_xor_si256(_mm256_xor_si256(                             \
+                    _mm256_loadu_si256((const __m256i*)(in + j * 32)), tw[j]), rk[0]);\
+            }                                                                         \
+            for (int r = 1; r < 14; r++) {                                            \
+                for (int j = 0; j < 8; j++) {                                         \
+                    s[j] = ROUND(s[j], rk[r]);                                        \
+                }                                                                     \
+            }                                                                         \
+            for (int j = 0; j < 8; j++) {                                             \
+                _mm256_storeu_si256((__m256i*)(out + j * 32),                         \
+                                    _mm256_xor_si256(LAST(s[j], rk[14]), tw[j]));     \
+            }                                                                         \
+            in += 256;                                                                \
+            out += 256;                                                               \
+            blocks -= 16;                                                             \
+        }                                                                             \
+                                                                                      \
+        /* Low lane holds the tweak of the next block */                              \
+        _mm_storeu_si128((__m128i*)tweak, _mm256_castsi256_si128(t));                 \
+    }                                                                                 \
+                                                                                      \
+    if (blocks > 0) {                                                                 \
+        TAIL(round_keys, tweak, in, out, blocks);                                     \
+    }                                                                                 \
+}
+
+XTS_VAES_KERNEL(aes256_xts_encrypt_blocks_vaes, _mm256_aesenc_epi128, _mm256_aesenclast_epi128,
+                aes256_xts_encrypt_blocks_aesni)
+XTS_VAES_KERNEL(aes256_xts_decrypt_blocks_vaes, _mm256_aesdec_epi128, _mm256_aesdeclast_epi128,
+                aes256_xts_decrypt_blocks_aesni)
+
+extern void aes256_key_expand_aesni(const uint8_t key[32], uint32_t* round_keys);
+extern void aes256_key_expand_dec_aesni(const uint32_t* enc_keys, uint32_t* dec_keys);
+extern void aes256_encrypt_block_aesni(const uint32_t* round_keys, const uint8_t in[16], uint8_t out[16]);
+
+/* Backend structure for VAES XTS */
+extern soliton_xts_backend_t backend_xts_vaes;
+soliton_xts_backend_t backend_xts_vaes = {
+    .key_expand = aes256_key_expand_aesni,
+    .key_expand_dec = aes256_key_expand_dec_aesni,
+    .encrypt_block = aes256_encrypt_block_aesni,
+    .encrypt_blocks = aes256_xts_encrypt_blocks_vaes,
+    .decrypt_blocks = aes256_xts_decrypt_blocks_vaes,
+    .name = "xts_vaes"
+};
+
+#endif /* __VAES__ && __AES__ && __AVX2__ */
+#endif /* __x86_64__ */
@@ -0,0 +1,166 @@
+/*
+ * ab_experiment.c - A/B assignment of GCM encrypt plans and per-arm reports
+ * Hosted (POSIX) - the core does the sampling; this file assigns contexts
+ * and turns the samples into per-size-class deltas
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "soliton_hosted.h"
+
+struct soliton_ab_experiment {
+    soliton_ab_samples* samples;    /* Attached to the core (ab_live) */
+    soliton_ab_config   cfg;
+    uint64_t            enrolled[SOLITON_AB_ARMS];
+    int                 killed;
+};
+
+/* Sample block shared by every experiment, cache-line aligned. gcm_ab_sample
+ * may still hold a pointer it loaded before soliton_ab_stop detached, so
+ * the block lives as long as the process and experiments run one at a time. */
+static soliton_ab_samples ab_live __attribute__((aligned(64)));
+static int experiment_active = 0;
+
+/* splitmix64 finalizer: key ids are often sequential */
+static uint64_t ab_mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+unsigned soliton_ab_arm(const soliton_ab_config* cfg, const void* ctx, uint64_t key_id) {
+    const uint64_t id = key_id ? key_id : (uint64_t)(uintptr_t)ctx;
+    return ab_mix(id ^ ab_mix(cfg->salt)) % 1000000u < cfg->treatment_ppm;
+}
+
+soliton_status soliton_ab_start(const soliton_ab_config* cfg, soliton_ab_experiment** out) {
+    if (!cfg || !out || (unsigned)cfg->control > SOLITON_GCM_PLAN_PIPELINED16 ||
+        (unsigned)cfg->treatment > SOLITON_GCM_PLAN_PIPELINED16 || cfg->treatment_ppm > 1000000u ||
+        cfg->sample_every == 0 || (cfg->sample_every & (cfg->sample_every - 1)) != 0) {
+        return SOLITON_INVALID_INPUT;
+    }
+    *out = NULL;
+    if (__atomic_exchange_n(&experiment_active, 1, __ATOMIC_ACQUIRE)) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    soliton_ab_experiment* exp = calloc(1, sizeof(*exp));
+    if (!exp) {
+        __atomic_store_n(&experiment_active, 0, __ATOMIC_RELEASE);
+        return SOLITON_INTERNAL_ERROR;
+    }
+
+    /* Reset with atomic stores: late samples of the previous experiment
+     * can still land here */
+    uint64_t* words = (uint64_t*)&ab_live;
+    for (size_t i = 0; i < sizeof(ab_live) / sizeof(uint64_t); i++) {
+        __atomic_store_n(&words[i], 0, __ATOMIC_RELAXED);
+    }
+    exp->samples = &ab_live;
+    exp->cfg = *cfg;
+
+    /* The kill switch is left as it is: only the operator re-arms it */
+    soliton_ab_samples_attach(exp->samples, cfg->sample_every);
+    *out = exp;
+    return SOLITON_OK;
+}
+
+soliton_status soliton_ab_enroll(soliton_ab_experiment* exp, soliton_aesgcm_ctx* ctx, uint64_t key_id) {
+    if (!exp || !ctx) {
+        return SOLITON_INVALID_INPUT;
+    }
+    if (__atomic_load_n(&exp->killed, __ATOMIC_RELAXED)) {
+        return SOLITON_OK;
+    }
+
+    const unsigned arm = soliton_ab_arm(&exp->cfg, ctx, key_id);
+    soliton_status st = soliton_aesgcm_set_plan(ctx, arm ? exp->cfg.treatment : exp->cfg.control);
+    if (st != SOLITON_OK) {
+        return st;
+    }
+    soliton_aesgcm_set_ab_arm(ctx, arm);
+    __atomic_fetch_add(&exp->enrolled[arm], 1, __ATOMIC_RELAXED);
+    return SOLITON_OK;
+}
+
+void soliton_ab_kill(soliton_ab_experiment* exp) {
+    soliton_plan_variants_enable(0);
+    if (exp) {
+        __atomic_store_n(&exp->killed, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/* Mean and sample variance of n samples from the core's sums */
+static void ab_moments(uint64_t n, uint64_t cycles, uint64_t cycles_sq, double* mean, double* var) {
+    *mean = n ? (double)cycles / (double)n : 0;
+    *var = 0;
+    if (n > 1) {
+        /* cycles_sq holds round(cycles / 16)^2 */
+        const double mq = *mean / 16;
+        const double vq = ((double)cycles_sq / (double)n - mq * mq) * (double)n / (double)(n - 1);
+        *var = vq > 0 ? vq * 256 : 0;
+    }
+}
+
+void soliton_ab_summarize(const soliton_ab_samples* samples, soliton_ab_report* out) {
+    memset(out, 0, sizeof(*out));
+
+    for (unsigned c = 0; c < SOLITON_AB_CLASSES; c++) {
+        soliton_ab_class_report* r = &out->classes[c];
+        double mean[SOLITON_AB_ARMS], var[SOLITON_AB_ARMS];
+
+        r->size_min = c == 0 ? 0 : (uint64_t)1 << (2 * c - 1);
+        r->size_max = c == SOLITON_AB_CLASSES - 1 ? UINT64_MAX : ((uint64_t)1 << (2 * c + 1)) - 1;
+
+        for (unsigned arm = 0; arm < SOLITON_AB_ARMS; arm++) {
+            const uint64_t n = __atomic_load_n(&samples->calls[arm][c], __ATOMIC_RELAXED);
+            const uint64_t bytes = __atomic_load_n(&samples->bytes[arm][c], __ATOMIC_RELAXED);
+            const uint64_t cycles = __atomic_load_n(&samples->cycles[arm][c], __ATOMIC_RELAXED);
+            const uint64_t sq = __atomic_load_n(&samples->cycles_sq[arm][c], __ATOMIC_RELAXED);
+            r->calls[arm] = n;
+            ab_moments(n, cycles, sq, &mean[arm], &var[arm]);
+            r->mean_cycles[arm] = mean[arm];
+            r->cycles_per_byte[arm] = bytes ? (double)cycles / (double)bytes : 0;
+        }
+
+        if (r->calls[0] < 2 || r->calls[1] < 2 || mean[0] <= 0) {
+            continue;
+        }
+        /* Welch: difference of means over the control mean */
+        const double se = sqrt(var[0] / (double)r->calls[0] + var[1] / (double)r->calls[1]);
+        r->delta_pct = 100.0 * (mean[1] - mean[0]) / mean[0];
+        r->ci95_pct = 100.0 * 1.96 * se / mean[0];
+        r->significant = r->calls[0] >= SOLITON_AB_MIN_CALLS && r->calls[1] >= SOLITON_AB_MIN_CALLS &&
+                         fabs(r->delta_pct) > r->ci95_pct;
+    }
+
+    for (unsigned arm = 0; arm < SOLITON_AB_ARMS; arm++) {
+        out->outliers[arm] = __atomic_load_n(&samples->outliers[arm], __ATOMIC_RELAXED);
+    }
+}
+
+soliton_status soliton_ab_read(const soliton_ab_experiment* exp, soliton_ab_report* out) {
+    if (!exp || !out) {
+        return SOLITON_INVALID_INPUT;
+    }
+    soliton_ab_summarize(exp->samples, out);
+    for (unsigned arm = 0; arm < SOLITON_AB_ARMS; arm++) {
+        out->enrolled[arm] = __atomic_load_n(&exp->enrolled[arm], __ATOMIC_RELAXED);
+    }
+    out->killed = __atomic_load_n(&exp->killed, __ATOMIC_RELAXED);
+    return SOLITON_OK;
+}
+
+void soliton_ab_stop(soliton_ab_experiment* exp) {
+    if (!exp) {
+        return;
+    }
+    soliton_ab_samples_attach(NULL, 0);
+    free(exp);
+    __atomic_store_n(&experiment_active, 0, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,123 @@
+/*
+ * cost_ledger.c - Per-tenant merge of AES-GCM cost counters
+ * Hosted (POSIX) - rows are heap allocated, kept sorted by tenant id
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "soliton_hosted.h"
+
+static void cost_add(soliton_aesgcm_cost* dst, const soliton_aesgcm_cost* src) {
+    dst->enc_messages   += src->enc_messages;
+    dst->dec_messages   += src->dec_messages;
+    dst->enc_bytes      += src->enc_bytes;
+    dst->dec_bytes      += src->dec_bytes;
+    dst->aad_bytes      += src->aad_bytes;
+    dst->auth_failures  += src->auth_failures;
+    dst->calls          += src->calls;
+    dst->sampled_calls  += src->sampled_calls;
+    dst->sampled_cycles += src->sampled_cycles;
+}
+
+/* Index of the first row with id >= tenant */
+static size_t ledger_lower_bound(const soliton_cost_ledger* ledger, uint64_t tenant) {
+    size_t lo = 0, hi = ledger->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (ledger->entries[mid].tenant < tenant) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void soliton_cost_ledger_init(soliton_cost_ledger* ledger) {
+    if (ledger) {
+        memset(ledger, 0, sizeof(*ledger));
+    }
+}
+
+soliton_status soliton_cost_ledger_merge(
+    soliton_cost_ledger* ledger, uint64_t tenant,
+    const soliton_aesgcm_cost* cost) {
+
+    if (!ledger || !cost) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    size_t i = ledger_lower_bound(ledger, tenant);
+    if (i < ledger->count && ledger->entries[i].tenant == tenant) {
+        cost_add(&ledger->entries[i].cost, cost);
+        return SOLITON_OK;
+    }
+
+    if (ledger->count == ledger->capacity) {
+        size_t cap = ledger->capacity ? ledger->capacity * 2 : 16;
+        soliton_cost_entry* grown = realloc(ledger->entries, cap * sizeof(*grown));
+        if (!grown) {
+            return SOLITON_INTERNAL_ERROR;
+        }
+        ledger->entries = grown;
+        ledger->capacity = cap;
+    }
+
+    memmove(&ledger->entries[i + 1], &ledger->entries[i],
+            (ledger->count - i) * sizeof(ledger->entries[0]));
+    ledger->entries[i].tenant = tenant;
+    ledger->entries[i].cost = *cost;
+    ledger->count++;
+    return SOLITON_OK;
+}
+
+soliton_status soliton_cost_ledger_harvest(
+    soliton_cost_ledger* ledger, uint64_t tenant,
+    soliton_aesgcm_ctx* ctx) {
+
+    soliton_aesgcm_cost cost;
+
+    if (!ledger) {
+        return SOLITON_INVALID_INPUT;
+    }
+    soliton_status st = soliton_aesgcm_cost_read(ctx, &cost);
+    if (st != SOLITON_OK) {
+        return st;
+    }
+    /* Zero the context only once the row has taken the counts */
+    st = soliton_cost_ledger_merge(ledger, tenant, &cost);
+    if (st == SOLITON_OK) {
+        soliton_aesgcm_cost_take(ctx, &cost);
+    }
+    return st;
+}
+
+const soliton_aesgcm_cost* soliton_cost_ledger_get(
+    const soliton_cost_ledger* ledger, uint64_t tenant) {
+
+    if (!ledger) {
+        return NULL;
+    }
+    size_t i = ledger_lower_bound(ledger, tenant);
+    if (i < ledger->count && ledger->entries[i].tenant == tenant) {
+        return &ledger->entries[i].cost;
+    }
+    return NULL;
+}
+
+void soliton_cost_ledger_free(soliton_cost_ledger* ledger) {
+    if (ledger) {
+        free(ledger->entries);
+        memset(ledger, 0, sizeof(*ledger));
+    }
+}
+
+uint64_t soliton_cost_estimated_cycles(const soliton_aesgcm_cost* cost) {
+    if (!cost || cost->sampled_calls == 0) {
+        return 0;
+    }
+    /* Scale in floating point: calls * cycles can overflow 64 bits */
+    return (uint64_t)((double)cost->sampled_cycles * (double)cost->calls /
+                      (double)cost->sampled_calls);
+}
@@ -0,0 +1,508 @@
+/*
+ * gcm_pool.c - Parallel AES-GCM seal_many/open_many on a work-stealing pool
+ * Hosted (POSIX threads) - whole messages per thread through the checked API
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "soliton_hosted.h"
+
+/* Runs dealt per worker: slack for stealing to even out a skewed mix */
+#define POOL_RUNS_PER_WORKER 8
+/* Reset, final and tag of one message, in bytes of bulk work, when sizing runs */
+#define POOL_MSG_OVERHEAD 256u
+
+/* A run: messages [begin, end) of the job, processed by one worker */
+typedef struct {
+    size_t   begin;
+    size_t   end;
+    uint64_t cost;              /* Bytes plus per-message overhead */
+} pool_run;
+
+/* Chase-Lev deque over a fixed slice of the job's runs. Nothing is pushed
+ * while a job runs, so there is no resize: the owner pops at bottom,
+ * thieves take from top. */
+typedef struct {
+    const pool_run* runs;
+    int64_t         top;
+    int64_t         bottom;
+} pool_deque;
+
+/* Job shared by every worker; set up before the helpers are woken */
+typedef struct {
+    const uint8_t*   key;
+    soliton_gcm_msg* msgs;      /* const for open */
+    soliton_status*  status;
+    int              decrypt;
+    size_t           runs_left; /* Runs not yet taken by any worker */
+    uint64_t         first_fail;/* min(index << 3 | status) of failures */
+} pool_job;
+
+typedef struct {
+    soliton_gcm_pool*      pool;
+    unsigned               id;
+    pthread_t              thread;
+    uint8_t*               ctx_buf;     /* SOLITON_AESGCM_CTX_BYTES, 64B aligned */
+    uint64_t               rng;         /* Victim choice */
+    soliton_gcm_pool_stats stats;
+    pool_deque             dq;
+} __attribute__((aligned(64))) pool_worker;
+
+struct soliton_gcm_pool {
+    unsigned        nworkers;
+    unsigned        started;    /* Helper threads running (1..started) */
+    pool_worker*    workers;    /* workers[0] is the calling thread */
+    pool_run*       runs;
+    size_t          runs_cap;
+    pthread_mutex_t job_lock;   /* One job at a time */
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+    pthread_cond_t  done;
+    uint64_t        generation; /* Bumped per job */
+    unsigned        busy;       /* Helpers still in the current job */
+    int             shutdown;
+    pool_job        job;
+};
+
+static void pool_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    sched_yield();
+#endif
+}
+
+/* Owner end: the last run, or NULL once a thief emptied the deque */
+static const pool_run* deque_pop(pool_deque* dq) {
+    const int64_t b = __atomic_load_n(&dq->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&dq->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t t = __atomic_load_n(&dq->top, __ATOMIC_RELAXED);
+
+    if (t > b) {
+        __atomic_store_n(&dq->bottom, b + 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    const pool_run* run = &dq->runs[b];
+    if (t == b) {
+        /* Last run: race the thieves for it */
+        if (!__atomic_compare_exchange_n(&dq->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            run = NULL;
+        }
+        __atomic_store_n(&dq->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+    return run;
+}
+
+/* Thief end: the first run, or NULL if empty or another thief won */
+static const pool_run* deque_steal(pool_deque* dq) {
+    int64_t t = __atomic_load_n(&dq->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    const int64_t b = __atomic_load_n(&dq->bottom, __ATOMIC_ACQUIRE);
+
+    if (t >= b) {
+        return NULL;
+    }
+    const pool_run* run = &dq->runs[t];
+    if (!__atomic_compare_exchange_n(&dq->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+        return NULL;
+    }
+    return run;
+}
+
+/* One message, whole, on this thread's context */
+static soliton_status pool_msg(soliton_aesgcm_ctx* ctx, const pool_job* job, soliton_gcm_msg* m) {
+    soliton_status st = soliton_aesgcm_reset(ctx, m->iv, sizeof(m->iv));
+    if (st == SOLITON_OK) {
+        st = soliton_aesgcm_aad_update(ctx, m->aad, m->aad_len);
+    }
+    if (st != SOLITON_OK) {
+        return st;
+    }
+
+    if (!job->decrypt) {
+        st = soliton_aesgcm_encrypt_update(ctx, m->in, m->out, m->len);
+        return st == SOLITON_OK ? soliton_aesgcm_encrypt_final(ctx, m->tag) : st;
+    }
+    st = soliton_aesgcm_decrypt_update(ctx, m->in, m->out, m->len);
+    if (st == SOLITON_OK) {
+        st = soliton_aesgcm_decrypt_final(ctx, m->tag);
+    }
+    if (st == SOLITON_AUTH_FAIL && m->len > 0) {
+        memset(m->out, 0, m->len);
+    }
+    return st;
+}
+
+static void pool_record_fail(pool_job* job, size_t index, soliton_status st) {
+    const uint64_t mine = (uint64_t)index << 3 | (uint64_t)st;
+    uint64_t cur = __atomic_load_n(&job->first_fail, __ATOMIC_RELAXED);
+    while (mine < cur &&
+           !__atomic_compare_exchange_n(&job->first_fail, &cur, mine, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+/* Messages [begin, end) never ran: no context or no memory */
+static void pool_fail_range(pool_job* job, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        if (job->status) {
+            job->status[i] = SOLITON_INTERNAL_ERROR;
+        }
+        pool_record_fail(job, i, SOLITON_INTERNAL_ERROR);
+    }
+}
+
+static void pool_do_run(soliton_aesgcm_ctx* ctx, pool_job* job, size_t begin, size_t end,
+                        soliton_gcm_pool_stats* stats) {
+    uint64_t bytes = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        soliton_gcm_msg* m = &job->msgs[i];
+        const soliton_status st = pool_msg(ctx, job, m);
+        if (job->status) {
+            job->status[i] = st;
+        }
+        if (st != SOLITON_OK) {
+            pool_record_fail(job, i, st);
+        }
+        bytes += m->len + m->aad_len;
+    }
+    __atomic_fetch_add(&stats->messages, end - begin, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->bytes, bytes, __ATOMIC_RELAXED);
+}
+
+/* Key this worker's context for the job (zero IV; every message resets) */
+static soliton_aesgcm_ctx* pool_ctx_open(uint8_t* buf, const uint8_t* key) {
+    static const uint8_t zero_iv[12];
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)buf;
+    return soliton_aesgcm_init(ctx, key, zero_iv, sizeof(zero_iv)) == SOLITON_OK ? ctx : NULL;
+}
+
+/* Another worker's run, victims scanned from a random start */
+static const pool_run* pool_steal(pool_worker* w) {
+    soliton_gcm_pool* pool = w->pool;
+    const unsigned n = pool->nworkers;
+
+    w->rng ^= w->rng << 13;
+    w->rng ^= w->rng >> 7;
+    w->rng ^= w->rng << 17;
+    const unsigned start = (unsigned)(w->rng % n);
+
+    for (unsigned k = 0; k < n; k++) {
+        const unsigned v = (start + k) % n;
+        if (v == w->id) {
+            continue;
+        }
+        const pool_run* run = deque_steal(&pool->workers[v].dq);
+        if (run) {
+            return run;
+        }
+    }
+    return NULL;
+}
+
+/* Drain own deque, then steal until every run of the job has been taken */
+static void pool_work(pool_worker* w) {
+    pool_job* job = &w->pool->job;
+    soliton_aesgcm_ctx* ctx = NULL;
+    int took = 0;
+
+    for (;;) {
+        const pool_run* run = deque_pop(&w->dq);
+        if (!run) {
+            if (__atomic_load_n(&job->runs_left, __ATOMIC_ACQUIRE) == 0) {
+                break;
+            }
+            run = pool_steal(w);
+            if (!run) {
+                pool_relax();
+                continue;
+            }
+            __atomic_fetch_add(&w->stats.steals, 1, __ATOMIC_RELAXED);
+        }
+        __atomic_fetch_sub(&job->runs_left, 1, __ATOMIC_RELEASE);
+        took = 1;
+
+        if (!ctx && !(ctx = pool_ctx_open(w->ctx_buf, job->key))) {
+            pool_fail_range(job, run->begin, run->end);
+            continue;
+        }
+        pool_do_run(ctx, job, run->begin, run->end, &w->stats);
+    }
+
+    if (took) {
+        __atomic_fetch_add(&w->stats.jobs, 1, __ATOMIC_RELAXED);
+    }
+    if (ctx) {
+        soliton_aesgcm_context_wipe(ctx);
+    }
+}
+
+static void* pool_helper(void* arg) {
+    pool_worker* w = arg;
+    soliton_gcm_pool* pool = w->pool;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        pool_work(w);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy == 0) {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* Cut the job into runs of about total / (workers * RUNS_PER_WORKER) bytes
+ * and deal contiguous slices of equal bytes to the workers' deques */
+static void pool_deal(soliton_gcm_pool* pool, size_t count, uint64_t total) {
+    const unsigned n = pool->nworkers;
+    const uint64_t target = total / ((uint64_t)n * POOL_RUNS_PER_WORKER) + 1;
+    const soliton_gcm_msg* msgs = pool->job.msgs;
+    size_t nruns = 0, begin = 0;
+    uint64_t acc = 0, run_start = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        acc += msgs[i].len + msgs[i].aad_len + POOL_MSG_OVERHEAD;
+        if (acc >= target * (nruns + 1) || i + 1 == count) {
+            pool->runs[nruns].begin = begin;
+            pool->runs[nruns].end = i + 1;
+            pool->runs[nruns].cost = acc - run_start;
+            nruns++;
+            begin = i + 1;
+            run_start = acc;
+        }
+    }
+
+    /* Worker w owns the runs up to the end of its 1/n share of the bytes */
+    size_t r = 0;
+    acc = 0;
+    for (unsigned w = 0; w < n; w++) {
+        pool_deque* dq = &pool->workers[w].dq;
+        const size_t first = r;
+        const double limit = (double)total * (double)(w + 1) / (double)n;
+
+        while (r < nruns && (w + 1 == n || (double)acc < limit)) {
+            acc += pool->runs[r++].cost;
+        }
+        dq->runs = pool->runs + first;
+        dq->top = 0;
+        dq->bottom = (int64_t)(r - first);
+    }
+    pool->job.runs_left = nruns;
+}
+
+static soliton_status pool_many(soliton_gcm_pool* pool, const uint8_t* key, soliton_gcm_msg* msgs,
+                                size_t count, soliton_status* status, int decrypt) {
+    if (!key || (!msgs && count > 0)) {
+        return SOLITON_INVALID_INPUT;
+    }
+    if (count == 0) {
+        return SOLITON_OK;
+    }
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += msgs[i].len + msgs[i].aad_len + POOL_MSG_OVERHEAD;
+    }
+
+    pool_job job = {
+        .key = key, .msgs = msgs, .status = status, .decrypt = decrypt, .first_fail = UINT64_MAX,
+    };
+
+    /* Serial: no pool, one worker, or too little work to wake the helpers */
+    if (!pool || pool->nworkers == 1 || total < SOLITON_POOL_SERIAL_BYTES) {
+        uint8_t local_buf[SOLITON_AESGCM_CTX_BYTES] __attribute__((aligned(64)));
+        soliton_gcm_pool_stats local_stats = {0};
+        soliton_gcm_pool_stats* stats = pool ? &pool->workers[0].stats : &local_stats;
+        uint8_t* buf = local_buf;
+
+        if (pool) {
+            pthread_mutex_lock(&pool->job_lock);
+            buf = pool->workers[0].ctx_buf;
+        }
+        soliton_aesgcm_ctx* ctx = pool_ctx_open(buf, key);
+        if (ctx) {
+            pool_do_run(ctx, &job, 0, count, stats);
+            __atomic_fetch_add(&stats->jobs, 1, __ATOMIC_RELAXED);
+            soliton_aesgcm_context_wipe(ctx);
+        }
+        if (pool) {
+            pthread_mutex_unlock(&pool->job_lock);
+        }
+        if (!ctx) {
+            pool_fail_range(&job, 0, count);
+            return SOLITON_INTERNAL_ERROR;
+        }
+        return job.first_fail == UINT64_MAX ? SOLITON_OK : (soliton_status)(job.first_fail & 7);
+    }
+
+    pthread_mutex_lock(&pool->job_lock);
+    if (count > pool->runs_cap) {
+        pool_run* runs = realloc(pool->runs, count * sizeof(*runs));
+        if (!runs) {
+            pthread_mutex_unlock(&pool->job_lock);
+            pool_fail_range(&job, 0, count);
+            return SOLITON_INTERNAL_ERROR;
+        }
+        pool->runs = runs;
+        pool->runs_cap = count;
+    }
+    pool->job = job;
+    pool_deal(pool, count, total);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->busy = pool->nworkers - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    pool_work(&pool->workers[0]);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    const uint64_t fail = pool->job.first_fail;
+    pthread_mutex_unlock(&pool->job_lock);
+    return fail == UINT64_MAX ? SOLITON_OK : (soliton_status)(fail & 7);
+}
+
+soliton_status soliton_aesgcm_seal_many(
+    soliton_gcm_pool* pool, const uint8_t key[SOLITON_AESGCM_KEY_BYTES],
+    soliton_gcm_msg* msgs, size_t count, soliton_status* status) {
+    return pool_many(pool, key, msgs, count, status, 0);
+}
+
+soliton_status soliton_aesgcm_open_many(
+    soliton_gcm_pool* pool, const uint8_t key[SOLITON_AESGCM_KEY_BYTES],
+    const soliton_gcm_msg* msgs, size_t count, soliton_status* status) {
+    /* Open only reads the tag; out buffers are the caller's to write */
+    return pool_many(pool, key, (soliton_gcm_msg*)msgs, count, status, 1);
+}
+
+soliton_status soliton_gcm_pool_create(unsigned threads, int pin, soliton_gcm_pool** out) {
+    if (!out) {
+        return SOLITON_INVALID_INPUT;
+    }
+    *out = NULL;
+
+    cpu_set_t mask;
+    int cpus[CPU_SETSIZE], ncpus = 0;
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; c++) {
+            if (CPU_ISSET(c, &mask)) {
+                cpus[ncpus++] = c;
+            }
+        }
+    }
+    if (threads == 0) {
+        threads = ncpus > 0 ? (unsigned)ncpus : 1;
+    }
+
+    soliton_gcm_pool* pool = calloc(1, sizeof(*pool));
+    pool_worker* workers = pool ? aligned_alloc(64, threads * sizeof(*workers)) : NULL;
+    if (!workers) {
+        free(pool);
+        return SOLITON_INTERNAL_ERROR;
+    }
+    memset(workers, 0, threads * sizeof(*workers));
+    pool->workers = workers;
+    pool->nworkers = threads;
+    pthread_mutex_init(&pool->job_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    for (unsigned i = 0; i < threads; i++) {
+        workers[i].pool = pool;
+        workers[i].id = i;
+        workers[i].rng = 0x9e3779b97f4a7c15ull * (i + 1);
+        workers[i].ctx_buf = aligned_alloc(64, SOLITON_AESGCM_CTX_BYTES);
+        if (!workers[i].ctx_buf) {
+            soliton_gcm_pool_destroy(pool);
+            return SOLITON_INTERNAL_ERROR;
+        }
+    }
+
+    for (unsigned i = 1; i < threads; i++) {
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (pin && ncpus > 0) {
+            cpu_set_t one;
+            CPU_ZERO(&one);
+            CPU_SET(cpus[i % (unsigned)ncpus], &one);
+            pthread_attr_setaffinity_np(&attr, sizeof(one), &one);
+        }
+        const int rc = pthread_create(&workers[i].thread, &attr, pool_helper, &workers[i]);
+        pthread_attr_destroy(&attr);
+        if (rc != 0) {
+            soliton_gcm_pool_destroy(pool);
+            return SOLITON_INTERNAL_ERROR;
+        }
+        pool->started = i;
+    }
+
+    *out = pool;
+    return SOLITON_OK;
+}
+
+void soliton_gcm_pool_destroy(soliton_gcm_pool* pool) {
+    if (!pool) {
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (unsigned i = 1; i <= pool->started; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    for (unsigned i = 0; i < pool->nworkers; i++) {
+        free(pool->workers[i].ctx_buf);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->job_lock);
+    free(pool->runs);
+    free(pool->workers);
+    free(pool);
+}
+
+unsigned soliton_gcm_pool_size(const soliton_gcm_pool* pool) {
+    return pool ? pool->nworkers : 0;
+}
+
+soliton_status soliton_gcm_pool_stats_get(const soliton_gcm_pool* pool, unsigned worker,
+                                          soliton_gcm_pool_stats* out) {
+    if (!pool || !out || worker >= pool->nworkers) {
+        return SOLITON_INVALID_INPUT;
+    }
+    const soliton_gcm_pool_stats* s = &pool->workers[worker].stats;
+    out->jobs = __atomic_load_n(&s->jobs, __ATOMIC_RELAXED);
+    out->messages = __atomic_load_n(&s->messages, __ATOMIC_RELAXED);
+    out->bytes = __atomic_load_n(&s->bytes, __ATOMIC_RELAXED);
+    out->steals = __atomic_load_n(&s->steals, __ATOMIC_RELAXED);
+    return SOLITON_OK;
+}
@@ -0,0 +1,154 @@
+/*
+ * keysnap_mmap.c - File save and mmap loader for AES-GCM key snapshots
+ * Hosted (POSIX) - wraps the freestanding core/keysnap.c format
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "soliton_hosted.h"
+
+/* Fill buf from the kernel CSPRNG */
+static int read_urandom(uint8_t* buf, size_t len) {
+    int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    size_t got = 0;
+    while (got < len) {
+        ssize_t r = read(fd, buf + got, len - got);
+        if (r < 0 && errno == EINTR) {
+            continue;
+        }
+        if (r <= 0) {
+            close(fd);
+            return -1;
+        }
+        got += (size_t)r;
+    }
+    close(fd);
+    return 0;
+}
+
+soliton_status soliton_keysnap_save(
+    const char* path,
+    const soliton_aesgcm_ctx* const* ctxs, size_t count,
+    const uint8_t wrap_key[SOLITON_KEYSNAP_WRAP_KEY_BYTES]) {
+
+    size_t total = soliton_keysnap_bytes(count);
+    char tmp[4096];
+
+    if (!path || !wrap_key || total == 0 ||
+        snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp)) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    uint8_t nonce[SOLITON_KEYSNAP_NONCE_BYTES];
+    if (read_urandom(nonce, sizeof(nonce)) != 0) {
+        return SOLITON_INTERNAL_ERROR;
+    }
+
+    int fd = open(tmp, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return SOLITON_INTERNAL_ERROR;
+    }
+    if (ftruncate(fd, (off_t)total) != 0) {
+        close(fd);
+        unlink(tmp);
+        return SOLITON_INTERNAL_ERROR;
+    }
+
+    /* Serialize straight into the page cache, no staging buffer */
+    uint8_t* out = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (out == MAP_FAILED) {
+        close(fd);
+        unlink(tmp);
+        return SOLITON_INTERNAL_ERROR;
+    }
+
+    soliton_status st = soliton_keysnap_export(ctxs, count, wrap_key, nonce, out, total);
+    int io_ok = msync(out, total, MS_SYNC) == 0;
+    munmap(out, total);
+    io_ok = io_ok && fsync(fd) == 0;
+    close(fd);
+
+    if (st == SOLITON_OK && !io_ok) {
+        st = SOLITON_INTERNAL_ERROR;
+    }
+    if (st != SOLITON_OK || rename(tmp, path) != 0) {
+        unlink(tmp);
+        return st != SOLITON_OK ? st : SOLITON_INTERNAL_ERROR;
+    }
+    return SOLITON_OK;
+}
+
+soliton_status soliton_keysnap_load(
+    const char* path,
+    const uint8_t wrap_key[SOLITON_KEYSNAP_WRAP_KEY_BYTES],
+    soliton_keysnap_map* map) {
+
+    if (!path || !wrap_key || !map) {
+        return SOLITON_INVALID_INPUT;
+    }
+    memset(map, 0, sizeof(*map));
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return SOLITON_INTERNAL_ERROR;
+    }
+
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || sb.st_size <= 0) {
+        close(fd);
+        return SOLITON_INTERNAL_ERROR;
+    }
+    size_t len = (size_t)sb.st_size;
+
+    /* Private writable mapping: decryption happens in place and dirtied
+     * pages become anonymous, the file itself is never modified */
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    uint8_t* base = mmap(NULL, len, PROT_READ | PROT_WRITE, flags, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return SOLITON_INTERNAL_ERROR;
+    }
+    madvise(base, len, MADV_SEQUENTIAL);
+#ifdef MADV_DONTDUMP
+    madvise(base, len, MADV_DONTDUMP);  /* keep key tables out of core dumps */
+#endif
+
+    size_t count = 0;
+    soliton_status st = soliton_keysnap_open(base, len, wrap_key, &count);
+    if (st != SOLITON_OK) {
+        munmap(base, len);
+        return st;
+    }
+    madvise(base, len, MADV_NORMAL);
+
+    map->base = base;
+    map->len = len;
+    map->count = count;
+    return SOLITON_OK;
+}
+
+void soliton_keysnap_unload(soliton_keysnap_map* map) {
+    if (!map || !map->base) {
+        return;
+    }
+    volatile uint8_t* p = map->base;
+    for (size_t i = 0; i < map->len; i++) {
+        p[i] = 0;
+    }
+    munmap(map->base, map->len);
+    memset(map, 0, sizeof(*map));
+}
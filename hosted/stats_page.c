@@ -0,0 +1,302 @@
+/*
+ * stats_page.c - Seqlock-protected shared-memory page of live soliton_stats
+ * Hosted (POSIX) - one page per process, read by tools/soliton_top.c
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "soliton_hosted.h"
+
+#define STATS_WORDS (sizeof(soliton_stats) / sizeof(uint64_t))
+#define STATS_READ_TRIES 10000
+
+struct soliton_stats_publisher {
+    soliton_stats_page*  page;
+    size_t               page_len;
+    soliton_stats_block* live;          /* Attached to the core (live_stats) */
+    soliton_stats        base;          /* live totals at start, subtracted */
+    pthread_mutex_t      write_lock;    /* One seqlock writer at a time */
+    pthread_mutex_t      wake_lock;
+    pthread_cond_t       wake;
+    pthread_t            thread;
+    unsigned             interval_ms;
+    int                  running;
+    char                 path[128];
+};
+
+/* The attached block is never freed: a data-path thread that loaded the
+ * sink just before soliton_stats_attach(NULL) may still add to it after
+ * publish_stop returns. One block, so one publisher per process at a time.
+ * It is never cleared either (a thread owning a slot adds without atomics),
+ * so each publisher counts from the totals it saw at start. */
+static soliton_stats_block live_stats;
+static int publisher_active = 0;
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static size_t page_bytes(void) {
+    const size_t pg = (size_t)sysconf(_SC_PAGESIZE);
+    return (sizeof(soliton_stats_page) + pg - 1) / pg * pg;
+}
+
+int soliton_stats_page_path(uint32_t pid, char* buf, size_t len) {
+    int n = snprintf(buf, len, "%s/soliton-stats.%u", SOLITON_STATS_PAGE_DIR, pid);
+    return n < 0 || (size_t)n >= len ? -1 : 0;
+}
+
+void soliton_stats_page_write(soliton_stats_page* page, const soliton_stats* stats, uint64_t now_ns) {
+    const uint64_t* src = (const uint64_t*)stats;
+    uint64_t* dst = (uint64_t*)&page->snapshot;
+    const uint64_t seq = __atomic_load_n(&page->seq, __ATOMIC_RELAXED);
+
+    /* Odd: readers retry until the copy below is complete */
+    __atomic_store_n(&page->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    for (size_t i = 0; i < STATS_WORDS; i++) {
+        __atomic_store_n(&dst[i], __atomic_load_n(&src[i], __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&page->publish_ns, now_ns, __ATOMIC_RELAXED);
+    __atomic_store_n(&page->publishes, __atomic_load_n(&page->publishes, __ATOMIC_RELAXED) + 1,
+                     __ATOMIC_RELAXED);
+
+    __atomic_store_n(&page->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+soliton_status soliton_stats_page_read(
+    const soliton_stats_page* page, soliton_stats* out, uint64_t* publish_ns) {
+
+    if (!page || !out) {
+        return SOLITON_INVALID_INPUT;
+    }
+    if (page->magic != SOLITON_STATS_PAGE_MAGIC || page->version != SOLITON_STATS_PAGE_VERSION ||
+        page->size != sizeof(soliton_stats_page)) {
+        return SOLITON_UNSUPPORTED;
+    }
+
+    const uint64_t* src = (const uint64_t*)&page->snapshot;
+    uint64_t* dst = (uint64_t*)out;
+
+    for (int tries = 0; tries < STATS_READ_TRIES; tries++) {
+        const uint64_t s1 = __atomic_load_n(&page->seq, __ATOMIC_ACQUIRE);
+        if (s1 & 1) {
+            continue;
+        }
+        for (size_t i = 0; i < STATS_WORDS; i++) {
+            dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+        }
+        const uint64_t ns = __atomic_load_n(&page->publish_ns, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&page->seq, __ATOMIC_RELAXED) == s1) {
+            if (publish_ns) {
+                *publish_ns = ns;
+            }
+            return SOLITON_OK;
+        }
+    }
+    return SOLITON_INTERNAL_ERROR;
+}
+
+/* Slot totals since the publisher started */
+static void publisher_totals(const soliton_stats_publisher* pub, soliton_stats* out) {
+    const uint64_t* base = (const uint64_t*)&pub->base;
+    uint64_t* w = (uint64_t*)out;
+
+    soliton_stats_sum(pub->live, out);
+    for (size_t i = 0; i < STATS_WORDS; i++) {
+        w[i] -= base[i];
+    }
+}
+
+void soliton_stats_publish(soliton_stats_publisher* pub) {
+    if (!pub) {
+        return;
+    }
+    soliton_stats now;
+    pthread_mutex_lock(&pub->write_lock);
+    publisher_totals(pub, &now);
+    soliton_stats_page_write(pub->page, &now, monotonic_ns());
+    pthread_mutex_unlock(&pub->write_lock);
+}
+
+static void* publisher_thread(void* arg) {
+    soliton_stats_publisher* pub = arg;
+
+    pthread_mutex_lock(&pub->wake_lock);
+    while (pub->running) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += pub->interval_ms / 1000;
+        deadline.tv_nsec += (long)(pub->interval_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        while (pub->running &&
+               pthread_cond_timedwait(&pub->wake, &pub->wake_lock, &deadline) != ETIMEDOUT) {
+        }
+        if (pub->running) {
+            pthread_mutex_unlock(&pub->wake_lock);
+            soliton_stats_publish(pub);
+            pthread_mutex_lock(&pub->wake_lock);
+        }
+    }
+    pthread_mutex_unlock(&pub->wake_lock);
+    return NULL;
+}
+
+static void publisher_free(soliton_stats_publisher* pub) {
+    if (pub->page) {
+        munmap(pub->page, pub->page_len);
+        unlink(pub->path);
+    }
+    pthread_mutex_destroy(&pub->write_lock);
+    pthread_mutex_destroy(&pub->wake_lock);
+    pthread_cond_destroy(&pub->wake);
+    free(pub);
+    __atomic_store_n(&publisher_active, 0, __ATOMIC_RELEASE);
+}
+
+soliton_status soliton_stats_publish_start(unsigned interval_ms, soliton_stats_publisher** out) {
+    if (!out) {
+        return SOLITON_INVALID_INPUT;
+    }
+    *out = NULL;
+    if (__atomic_exchange_n(&publisher_active, 1, __ATOMIC_ACQUIRE)) {
+        return SOLITON_INVALID_INPUT;
+    }
+
+    soliton_stats_publisher* pub = calloc(1, sizeof(*pub));
+    if (!pub) {
+        __atomic_store_n(&publisher_active, 0, __ATOMIC_RELEASE);
+        return SOLITON_INTERNAL_ERROR;
+    }
+    pthread_mutex_init(&pub->write_lock, NULL);
+    pthread_mutex_init(&pub->wake_lock, NULL);
+    pthread_condattr_t ca;
+    pthread_condattr_init(&ca);
+    pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+    pthread_cond_init(&pub->wake, &ca);
+    pthread_condattr_destroy(&ca);
+
+    if (soliton_stats_page_path((uint32_t)getpid(), pub->path, sizeof(pub->path)) != 0) {
+        publisher_free(pub);
+        return SOLITON_INTERNAL_ERROR;
+    }
+
+    /* Start from zero: everything already in the block is the base */
+    pub->live = &live_stats;
+    soliton_stats_sum(pub->live, &pub->base);
+
+    /* A page left by a dead process with a recycled PID, or a file or
+     * symlink planted at the path, is removed rather than opened through */
+    if (unlink(pub->path) != 0 && errno != ENOENT) {
+        publisher_free(pub);
+        return SOLITON_INTERNAL_ERROR;
+    }
+    int fd = open(pub->path, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, SOLITON_STATS_PAGE_MODE);
+    if (fd < 0) {
+        publisher_free(pub);
+        return SOLITON_INTERNAL_ERROR;
+    }
+    pub->page_len = page_bytes();
+    void* map = MAP_FAILED;
+    if (ftruncate(fd, (off_t)pub->page_len) == 0) {
+        map = mmap(NULL, pub->page_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) {
+        unlink(pub->path);
+        publisher_free(pub);
+        return SOLITON_INTERNAL_ERROR;
+    }
+    pub->page = map;
+
+    /* Header last: a reader that sees the magic sees a complete page */
+    pub->page->size = sizeof(soliton_stats_page);
+    pub->page->pid = (uint32_t)getpid();
+    pub->page->start_ns = monotonic_ns();
+    soliton_stats zero = {0};
+    soliton_stats_page_write(pub->page, &zero, pub->page->start_ns);
+    pub->page->version = SOLITON_STATS_PAGE_VERSION;
+    __atomic_store_n(&pub->page->magic, SOLITON_STATS_PAGE_MAGIC, __ATOMIC_RELEASE);
+
+    if (interval_ms > 0) {
+        pub->interval_ms = interval_ms;
+        pub->running = 1;
+        if (pthread_create(&pub->thread, NULL, publisher_thread, pub) != 0) {
+            publisher_free(pub);
+            return SOLITON_INTERNAL_ERROR;
+        }
+    }
+
+    soliton_stats_attach(pub->live);
+    *out = pub;
+    return SOLITON_OK;
+}
+
+void soliton_stats_publish_stop(soliton_stats_publisher* pub) {
+    if (!pub) {
+        return;
+    }
+    soliton_stats_attach(NULL);
+
+    if (pub->interval_ms > 0) {
+        pthread_mutex_lock(&pub->wake_lock);
+        pub->running = 0;
+        pthread_cond_signal(&pub->wake);
+        pthread_mutex_unlock(&pub->wake_lock);
+        pthread_join(pub->thread, NULL);
+    }
+    publisher_free(pub);
+}
+
+soliton_status soliton_stats_view_open(uint32_t pid, soliton_stats_view* view) {
+    char path[128];
+
+    if (!view || soliton_stats_page_path(pid, path, sizeof(path)) != 0) {
+        return SOLITON_INVALID_INPUT;
+    }
+    view->page = NULL;
+    view->len = 0;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return SOLITON_INTERNAL_ERROR;
+    }
+    struct stat st;
+    void* map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(soliton_stats_page)) {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) {
+        return SOLITON_INTERNAL_ERROR;
+    }
+
+    view->page = map;
+    view->len = (size_t)st.st_size;
+    return SOLITON_OK;
+}
+
+void soliton_stats_view_close(soliton_stats_view* view) {
+    if (view && view->page) {
+        munmap((void*)view->page, view->len);
+        view->page = NULL;
+        view->len = 0;
+    }
+}
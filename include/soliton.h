@@ -1,8 +1,8 @@
 /*
  * soliton.h - Public API for soliton.c cryptographic engine
  *
- * Freestanding C17 implementation of AES-256-GCM and ChaCha20-Poly1305
- * Compliant with NIST SP 800-38D and RFC 8439
+ * Freestanding C17 implementation of AES-256-GCM, ChaCha20-Poly1305 and AEGIS
+ * Compliant with NIST SP 800-38D, RFC 8439 and draft-irtf-cfrg-aegis-aead
  */
 
 #ifndef SOLITON_H
@@ -32,7 +32,18 @@ enum {
     SOLITON_FEAT_NEON    = 1u << 4,  /* ARM NEON */
     SOLITON_FEAT_PMULL   = 1u << 5,  /* ARM polynomial multiply */
     SOLITON_FEAT_AESNI   = 1u << 6,  /* Intel AES-NI */
-    SOLITON_FEAT_PCLMUL  = 1u << 7   /* Intel PCLMULQDQ */
+    SOLITON_FEAT_PCLMUL  = 1u << 7,  /* Intel PCLMULQDQ */
+    SOLITON_FEAT_AES     = 1u << 8,  /* ARM AES instructions */
+    SOLITON_FEAT_SVE     = 1u << 9,  /* ARM SVE */
+    SOLITON_FEAT_SVE2    = 1u << 10, /* ARM SVE2 */
+    SOLITON_FEAT_SVE_AES = 1u << 11, /* ARM SVE2 AESE/AESMC */
+    SOLITON_FEAT_SVE_PMULL128 = 1u << 12, /* ARM SVE2 PMULLB/PMULLT 64x64->128 */
+    SOLITON_FEAT_RVV     = 1u << 13, /* RISC-V V extension */
+    SOLITON_FEAT_ZVKNED  = 1u << 14, /* RISC-V vector AES */
+    SOLITON_FEAT_ZVKG    = 1u << 15, /* RISC-V vector GHASH */
+    SOLITON_FEAT_ZVBB    = 1u << 16, /* RISC-V vector bit-manip (Zvbb or its Zvkb subset) */
+    SOLITON_FEAT_AVX512BW = 1u << 17, /* Intel AVX-512 Byte/Word (with OS ZMM state) */
+    SOLITON_FEAT_SSE42   = 1u << 18  /* Intel SSE4.2 (crc32) */
 };
 
 /* Capability structure */
@@ -52,6 +63,32 @@ typedef enum {
     SOLITON_INTERNAL_ERROR
 } soliton_status;
 
+/* ===================== Vector-width policy (x86-64) ===================== */
+
+/* Whether bulk kernels may use 512-bit (ZMM) registers. On Skylake-SP-class
+ * parts sustained 512-bit AES drops the core to a lower turbo license, which
+ * also slows the non-crypto work sharing that core; on Sapphire Rapids and
+ * Zen 4 it costs nothing. The policy is process-wide and is read on every
+ * update call, so it can be changed at any time. */
+typedef enum {
+    SOLITON_VWIDTH_AUTO = 0,        /* Resolved from the detected microarchitecture */
+    SOLITON_VWIDTH_PREFER_YMM,      /* Never use ZMM kernels */
+    SOLITON_VWIDTH_ZMM_ABOVE,       /* ZMM only for requests >= zmm_min_bytes */
+    SOLITON_VWIDTH_ALWAYS_ZMM       /* ZMM whenever the CPU and OS support it */
+} soliton_vwidth_policy;
+
+/* Default threshold for SOLITON_VWIDTH_ZMM_ABOVE (zmm_min_bytes == 0) */
+#define SOLITON_VWIDTH_ZMM_MIN_DEFAULT 16384u
+
+/* Set the process-wide policy; zmm_min_bytes only matters for ZMM_ABOVE */
+soliton_status soliton_set_vwidth_policy(soliton_vwidth_policy policy, size_t zmm_min_bytes);
+
+/* Effective policy (AUTO already resolved) and its threshold (may be NULL) */
+soliton_vwidth_policy soliton_get_vwidth_policy(size_t* zmm_min_bytes);
+
+/* 1 if a request of len bytes would run on the ZMM kernels, else 0 */
+int soliton_vwidth_uses_zmm(size_t len);
+
 /* ========================= AES-256-GCM API ========================= */
 
 #define SOLITON_AESGCM_KEY_BYTES 32u
@@ -60,6 +97,9 @@ typedef enum {
 /* Opaque context structure */
 typedef struct soliton_aesgcm_ctx soliton_aesgcm_ctx;
 
+/* Caller storage for one context: this many bytes, 64-byte aligned */
+#define SOLITON_AESGCM_CTX_BYTES 1024u
+
 /* Initialize AES-GCM context
  * key: 32-byte key
  * iv: initialization vector (12 bytes preferred)
@@ -85,6 +125,17 @@ soliton_status soliton_aesgcm_reset(
     soliton_aesgcm_ctx* ctx,
     const uint8_t* iv, size_t iv_len);
 
+/* Bind a constant AAD prefix (e.g. a per-connection header) to the context
+ * GHASH over the prefix is computed once; each reset then starts from that
+ * state, so only the per-message suffix is passed to aad_update. Tags are
+ * identical to hashing prefix || suffix every message.
+ * prefix_len: multiple of 16 bytes; 0 removes the binding
+ * Call right after init or reset (before any AAD or data); the binding
+ * applies to that message. soliton_aesgcm_init clears it. */
+soliton_status soliton_aesgcm_aad_prefix_bind(
+    soliton_aesgcm_ctx* ctx,
+    const uint8_t* prefix, size_t prefix_len);
+
 /* Process additional authenticated data (AAD)
  * Can be called multiple times before encrypt/decrypt_update */
 soliton_status soliton_aesgcm_aad_update(
@@ -124,6 +175,282 @@ soliton_status soliton_aesgcm_decrypt_final(
 /* Securely wipe context */
 void soliton_aesgcm_context_wipe(soliton_aesgcm_ctx* ctx);
 
+/* ============ AES-GCM per-context cost accounting ============ */
+
+/* Counters for attributing crypto CPU to a key or tenant. Message totals
+ * are added once per message at final (checked or soliton_fast.h calls);
+ * a message never finalized is not counted. Cycles are sampled on 1 in
+ * sample_every checked-API aad/update/final calls; estimated total cycles
+ * are sampled_cycles * calls / sampled_calls. Counters survive reset and
+ * keyring commits and are cleared by init, so read them before a context
+ * is re-initialized or wiped. soliton_hosted.h merges them per tenant. */
+typedef struct {
+    uint64_t enc_messages;      /* Encrypt messages finalized */
+    uint64_t dec_messages;      /* Decrypt messages finalized */
+    uint64_t enc_bytes;         /* Plaintext bytes of finalized encrypts */
+    uint64_t dec_bytes;         /* Ciphertext bytes of finalized decrypts */
+    uint64_t aad_bytes;         /* AAD hashed per message (bound prefix excluded) */
+    uint64_t auth_failures;     /* decrypt_final returning SOLITON_AUTH_FAIL */
+    uint64_t calls;             /* Checked-API aad/update/final calls */
+    uint64_t sampled_calls;     /* Calls timed */
+    uint64_t sampled_cycles;    /* Cycles (timer ticks off x86) in timed calls */
+} soliton_aesgcm_cost;
+
+/* Start counting from zero
+ * sample_every: 0 for counters only, else a power of two (1 times every call) */
+soliton_status soliton_aesgcm_cost_enable(soliton_aesgcm_ctx* ctx, uint32_t sample_every);
+
+/* Stop counting (counters stay readable) */
+void soliton_aesgcm_cost_disable(soliton_aesgcm_ctx* ctx);
+
+/* Copy the counters out (all zero if never enabled) */
+soliton_status soliton_aesgcm_cost_read(const soliton_aesgcm_ctx* ctx, soliton_aesgcm_cost* out);
+
+/* Copy the counters out and zero them, keeping counting and sampling on
+ * (for periodic harvesting without double counting) */
+soliton_status soliton_aesgcm_cost_take(soliton_aesgcm_ctx* ctx, soliton_aesgcm_cost* out);
+
+/* ============ Process-wide live statistics ============ */
+
+/* GCM bulk kernel ids (soliton_stats.kernel_*, USDT gcm_kernel probe) */
+#define SOLITON_KERNEL_GENERIC      0   /* Backend CTR blocks + GHASH update */
+#define SOLITON_KERNEL_CLMUL8       1   /* CTR blocks + 8-way CLMUL GHASH */
+#define SOLITON_KERNEL_FUSED8       2   /* VAES+CLMUL fused, 8 blocks per call */
+#define SOLITON_KERNEL_FUSED16      3   /* VAES+CLMUL fused, 16 blocks per call */
+#define SOLITON_KERNEL_PIPELINED16  4   /* VAES+CLMUL phase-locked, 16 blocks */
+#define SOLITON_KERNEL_RESIDENT     5   /* VAES+CLMUL whole-span resident */
+#define SOLITON_KERNEL_STITCHED     6   /* Backend gcm_blocks */
+#define SOLITON_KERNEL_RESIDENT_CRC 7   /* Resident with fused CRC32C */
+#define SOLITON_KERNEL_DUPLEX       8   /* TX encrypt + RX decrypt in one pass */
+#define SOLITON_KERNEL_CTR512       9   /* 512-bit CTR + resident GHASH (vwidth policy) */
+
+#define SOLITON_STATS_KERNELS 16
+#define SOLITON_STATS_BUCKETS 32
+
+/* Aggregate counters for every AES-GCM context in the process, for live
+ * monitoring (soliton_hosted.h publishes them to a shared-memory page).
+ * Histogram bucket b counts values in [2^(b-1), 2^b); bucket 0 counts
+ * zero and the last bucket everything larger. */
+typedef struct {
+    uint64_t kernel_calls[SOLITON_STATS_KERNELS]; /* Bulk kernel runs by SOLITON_KERNEL_* */
+    uint64_t kernel_bytes[SOLITON_STATS_KERNELS]; /* Bytes through each kernel */
+    uint64_t update_bytes[SOLITON_STATS_BUCKETS]; /* Checked-API encrypt/decrypt update sizes */
+    uint64_t latency[SOLITON_STATS_BUCKETS];      /* Cycles of cost-sampled calls */
+    uint64_t tail_blocks;       /* Updates leaving 1..7 whole blocks past the last batch */
+    uint64_t tail_partial;      /* Updates ending in a 1..15-byte partial block */
+    uint64_t enc_messages;      /* Encrypt finals (checked and soliton_fast.h) */
+    uint64_t dec_messages;      /* Decrypt finals */
+    uint64_t auth_failures;     /* Decrypt finals returning SOLITON_AUTH_FAIL */
+    uint64_t plan_switches;     /* Vector-width policy or plan-variant switch changes */
+} soliton_stats;
+
+#define SOLITON_STATS_SLOTS 64
+
+/* One thread's counters, on cache lines of their own */
+typedef struct {
+    _Alignas(64) soliton_stats s;
+} soliton_stats_slot;
+
+/* Live counters, split per thread: the first SOLITON_STATS_SLOTS - 1
+ * threads to count each own a slot and add with plain loads and stores;
+ * every later thread shares the last slot with relaxed atomic adds. No
+ * locks, syscalls or shared cache lines on the data path for the first
+ * 63 threads. Read the totals with soliton_stats_sum. */
+typedef struct {
+    soliton_stats_slot slot[SOLITON_STATS_SLOTS];
+} soliton_stats_block;
+
+/* Start adding into block (NULL stops). Detaching does not wait: a call
+ * that loaded the old block just before may still add to it afterwards.
+ * Give the block static or process lifetime, or free it only once every
+ * thread that was in an AES-GCM call at the detach has returned. latency
+ * only fills from contexts with cost sampling on (soliton_aesgcm_cost_enable
+ * with sample_every > 0). */
+void soliton_stats_attach(soliton_stats_block* block);
+
+/* Sum of every slot of block into out, safe while threads are adding
+ * (each counter is read once; the total is not a cross-counter snapshot) */
+void soliton_stats_sum(const soliton_stats_block* block, soliton_stats* out);
+
+/* ============ AES-GCM plan variants (A/B experiments) ============ */
+
+/* Encrypt bulk kernel plan for one context. AUTO is the plan init picked;
+ * the others force a VAES+CLMUL kernel shape. Every plan produces the same
+ * ciphertext and tag; decrypt has a single bulk kernel and ignores them. */
+typedef enum {
+    SOLITON_GCM_PLAN_AUTO = 0,      /* Selected at init */
+    SOLITON_GCM_PLAN_RESIDENT8,     /* 8-block batches, whole-span resident kernel */
+    SOLITON_GCM_PLAN_FUSED16,       /* 16-block fused, one reduction per 16 blocks */
+    SOLITON_GCM_PLAN_PIPELINED16    /* 16-block phase-locked (AES k+1 under GHASH k) */
+} soliton_gcm_plan;
+
+/* Run ctx's encrypt updates on plan until changed or re-initialized
+ * (init restores AUTO; a keyring commit keeps it). SOLITON_UNSUPPORTED if the backend has no VAES+CLMUL
+ * kernels (AUTO is always accepted). */
+soliton_status soliton_aesgcm_set_plan(soliton_aesgcm_ctx* ctx, soliton_gcm_plan plan);
+
+/* Plan variants kill switch, process-wide and immediate: while disabled
+ * every context runs its AUTO plan and nothing is added to the A/B
+ * samples. Enabled by default. */
+void soliton_plan_variants_enable(int enabled);
+
+#define SOLITON_AB_ARMS    2        /* 0 = control, 1 = treatment */
+#define SOLITON_AB_CLASSES 8
+#define SOLITON_AB_NONE    0xffu    /* Context not in an experiment */
+
+/* Cycle samples per experiment arm and update size class. Class c holds
+ * encrypt updates of [2^(2c-1), 2^(2c+1)) bytes (c = 0: under 2, the last
+ * class: 8 KiB and up). Each context tagged with an arm has 1 in
+ * sample_every of its encrypt updates timed (soliton_ab_samples_attach),
+ * separately from its cost counters, and added as relaxed atomic adds. cycles_sq sums squares of cycles / 16 (rounded) so
+ * it cannot overflow before the means are useful; calls of 2^32 cycles or
+ * more are preemptions, not kernel cost, and only count in outliers. */
+typedef struct {
+    uint64_t calls[SOLITON_AB_ARMS][SOLITON_AB_CLASSES];
+    uint64_t bytes[SOLITON_AB_ARMS][SOLITON_AB_CLASSES];
+    uint64_t cycles[SOLITON_AB_ARMS][SOLITON_AB_CLASSES];
+    uint64_t cycles_sq[SOLITON_AB_ARMS][SOLITON_AB_CLASSES]; /* Sum of round(cycles / 16)^2 */
+    uint64_t outliers[SOLITON_AB_ARMS];
+} soliton_ab_samples;
+
+/* Tag ctx's sampled encrypt updates for arm (or SOLITON_AB_NONE); init
+ * clears the tag */
+soliton_status soliton_aesgcm_set_ab_arm(soliton_aesgcm_ctx* ctx, unsigned arm);
+
+/* Start adding into samples, timing 1 in sample_every encrypt updates per
+ * tagged context (a power of two >= 1; SOLITON_INVALID_INPUT otherwise).
+ * NULL stops. As with soliton_stats_attach, detaching does not wait for
+ * calls already sampling into the old block. */
+soliton_status soliton_ab_samples_attach(soliton_ab_samples* samples, uint32_t sample_every);
+
+/* ============ AES-GCM with fused CRC32C (storage pipelines) ============ */
+
+/* Encrypt/decrypt updates that also return CRC32C (Castagnoli) of the
+ * plaintext and/or ciphertext, summed in the bulk kernel while the data is
+ * in registers instead of in separate passes. Same ciphertext, plaintext
+ * and tag as the plain updates, and the same context; the CRC values are
+ * caller-held and chain across updates (and objects): start from 0, or a
+ * previous result, and read them once the last update is done. */
+
+#define SOLITON_CRC_PLAINTEXT  1u
+#define SOLITON_CRC_CIPHERTEXT 2u
+
+typedef struct {
+    uint32_t pt;        /* Running CRC32C of the plaintext */
+    uint32_t ct;        /* Running CRC32C of the ciphertext */
+    uint32_t which;     /* SOLITON_CRC_PLAINTEXT and/or SOLITON_CRC_CIPHERTEXT */
+} soliton_crc32c_pair;
+
+/* CRC32C of data continuing crc (0 to start; 0xE3069283 for "123456789") */
+uint32_t soliton_crc32c(uint32_t crc, const uint8_t* data, size_t len);
+
+/* encrypt_update / decrypt_update plus the CRCs selected by crc->which
+ * Returns SOLITON_INVALID_INPUT for a NULL crc or an empty/unknown set */
+soliton_status soliton_aesgcm_encrypt_update_crc(
+    soliton_aesgcm_ctx* ctx,
+    const uint8_t* pt, uint8_t* ct, size_t len,
+    soliton_crc32c_pair* crc);
+
+soliton_status soliton_aesgcm_decrypt_update_crc(
+    soliton_aesgcm_ctx* ctx,
+    const uint8_t* ct, uint8_t* pt, size_t len,
+    soliton_crc32c_pair* crc);
+
+/* ================ AES-GCM key snapshot / restore ================= */
+
+/* Versioned, encrypted snapshot of expanded AES-GCM keys (round keys and
+ * H powers) so a restarting process can skip key setup. Records are sealed
+ * with ChaCha20-Poly1305 under a 32-byte wrap key; the header binds the
+ * format version, context layout, CPU features and backend, and snapshots
+ * from an incompatible build or CPU are rejected with SOLITON_UNSUPPORTED.
+ * hosted/keysnap_mmap.c provides file save and an mmap loader. */
+
+#define SOLITON_KEYSNAP_VERSION        2u
+#define SOLITON_KEYSNAP_HEADER_BYTES   64u
+#define SOLITON_KEYSNAP_TAG_BYTES      16u
+#define SOLITON_KEYSNAP_WRAP_KEY_BYTES 32u
+#define SOLITON_KEYSNAP_NONCE_BYTES    12u
+
+/* Total snapshot size for count contexts (0 on overflow) */
+size_t soliton_keysnap_bytes(size_t count);
+
+/* Serialize and seal count initialized contexts into out
+ * nonce: MUST be unique per wrap key
+ * out_len: at least soliton_keysnap_bytes(count) */
+soliton_status soliton_keysnap_export(
+    const soliton_aesgcm_ctx* const* ctxs, size_t count,
+    const uint8_t wrap_key[SOLITON_KEYSNAP_WRAP_KEY_BYTES],
+    const uint8_t nonce[SOLITON_KEYSNAP_NONCE_BYTES],
+    uint8_t* out, size_t out_len);
+
+/* Verify and decrypt a snapshot in place (snap must be 64-byte aligned)
+ * Returns SOLITON_UNSUPPORTED for a version/layout/CPU mismatch and
+ * SOLITON_AUTH_FAIL (payload wiped) for a wrong key or modified data.
+ * On success the records are usable in place via soliton_keysnap_ctx. */
+soliton_status soliton_keysnap_open(
+    uint8_t* snap, size_t snap_len,
+    const uint8_t wrap_key[SOLITON_KEYSNAP_WRAP_KEY_BYTES],
+    size_t* count);
+
+/* Context i of an opened snapshot, NULL if not opened or out of range.
+ * Call soliton_aesgcm_reset with a fresh IV before each message. */
+soliton_aesgcm_ctx* soliton_keysnap_ctx(uint8_t* snap, size_t index);
+
+/* ============= AES-GCM key rotation (double-buffered) ============ */
+
+/* A keyring pairs two caller-owned contexts: the active key used by the
+ * data path and a standby slot where the next key is built off the hot
+ * path - in one call on a helper thread, or as begin + step in idle
+ * slices. At a message boundary the data path switches keys with
+ * soliton_aesgcm_keyring_commit, which is one index swap; the helper
+ * then wipes the old key with soliton_aesgcm_keyring_retire.
+ *
+ * One data-path thread (active, commit) and one helper thread (prepare,
+ * retire) may use a keyring concurrently. Do not keep a context pointer
+ * across a commit. Keyring contexts carry no IV and reject updates until
+ * soliton_aesgcm_reset is called; reset before each message. An AAD
+ * prefix binding belongs to its key: bind again after a commit.
+ * Treat the fields as opaque. */
+typedef struct {
+    soliton_aesgcm_ctx* slot[2];
+    uint32_t active;              /* Index of the active slot */
+    uint32_t standby;             /* Standby slot state */
+} soliton_aesgcm_keyring;
+
+/* Key the active slot (ctx0) and clear the standby slot (ctx1) */
+soliton_status soliton_aesgcm_keyring_init(
+    soliton_aesgcm_keyring* kr,
+    soliton_aesgcm_ctx* ctx0, soliton_aesgcm_ctx* ctx1,
+    const uint8_t key[SOLITON_AESGCM_KEY_BYTES]);
+
+/* Context currently carrying traffic */
+soliton_aesgcm_ctx* soliton_aesgcm_keyring_active(soliton_aesgcm_keyring* kr);
+
+/* Build the next key in the standby slot (helper thread)
+ * Returns SOLITON_INVALID_INPUT if a prepared key is still uncommitted */
+soliton_status soliton_aesgcm_keyring_prepare(
+    soliton_aesgcm_keyring* kr,
+    const uint8_t next_key[SOLITON_AESGCM_KEY_BYTES]);
+
+/* The same in two slices: begin expands the round keys (the key is not
+ * retained), step derives the GHASH tables and publishes the key */
+soliton_status soliton_aesgcm_keyring_prepare_begin(
+    soliton_aesgcm_keyring* kr,
+    const uint8_t next_key[SOLITON_AESGCM_KEY_BYTES]);
+soliton_status soliton_aesgcm_keyring_prepare_step(soliton_aesgcm_keyring* kr);
+
+/* Switch to the prepared key (data path, between messages). The new key
+ * inherits the outgoing context's cost counters and sampling, plan variant
+ * and A/B arm. Returns SOLITON_INVALID_INPUT if no key is ready; the
+ * active key is kept */
+soliton_status soliton_aesgcm_keyring_commit(soliton_aesgcm_keyring* kr);
+
+/* Wipe the key retired by the last commit (helper thread; no-op otherwise) */
+void soliton_aesgcm_keyring_retire(soliton_aesgcm_keyring* kr);
+
+/* Wipe both slots */
+void soliton_aesgcm_keyring_wipe(soliton_aesgcm_keyring* kr);
+
 /* ==================== ChaCha20-Poly1305 API ====================== */
 
 #define SOLITON_CHACHA_KEY_BYTES   32u
@@ -133,6 +460,15 @@ void soliton_aesgcm_context_wipe(soliton_aesgcm_ctx* ctx);
 /* Opaque context structure */
 typedef struct soliton_chacha_ctx soliton_chacha_ctx;
 
+/* ChaCha round-count variant. Only SOLITON_CHACHA20 is RFC 8439;
+ * ChaCha12/ChaCha8 trade security margin for speed and are not
+ * interoperable with standard ChaCha20-Poly1305 peers. */
+typedef enum {
+    SOLITON_CHACHA20 = 0,   /* 20 rounds (RFC 8439, default) */
+    SOLITON_CHACHA12 = 1,   /* 12 rounds */
+    SOLITON_CHACHA8  = 2    /* 8 rounds */
+} soliton_chacha_variant;
+
 /* Initialize ChaCha20-Poly1305 context
  * key: 32-byte key
  * nonce: 12-byte nonce */
@@ -141,6 +477,23 @@ soliton_status soliton_chacha_init(
     const uint8_t key[SOLITON_CHACHA_KEY_BYTES],
     const uint8_t nonce[SOLITON_CHACHA_NONCE_BYTES]);
 
+/* Initialize a ChaCha{20,12,8}-Poly1305 context (RFC 8439 construction
+ * with the selected round count for both keystream and Poly1305 key) */
+soliton_status soliton_chacha_init_variant(
+    soliton_chacha_ctx* ctx,
+    soliton_chacha_variant variant,
+    const uint8_t key[SOLITON_CHACHA_KEY_BYTES],
+    const uint8_t nonce[SOLITON_CHACHA_NONCE_BYTES]);
+
+/* Raw ChaCha{20,12,8} keystream XOR (no authentication)
+ * counter: initial 32-bit block counter; in may equal out */
+soliton_status soliton_chacha_stream_xor(
+    soliton_chacha_variant variant,
+    const uint8_t key[SOLITON_CHACHA_KEY_BYTES],
+    const uint8_t nonce[SOLITON_CHACHA_NONCE_BYTES],
+    uint32_t counter,
+    const uint8_t* in, uint8_t* out, size_t len);
+
 /* Process additional authenticated data (AAD) */
 soliton_status soliton_chacha_aad_update(
     soliton_chacha_ctx* ctx,
@@ -169,6 +522,129 @@ soliton_status soliton_chacha_decrypt_final(
 /* Securely wipe context */
 void soliton_chacha_context_wipe(soliton_chacha_ctx* ctx);
 
+/* ================= AEGIS-128L / AEGIS-256 API ==================== */
+
+#define SOLITON_AEGIS128L_KEY_BYTES   16u
+#define SOLITON_AEGIS128L_NONCE_BYTES 16u
+#define SOLITON_AEGIS256_KEY_BYTES    32u
+#define SOLITON_AEGIS256_NONCE_BYTES  32u
+#define SOLITON_AEGIS_TAG_BYTES       16u
+
+/* AEGIS variant (draft-irtf-cfrg-aegis-aead) */
+typedef enum {
+    SOLITON_AEGIS_128L = 0,
+    SOLITON_AEGIS_256  = 1
+} soliton_aegis_alg;
+
+/* Opaque context structure */
+typedef struct soliton_aegis_ctx soliton_aegis_ctx;
+
+/* Initialize AEGIS context
+ * alg: SOLITON_AEGIS_128L or SOLITON_AEGIS_256
+ * key: 16-byte (128L) or 32-byte (256) key
+ * nonce: 16-byte (128L) or 32-byte (256) nonce, MUST be unique per key */
+soliton_status soliton_aegis_init(
+    soliton_aegis_ctx* ctx,
+    soliton_aegis_alg alg,
+    const uint8_t* key,
+    const uint8_t* nonce);
+
+/* Process additional authenticated data (AAD)
+ * Can be called multiple times before encrypt/decrypt_update */
+soliton_status soliton_aegis_aad_update(
+    soliton_aegis_ctx* ctx,
+    const uint8_t* aad, size_t aad_len);
+
+/* Encrypt data (ct may equal pt for in-place) */
+soliton_status soliton_aegis_encrypt_update(
+    soliton_aegis_ctx* ctx,
+    const uint8_t* pt, uint8_t* ct, size_t len);
+
+/* Finalize encryption and output 16-byte authentication tag */
+soliton_status soliton_aegis_encrypt_final(
+    soliton_aegis_ctx* ctx,
+    uint8_t tag[SOLITON_AEGIS_TAG_BYTES]);
+
+/* Decrypt data (pt may equal ct for in-place) */
+soliton_status soliton_aegis_decrypt_update(
+    soliton_aegis_ctx* ctx,
+    const uint8_t* ct, uint8_t* pt, size_t len);
+
+/* Finalize decryption and verify authentication tag
+ * Returns SOLITON_AUTH_FAIL if tag verification fails
+ * On failure, decrypted plaintext MUST be treated as undefined */
+soliton_status soliton_aegis_decrypt_final(
+    soliton_aegis_ctx* ctx,
+    const uint8_t tag[SOLITON_AEGIS_TAG_BYTES]);
+
+/* Securely wipe context */
+void soliton_aegis_context_wipe(soliton_aegis_ctx* ctx);
+
+/* One-shot AEGIS encryption (no caller-provided context) */
+soliton_status soliton_aegis_encrypt(
+    soliton_aegis_alg alg,
+    const uint8_t* key, const uint8_t* nonce,
+    const uint8_t* aad, size_t aad_len,
+    const uint8_t* pt, uint8_t* ct, size_t len,
+    uint8_t tag[SOLITON_AEGIS_TAG_BYTES]);
+
+/* One-shot AEGIS decryption
+ * On SOLITON_AUTH_FAIL the plaintext buffer is zeroed */
+soliton_status soliton_aegis_decrypt(
+    soliton_aegis_alg alg,
+    const uint8_t* key, const uint8_t* nonce,
+    const uint8_t* aad, size_t aad_len,
+    const uint8_t* ct, uint8_t* pt, size_t len,
+    const uint8_t tag[SOLITON_AEGIS_TAG_BYTES]);
+
+/* ================= AES-256-XTS API (IEEE 1619) =================== */
+
+#define SOLITON_XTS_KEY_BYTES   64u            /* Key1 (data) || Key2 (tweak) */
+#define SOLITON_XTS_TWEAK_BYTES 16u
+#define SOLITON_XTS_MAX_BYTES   (16u << 20)    /* 2^20 blocks per data unit (SP 800-38E) */
+
+/* Opaque context structure */
+typedef struct soliton_xts_ctx soliton_xts_ctx;
+
+/* Initialize XTS context: expands Key1 for both directions and Key2 for
+ * the tweak. Returns SOLITON_INVALID_INPUT if Key1 == Key2 (FIPS 140
+ * implementation guidance forbids equal halves) */
+soliton_status soliton_xts_init(
+    soliton_xts_ctx* ctx,
+    const uint8_t key[SOLITON_XTS_KEY_BYTES]);
+
+/* Encrypt one data unit (sector) under a raw 16-byte tweak
+ * len: 16..SOLITON_XTS_MAX_BYTES; a partial last block uses ciphertext
+ * stealing, so ct is exactly len bytes. ct may equal pt for in-place */
+soliton_status soliton_xts_encrypt(
+    const soliton_xts_ctx* ctx,
+    const uint8_t tweak[SOLITON_XTS_TWEAK_BYTES],
+    const uint8_t* pt, uint8_t* ct, size_t len);
+
+/* Decrypt one data unit (pt may equal ct for in-place) */
+soliton_status soliton_xts_decrypt(
+    const soliton_xts_ctx* ctx,
+    const uint8_t tweak[SOLITON_XTS_TWEAK_BYTES],
+    const uint8_t* ct, uint8_t* pt, size_t len);
+
+/* Encrypt count consecutive sectors of sector_size bytes, starting at
+ * first_sector. Sector n uses the little-endian 128-bit n as its tweak
+ * (IEEE 1619 data unit sequence number); results match count calls to
+ * soliton_xts_encrypt, with the sector tweaks encrypted in bulk */
+soliton_status soliton_xts_encrypt_sectors(
+    const soliton_xts_ctx* ctx,
+    uint64_t first_sector, size_t sector_size,
+    const uint8_t* pt, uint8_t* ct, size_t count);
+
+/* Decrypt count consecutive sectors (see soliton_xts_encrypt_sectors) */
+soliton_status soliton_xts_decrypt_sectors(
+    const soliton_xts_ctx* ctx,
+    uint64_t first_sector, size_t sector_size,
+    const uint8_t* ct, uint8_t* pt, size_t count);
+
+/* Securely wipe context */
+void soliton_xts_context_wipe(soliton_xts_ctx* ctx);
+
 /* ================== Superlane Coalescing API (v1.1) ================== */
 
 /* Span structure for batch processing */
@@ -204,12 +680,65 @@ soliton_status soliton_chacha_batch_update(
     soliton_span* spans,
     size_t N);
 
+/* Encrypt multiple AEGIS streams in a single batch
+ * Streams sharing a variant are paired across SIMD lanes where the
+ * backend supports it (VAES: two streams per YMM register).
+ * bctx may be NULL; each stream's result matches per-stream API output */
+soliton_status soliton_aegis_batch_update(
+    soliton_batch_ctx* bctx,
+    soliton_aegis_ctx** ctxs,
+    soliton_span* spans,
+    size_t N);
+
+/* Advance one connection's outbound encrypt (tx) and inbound decrypt (rx)
+ * in a single pass, interleaving both streams' AES and GHASH work
+ * tx: plaintext in, ciphertext out; rx: ciphertext in, plaintext out
+ * Contexts must be distinct; in == out is allowed within a span, but the
+ * two spans must not overlap each other. Output, counters and tags are
+ * identical to encrypt_update(tx) followed by decrypt_update(rx). */
+soliton_status soliton_aesgcm_duplex_update(
+    soliton_aesgcm_ctx* tx_ctx, const soliton_span* tx,
+    soliton_aesgcm_ctx* rx_ctx, const soliton_span* rx);
+
 /* Wipe batch context */
 void soliton_batch_context_wipe(soliton_batch_ctx* bctx);
 
 /* Maximum batch size supported by implementation */
 #define SOLITON_MAX_BATCH_SIZE 256u
 
+/* ================= AES-GCM datagram batches (UDP GSO) ================== */
+
+/* One datagram to seal: hdr is sent in the clear and authenticated as its
+ * AAD, payload is encrypted. hdr may be NULL when hdr_len is 0. */
+typedef struct {
+    const uint8_t* hdr;
+    size_t hdr_len;
+    const uint8_t* payload;
+    size_t len;
+} soliton_datagram;
+
+/* Seal count datagrams back to back into out, ready for one UDP_SEGMENT
+ * (GSO) send: each is written as hdr || ciphertext || 16-byte tag.
+ * Every datagram but the last must come to exactly segment_size bytes on
+ * the wire and the last to at most segment_size, which is the layout the
+ * kernel splits on. Datagram i uses the nonce iv ^ (0^32 || be64(first_pn
+ * + i)), the QUIC / DTLS 1.3 per-packet nonce; any AAD prefix bound to
+ * ctx is hashed ahead of each header. Tags match reset/aad/update/final
+ * per datagram with that nonce; the tag masks E_K(J0) of several
+ * datagrams are encrypted in one multi-block pass. A payload may already
+ * sit at its ciphertext position in out (in-place), otherwise inputs must
+ * not overlap out. ctx is left finalized (reset before reusing it for a
+ * stream). *out_len gets the bytes written; SOLITON_INVALID_INPUT for a
+ * layout that does not fit segment_size or out_cap. Header protection is
+ * the caller's. */
+soliton_status soliton_aesgcm_seal_gso(
+    soliton_aesgcm_ctx* ctx,
+    const uint8_t iv[12],
+    uint64_t first_pn,
+    const soliton_datagram* dgrams, size_t count,
+    size_t segment_size,
+    uint8_t* out, size_t out_cap, size_t* out_len);
+
 /* ======================== Policy Notes ========================= */
 
 /*
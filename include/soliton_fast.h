@@ -0,0 +1,124 @@
+/*
+ * soliton_fast.h - Unchecked inline AES-GCM entry points
+ *
+ * The soliton_aesgcm_* calls validate every argument and the context state
+ * machine on each call, then branch through ctx->backend and ctx->plan.
+ * For hot loops that already guarantee those preconditions, the calls here
+ * skip validation and call kernels resolved once by soliton_fast_init().
+ * Each entry point is one indirect call through the soliton_fast table,
+ * which init writes once and nothing writes afterwards. The size tier
+ * (below SOLITON_FAST_SMALL_MAX or not) is decided inline, so a caller
+ * with a constant length compiles to one table load and that call, with
+ * no argument checks or backend/plan lookups in between.
+ *
+ * Rules:
+ *   - soliton_fast_init() once per process, before any other thread uses
+ *     these calls; contexts come from soliton_aesgcm_init as usual
+ *   - 96-bit IVs only (soliton_aesgcm_reset for other lengths)
+ *   - Same call order as the checked API: reset, aad*, update*, final
+ *   - Checked and fast calls may be mixed on one context
+ *   - soliton_fast_aesgcm_reset resumes from a bound AAD prefix
+ *     (soliton_aesgcm_aad_prefix_bind), as the checked reset does
+ *
+ * Preconditions are asserted with SOLITON_FAST_CHECK in debug builds and
+ * compiled out under NDEBUG (or SOLITON_FAST_NO_CHECKS). A violated
+ * precondition traps instead of returning a status code.
+ */
+
+#ifndef SOLITON_FAST_H
+#define SOLITON_FAST_H
+
+#include "soliton.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Lengths below this take the small tier (no batch loop or plan lookup) */
+#define SOLITON_FAST_SMALL_MAX 128u
+
+/* Kernel table, written by soliton_fast_init() only; read-only to callers */
+typedef struct {
+    void (*gcm_reset96)(soliton_aesgcm_ctx* ctx, const uint8_t iv[12]);
+    void (*gcm_aad)(soliton_aesgcm_ctx* ctx, const uint8_t* aad, size_t len);
+    void (*gcm_seal_small)(soliton_aesgcm_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len);
+    void (*gcm_open_small)(soliton_aesgcm_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len);
+    void (*gcm_seal_bulk)(soliton_aesgcm_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len);
+    void (*gcm_open_bulk)(soliton_aesgcm_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len);
+    void (*gcm_seal_final)(soliton_aesgcm_ctx* ctx, uint8_t tag[SOLITON_AESGCM_TAG_BYTES]);
+    soliton_status (*gcm_open_final)(soliton_aesgcm_ctx* ctx, const uint8_t tag[SOLITON_AESGCM_TAG_BYTES]);
+} soliton_fast_table;
+
+extern soliton_fast_table soliton_fast;
+
+/* Resolve the kernel table for the running CPU (idempotent) */
+void soliton_fast_init(void);
+
+/* Precondition classes for soliton_fast_gcm_valid */
+enum {
+    SOLITON_FAST_OP_RESET  = 0,
+    SOLITON_FAST_OP_AAD    = 1,
+    SOLITON_FAST_OP_UPDATE = 2,
+    SOLITON_FAST_OP_FINAL  = 3
+};
+
+/* Non-zero if the checked API would accept op on ctx (debug checks only) */
+int soliton_fast_gcm_valid(const soliton_aesgcm_ctx* ctx, unsigned op,
+                           const void* in, const void* out, size_t len);
+
+#if !defined(NDEBUG) && !defined(SOLITON_FAST_NO_CHECKS)
+#define SOLITON_FAST_CHECK(cond) do { if (!(cond)) __builtin_trap(); } while (0)
+#else
+#define SOLITON_FAST_CHECK(cond) ((void)0)
+#endif
+
+static inline void soliton_fast_aesgcm_reset(soliton_aesgcm_ctx* ctx, const uint8_t iv[12]) {
+    SOLITON_FAST_CHECK(soliton_fast_gcm_valid(ctx, SOLITON_FAST_OP_RESET, iv, iv, 12));
+    soliton_fast.gcm_reset96(ctx, iv);
+}
+
+static inline void soliton_fast_aesgcm_aad_update(soliton_aesgcm_ctx* ctx, const uint8_t* aad, size_t len) {
+    SOLITON_FAST_CHECK(soliton_fast_gcm_valid(ctx, SOLITON_FAST_OP_AAD, aad, aad, len));
+    soliton_fast.gcm_aad(ctx, aad, len);
+}
+
+static inline void soliton_fast_aesgcm_encrypt_update(
+    soliton_aesgcm_ctx* ctx, const uint8_t* pt, uint8_t* ct, size_t len) {
+
+    SOLITON_FAST_CHECK(soliton_fast_gcm_valid(ctx, SOLITON_FAST_OP_UPDATE, pt, ct, len));
+    if (len < SOLITON_FAST_SMALL_MAX) {
+        soliton_fast.gcm_seal_small(ctx, pt, ct, len);
+    } else {
+        soliton_fast.gcm_seal_bulk(ctx, pt, ct, len);
+    }
+}
+
+static inline void soliton_fast_aesgcm_decrypt_update(
+    soliton_aesgcm_ctx* ctx, const uint8_t* ct, uint8_t* pt, size_t len) {
+
+    SOLITON_FAST_CHECK(soliton_fast_gcm_valid(ctx, SOLITON_FAST_OP_UPDATE, ct, pt, len));
+    if (len < SOLITON_FAST_SMALL_MAX) {
+        soliton_fast.gcm_open_small(ctx, ct, pt, len);
+    } else {
+        soliton_fast.gcm_open_bulk(ctx, ct, pt, len);
+    }
+}
+
+static inline void soliton_fast_aesgcm_encrypt_final(soliton_aesgcm_ctx* ctx, uint8_t tag[SOLITON_AESGCM_TAG_BYTES]) {
+    SOLITON_FAST_CHECK(soliton_fast_gcm_valid(ctx, SOLITON_FAST_OP_FINAL, tag, tag, SOLITON_AESGCM_TAG_BYTES));
+    soliton_fast.gcm_seal_final(ctx, tag);
+}
+
+/* SOLITON_OK or SOLITON_AUTH_FAIL, as soliton_aesgcm_decrypt_final */
+static inline soliton_status soliton_fast_aesgcm_decrypt_final(
+    soliton_aesgcm_ctx* ctx, const uint8_t tag[SOLITON_AESGCM_TAG_BYTES]) {
+
+    SOLITON_FAST_CHECK(soliton_fast_gcm_valid(ctx, SOLITON_FAST_OP_FINAL, tag, tag, SOLITON_AESGCM_TAG_BYTES));
+    return soliton_fast.gcm_open_final(ctx, tag);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOLITON_FAST_H */
@@ -0,0 +1,300 @@
+/*
+ * soliton_hosted.h - Hosted (POSIX) helpers for soliton.c
+ *
+ * Everything here needs an operating system (files, mmap, randomness) and
+ * lives in libsoliton_hosted.a, built separately from the freestanding core.
+ */
+
+#ifndef SOLITON_HOSTED_H
+#define SOLITON_HOSTED_H
+
+#include "soliton.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ================= AES-GCM key snapshot files ==================== */
+
+/* A snapshot mapped privately (copy-on-write) and opened in place */
+typedef struct {
+    uint8_t* base;      /* mapping base (page aligned) */
+    size_t   len;       /* mapping length */
+    size_t   count;     /* number of contexts */
+} soliton_keysnap_map;
+
+/* Write a sealed snapshot of count contexts to path
+ * A fresh random nonce is drawn per file; the file is written to
+ * "<path>.tmp", synced and renamed so readers never see a partial file. */
+soliton_status soliton_keysnap_save(
+    const char* path,
+    const soliton_aesgcm_ctx* const* ctxs, size_t count,
+    const uint8_t wrap_key[SOLITON_KEYSNAP_WRAP_KEY_BYTES]);
+
+/* Map a snapshot file and open it in place
+ * Cold start cost is one sequential read + ChaCha20-Poly1305 pass; no key
+ * expansion or H-power computation. Contexts are then obtained with
+ * soliton_keysnap_ctx(map->base, i). Same status codes as
+ * soliton_keysnap_open, SOLITON_INTERNAL_ERROR for I/O failures. */
+soliton_status soliton_keysnap_load(
+    const char* path,
+    const uint8_t wrap_key[SOLITON_KEYSNAP_WRAP_KEY_BYTES],
+    soliton_keysnap_map* map);
+
+/* Wipe and unmap a loaded snapshot */
+void soliton_keysnap_unload(soliton_keysnap_map* map);
+
+/* ================= Per-tenant cost ledger ==================== */
+
+/* One ledger row: a tenant's merged AES-GCM cost counters */
+typedef struct {
+    uint64_t            tenant;
+    soliton_aesgcm_cost cost;
+} soliton_cost_entry;
+
+/* Rows sorted by tenant id; lookups are binary searches */
+typedef struct {
+    soliton_cost_entry* entries;
+    size_t              count;
+    size_t              capacity;
+} soliton_cost_ledger;
+
+/* Initialize an empty ledger (no allocation until the first merge) */
+void soliton_cost_ledger_init(soliton_cost_ledger* ledger);
+
+/* Add cost into the tenant's row, creating it on first use
+ * Returns SOLITON_INTERNAL_ERROR if the row cannot be allocated. */
+soliton_status soliton_cost_ledger_merge(
+    soliton_cost_ledger* ledger, uint64_t tenant,
+    const soliton_aesgcm_cost* cost);
+
+/* Merge a context's counters into the tenant's row and zero them on the
+ * context, so periodic harvesting never counts a call twice */
+soliton_status soliton_cost_ledger_harvest(
+    soliton_cost_ledger* ledger, uint64_t tenant,
+    soliton_aesgcm_ctx* ctx);
+
+/* The tenant's merged counters, or NULL if the tenant has no row */
+const soliton_aesgcm_cost* soliton_cost_ledger_get(
+    const soliton_cost_ledger* ledger, uint64_t tenant);
+
+/* Release the ledger's rows */
+void soliton_cost_ledger_free(soliton_cost_ledger* ledger);
+
+/* Estimated total cycles: sampled_cycles scaled by calls / sampled_calls
+ * (0 when nothing was sampled) */
+uint64_t soliton_cost_estimated_cycles(const soliton_aesgcm_cost* cost);
+
+/* ================= Live statistics page ==================== */
+
+/* Shared-memory page a monitor (soliton-top) maps read-only by PID. The
+ * process's data path only adds to its thread's slot of the
+ * soliton_stats_block attached to the core; a publisher sums the slots
+ * into the page under a seqlock, so readers get a consistent snapshot
+ * without syscalls, signals or locks on either side. */
+#define SOLITON_STATS_PAGE_MAGIC   0x54534c53u  /* "SLST" */
+#define SOLITON_STATS_PAGE_VERSION 1u
+#define SOLITON_STATS_PAGE_DIR     "/dev/shm"
+#define SOLITON_STATS_PAGE_MODE    0600         /* Owner only: run soliton-top as the same user */
+
+typedef struct {
+    uint32_t      magic;        /* SOLITON_STATS_PAGE_MAGIC */
+    uint32_t      version;      /* SOLITON_STATS_PAGE_VERSION */
+    uint32_t      size;         /* sizeof(soliton_stats_page) */
+    uint32_t      pid;          /* Publishing process */
+    uint64_t      seq;          /* Seqlock: odd while the snapshot is written */
+    uint64_t      start_ns;     /* CLOCK_MONOTONIC at publisher start */
+    uint64_t      publish_ns;   /* CLOCK_MONOTONIC of this snapshot */
+    uint64_t      publishes;    /* Snapshots written */
+    soliton_stats snapshot;
+} soliton_stats_page;
+
+typedef struct soliton_stats_publisher soliton_stats_publisher;
+
+/* "<SOLITON_STATS_PAGE_DIR>/soliton-stats.<pid>"; -1 if buf is too small */
+int soliton_stats_page_path(uint32_t pid, char* buf, size_t len);
+
+/* Create this process's page, attach the process's soliton_stats_block
+ * (counting from zero) and, if interval_ms > 0, publish from a background thread every
+ * interval_ms. A stale file or symlink at the path is unlinked and the
+ * page created O_EXCL with SOLITON_STATS_PAGE_MODE. SOLITON_INVALID_INPUT
+ * while another publisher is running, SOLITON_INTERNAL_ERROR for file,
+ * mapping or thread errors. */
+soliton_status soliton_stats_publish_start(unsigned interval_ms, soliton_stats_publisher** out);
+
+/* Publish a snapshot now (also safe alongside the background thread) */
+void soliton_stats_publish(soliton_stats_publisher* pub);
+
+/* Detach from the core, stop the thread, remove the page and free the
+ * publisher. The counter block itself is static, so calls still adding
+ * into it after the detach stay safe. */
+void soliton_stats_publish_stop(soliton_stats_publisher* pub);
+
+/* Seqlock writer: copy stats into page->snapshot stamped now_ns (one
+ * writer at a time per page) */
+void soliton_stats_page_write(soliton_stats_page* page, const soliton_stats* stats, uint64_t now_ns);
+
+/* Seqlock reader: a consistent copy of the snapshot and its time
+ * SOLITON_UNSUPPORTED for a foreign magic or version, SOLITON_INTERNAL_ERROR
+ * if the writer kept the page busy. */
+soliton_status soliton_stats_page_read(
+    const soliton_stats_page* page, soliton_stats* out, uint64_t* publish_ns);
+
+/* A page mapped read-only by a monitor */
+typedef struct {
+    const soliton_stats_page* page;
+    size_t                    len;
+} soliton_stats_view;
+
+/* Map the page of process pid (SOLITON_INTERNAL_ERROR if it has none) */
+soliton_status soliton_stats_view_open(uint32_t pid, soliton_stats_view* view);
+
+void soliton_stats_view_close(soliton_stats_view* view);
+
+/* ================= Kernel A/B experiments ==================== */
+
+/* Run a candidate encrypt plan on a fraction of real contexts next to the
+ * incumbent. Assignment hashes a key id (or the context address) with the
+ * salt, so a key stays in one arm across restarts and hosts. The core
+ * times 1 in sample_every encrypt updates of each enrolled context into
+ * soliton_ab_samples, without touching the context's cost counters;
+ * soliton_ab_read turns them into a per-size-class
+ * delta with a 95% interval. One experiment per process at a time; the
+ * report math needs -lm. */
+typedef struct {
+    soliton_gcm_plan control;       /* Arm 0 plan (usually SOLITON_GCM_PLAN_AUTO) */
+    soliton_gcm_plan treatment;     /* Arm 1 plan */
+    uint32_t         treatment_ppm; /* Share of contexts in arm 1, per million */
+    uint32_t         sample_every;  /* Cycle sample period, a power of two >= 1 */
+    uint64_t         salt;          /* Reshuffles the assignment per experiment */
+} soliton_ab_config;
+
+typedef struct soliton_ab_experiment soliton_ab_experiment;
+
+/* Fewest samples per arm before a class can be called significant */
+#define SOLITON_AB_MIN_CALLS 32
+
+typedef struct {
+    uint64_t size_min;                          /* Update sizes in the class, inclusive */
+    uint64_t size_max;
+    uint64_t calls[SOLITON_AB_ARMS];            /* Sampled updates */
+    double   mean_cycles[SOLITON_AB_ARMS];
+    double   cycles_per_byte[SOLITON_AB_ARMS];
+    double   delta_pct;     /* Treatment mean vs control mean (negative: faster) */
+    double   ci95_pct;      /* Half-width of the 95% interval on delta_pct */
+    int      significant;   /* Both arms >= SOLITON_AB_MIN_CALLS, interval excludes 0 */
+} soliton_ab_class_report;
+
+typedef struct {
+    soliton_ab_class_report classes[SOLITON_AB_CLASSES];
+    uint64_t enrolled[SOLITON_AB_ARMS];         /* Contexts assigned (0 from summarize) */
+    uint64_t outliers[SOLITON_AB_ARMS];         /* Samples dropped as preemptions */
+    int      killed;                            /* Kill switch pulled */
+} soliton_ab_report;
+
+/* Validate cfg and attach the zeroed sample block with cfg's period.
+ * Does not re-arm a pulled kill switch (soliton_plan_variants_enable(1)
+ * does); until then enrolled contexts run AUTO and nothing is sampled.
+ * SOLITON_INVALID_INPUT for a bad plan, share or period, or while another
+ * experiment is running. */
+soliton_status soliton_ab_start(const soliton_ab_config* cfg, soliton_ab_experiment** out);
+
+/* Arm (0 or 1) cfg assigns: by key_id, or by the context address if 0 */
+unsigned soliton_ab_arm(const soliton_ab_config* cfg, const void* ctx, uint64_t key_id);
+
+/* Put an initialized context in its arm: plan and sample tag only (cost
+ * counters and cost sampling are left alone). Re-enroll after every init.
+ * No-op once killed; SOLITON_UNSUPPORTED (context untouched) if the
+ * backend cannot run the arm's plan. */
+soliton_status soliton_ab_enroll(soliton_ab_experiment* exp, soliton_aesgcm_ctx* ctx, uint64_t key_id);
+
+/* Kill switch: every context back on its AUTO plan at its next update,
+ * sampling stops. Process-wide (soliton_plan_variants_enable(0)) and it
+ * stays pulled, through later experiments too, until the operator calls
+ * soliton_plan_variants_enable(1). */
+void soliton_ab_kill(soliton_ab_experiment* exp);
+
+/* Report from the experiment's live samples */
+soliton_status soliton_ab_read(const soliton_ab_experiment* exp, soliton_ab_report* out);
+
+/* Report from any sample block (e.g. one merged across processes) */
+void soliton_ab_summarize(const soliton_ab_samples* samples, soliton_ab_report* out);
+
+/* Detach the samples and free the experiment (the sample block is static,
+ * so late samples stay safe); enrolled contexts keep their plan until
+ * re-initialized, so kill first to roll everyone back */
+void soliton_ab_stop(soliton_ab_experiment* exp);
+
+/* ============== Parallel AES-GCM over many messages ============== */
+
+/* Seal or open thousands of independent messages under one key on a
+ * persistent thread pool. A job is cut into contiguous runs of messages of
+ * roughly equal bytes (not equal counts) and dealt to per-worker
+ * work-stealing deques; idle workers steal runs from busy ones. Each
+ * message runs whole on one thread through the checked API, so it gets the
+ * same kernel a single-threaded caller would. Jobs below
+ * SOLITON_POOL_SERIAL_BYTES run on the calling thread without waking the
+ * pool. One job at a time per pool; other callers wait. */
+typedef struct {
+    uint8_t        iv[12];
+    uint8_t        tag[SOLITON_AESGCM_TAG_BYTES];  /* Written by seal, checked by open */
+    const uint8_t* aad;         /* May be NULL when aad_len is 0 */
+    size_t         aad_len;
+    const uint8_t* in;          /* Plaintext (seal) or ciphertext (open) */
+    uint8_t*       out;         /* Ciphertext (seal) or plaintext (open); may equal in */
+    size_t         len;
+} soliton_gcm_msg;
+
+typedef struct soliton_gcm_pool soliton_gcm_pool;
+
+/* Jobs with fewer total bytes than this stay on the calling thread */
+#define SOLITON_POOL_SERIAL_BYTES 65536u
+
+/* Per-worker totals since the pool was created (worker 0 is the caller) */
+typedef struct {
+    uint64_t jobs;              /* Jobs this worker took part in */
+    uint64_t messages;
+    uint64_t bytes;             /* Message + AAD bytes */
+    uint64_t steals;            /* Runs taken from another worker's deque */
+} soliton_gcm_pool_stats;
+
+/* Pool of threads workers: the thread calling seal_many/open_many is
+ * worker 0 and threads - 1 helpers are started now and kept parked
+ * between jobs. threads == 0 means one per CPU in the process's affinity
+ * mask. With pin set, helper i is pinned to the i-th CPU of that mask
+ * (pin the calling thread to the first one for one worker per core).
+ * SOLITON_INTERNAL_ERROR if threads or memory cannot be had. */
+soliton_status soliton_gcm_pool_create(unsigned threads, int pin, soliton_gcm_pool** out);
+
+/* Stop and join the helpers, wipe their contexts and free */
+void soliton_gcm_pool_destroy(soliton_gcm_pool* pool);
+
+/* Workers in the pool, the caller included */
+unsigned soliton_gcm_pool_size(const soliton_gcm_pool* pool);
+
+/* Totals of one worker (SOLITON_INVALID_INPUT if worker is out of range) */
+soliton_status soliton_gcm_pool_stats_get(const soliton_gcm_pool* pool, unsigned worker,
+                                          soliton_gcm_pool_stats* out);
+
+/* Encrypt count messages under key, writing each out and tag
+ * status (may be NULL) gets one code per message: SOLITON_INVALID_INPUT
+ * for NULL buffers with a length, SOLITON_INTERNAL_ERROR for messages that
+ * never ran (context setup or memory failure). Returns SOLITON_OK if every message
+ * sealed, else the status of the first failed message. pool may be NULL
+ * to run everything on the calling thread. */
+soliton_status soliton_aesgcm_seal_many(
+    soliton_gcm_pool* pool, const uint8_t key[SOLITON_AESGCM_KEY_BYTES],
+    soliton_gcm_msg* msgs, size_t count, soliton_status* status);
+
+/* Decrypt and verify count messages under key (see seal_many)
+ * A message failing its tag gets SOLITON_AUTH_FAIL and its out is zeroed;
+ * the others are unaffected. */
+soliton_status soliton_aesgcm_open_many(
+    soliton_gcm_pool* pool, const uint8_t key[SOLITON_AESGCM_KEY_BYTES],
+    const soliton_gcm_msg* msgs, size_t count, soliton_status* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOLITON_HOSTED_H */
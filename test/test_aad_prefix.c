@@ -0,0 +1,193 @@
+/*
+ * test_aad_prefix.c - Bound AAD prefix (soliton_aesgcm_aad_prefix_bind)
+ *
+ * PROOF OBLIGATIONS:
+ *   1. For prefix lengths 16..512 and suffix lengths 0..40, bind + suffix
+ *      gives the same ciphertext and tag as passing prefix || suffix to
+ *      aad_update, on the bind message and on later resets (96-bit and
+ *      non-96-bit IVs, soliton_fast.h reset)
+ *   2. The tag matches OpenSSL over the full AAD, and open with a bound
+ *      prefix accepts it
+ *   3. Unaligned prefixes, binding after AAD or data, and uninitialized
+ *      contexts are rejected; prefix_len 0 and init clear the binding
+ *
+ * Compile: cc -O2 -o test_aad_prefix test_aad_prefix.c -L. -lsoliton_core -lcrypto
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <openssl/evp.h>
+
+#include "../include/soliton_fast.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_PREFIX 512
+#define MAX_SUFFIX 40
+#define MSG_LEN 300
+
+static uint8_t ref_buf[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t bound_buf[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t key[32], iv[12], long_iv[20];
+static uint8_t aad[MAX_PREFIX + MAX_SUFFIX];
+static uint8_t pt[MSG_LEN], ref_ct[MSG_LEN], ct[MSG_LEN], out[MSG_LEN];
+
+/* Full AAD through aad_update every message */
+static void ref_seal(const uint8_t* nonce, size_t nonce_len, size_t aad_len, uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ref = (soliton_aesgcm_ctx*)ref_buf;
+
+    soliton_aesgcm_reset(ref, nonce, nonce_len);
+    soliton_aesgcm_aad_update(ref, aad, aad_len);
+    soliton_aesgcm_encrypt_update(ref, pt, ref_ct, MSG_LEN);
+    soliton_aesgcm_encrypt_final(ref, tag);
+}
+
+/* Suffix only, prefix already bound to ctx */
+static void bound_seal(soliton_aesgcm_ctx* ctx, const uint8_t* suffix, size_t suffix_len, uint8_t tag[16]) {
+    soliton_aesgcm_aad_update(ctx, suffix, suffix_len);
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, MSG_LEN);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+}
+
+static void openssl_tag(size_t aad_len, uint8_t tag[16]) {
+    int outl = 0;
+    uint8_t tmp[MSG_LEN];
+    EVP_CIPHER_CTX* evp = EVP_CIPHER_CTX_new();
+    EVP_EncryptInit_ex(evp, EVP_aes_256_gcm(), NULL, NULL, NULL);
+    EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_SET_IVLEN, 12, NULL);
+    EVP_EncryptInit_ex(evp, NULL, NULL, key, iv);
+    EVP_EncryptUpdate(evp, NULL, &outl, aad, (int)aad_len);
+    EVP_EncryptUpdate(evp, tmp, &outl, pt, MSG_LEN);
+    EVP_EncryptFinal_ex(evp, tmp + outl, &outl);
+    EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_GET_TAG, 16, tag);
+    EVP_CIPHER_CTX_free(evp);
+}
+
+static void test_equivalence(void) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)bound_buf;
+    uint8_t ref_tag[16], tag[16], ossl_tag[16];
+    int first = 1, later = 1, long_ok = 1, fast_ok = 1, ossl = 1, open_ok = 1;
+    size_t cases = 0;
+    char what[96];
+
+    printf("\nBound prefix vs full AAD:\n");
+
+    for (size_t plen = 16; plen <= MAX_PREFIX; plen += plen < 64 ? 16 : 112) {
+        for (size_t slen = 0; slen <= MAX_SUFFIX; slen += 13) {
+            const uint8_t* suffix = aad + plen;
+            cases++;
+
+            /* Message the prefix is bound on */
+            fill(iv, sizeof(iv), (uint32_t)(plen * 64 + slen));
+            ref_seal(iv, sizeof(iv), plen + slen, ref_tag);
+            soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+            first &= soliton_aesgcm_aad_prefix_bind(ctx, aad, plen) == SOLITON_OK;
+            bound_seal(ctx, suffix, slen, tag);
+            first &= memcmp(ct, ref_ct, MSG_LEN) == 0 && memcmp(tag, ref_tag, 16) == 0;
+
+            openssl_tag(plen + slen, ossl_tag);
+            ossl &= memcmp(tag, ossl_tag, 16) == 0;
+
+            /* Later messages on the same binding */
+            for (uint32_t m = 0; m < 3; m++) {
+                fill(iv, sizeof(iv), (uint32_t)(plen + slen + m + 7));
+                ref_seal(iv, sizeof(iv), plen + slen, ref_tag);
+                soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+                bound_seal(ctx, suffix, slen, tag);
+                later &= memcmp(ct, ref_ct, MSG_LEN) == 0 && memcmp(tag, ref_tag, 16) == 0;
+            }
+
+            fill(long_iv, sizeof(long_iv), (uint32_t)(plen + slen));
+            ref_seal(long_iv, sizeof(long_iv), plen + slen, ref_tag);
+            soliton_aesgcm_reset(ctx, long_iv, sizeof(long_iv));
+            bound_seal(ctx, suffix, slen, tag);
+            long_ok &= memcmp(ct, ref_ct, MSG_LEN) == 0 && memcmp(tag, ref_tag, 16) == 0;
+
+            fill(iv, sizeof(iv), (uint32_t)(plen + slen + 99));
+            ref_seal(iv, sizeof(iv), plen + slen, ref_tag);
+            soliton_fast_aesgcm_reset(ctx, iv);
+            if (slen > 0) {
+                soliton_fast_aesgcm_aad_update(ctx, suffix, slen);
+            }
+            soliton_fast_aesgcm_encrypt_update(ctx, pt, ct, MSG_LEN);
+            soliton_fast_aesgcm_encrypt_final(ctx, tag);
+            fast_ok &= memcmp(ct, ref_ct, MSG_LEN) == 0 && memcmp(tag, ref_tag, 16) == 0;
+
+            soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+            soliton_aesgcm_aad_update(ctx, suffix, slen);
+            soliton_aesgcm_decrypt_update(ctx, ref_ct, out, MSG_LEN);
+            open_ok &= soliton_aesgcm_decrypt_final(ctx, ref_tag) == SOLITON_OK && memcmp(out, pt, MSG_LEN) == 0;
+        }
+    }
+
+    snprintf(what, sizeof(what), "bind message matches for %zu prefix/suffix pairs", cases);
+    check(first, what);
+    check(later, "later resets resume from the bound prefix");
+    check(long_ok, "20-byte IV reset resumes from the bound prefix");
+    check(fast_ok, "soliton_fast_aesgcm_reset resumes from the bound prefix");
+    check(ossl, "tag matches OpenSSL over prefix || suffix");
+    check(open_ok, "open with a bound prefix accepts the full-AAD tag");
+}
+
+static void test_rejects(void) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)bound_buf;
+    static uint8_t blank[CTX_SIZE] __attribute__((aligned(64)));
+    uint8_t ref_tag[16], tag[16];
+
+    printf("\nArgument and state checks:\n");
+
+    fill(iv, sizeof(iv), 5);
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    check(soliton_aesgcm_aad_prefix_bind(ctx, aad, 24) == SOLITON_INVALID_INPUT, "unaligned prefix rejected");
+    check(soliton_aesgcm_aad_prefix_bind(ctx, NULL, 16) == SOLITON_INVALID_INPUT, "NULL prefix rejected");
+    check(soliton_aesgcm_aad_prefix_bind(NULL, aad, 16) == SOLITON_INVALID_INPUT, "NULL context rejected");
+    check(soliton_aesgcm_aad_prefix_bind((soliton_aesgcm_ctx*)blank, aad, 16) == SOLITON_INVALID_INPUT,
+          "uninitialized context rejected");
+
+    soliton_aesgcm_aad_update(ctx, aad, 16);
+    check(soliton_aesgcm_aad_prefix_bind(ctx, aad, 16) == SOLITON_INVALID_INPUT, "bind after AAD rejected");
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, 16);
+    check(soliton_aesgcm_aad_prefix_bind(ctx, aad, 16) == SOLITON_INVALID_INPUT, "bind after data rejected");
+
+    /* Unbind: reset hashes nothing up front again */
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_prefix_bind(ctx, aad, 64);
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    check(soliton_aesgcm_aad_prefix_bind(ctx, NULL, 0) == SOLITON_OK, "prefix_len 0 accepted");
+    ref_seal(iv, sizeof(iv), 20, ref_tag);
+    bound_seal(ctx, aad, 20, tag);
+    check(memcmp(tag, ref_tag, 16) == 0, "prefix_len 0 clears the binding");
+
+    soliton_aesgcm_aad_prefix_bind(ctx, aad, 64);
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    bound_seal(ctx, aad, 20, tag);
+    check(memcmp(tag, ref_tag, 16) == 0, "init clears the binding");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("Bound AAD Prefix Validation\n");
+    printf("==========================================\n");
+
+    fill(key, sizeof(key), 1);
+    fill(aad, sizeof(aad), 2);
+    fill(pt, sizeof(pt), 3);
+    soliton_aesgcm_init((soliton_aesgcm_ctx*)ref_buf, key, iv, sizeof(iv));
+    soliton_aesgcm_init((soliton_aesgcm_ctx*)bound_buf, key, iv, sizeof(iv));
+    soliton_fast_init();
+
+    test_equivalence();
+    test_rejects();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL AAD PREFIX TESTS PASSED\n");
+    } else {
+        printf("✗ %d AAD PREFIX TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
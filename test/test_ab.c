@@ -0,0 +1,375 @@
+/*
+ * test_ab.c - GCM plan variants + hosted A/B experiments
+ *
+ * PROOF OBLIGATIONS:
+ *   1. Every plan variant seals to the same ciphertext and tag as the plan
+ *      init picked, across batch, 16-block and tail boundaries
+ *   2. A variant runs its own bulk kernel; the kill switch sends every
+ *      context back to its AUTO kernel at the next update and counts as a
+ *      plan switch; init restores AUTO
+ *   3. Assignment is deterministic per key id, honours the share within
+ *      sampling error, and changes with the salt
+ *   4. Enrolled contexts' sampled encrypt updates land in their arm and
+ *      size class (decrypts do not); enrolment leaves cost counters and
+ *      cost sampling alone; after the kill switch nothing is sampled and
+ *      enrolment is a no-op
+ *   5. The report's delta, interval and significance match hand-computed
+ *      Welch statistics
+ *   6. One experiment runs at a time; the next one starts from empty
+ *      samples, times 1 in sample_every updates per context, and does not
+ *      re-arm a pulled kill switch
+ *
+ * Compile: cc -O2 -o test_ab test_ab.c -L. -lsoliton_hosted -lsoliton_core -lm
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../include/soliton_hosted.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_LEN 16401
+#define N_CTX 64
+
+static uint8_t ctx_buf[N_CTX][CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t key[32], iv[12], aad[20];
+static uint8_t pt[MAX_LEN], ct[MAX_LEN], ref[MAX_LEN];
+
+static soliton_aesgcm_ctx* ctx_at(int i) {
+    return (soliton_aesgcm_ctx*)ctx_buf[i];
+}
+
+static void seal(soliton_aesgcm_ctx* ctx, uint8_t* out, size_t len, uint8_t tag[16]) {
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_encrypt_update(ctx, pt, out, len);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+}
+
+static const char* plan_name(soliton_gcm_plan p) {
+    static const char* const names[] = { "AUTO", "RESIDENT8", "FUSED16", "PIPELINED16" };
+    return names[p];
+}
+
+static void test_equivalence(void) {
+    static const size_t sizes[] = { 0, 15, 16, 100, 128, 255, 256, 384, 1000, 2053, 4096, 16401 };
+    soliton_aesgcm_ctx* ctx = ctx_at(0);
+    char what[128];
+
+    printf("\nPlan variants vs AUTO:\n");
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    check(soliton_aesgcm_set_plan(ctx, (soliton_gcm_plan)4) == SOLITON_INVALID_INPUT &&
+          soliton_aesgcm_set_plan(NULL, SOLITON_GCM_PLAN_AUTO) == SOLITON_INVALID_INPUT,
+          "unknown plan / NULL context rejected");
+
+    for (int p = SOLITON_GCM_PLAN_RESIDENT8; p <= SOLITON_GCM_PLAN_PIPELINED16; p++) {
+        int same = 1;
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            uint8_t tag_ref[16], tag[16];
+            soliton_aesgcm_set_plan(ctx, SOLITON_GCM_PLAN_AUTO);
+            seal(ctx, ref, sizes[i], tag_ref);
+            soliton_aesgcm_set_plan(ctx, (soliton_gcm_plan)p);
+            seal(ctx, ct, sizes[i], tag);
+            same &= memcmp(ct, ref, sizes[i]) == 0 && memcmp(tag, tag_ref, 16) == 0;
+        }
+        snprintf(what, sizeof(what), "%s: same ciphertext and tag, 0..16401 bytes", plan_name((soliton_gcm_plan)p));
+        check(same, what);
+    }
+    soliton_aesgcm_context_wipe(ctx);
+}
+
+static soliton_stats_block stats_block;
+
+/* Kernel that ran the bulk of one 4096-byte seal */
+static int bulk_kernel(soliton_aesgcm_ctx* ctx, soliton_stats* st) {
+    uint8_t tag[16];
+    memset(&stats_block, 0, sizeof(stats_block));
+    seal(ctx, ct, 4096, tag);
+    soliton_stats_sum(&stats_block, st);
+    for (int k = 0; k < SOLITON_STATS_KERNELS; k++) {
+        if (st->kernel_calls[k]) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+static void test_routing(void) {
+    soliton_aesgcm_ctx* ctx = ctx_at(0);
+    soliton_stats st;
+
+    printf("\nKernel routing + kill switch:\n");
+
+    soliton_stats_attach(&stats_block);
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    const int auto_kernel = bulk_kernel(ctx, &st);
+    check(auto_kernel >= 0, "AUTO runs a bulk kernel");
+
+    soliton_aesgcm_set_plan(ctx, SOLITON_GCM_PLAN_RESIDENT8);
+    check(bulk_kernel(ctx, &st) == SOLITON_KERNEL_RESIDENT, "RESIDENT8 -> resident kernel");
+    soliton_aesgcm_set_plan(ctx, SOLITON_GCM_PLAN_FUSED16);
+    check(bulk_kernel(ctx, &st) == SOLITON_KERNEL_FUSED16, "FUSED16 -> fused16 kernel");
+    soliton_aesgcm_set_plan(ctx, SOLITON_GCM_PLAN_PIPELINED16);
+    check(bulk_kernel(ctx, &st) == SOLITON_KERNEL_PIPELINED16, "PIPELINED16 -> pipelined16 kernel");
+
+    memset(&stats_block, 0, sizeof(stats_block));
+    soliton_plan_variants_enable(0);
+    soliton_plan_variants_enable(0);
+    soliton_stats_sum(&stats_block, &st);
+    check(st.plan_switches == 1, "kill switch counts one plan switch");
+    check(bulk_kernel(ctx, &st) == auto_kernel, "killed: variant context back on the AUTO kernel");
+
+    soliton_plan_variants_enable(1);
+    check(bulk_kernel(ctx, &st) == SOLITON_KERNEL_PIPELINED16, "re-enabled: variant applies again");
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    check(bulk_kernel(ctx, &st) == auto_kernel, "init restores AUTO");
+
+    soliton_stats_attach(NULL);
+    soliton_aesgcm_context_wipe(ctx);
+}
+
+static void test_assignment(void) {
+    soliton_ab_config cfg = { SOLITON_GCM_PLAN_AUTO, SOLITON_GCM_PLAN_FUSED16, 250000, 1, 7 };
+    unsigned treated = 0, moved = 0, stable = 1;
+    const unsigned n = 20000;
+
+    printf("\nAssignment:\n");
+
+    for (uint64_t id = 1; id <= n; id++) {
+        const unsigned a = soliton_ab_arm(&cfg, NULL, id);
+        treated += a;
+        stable &= soliton_ab_arm(&cfg, NULL, id) == a;
+    }
+    check(stable, "same key id, same arm");
+    check(treated > n / 4 - 300 && treated < n / 4 + 300, "25% share within sampling error (20000 keys)");
+
+    cfg.treatment_ppm = 0;
+    unsigned none = 0, all = 0;
+    for (uint64_t id = 1; id <= 1000; id++) {
+        none += soliton_ab_arm(&cfg, NULL, id);
+    }
+    cfg.treatment_ppm = 1000000;
+    for (uint64_t id = 1; id <= 1000; id++) {
+        all += soliton_ab_arm(&cfg, NULL, id);
+    }
+    check(none == 0 && all == 1000, "0 ppm: all control, 1000000 ppm: all treatment");
+
+    cfg.treatment_ppm = 500000;
+    soliton_ab_config other = cfg;
+    other.salt = 8;
+    for (uint64_t id = 1; id <= 1000; id++) {
+        moved += soliton_ab_arm(&cfg, NULL, id) != soliton_ab_arm(&other, NULL, id);
+    }
+    check(moved > 300 && moved < 700, "new salt reshuffles about half the keys");
+
+    check(soliton_ab_arm(&cfg, ctx_at(3), 0) == soliton_ab_arm(&cfg, NULL, (uint64_t)(uintptr_t)ctx_at(3)),
+          "key id 0 assigns by context address");
+}
+
+static void test_experiment(void) {
+    const soliton_ab_config cfg = {
+        SOLITON_GCM_PLAN_RESIDENT8, SOLITON_GCM_PLAN_FUSED16, 500000, 1, 0x5eed
+    };
+    soliton_ab_experiment* exp = NULL;
+    soliton_ab_report r;
+    uint8_t tag[16];
+    unsigned arms[N_CTX], expect_arm[SOLITON_AB_ARMS] = { 0, 0 };
+
+    printf("\nLive experiment:\n");
+
+    soliton_ab_config bad = cfg;
+    bad.sample_every = 3;
+    check(soliton_ab_start(&bad, &exp) == SOLITON_INVALID_INPUT, "non-power-of-two period rejected");
+    bad = cfg;
+    bad.treatment_ppm = 1000001;
+    check(soliton_ab_start(&bad, &exp) == SOLITON_INVALID_INPUT, "share above 100% rejected");
+
+    check(soliton_ab_start(&cfg, &exp) == SOLITON_OK && exp, "start");
+    soliton_ab_experiment* dup = NULL;
+    check(soliton_ab_start(&cfg, &dup) == SOLITON_INVALID_INPUT && !dup, "second experiment rejected while one runs");
+    int enrolled = 1;
+    for (int i = 0; i < N_CTX; i++) {
+        soliton_aesgcm_init(ctx_at(i), key, iv, sizeof(iv));
+        if (i == 0) {
+            /* A tenant's chargeback counters, running before enrolment */
+            soliton_aesgcm_cost_enable(ctx_at(0), 4);
+            seal(ctx_at(0), ct, 300, tag);
+        }
+        enrolled &= soliton_ab_enroll(exp, ctx_at(i), 1000 + (uint64_t)i) == SOLITON_OK;
+        arms[i] = soliton_ab_arm(&cfg, ctx_at(i), 1000 + (uint64_t)i);
+        expect_arm[arms[i]]++;
+    }
+    check(enrolled, "enroll 64 contexts by key id");
+    soliton_aesgcm_cost cost;
+    soliton_aesgcm_cost_read(ctx_at(0), &cost);
+    check(cost.enc_messages == 1 && cost.calls == 3, "enroll keeps the tenant's cost counters");
+
+    /* Per context: 3 x 4096-byte and 2 x 300-byte encrypts, 1 decrypt */
+    for (int i = 0; i < N_CTX; i++) {
+        for (int m = 0; m < 3; m++) {
+            seal(ctx_at(i), ct, 4096, tag);
+        }
+        for (int m = 0; m < 2; m++) {
+            seal(ctx_at(i), ct, 300, tag);
+        }
+        soliton_aesgcm_reset(ctx_at(i), iv, sizeof(iv));
+        soliton_aesgcm_decrypt_update(ctx_at(i), ct, ref, 300);
+        soliton_aesgcm_decrypt_final(ctx_at(i), tag);
+    }
+
+    check(soliton_ab_read(exp, &r) == SOLITON_OK, "read report");
+    check(r.enrolled[0] == expect_arm[0] && r.enrolled[1] == expect_arm[1] &&
+          expect_arm[0] > 0 && expect_arm[1] > 0, "enrolled counts match the assignment, both arms used");
+
+    /* 4096 B: class 6 [2048, 8191]; 300 B: class 4 [128, 511] */
+    check(r.classes[6].size_min == 2048 && r.classes[6].size_max == 8191 &&
+          r.classes[4].size_min == 128 && r.classes[4].size_max == 511, "class bounds");
+    check(r.classes[6].calls[0] == 3 * expect_arm[0] && r.classes[6].calls[1] == 3 * expect_arm[1],
+          "4096-byte encrypts sampled per arm");
+    check(r.classes[4].calls[0] == 2 * expect_arm[0] && r.classes[4].calls[1] == 2 * expect_arm[1],
+          "300-byte encrypts sampled per arm, decrypts not");
+    uint64_t other = 0;
+    for (int c = 0; c < SOLITON_AB_CLASSES; c++) {
+        if (c != 4 && c != 6) {
+            other += r.classes[c].calls[0] + r.classes[c].calls[1];
+        }
+    }
+    check(other == 0, "no samples in other classes");
+    soliton_aesgcm_cost_read(ctx_at(0), &cost);
+    check(cost.enc_messages == 6 && cost.calls == 3 * 6 + 2 && cost.sampled_calls == 20 / 4,
+          "tenant's cost sampling keeps its own period");
+    soliton_aesgcm_cost_read(ctx_at(1), &cost);
+    check(cost.calls == 0 && cost.enc_messages == 0, "enroll does not turn cost counting on");
+    check(r.classes[6].mean_cycles[0] > 0 && r.classes[6].mean_cycles[1] > 0 &&
+          r.classes[6].cycles_per_byte[0] > 0 && isfinite(r.classes[6].ci95_pct) &&
+          r.classes[6].ci95_pct >= 0, "means, cycles/byte and interval populated");
+
+    printf("    4096 B: control %.0f cyc, treatment %.0f cyc, delta %+.1f%% +/- %.1f%%%s\n",
+           r.classes[6].mean_cycles[0], r.classes[6].mean_cycles[1], r.classes[6].delta_pct,
+           r.classes[6].ci95_pct, r.classes[6].significant ? " (significant)" : "");
+
+    soliton_ab_kill(exp);
+    for (int i = 0; i < N_CTX; i++) {
+        seal(ctx_at(i), ct, 4096, tag);
+    }
+    soliton_ab_report after;
+    soliton_ab_read(exp, &after);
+    check(after.killed && after.classes[6].calls[0] == r.classes[6].calls[0] &&
+          after.classes[6].calls[1] == r.classes[6].calls[1], "killed: nothing sampled");
+
+    soliton_aesgcm_init(ctx_at(0), key, iv, sizeof(iv));
+    soliton_ab_enroll(exp, ctx_at(0), 1000);
+    soliton_ab_read(exp, &after);
+    check(after.enrolled[0] + after.enrolled[1] == N_CTX, "killed: enroll is a no-op");
+
+    soliton_ab_stop(exp);
+    soliton_ab_config every4 = cfg;
+    every4.sample_every = 4;
+    check(soliton_ab_start(&every4, &exp) == SOLITON_OK && soliton_ab_read(exp, &after) == SOLITON_OK &&
+          after.classes[6].calls[0] == 0 && after.classes[6].calls[1] == 0 && after.enrolled[0] == 0,
+          "restart after stop begins with empty samples");
+    for (int i = 0; i < N_CTX; i++) {
+        soliton_aesgcm_init(ctx_at(i), key, iv, sizeof(iv));
+        soliton_ab_enroll(exp, ctx_at(i), 1000 + (uint64_t)i);
+        seal(ctx_at(i), ct, 4096, tag);
+    }
+    soliton_ab_read(exp, &after);
+    check(after.classes[6].calls[0] + after.classes[6].calls[1] == 0,
+          "restart does not re-arm the kill switch");
+
+    soliton_plan_variants_enable(1);
+    for (int i = 0; i < N_CTX; i++) {
+        for (int m = 0; m < 8; m++) {
+            seal(ctx_at(i), ct, 4096, tag);
+        }
+    }
+    soliton_ab_read(exp, &after);
+    check(after.classes[6].calls[0] == 2 * expect_arm[0] && after.classes[6].calls[1] == 2 * expect_arm[1],
+          "re-armed: 1 in 4 encrypt updates sampled per context");
+    soliton_ab_stop(exp);
+    for (int i = 0; i < N_CTX; i++) {
+        soliton_aesgcm_context_wipe(ctx_at(i));
+    }
+}
+
+/* n samples alternating lo, hi cycles into arm/class 5, as the core adds them */
+static void add_samples(soliton_ab_samples* s, unsigned arm, unsigned n, uint64_t lo, uint64_t hi) {
+    for (unsigned i = 0; i < n; i++) {
+        const uint64_t dt = (i & 1) ? hi : lo, q = (dt + 8) >> 4;
+        s->calls[arm][5]++;
+        s->bytes[arm][5] += 1000;
+        s->cycles[arm][5] += dt;
+        s->cycles_sq[arm][5] += q * q;
+    }
+}
+
+static void test_statistics(void) {
+    soliton_ab_samples s;
+    soliton_ab_report r;
+
+    printf("\nReport statistics:\n");
+
+    /* Control 1000 +/- 40, treatment 900 +/- 40: -10%, +/- 1.96 * 5.69 / 1000 */
+    memset(&s, 0, sizeof(s));
+    add_samples(&s, 0, 100, 960, 1040);
+    add_samples(&s, 1, 100, 864, 944);
+    soliton_ab_summarize(&s, &r);
+    const soliton_ab_class_report* c = &r.classes[5];
+    check(fabs(c->mean_cycles[0] - 1000) < 1e-9 && fabs(c->mean_cycles[1] - 904) < 1e-9, "means");
+    check(fabs(c->cycles_per_byte[0] - 1.0) < 1e-9, "cycles per byte");
+    check(fabs(c->delta_pct - -9.6) < 1e-9, "delta -9.6%");
+    const double se = sqrt(1600.0 * 100 / 99 / 100 * 2);
+    check(fabs(c->ci95_pct - 100 * 1.96 * se / 1000) < 0.02, "95% interval from Welch standard error");
+    check(c->significant, "significant");
+
+    memset(&s, 0, sizeof(s));
+    add_samples(&s, 0, 100, 960, 1040);
+    add_samples(&s, 1, 100, 960, 1040);
+    soliton_ab_summarize(&s, &r);
+    check(fabs(r.classes[5].delta_pct) < 1e-9 && !r.classes[5].significant, "identical arms: 0%, not significant");
+
+    memset(&s, 0, sizeof(s));
+    add_samples(&s, 0, 10, 960, 1040);
+    add_samples(&s, 1, 10, 464, 544);
+    soliton_ab_summarize(&s, &r);
+    check(r.classes[5].delta_pct < -40 && !r.classes[5].significant,
+          "below SOLITON_AB_MIN_CALLS: never significant");
+
+    memset(&s, 0, sizeof(s));
+    add_samples(&s, 0, 100, 1000, 1000);
+    soliton_ab_summarize(&s, &r);
+    check(r.classes[5].delta_pct == 0 && r.classes[5].ci95_pct == 0 && !r.classes[5].significant,
+          "one arm empty: no delta");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("GCM Plan Variant A/B Validation\n");
+    printf("==========================================\n");
+
+    fill(key, sizeof(key), 1);
+    fill(iv, sizeof(iv), 2);
+    fill(aad, sizeof(aad), 3);
+    fill(pt, sizeof(pt), 4);
+
+    test_equivalence();
+    test_routing();
+    test_assignment();
+    test_experiment();
+    test_statistics();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL PLAN VARIANT A/B TESTS PASSED\n");
+    } else {
+        printf("✗ %d PLAN VARIANT A/B TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,372 @@
+/*
+ * test_aegis.c — AEGIS-128L / AEGIS-256 Test Vectors and Equivalence
+ *
+ * PROOF OBLIGATIONS:
+ *   1. Known-answer vectors (draft-irtf-cfrg-aegis-aead) match exactly
+ *      for ciphertext and 128-bit tag, via the streaming and one-shot APIs
+ *   2. Arbitrary streaming splits of AAD and message match one-shot output
+ *   3. Decryption round-trips; a flipped tag bit returns AUTH_FAIL and the
+ *      one-shot API zeroes the plaintext
+ *   4. soliton_aegis_batch_update matches per-stream output (VAES lanes)
+ *   5. Scalar fallback kernels match the selected (AES-NI/VAES) backend
+ *
+ * Compile: cc -O2 -o test_aegis test_aegis.c -L. -lsoliton_core
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+/* Scalar kernels (core/aegis_scalar.c) for backend cross-checks */
+extern void aegis128l_init_scalar(uint8_t*, const uint8_t*, const uint8_t*);
+extern void aegis128l_absorb_scalar(uint8_t*, const uint8_t*, size_t);
+extern void aegis128l_encrypt_scalar(uint8_t*, const uint8_t*, uint8_t*, size_t);
+extern void aegis128l_final_scalar(uint8_t*, uint64_t, uint64_t, uint8_t*);
+extern void aegis256_init_scalar(uint8_t*, const uint8_t*, const uint8_t*);
+extern void aegis256_absorb_scalar(uint8_t*, const uint8_t*, size_t);
+extern void aegis256_encrypt_scalar(uint8_t*, const uint8_t*, uint8_t*, size_t);
+extern void aegis256_final_scalar(uint8_t*, uint64_t, uint64_t, uint8_t*);
+
+#define CTX_SIZE 1024
+
+typedef struct {
+    const char* name;
+    soliton_aegis_alg alg;
+    const char* key_hex;
+    const char* nonce_hex;
+    const char* aad_hex;
+    const char* pt_hex;
+    const char* ct_hex;
+    const char* tag_hex;
+} aegis_vector_t;
+
+static const aegis_vector_t vectors[] = {
+    {
+        .name = "AEGIS-128L TV1 (16-byte PT)",
+        .alg = SOLITON_AEGIS_128L,
+        .key_hex = "10010000000000000000000000000000",
+        .nonce_hex = "10000200000000000000000000000000",
+        .aad_hex = "",
+        .pt_hex = "00000000000000000000000000000000",
+        .ct_hex = "c1c0e58bd913006feba00f4b3cc3594e",
+        .tag_hex = "abe0ece80c24868a226a35d16bdae37a"
+    },
+    {
+        .name = "AEGIS-128L TV3 (8-byte AAD, 32-byte PT)",
+        .alg = SOLITON_AEGIS_128L,
+        .key_hex = "10010000000000000000000000000000",
+        .nonce_hex = "10000200000000000000000000000000",
+        .aad_hex = "0001020304050607",
+        .pt_hex = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+        .ct_hex = "79d94593d8c2119d7e8fd9b8fc77845c5c077a05b2528b6ac54b563aed8efe84",
+        .tag_hex = "cc6f3372f6aa1bb82388d695c3962d9a"
+    },
+    {
+        .name = "AEGIS-128L (8-byte AAD, 13-byte PT)",
+        .alg = SOLITON_AEGIS_128L,
+        .key_hex = "10010000000000000000000000000000",
+        .nonce_hex = "10000200000000000000000000000000",
+        .aad_hex = "0001020304050607",
+        .pt_hex = "000102030405060708090a0b0c",
+        .ct_hex = "79d94593d8c2119d7e8fd9b8fc",
+        .tag_hex = "1f9d42ea70716f08ca6564451c35a4ac"
+    },
+    {
+        .name = "AEGIS-128L (16-byte AAD, 40-byte PT)",
+        .alg = SOLITON_AEGIS_128L,
+        .key_hex = "10010000000000000000000000000000",
+        .nonce_hex = "10000200000000000000000000000000",
+        .aad_hex = "000102030405060708090a0b0c0d0e0f",
+        .pt_hex = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+                  "2021222324252627",
+        .ct_hex = "79d94593d8c2119d7e8fd9b8fc77845c5c077a05b2528b6ac54b563aed8efe84"
+                  "8320629d2cfa7e19",
+        .tag_hex = "5edff11f0e5ea7d4f01dcfee1aa396fd"
+    },
+    {
+        .name = "AEGIS-256 TV1 (16-byte PT)",
+        .alg = SOLITON_AEGIS_256,
+        .key_hex = "1001000000000000000000000000000000000000000000000000000000000000",
+        .nonce_hex = "1000020000000000000000000000000000000000000000000000000000000000",
+        .aad_hex = "",
+        .pt_hex = "00000000000000000000000000000000",
+        .ct_hex = "754fc3d8c973246dcc6d741412a4b236",
+        .tag_hex = "3fe91994768b332ed7f570a19ec5896e"
+    },
+    {
+        .name = "AEGIS-256 (8-byte AAD, 32-byte PT)",
+        .alg = SOLITON_AEGIS_256,
+        .key_hex = "1001000000000000000000000000000000000000000000000000000000000000",
+        .nonce_hex = "1000020000000000000000000000000000000000000000000000000000000000",
+        .aad_hex = "0001020304050607",
+        .pt_hex = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+        .ct_hex = "f373079ed84b2709faee373584585d60accd191db310ef5d8b11833df9dec711",
+        .tag_hex = "8d86f91ee606e9ff26a01b64ccbdd91d"
+    },
+    {
+        .name = "AEGIS-256 (8-byte AAD, 13-byte PT)",
+        .alg = SOLITON_AEGIS_256,
+        .key_hex = "1001000000000000000000000000000000000000000000000000000000000000",
+        .nonce_hex = "1000020000000000000000000000000000000000000000000000000000000000",
+        .aad_hex = "0001020304050607",
+        .pt_hex = "000102030405060708090a0b0c",
+        .ct_hex = "f373079ed84b2709faee373584",
+        .tag_hex = "a795d1fbcf2975497874ad5223a161fd"
+    },
+    {
+        .name = "AEGIS-256 (16-byte AAD, 40-byte PT)",
+        .alg = SOLITON_AEGIS_256,
+        .key_hex = "1001000000000000000000000000000000000000000000000000000000000000",
+        .nonce_hex = "1000020000000000000000000000000000000000000000000000000000000000",
+        .aad_hex = "000102030405060708090a0b0c0d0e0f",
+        .pt_hex = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+                  "2021222324252627",
+        .ct_hex = "f373079ed84b2709faee373584585d6037a0d4bd2894f000f3c0f594d0578778"
+                  "61719793f889c388",
+        .tag_hex = "d2dd3c176c1443e6b16fb65ccdd3ca07"
+    },
+};
+
+#define NUM_VECTORS (sizeof(vectors) / sizeof(vectors[0]))
+
+/* Test 1: known-answer vectors */
+static void test_vectors(void) {
+    printf("\n[1] Known-answer vectors\n");
+
+    for (size_t v = 0; v < NUM_VECTORS; v++) {
+        const aegis_vector_t* tv = &vectors[v];
+        uint8_t key[32], nonce[32], aad[64], pt[64], ct_exp[64], tag_exp[16];
+        uint8_t ct[64], tag[16], dec[64];
+        uint8_t ctx_buffer[CTX_SIZE] __attribute__((aligned(64)));
+        soliton_aegis_ctx* ctx = (soliton_aegis_ctx*)ctx_buffer;
+
+        hex_to_bytes(key, tv->key_hex);
+        hex_to_bytes(nonce, tv->nonce_hex);
+        size_t aad_len = (size_t)hex_to_bytes(aad, tv->aad_hex);
+        size_t pt_len = (size_t)hex_to_bytes(pt, tv->pt_hex);
+        hex_to_bytes(ct_exp, tv->ct_hex);
+        hex_to_bytes(tag_exp, tv->tag_hex);
+
+        printf(" %s\n", tv->name);
+
+        /* Streaming API */
+        soliton_aegis_init(ctx, tv->alg, key, nonce);
+        soliton_aegis_aad_update(ctx, aad, aad_len);
+        soliton_aegis_encrypt_update(ctx, pt, ct, pt_len);
+        soliton_aegis_encrypt_final(ctx, tag);
+        check(memcmp(ct, ct_exp, pt_len) == 0 && memcmp(tag, tag_exp, 16) == 0,
+              "streaming encrypt");
+
+        /* One-shot API */
+        memset(ct, 0, sizeof(ct));
+        memset(tag, 0, sizeof(tag));
+        soliton_status st = soliton_aegis_encrypt(tv->alg, key, nonce, aad, aad_len,
+                                                  pt, ct, pt_len, tag);
+        check(st == SOLITON_OK && memcmp(ct, ct_exp, pt_len) == 0 &&
+              memcmp(tag, tag_exp, 16) == 0, "one-shot encrypt");
+
+        st = soliton_aegis_decrypt(tv->alg, key, nonce, aad, aad_len,
+                                   ct_exp, dec, pt_len, tag_exp);
+        check(st == SOLITON_OK && memcmp(dec, pt, pt_len) == 0, "one-shot decrypt");
+
+        soliton_aegis_context_wipe(ctx);
+    }
+}
+
+/* Test 2: streaming splits match one-shot */
+static void test_streaming(void) {
+    static const size_t splits[] = { 1, 7, 15, 16, 17, 31, 32, 33, 100 };
+    uint8_t key[32], nonce[32], aad[77], pt[517];
+    uint8_t ct_ref[517], tag_ref[16], ct[517], tag[16];
+
+    printf("\n[2] Streaming splits vs one-shot\n");
+
+    fill(key, sizeof(key), 1);
+    fill(nonce, sizeof(nonce), 2);
+    fill(aad, sizeof(aad), 3);
+    fill(pt, sizeof(pt), 4);
+
+    for (int a = 0; a < 2; a++) {
+        soliton_aegis_alg alg = a == 0 ? SOLITON_AEGIS_128L : SOLITON_AEGIS_256;
+        int ok = 1;
+
+        soliton_aegis_encrypt(alg, key, nonce, aad, sizeof(aad), pt, ct_ref, sizeof(pt), tag_ref);
+
+        for (size_t s = 0; s < sizeof(splits) / sizeof(splits[0]); s++) {
+            uint8_t ctx_buffer[CTX_SIZE] __attribute__((aligned(64)));
+            soliton_aegis_ctx* ctx = (soliton_aegis_ctx*)ctx_buffer;
+            size_t step = splits[s];
+
+            soliton_aegis_init(ctx, alg, key, nonce);
+            for (size_t off = 0; off < sizeof(aad); off += step) {
+                size_t n = sizeof(aad) - off < step ? sizeof(aad) - off : step;
+                soliton_aegis_aad_update(ctx, aad + off, n);
+            }
+            for (size_t off = 0; off < sizeof(pt); off += step) {
+                size_t n = sizeof(pt) - off < step ? sizeof(pt) - off : step;
+                soliton_aegis_encrypt_update(ctx, pt + off, ct + off, n);
+            }
+            soliton_aegis_encrypt_final(ctx, tag);
+            ok &= memcmp(ct, ct_ref, sizeof(pt)) == 0 && memcmp(tag, tag_ref, 16) == 0;
+
+            /* Streaming decrypt, in place */
+            uint8_t buf[517];
+            memcpy(buf, ct_ref, sizeof(buf));
+            soliton_aegis_init(ctx, alg, key, nonce);
+            soliton_aegis_aad_update(ctx, aad, sizeof(aad));
+            for (size_t off = 0; off < sizeof(buf); off += step) {
+                size_t n = sizeof(buf) - off < step ? sizeof(buf) - off : step;
+                soliton_aegis_decrypt_update(ctx, buf + off, buf + off, n);
+            }
+            ok &= soliton_aegis_decrypt_final(ctx, tag_ref) == SOLITON_OK;
+            ok &= memcmp(buf, pt, sizeof(pt)) == 0;
+        }
+
+        check(ok, alg == SOLITON_AEGIS_128L ? "AEGIS-128L splits 1..100 bytes"
+                                            : "AEGIS-256 splits 1..100 bytes");
+    }
+}
+
+/* Test 3: authentication failure */
+static void test_auth_fail(void) {
+    uint8_t key[32], nonce[32], pt[100], ct[100], dec[100], tag[16];
+
+    printf("\n[3] Authentication failure\n");
+
+    fill(key, sizeof(key), 5);
+    fill(nonce, sizeof(nonce), 6);
+    fill(pt, sizeof(pt), 7);
+
+    for (int a = 0; a < 2; a++) {
+        soliton_aegis_alg alg = a == 0 ? SOLITON_AEGIS_128L : SOLITON_AEGIS_256;
+        uint8_t zeros[100] = {0};
+
+        soliton_aegis_encrypt(alg, key, nonce, NULL, 0, pt, ct, sizeof(pt), tag);
+        tag[0] ^= 0x01;
+        memset(dec, 0xFF, sizeof(dec));
+        soliton_status st = soliton_aegis_decrypt(alg, key, nonce, NULL, 0, ct, dec, sizeof(ct), tag);
+        check(st == SOLITON_AUTH_FAIL && memcmp(dec, zeros, sizeof(dec)) == 0,
+              alg == SOLITON_AEGIS_128L ? "AEGIS-128L bad tag rejected, PT zeroed"
+                                        : "AEGIS-256 bad tag rejected, PT zeroed");
+    }
+}
+
+/* Test 4: batch API matches per-stream output */
+static void test_batch(void) {
+    enum { STREAMS = 7 };
+    static const size_t lens[STREAMS] = { 0, 64, 1000, 4096, 33, 4096, 17 };
+    uint8_t ctx_buffers[STREAMS][CTX_SIZE] __attribute__((aligned(64)));
+    soliton_aegis_ctx* ctxs[STREAMS];
+    soliton_span spans[STREAMS];
+    uint8_t* pts[STREAMS];
+    uint8_t* cts[STREAMS];
+    uint8_t* refs[STREAMS];
+    uint8_t key[32], nonce[32], aad[20];
+
+    printf("\n[4] Batch vs per-stream\n");
+
+    for (int a = 0; a < 2; a++) {
+        soliton_aegis_alg alg = a == 0 ? SOLITON_AEGIS_128L : SOLITON_AEGIS_256;
+        int ok = 1;
+
+        for (int i = 0; i < STREAMS; i++) {
+            pts[i] = malloc(lens[i] + 1);
+            cts[i] = malloc(lens[i] + 1);
+            refs[i] = malloc(lens[i] + 1);
+            fill(pts[i], lens[i], 100 + (uint32_t)i);
+
+            ctxs[i] = (soliton_aegis_ctx*)ctx_buffers[i];
+            fill(key, sizeof(key), 200 + (uint32_t)i);
+            fill(nonce, sizeof(nonce), 300 + (uint32_t)i);
+            fill(aad, sizeof(aad), 400 + (uint32_t)i);
+            soliton_aegis_init(ctxs[i], alg, key, nonce);
+            /* Odd-sized AAD on some streams exercises the AAD flush */
+            soliton_aegis_aad_update(ctxs[i], aad, (size_t)(i % 3) * 7);
+
+            spans[i].in = pts[i];
+            spans[i].out = cts[i];
+            spans[i].len = lens[i];
+        }
+
+        ok &= soliton_aegis_batch_update(NULL, ctxs, spans, STREAMS) == SOLITON_OK;
+
+        for (int i = 0; i < STREAMS; i++) {
+            uint8_t tag[16], tag_ref[16];
+
+            soliton_aegis_encrypt_final(ctxs[i], tag);
+
+            fill(key, sizeof(key), 200 + (uint32_t)i);
+            fill(nonce, sizeof(nonce), 300 + (uint32_t)i);
+            fill(aad, sizeof(aad), 400 + (uint32_t)i);
+            soliton_aegis_encrypt(alg, key, nonce, aad, (size_t)(i % 3) * 7,
+                                  pts[i], refs[i], lens[i], tag_ref);
+
+            ok &= memcmp(cts[i], refs[i], lens[i]) == 0 && memcmp(tag, tag_ref, 16) == 0;
+
+            free(pts[i]);
+            free(cts[i]);
+            free(refs[i]);
+        }
+
+        check(ok, alg == SOLITON_AEGIS_128L ? "AEGIS-128L batch of 7 streams"
+                                            : "AEGIS-256 batch of 7 streams");
+    }
+}
+
+/* Test 5: scalar kernels match the selected backend */
+static void test_scalar_equivalence(void) {
+    uint8_t key[32], nonce[32], aad[64], pt[4096], ct[4096], ct_ref[4096];
+    uint8_t tag[16], tag_ref[16];
+    uint8_t state[128];
+
+    printf("\n[5] Scalar fallback vs selected backend\n");
+
+    fill(key, sizeof(key), 8);
+    fill(nonce, sizeof(nonce), 9);
+    fill(aad, sizeof(aad), 10);
+    fill(pt, sizeof(pt), 11);
+
+    soliton_aegis_encrypt(SOLITON_AEGIS_128L, key, nonce, aad, sizeof(aad),
+                          pt, ct_ref, sizeof(pt), tag_ref);
+    aegis128l_init_scalar(state, key, nonce);
+    aegis128l_absorb_scalar(state, aad, sizeof(aad) / 32);
+    aegis128l_encrypt_scalar(state, pt, ct, sizeof(pt) / 32);
+    aegis128l_final_scalar(state, sizeof(aad), sizeof(pt), tag);
+    check(memcmp(ct, ct_ref, sizeof(pt)) == 0 && memcmp(tag, tag_ref, 16) == 0,
+          "AEGIS-128L scalar == dispatched (4 KiB)");
+
+    soliton_aegis_encrypt(SOLITON_AEGIS_256, key, nonce, aad, sizeof(aad),
+                          pt, ct_ref, sizeof(pt), tag_ref);
+    aegis256_init_scalar(state, key, nonce);
+    aegis256_absorb_scalar(state, aad, sizeof(aad) / 16);
+    aegis256_encrypt_scalar(state, pt, ct, sizeof(pt) / 16);
+    aegis256_final_scalar(state, sizeof(aad), sizeof(pt), tag);
+    check(memcmp(ct, ct_ref, sizeof(pt)) == 0 && memcmp(tag, tag_ref, 16) == 0,
+          "AEGIS-256 scalar == dispatched (4 KiB)");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("AEGIS-128L / AEGIS-256 Validation\n");
+    printf("==========================================\n");
+
+    test_vectors();
+    test_streaming();
+    test_auth_fail();
+    test_batch();
+    test_scalar_equivalence();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL AEGIS TESTS PASSED\n");
+    } else {
+        printf("✗ %d AEGIS TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+/*
+ * test_chacha_variants.c — ChaCha20 / ChaCha12 / ChaCha8 Specialization
+ *
+ * PROOF OBLIGATIONS:
+ *   1. Keystream known-answer vectors for 20/12/8 rounds match exactly
+ *      (all-zero key/nonce, and the RFC 8439 §2.3.2 key/nonce at counter 1)
+ *   2. soliton_chacha_stream_xor (selected AVX2/NEON backend + scalar tail)
+ *      matches the round-specialized scalar kernels at every length 0..1100
+ *   3. soliton_chacha_init is identical to init_variant(SOLITON_CHACHA20)
+ *   4. Each AEAD variant round-trips, rejects a flipped tag, and produces
+ *      ciphertext distinct from the other variants
+ *
+ * Compile: cc -O2 -o test_chacha_variants test_chacha_variants.c -L. -lsoliton_core
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+/* Scalar kernels (core/chacha_scalar.c) for backend cross-checks */
+extern void chacha20_xor_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+extern void chacha12_xor_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+extern void chacha8_xor_scalar(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t);
+
+#define CTX_SIZE 1024
+
+static const soliton_chacha_variant variants[3] = {
+    SOLITON_CHACHA20, SOLITON_CHACHA12, SOLITON_CHACHA8
+};
+static const char* variant_names[3] = { "ChaCha20", "ChaCha12", "ChaCha8" };
+
+typedef struct {
+    const char* name;
+    soliton_chacha_variant variant;
+    int rfc_key;        /* 0: all-zero key/nonce, counter 0; 1: RFC 8439 §2.3.2 */
+    const char* block;  /* first 64-byte keystream block */
+} stream_vector;
+
+static const stream_vector stream_vectors[] = {
+    { "ChaCha20 zero key", SOLITON_CHACHA20, 0,
+      "76b8e0ada0f13d90405d6ae55386bd28bdd219b8a08ded1aa836efcc8b770dc7"
+      "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee6586" },
+    { "ChaCha12 zero key", SOLITON_CHACHA12, 0,
+      "9bf49a6a0755f953811fce125f2683d50429c3bb49e074147e0089a52eae155f"
+      "0564f879d27ae3c02ce82834acfa8c793a629f2ca0de6919610be82f411326be" },
+    { "ChaCha8 zero key", SOLITON_CHACHA8, 0,
+      "3e00ef2f895f40d67f5bb8e81f09a5a12c840ec3ce9a7f3b181be188ef711a1e"
+      "984ce172b9216f419f445367456d5619314a42a3da86b001387bfdb80e0cfe42" },
+    { "ChaCha20 RFC 8439 2.3.2", SOLITON_CHACHA20, 1,
+      "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+      "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e" },
+    { "ChaCha12 RFC 8439 key/nonce", SOLITON_CHACHA12, 1,
+      "7f8b136677c73799e3e7777d16e6d8ccc787ce39694990c628e087029ce9190b"
+      "da4be31ac3fe2102a9ad737cf82fa3b06e68b63371c65c827299040ade1ba8a0" },
+    { "ChaCha8 RFC 8439 key/nonce", SOLITON_CHACHA8, 1,
+      "eead9dfbbc60443e9d6811bab8e60a3ac6001e0dfb985f65efcb0ea42454411c"
+      "64747ef73d4766e0c20e19208e5cb11777d487263152e65dc5ff947fcab23b2b" },
+};
+
+static void test_stream_vectors(void) {
+    printf("\n[1] Keystream known-answer vectors\n");
+
+    for (size_t v = 0; v < sizeof(stream_vectors) / sizeof(stream_vectors[0]); v++) {
+        const stream_vector* tv = &stream_vectors[v];
+        uint8_t key[32] = {0}, nonce[12] = {0}, expect[64];
+        uint8_t zeros[64] = {0}, out[64];
+        uint32_t counter = 0;
+
+        if (tv->rfc_key) {
+            for (int i = 0; i < 32; i++) key[i] = (uint8_t)i;
+            hex_to_bytes(nonce, "000000090000004a00000000");
+            counter = 1;
+        }
+        hex_to_bytes(expect, tv->block);
+
+        soliton_status st = soliton_chacha_stream_xor(tv->variant, key, nonce, counter,
+                                                      zeros, out, sizeof(out));
+        check(st == SOLITON_OK && memcmp(out, expect, 64) == 0, tv->name);
+    }
+
+    uint8_t key[32] = {0}, nonce[12] = {0}, buf[1] = {0};
+    check(soliton_chacha_stream_xor((soliton_chacha_variant)7, key, nonce, 0, buf, buf, 1)
+          == SOLITON_INVALID_INPUT, "unknown variant rejected");
+}
+
+static void test_backend_equivalence(void) {
+    printf("\n[2] Selected backend vs scalar kernels (lengths 0..1100)\n");
+
+    static uint8_t in[1100], ref[1100], out[1100];
+    uint8_t key[32], nonce[12];
+    void (*scalar[3])(const uint8_t*, const uint8_t*, uint32_t, const uint8_t*, uint8_t*, size_t) = {
+        chacha20_xor_scalar, chacha12_xor_scalar, chacha8_xor_scalar
+    };
+
+    fill(key, sizeof(key), 1);
+    fill(nonce, sizeof(nonce), 2);
+    fill(in, sizeof(in), 3);
+
+    for (int v = 0; v < 3; v++) {
+        int ok = 1;
+        for (size_t len = 0; len <= sizeof(in) && ok; len++) {
+            uint32_t counter = (uint32_t)(len * 7);
+            scalar[v](key, nonce, counter, in, ref, len);
+            soliton_chacha_stream_xor(variants[v], key, nonce, counter, in, out, len);
+            ok = memcmp(ref, out, len) == 0;
+            if (!ok) printf("    mismatch at len=%zu\n", len);
+        }
+
+        /* In-place operation */
+        memcpy(out, in, sizeof(in));
+        soliton_chacha_stream_xor(variants[v], key, nonce, 5, out, out, sizeof(out));
+        scalar[v](key, nonce, 5, in, ref, sizeof(in));
+        ok = ok && memcmp(ref, out, sizeof(out)) == 0;
+
+        char what[64];
+        snprintf(what, sizeof(what), "%s bulk + tail (incl. in-place)", variant_names[v]);
+        check(ok, what);
+    }
+}
+
+static int aead_seal(soliton_chacha_variant variant, int use_default_init,
+                     const uint8_t* key, const uint8_t* nonce,
+                     const uint8_t* aad, size_t aad_len,
+                     const uint8_t* pt, uint8_t* ct, size_t len, uint8_t tag[16]) {
+    uint8_t ctx_buffer[CTX_SIZE] __attribute__((aligned(64)));
+    soliton_chacha_ctx* ctx = (soliton_chacha_ctx*)ctx_buffer;
+    soliton_status st = use_default_init ? soliton_chacha_init(ctx, key, nonce)
+                                         : soliton_chacha_init_variant(ctx, variant, key, nonce);
+    if (st != SOLITON_OK) return 0;
+    if (soliton_chacha_aad_update(ctx, aad, aad_len) != SOLITON_OK) return 0;
+    if (soliton_chacha_encrypt_update(ctx, pt, ct, len) != SOLITON_OK) return 0;
+    st = soliton_chacha_encrypt_final(ctx, tag);
+    soliton_chacha_context_wipe(ctx);
+    return st == SOLITON_OK;
+}
+
+static soliton_status aead_open(soliton_chacha_variant variant,
+                                const uint8_t* key, const uint8_t* nonce,
+                                const uint8_t* aad, size_t aad_len,
+                                const uint8_t* ct, uint8_t* pt, size_t len, const uint8_t tag[16]) {
+    uint8_t ctx_buffer[CTX_SIZE] __attribute__((aligned(64)));
+    soliton_chacha_ctx* ctx = (soliton_chacha_ctx*)ctx_buffer;
+    soliton_chacha_init_variant(ctx, variant, key, nonce);
+    soliton_chacha_aad_update(ctx, aad, aad_len);
+    soliton_chacha_decrypt_update(ctx, ct, pt, len);
+    soliton_status st = soliton_chacha_decrypt_final(ctx, tag);
+    soliton_chacha_context_wipe(ctx);
+    return st;
+}
+
+static void test_aead(void) {
+    printf("\n[3] AEAD variants\n");
+
+    enum { LEN = 777 };
+    uint8_t key[32], nonce[12], aad[37], pt[LEN], dec[LEN];
+    uint8_t ct[3][LEN], tag[3][16];
+
+    fill(key, sizeof(key), 11);
+    fill(nonce, sizeof(nonce), 12);
+    fill(aad, sizeof(aad), 13);
+    fill(pt, sizeof(pt), 14);
+
+    /* Default init is ChaCha20 */
+    uint8_t ct_default[LEN], tag_default[16];
+    int ok = aead_seal(SOLITON_CHACHA20, 1, key, nonce, aad, sizeof(aad), pt, ct_default, LEN, tag_default);
+    ok = ok && aead_seal(SOLITON_CHACHA20, 0, key, nonce, aad, sizeof(aad), pt, ct[0], LEN, tag[0]);
+    check(ok && memcmp(ct_default, ct[0], LEN) == 0 && memcmp(tag_default, tag[0], 16) == 0,
+          "soliton_chacha_init == init_variant(SOLITON_CHACHA20)");
+
+    for (int v = 1; v < 3; v++) {
+        aead_seal(variants[v], 0, key, nonce, aad, sizeof(aad), pt, ct[v], LEN, tag[v]);
+    }
+
+    for (int v = 0; v < 3; v++) {
+        char what[64];
+
+        memset(dec, 0, sizeof(dec));
+        soliton_status st = aead_open(variants[v], key, nonce, aad, sizeof(aad), ct[v], dec, LEN, tag[v]);
+        snprintf(what, sizeof(what), "%s round-trip", variant_names[v]);
+        check(st == SOLITON_OK && memcmp(dec, pt, LEN) == 0, what);
+
+        uint8_t bad[16];
+        memcpy(bad, tag[v], 16);
+        bad[0] ^= 1;
+        st = aead_open(variants[v], key, nonce, aad, sizeof(aad), ct[v], dec, LEN, bad);
+        snprintf(what, sizeof(what), "%s flipped tag -> AUTH_FAIL", variant_names[v]);
+        check(st == SOLITON_AUTH_FAIL, what);
+
+        /* A tag from another round count must not verify */
+        int w = (v + 1) % 3;
+        st = aead_open(variants[w], key, nonce, aad, sizeof(aad), ct[v], dec, LEN, tag[v]);
+        snprintf(what, sizeof(what), "%s tag rejected by %s", variant_names[v], variant_names[w]);
+        check(st == SOLITON_AUTH_FAIL, what);
+    }
+
+    check(memcmp(ct[0], ct[1], LEN) != 0 && memcmp(ct[0], ct[2], LEN) != 0 &&
+          memcmp(ct[1], ct[2], LEN) != 0, "variants produce distinct ciphertext");
+
+    uint8_t ctx_buffer[CTX_SIZE] __attribute__((aligned(64)));
+    check(soliton_chacha_init_variant((soliton_chacha_ctx*)ctx_buffer, (soliton_chacha_variant)3,
+                                      key, nonce) == SOLITON_INVALID_INPUT,
+          "init_variant rejects unknown variant");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("ChaCha20 / ChaCha12 / ChaCha8 Validation\n");
+    printf("==========================================\n");
+
+    test_stream_vectors();
+    test_backend_equivalence();
+    test_aead();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL CHACHA VARIANT TESTS PASSED\n");
+    } else {
+        printf("✗ %d CHACHA VARIANT TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
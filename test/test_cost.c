@@ -0,0 +1,241 @@
+/*
+ * test_cost.c - Per-context cost counters + per-tenant ledger
+ *
+ * PROOF OBLIGATIONS:
+ *   1. Finalized encrypt/decrypt messages, bytes and AAD bytes are counted
+ *      exactly, through the checked and soliton_fast.h calls; a bound AAD
+ *      prefix is not counted as per-message AAD
+ *   2. Failed opens count as auth failures; unfinished messages and
+ *      disabled contexts count nothing
+ *   3. sample_every 1 times every checked call; sample_every 4 times one
+ *      in four; non-power-of-two periods are rejected
+ *   4. take zeroes the context; init clears the counters
+ *   5. The ledger merges per tenant, keeps tenants apart and harvest never
+ *      counts a call twice
+ *
+ * Compile: cc -O2 -o test_cost test_cost.c -L. -lsoliton_hosted -lsoliton_core
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../include/soliton_fast.h"
+#include "../include/soliton_hosted.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MSG_LEN 1000
+
+static uint8_t ctx_buf[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t key[32], iv[12], aad[64];
+static uint8_t pt[MSG_LEN], ct[MSG_LEN], out[MSG_LEN];
+
+/* aad + 2 updates + final: 4 checked calls */
+static void seal(soliton_aesgcm_ctx* ctx, size_t len, size_t aad_len, uint8_t tag[16]) {
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, aad_len);
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, 16);
+    soliton_aesgcm_encrypt_update(ctx, pt + 16, ct + 16, len - 16);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+}
+
+static soliton_status open_msg(soliton_aesgcm_ctx* ctx, size_t len, size_t aad_len, const uint8_t tag[16]) {
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, aad_len);
+    soliton_aesgcm_decrypt_update(ctx, ct, out, len);
+    return soliton_aesgcm_decrypt_final(ctx, tag);
+}
+
+static void test_counts(void) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)ctx_buf;
+    soliton_aesgcm_cost c;
+    uint8_t tag[16];
+
+    printf("\nMessage counters:\n");
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.calls == 0 && c.enc_messages == 0, "counters zero before enable");
+
+    seal(ctx, MSG_LEN, 20, tag);
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.calls == 0 && c.enc_messages == 0, "nothing counted while disabled");
+
+    check(soliton_aesgcm_cost_enable(ctx, 0) == SOLITON_OK, "enable, counters only");
+    seal(ctx, MSG_LEN, 20, tag);
+    seal(ctx, 100, 0, tag);
+    check(open_msg(ctx, 100, 0, tag) == SOLITON_OK, "open succeeds");
+    tag[3] ^= 1;
+    check(open_msg(ctx, 100, 0, tag) == SOLITON_AUTH_FAIL, "tampered open fails");
+
+    /* Unfinished message: calls only */
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, 64);
+
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.enc_messages == 2 && c.enc_bytes == MSG_LEN + 100, "encrypt messages and bytes");
+    check(c.dec_messages == 2 && c.dec_bytes == 200, "decrypt messages and bytes");
+    check(c.auth_failures == 1, "one auth failure");
+    check(c.aad_bytes == 20, "AAD bytes");
+    check(c.calls == 4 + 4 + 3 + 3 + 1, "checked calls");
+    check(c.sampled_calls == 0 && c.sampled_cycles == 0, "no sampling with sample_every 0");
+
+    /* Bound prefix: only the per-message suffix counts */
+    soliton_aesgcm_cost_enable(ctx, 0);
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_prefix_bind(ctx, aad, 48);
+    soliton_aesgcm_aad_update(ctx, aad + 48, 10);
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, 32);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.aad_bytes == 10 && c.enc_messages == 1, "bound prefix excluded from AAD bytes");
+    soliton_aesgcm_aad_prefix_bind(ctx, NULL, 0);
+
+    /* Fast path: message totals, no calls */
+    soliton_aesgcm_cost_enable(ctx, 1);
+    soliton_fast_aesgcm_reset(ctx, iv);
+    soliton_fast_aesgcm_aad_update(ctx, aad, 16);
+    soliton_fast_aesgcm_encrypt_update(ctx, pt, ct, MSG_LEN);
+    soliton_fast_aesgcm_encrypt_final(ctx, tag);
+    soliton_fast_aesgcm_reset(ctx, iv);
+    soliton_fast_aesgcm_aad_update(ctx, aad, 16);
+    soliton_fast_aesgcm_decrypt_update(ctx, ct, out, MSG_LEN);
+    tag[0] ^= 1;
+    soliton_fast_aesgcm_decrypt_final(ctx, tag);
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.enc_messages == 1 && c.enc_bytes == MSG_LEN && c.dec_messages == 1 &&
+          c.dec_bytes == MSG_LEN && c.aad_bytes == 32 && c.auth_failures == 1,
+          "soliton_fast.h messages counted");
+    check(c.calls == 0, "soliton_fast.h calls not counted");
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.enc_messages == 0 && c.dec_messages == 0, "init clears the counters");
+    seal(ctx, 100, 0, tag);
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.calls == 0, "init disables counting");
+}
+
+static void test_sampling(void) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)ctx_buf;
+    soliton_aesgcm_cost c;
+    uint8_t tag[16];
+
+    printf("\nCycle sampling:\n");
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    check(soliton_aesgcm_cost_enable(ctx, 3) == SOLITON_INVALID_INPUT, "sample_every 3 rejected");
+    check(soliton_aesgcm_cost_enable(NULL, 1) == SOLITON_INVALID_INPUT, "NULL context rejected");
+
+    soliton_aesgcm_cost_enable(ctx, 1);
+    for (int i = 0; i < 10; i++) {
+        seal(ctx, MSG_LEN, 20, tag);
+    }
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.calls == 40 && c.sampled_calls == 40, "sample_every 1 times every call");
+#if defined(__x86_64__) || defined(__aarch64__)
+    check(c.sampled_cycles > 0, "cycles recorded");
+#endif
+    check(soliton_cost_estimated_cycles(&c) == c.sampled_cycles, "estimate equals total when all sampled");
+
+    soliton_aesgcm_cost_enable(ctx, 4);
+    for (int i = 0; i < 10; i++) {
+        seal(ctx, MSG_LEN, 20, tag);
+    }
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.calls == 40 && c.sampled_calls == 10, "sample_every 4 times one call in four");
+
+    soliton_aesgcm_cost taken;
+    check(soliton_aesgcm_cost_take(ctx, &taken) == SOLITON_OK && taken.calls == 40, "take returns the counters");
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.calls == 0 && c.sampled_calls == 0, "take zeroes the context");
+    seal(ctx, MSG_LEN, 20, tag);
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.calls == 4 && c.sampled_calls == 1, "counting and sampling continue after take");
+
+    soliton_aesgcm_cost_disable(ctx);
+    seal(ctx, MSG_LEN, 20, tag);
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.calls == 4 && c.enc_messages == 1, "disable stops counting, counters kept");
+}
+
+static void test_ledger(void) {
+    static uint8_t bufs[3][CTX_SIZE] __attribute__((aligned(64)));
+    soliton_cost_ledger ledger;
+    uint8_t tag[16];
+    int merged = 1;
+
+    printf("\nPer-tenant ledger:\n");
+
+    soliton_cost_ledger_init(&ledger);
+    check(soliton_cost_ledger_get(&ledger, 7) == NULL, "empty ledger has no rows");
+
+    /* Tenant 7 owns contexts 0 and 1, tenant 3 owns context 2 */
+    static const uint64_t owner[3] = { 7, 7, 3 };
+    for (int i = 0; i < 3; i++) {
+        soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)bufs[i];
+        soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+        soliton_aesgcm_cost_enable(ctx, 0);
+    }
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < 3; i++) {
+            soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)bufs[i];
+            seal(ctx, 100 * (size_t)(i + 1), 0, tag);
+            merged &= soliton_cost_ledger_harvest(&ledger, owner[i], ctx) == SOLITON_OK;
+        }
+    }
+    check(merged, "harvest succeeds");
+
+    const soliton_aesgcm_cost* t7 = soliton_cost_ledger_get(&ledger, 7);
+    const soliton_aesgcm_cost* t3 = soliton_cost_ledger_get(&ledger, 3);
+    check(ledger.count == 2 && ledger.entries[0].tenant == 3, "two rows, sorted by tenant");
+    check(t7 && t7->enc_messages == 10 && t7->enc_bytes == 5 * 300 && t7->calls == 40,
+          "tenant 7 merges both contexts, each call once");
+    check(t3 && t3->enc_messages == 5 && t3->enc_bytes == 5 * 300 && t3->calls == 20, "tenant 3 kept apart");
+
+    /* Many tenants, inserted out of order */
+    soliton_aesgcm_cost one;
+    memset(&one, 0, sizeof(one));
+    one.enc_messages = 1;
+    for (uint64_t t = 0; t < 200; t++) {
+        soliton_cost_ledger_merge(&ledger, (t * 7919) % 200 + 1000, &one);
+        soliton_cost_ledger_merge(&ledger, (t * 7919) % 200 + 1000, &one);
+    }
+    int sorted = ledger.count == 202;
+    for (size_t i = 1; i < ledger.count; i++) {
+        sorted &= ledger.entries[i - 1].tenant < ledger.entries[i].tenant;
+    }
+    check(sorted, "200 out-of-order tenants stay sorted and unique");
+    t7 = soliton_cost_ledger_get(&ledger, 1123);
+    check(t7 && t7->enc_messages == 2, "lookup after growth");
+
+    soliton_cost_ledger_free(&ledger);
+    check(ledger.count == 0 && ledger.entries == NULL, "free empties the ledger");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("AES-GCM Cost Accounting Validation\n");
+    printf("==========================================\n");
+
+    fill(key, sizeof(key), 1);
+    fill(iv, sizeof(iv), 2);
+    fill(aad, sizeof(aad), 3);
+    fill(pt, sizeof(pt), 4);
+    soliton_fast_init();
+
+    test_counts();
+    test_sampling();
+    test_ledger();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL COST ACCOUNTING TESTS PASSED\n");
+    } else {
+        printf("✗ %d COST ACCOUNTING TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+/*
+ * test_crc32c.c - AES-GCM updates with fused CRC32C
+ *
+ * PROOF OBLIGATIONS:
+ *   1. soliton_crc32c matches a bitwise reference (and the standard check
+ *      value), and chains across split inputs
+ *   2. encrypt_update_crc gives the same ciphertext and tag as
+ *      encrypt_update, and CRCs equal to a separate pass over plaintext and
+ *      ciphertext, for lengths 0..600 and bulk sizes up to 64KB + tails and
+ *      every stream set; a stream not selected is left untouched
+ *   3. The CRCs chain across several updates and across objects
+ *   4. decrypt_update_crc recovers the plaintext, accepts the tag and
+ *      returns the same CRCs, out of place and in place (also encrypt)
+ *   5. NULL/empty/unknown stream sets and finalized contexts are rejected
+ *
+ * Compile: cc -O2 -o test_crc32c test_crc32c.c -L. -lsoliton_core
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_LEN (65536 + 47)
+
+/* Bitwise CRC32C reference (reflected 0x1EDC6F41) */
+static uint32_t ref_crc32c(uint32_t crc, const uint8_t* p, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= p[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static const uint32_t sets[] = {
+    SOLITON_CRC_PLAINTEXT, SOLITON_CRC_CIPHERTEXT, SOLITON_CRC_PLAINTEXT | SOLITON_CRC_CIPHERTEXT
+};
+
+static const size_t bulk[] = { 1024, 1500, 4096, 4111, 16384, 65536, MAX_LEN };
+#define NBULK (sizeof(bulk) / sizeof(bulk[0]))
+
+static uint8_t ref_buf[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t crc_buf[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t key[32], iv[12], aad[20];
+static uint8_t pt[MAX_LEN], ref_ct[MAX_LEN], ct[MAX_LEN], out[MAX_LEN];
+
+static void ref_seal(size_t len, uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ref = (soliton_aesgcm_ctx*)ref_buf;
+
+    soliton_aesgcm_reset(ref, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ref, aad, sizeof(aad));
+    soliton_aesgcm_encrypt_update(ref, pt, ref_ct, len);
+    soliton_aesgcm_encrypt_final(ref, tag);
+}
+
+/* Seal with CRC in updates of at most chunk bytes (chunk == 0: one update) */
+static void crc_seal(const uint8_t* src, uint8_t* dst, size_t len, size_t chunk,
+                     soliton_crc32c_pair* crc, uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)crc_buf;
+
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    if (chunk == 0 || chunk > len) {
+        chunk = len;
+    }
+    size_t off = 0;
+    do {
+        const size_t n = len - off < chunk ? len - off : chunk;
+        soliton_aesgcm_encrypt_update_crc(ctx, src + off, dst + off, n, crc);
+        off += n;
+    } while (off < len);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+}
+
+static soliton_status crc_open(const uint8_t* src, uint8_t* dst, size_t len,
+                               soliton_crc32c_pair* crc, const uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)crc_buf;
+
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_decrypt_update_crc(ctx, src, dst, len, crc);
+    return soliton_aesgcm_decrypt_final(ctx, tag);
+}
+
+/* Selected fields equal the reference, the other one still holds 0xA5A5A5A5 */
+static int crc_ok(const soliton_crc32c_pair* crc, uint32_t want_pt, uint32_t want_ct) {
+    const uint32_t p = (crc->which & SOLITON_CRC_PLAINTEXT) ? want_pt : 0xA5A5A5A5u;
+    const uint32_t c = (crc->which & SOLITON_CRC_CIPHERTEXT) ? want_ct : 0xA5A5A5A5u;
+    return crc->pt == p && crc->ct == c;
+}
+
+static void test_standalone(void) {
+    static const uint8_t check_str[] = "123456789";
+    int split = 1;
+
+    printf("\nsoliton_crc32c:\n");
+
+    check(soliton_crc32c(0, check_str, 9) == 0xE3069283u, "check value 0xE3069283");
+    check(soliton_crc32c(0, pt, 1000) == ref_crc32c(0, pt, 1000), "matches bitwise reference (1000 bytes)");
+    for (size_t cut = 0; cut <= 200; cut += 7) {
+        split &= soliton_crc32c(soliton_crc32c(0, pt, cut), pt + cut, 200 - cut) == ref_crc32c(0, pt, 200);
+    }
+    check(split, "chains across split inputs");
+}
+
+static void test_encrypt(void) {
+    uint8_t ref_tag[16], tag[16];
+    int same = 1, crcs = 1;
+    char what[96];
+
+    printf("\nencrypt_update_crc vs encrypt_update + separate CRC passes:\n");
+
+    for (size_t i = 0; i <= 600 + NBULK; i++) {
+        const size_t n = i <= 600 ? i : bulk[i - 601];
+        fill(iv, sizeof(iv), (uint32_t)n);
+        ref_seal(n, ref_tag);
+        const uint32_t want_pt = ref_crc32c(0, pt, n);
+        const uint32_t want_ct = ref_crc32c(0, ref_ct, n);
+
+        for (size_t s = 0; s < 3; s++) {
+            soliton_crc32c_pair crc = { 0, 0, sets[s] };
+            if (!(sets[s] & SOLITON_CRC_PLAINTEXT)) crc.pt = 0xA5A5A5A5u;
+            if (!(sets[s] & SOLITON_CRC_CIPHERTEXT)) crc.ct = 0xA5A5A5A5u;
+
+            memset(ct, 0, n);
+            crc_seal(pt, ct, n, 0, &crc, tag);
+            same &= memcmp(ct, ref_ct, n) == 0 && memcmp(tag, ref_tag, 16) == 0;
+            crcs &= crc_ok(&crc, want_pt, want_ct);
+        }
+    }
+
+    snprintf(what, sizeof(what), "ciphertext and tag identical (lengths 0..600 + %zu bulk sizes)", (size_t)NBULK);
+    check(same, what);
+    check(crcs, "CRCs match separate passes for pt, ct and both; unselected untouched");
+}
+
+static void test_chaining(void) {
+    static const size_t chunks[] = { 16, 128, 144, 1024, 4096 };
+    uint8_t ref_tag[16], tag[16];
+    int ok = 1;
+
+    printf("\nChaining:\n");
+
+    fill(iv, sizeof(iv), 77);
+    ref_seal(MAX_LEN, ref_tag);
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        soliton_crc32c_pair crc = { 0, 0, SOLITON_CRC_PLAINTEXT | SOLITON_CRC_CIPHERTEXT };
+        crc_seal(pt, ct, MAX_LEN, chunks[c], &crc, tag);
+        ok &= memcmp(ct, ref_ct, MAX_LEN) == 0 && memcmp(tag, ref_tag, 16) == 0;
+        ok &= crc.pt == ref_crc32c(0, pt, MAX_LEN) && crc.ct == ref_crc32c(0, ref_ct, MAX_LEN);
+    }
+    check(ok, "updates of 16..4096 bytes chain to the whole-object CRC");
+
+    /* Two objects, second seeded with the first's CRCs */
+    soliton_crc32c_pair crc = { 0, 0, SOLITON_CRC_PLAINTEXT | SOLITON_CRC_CIPHERTEXT };
+    fill(iv, sizeof(iv), 78);
+    crc_seal(pt, ct, 5000, 0, &crc, tag);
+    const uint32_t ct1 = ref_crc32c(0, ct, 5000);
+    crc_seal(pt + 5000, ct, 3000, 0, &crc, tag);
+    check(crc.pt == ref_crc32c(0, pt, 8000) && crc.ct == ref_crc32c(ct1, ct, 3000),
+          "seeding with a previous object's CRC continues it");
+}
+
+static void test_decrypt(void) {
+    uint8_t tag[16];
+    int ok = 1, in_place = 1, enc_in_place = 1;
+
+    printf("\ndecrypt_update_crc:\n");
+
+    for (size_t i = 0; i < NBULK; i++) {
+        const size_t n = bulk[i];
+        fill(iv, sizeof(iv), (uint32_t)n + 1);
+        ref_seal(n, tag);
+        const uint32_t want_pt = ref_crc32c(0, pt, n);
+        const uint32_t want_ct = ref_crc32c(0, ref_ct, n);
+
+        for (size_t s = 0; s < 3; s++) {
+            soliton_crc32c_pair crc = { 0xA5A5A5A5u, 0xA5A5A5A5u, sets[s] };
+            if (sets[s] & SOLITON_CRC_PLAINTEXT) crc.pt = 0;
+            if (sets[s] & SOLITON_CRC_CIPHERTEXT) crc.ct = 0;
+            soliton_crc32c_pair crc2 = crc, crc3 = crc;
+
+            memset(out, 0, n);
+            ok &= crc_open(ref_ct, out, n, &crc, tag) == SOLITON_OK && memcmp(out, pt, n) == 0;
+            ok &= crc_ok(&crc, want_pt, want_ct);
+
+            memcpy(out, ref_ct, n);
+            in_place &= crc_open(out, out, n, &crc2, tag) == SOLITON_OK && memcmp(out, pt, n) == 0;
+            in_place &= crc_ok(&crc2, want_pt, want_ct);
+
+            uint8_t tag2[16];
+            memcpy(out, pt, n);
+            crc_seal(out, out, n, 0, &crc3, tag2);
+            enc_in_place &= memcmp(out, ref_ct, n) == 0 && memcmp(tag2, tag, 16) == 0;
+            enc_in_place &= crc_ok(&crc3, want_pt, want_ct);
+        }
+    }
+
+    check(ok, "plaintext recovered, tag accepted, CRCs match");
+    check(in_place, "in-place decrypt");
+    check(enc_in_place, "in-place encrypt");
+}
+
+static void test_rejects(void) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)crc_buf;
+    soliton_crc32c_pair none = { 0, 0, 0 };
+    soliton_crc32c_pair bad = { 0, 0, 4 };
+    soliton_crc32c_pair crc = { 0, 0, SOLITON_CRC_PLAINTEXT };
+    uint8_t tag[16];
+
+    printf("\nArgument and state checks:\n");
+
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    check(soliton_aesgcm_encrypt_update_crc(ctx, pt, ct, 64, NULL) == SOLITON_INVALID_INPUT, "NULL crc rejected");
+    check(soliton_aesgcm_encrypt_update_crc(ctx, pt, ct, 64, &none) == SOLITON_INVALID_INPUT, "empty stream set rejected");
+    check(soliton_aesgcm_decrypt_update_crc(ctx, ct, pt, 64, &bad) == SOLITON_INVALID_INPUT, "unknown stream bit rejected");
+    check(soliton_aesgcm_encrypt_update_crc(NULL, pt, ct, 64, &crc) == SOLITON_INVALID_INPUT, "NULL context rejected");
+    check(soliton_aesgcm_encrypt_update_crc(ctx, NULL, ct, 64, &crc) == SOLITON_INVALID_INPUT, "NULL buffer rejected");
+    soliton_aesgcm_encrypt_final(ctx, tag);
+    check(soliton_aesgcm_encrypt_update_crc(ctx, pt, ct, 64, &crc) == SOLITON_INVALID_INPUT &&
+          crc.pt == 0, "finalized context rejected, crc unchanged");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("Fused CRC32C Validation\n");
+    printf("==========================================\n");
+
+    fill(key, sizeof(key), 1);
+    fill(aad, sizeof(aad), 2);
+    fill(pt, sizeof(pt), 3);
+    soliton_aesgcm_init((soliton_aesgcm_ctx*)ref_buf, key, iv, sizeof(iv));
+    soliton_aesgcm_init((soliton_aesgcm_ctx*)crc_buf, key, iv, sizeof(iv));
+
+    test_standalone();
+    test_encrypt();
+    test_chaining();
+    test_decrypt();
+    test_rejects();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL CRC32C TESTS PASSED\n");
+    } else {
+        printf("✗ %d CRC32C TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
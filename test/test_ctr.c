@@ -0,0 +1,182 @@
+/*
+ * test_ctr.c — Shared counter engine (ctr_engine.h) in the CTR/GCM kernels
+ *
+ * PROOF OBLIGATIONS:
+ *   1. Every AES-CTR kernel present matches a block-at-a-time inc32
+ *      reference for 0..40 blocks from counters 2, 2^32-16, 2^32-5 and
+ *      2^32-1: the counter word wraps mod 2^32, bytes 0..11 never change
+ *   2. AES-GCM ciphertext matches OpenSSL for every length 0..1100 and
+ *      bulk sizes, with the engine carried across 8/16-block batches, under
+ *      both vector-width policies
+ *
+ * Kernels absent from the build or unsupported by the CPU are skipped.
+ *
+ * Compile: cc -O2 -o test_ctr test_ctr.c -L. -lsoliton_core -lcrypto
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <openssl/evp.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_BLOCKS 40
+#define MAX_LEN (16384 + 48)
+
+typedef void (*ctr_kernel_fn)(const uint32_t*, const uint8_t*, uint32_t,
+                              const uint8_t*, uint8_t*, size_t);
+
+extern void aes256_key_expand_scalar(const uint8_t*, uint32_t*);
+extern void aes256_encrypt_block_scalar(const uint32_t*, const uint8_t*, uint8_t*);
+extern void aes256_ctr_blocks_scalar(const uint32_t*, const uint8_t*, uint32_t,
+                                     const uint8_t*, uint8_t*, size_t);
+
+/* Kernels under test (weak: only the ones built for this target exist) */
+extern void aes256_ctr_blocks_vaes(const uint32_t*, const uint8_t*, uint32_t,
+                                   const uint8_t*, uint8_t*, size_t) __attribute__((weak));
+extern void aes256_ctr_blocks_vaes512(const uint32_t*, const uint8_t*, uint32_t,
+                                      const uint8_t*, uint8_t*, size_t) __attribute__((weak));
+
+static uint8_t key[32], iv[16];
+static uint8_t pt[MAX_LEN], ct[MAX_LEN], ref[MAX_LEN];
+
+/* One block at a time: bytes 0..11 from the IV, word 3 = be32(counter + i) */
+static void ctr_reference(const uint32_t* rk, uint32_t counter, const uint8_t* in,
+                          uint8_t* out, size_t blocks) {
+    uint8_t cb[16], ks[16];
+
+    memcpy(cb, iv, 12);
+    for (size_t b = 0; b < blocks; b++) {
+        uint32_t c = counter + (uint32_t)b;
+        cb[12] = (uint8_t)(c >> 24);
+        cb[13] = (uint8_t)(c >> 16);
+        cb[14] = (uint8_t)(c >> 8);
+        cb[15] = (uint8_t)c;
+        aes256_encrypt_block_scalar(rk, cb, ks);
+        for (int i = 0; i < 16; i++) {
+            out[b * 16 + i] = in[b * 16 + i] ^ ks[i];
+        }
+    }
+}
+
+static void test_kernels(void) {
+    static const uint32_t starts[] = { 2, 0xFFFFFFF0u, 0xFFFFFFFBu, 0xFFFFFFFFu };
+    soliton_caps caps;
+    uint32_t rk[60];
+    const struct {
+        const char* name;
+        ctr_kernel_fn fn;
+        uint32_t feat;
+    } kernels[] = {
+        { "scalar", aes256_ctr_blocks_scalar, 0 },
+        { "VAES (YMM)", aes256_ctr_blocks_vaes, SOLITON_FEAT_VAES | SOLITON_FEAT_AVX2 },
+        { "VAES (ZMM)", aes256_ctr_blocks_vaes512, SOLITON_FEAT_VAES | SOLITON_FEAT_AVX512BW },
+    };
+
+    printf("\nCTR kernels across the 2^32 counter wrap:\n");
+    soliton_query_caps(&caps);
+    aes256_key_expand_scalar(key, rk);
+    fill(pt, MAX_BLOCKS * 16, 5);
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        char what[80];
+        int ok = 1;
+
+        if (!kernels[k].fn || (caps.bits & kernels[k].feat) != kernels[k].feat) {
+            printf("  - %s not available, skipped\n", kernels[k].name);
+            continue;
+        }
+
+        for (size_t s = 0; s < sizeof(starts) / sizeof(starts[0]); s++) {
+            for (size_t blocks = 0; blocks <= MAX_BLOCKS; blocks++) {
+                ctr_reference(rk, starts[s], pt, ref, blocks);
+                memset(ct, 0xA5, (MAX_BLOCKS + 1) * 16);
+                kernels[k].fn(rk, iv, starts[s], pt, ct, blocks);
+                ok &= memcmp(ct, ref, blocks * 16) == 0;
+                ok &= ct[blocks * 16] == 0xA5;  /* nothing written past the end */
+            }
+        }
+        snprintf(what, sizeof(what), "%s: 0..%d blocks from 4 start counters", kernels[k].name, MAX_BLOCKS);
+        check(ok, what);
+    }
+}
+
+/* GCM ciphertext does not depend on GHASH; compare it alone against EVP */
+static int gcm_ct_matches(size_t len) {
+    uint8_t buf[CTX_SIZE] __attribute__((aligned(64)));
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)buf;
+    uint8_t tag[16];
+    int outl = 0;
+
+    soliton_aesgcm_init(ctx, key, iv, 12);
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, len);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+    soliton_aesgcm_context_wipe(ctx);
+
+    EVP_CIPHER_CTX* evp = EVP_CIPHER_CTX_new();
+    EVP_EncryptInit_ex(evp, EVP_aes_256_gcm(), NULL, NULL, NULL);
+    EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_SET_IVLEN, 12, NULL);
+    EVP_EncryptInit_ex(evp, NULL, NULL, key, iv);
+    if (len > 0) {
+        EVP_EncryptUpdate(evp, ref, &outl, pt, (int)len);
+    }
+    EVP_CIPHER_CTX_free(evp);
+
+    return memcmp(ct, ref, len) == 0;
+}
+
+static void test_gcm(void) {
+    static const size_t bulk[] = { 2048, 4096 + 16, 8192 + 48, 16384 + 48 };
+    static const struct {
+        soliton_vwidth_policy policy;
+        const char* name;
+    } policies[] = {
+        { SOLITON_VWIDTH_PREFER_YMM, "prefer-YMM" },
+        { SOLITON_VWIDTH_ALWAYS_ZMM, "always-ZMM" },
+    };
+
+    printf("\nAES-GCM ciphertext vs OpenSSL:\n");
+    fill(pt, MAX_LEN, 9);
+
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+        char what[80];
+        int ok = 1;
+
+        soliton_set_vwidth_policy(policies[p].policy, 0);
+        for (size_t len = 0; len <= 1100; len++) {
+            ok &= gcm_ct_matches(len);
+        }
+        for (size_t i = 0; i < sizeof(bulk) / sizeof(bulk[0]); i++) {
+            ok &= gcm_ct_matches(bulk[i]);
+        }
+        snprintf(what, sizeof(what), "%s: 0..1100 bytes + bulk sizes", policies[p].name);
+        check(ok, what);
+    }
+    soliton_set_vwidth_policy(SOLITON_VWIDTH_AUTO, 0);
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("Counter Engine Validation\n");
+    printf("==========================================\n");
+
+    fill(key, sizeof(key), 1);
+    fill(iv, sizeof(iv), 2);
+    iv[8] = iv[9] = iv[10] = iv[11] = 0xFF;  /* a carry out of word 3 would show */
+
+    test_kernels();
+    test_gcm();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL COUNTER ENGINE TESTS PASSED\n");
+    } else {
+        printf("✗ %d COUNTER ENGINE TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,230 @@
+/*
+ * test_duplex.c — soliton_aesgcm_duplex_update (TX encrypt + RX decrypt)
+ *
+ * PROOF OBLIGATIONS:
+ *   1. For every pair of span lengths, duplex TX ciphertext and tag equal
+ *      encrypt_update on a twin context, and duplex RX plaintext equals
+ *      decrypt_update on a twin context
+ *   2. RX verifies a tag produced by the ordinary encrypt path; a flipped
+ *      ciphertext bit is rejected
+ *   3. In-place spans (in == out) give the same result
+ *   4. NULL contexts/spans, tx_ctx == rx_ctx, NULL buffers with non-zero
+ *      length and finalized contexts are rejected
+ *   5. TX ciphertext and tag match OpenSSL, and RX opens a message
+ *      sealed by OpenSSL
+ *
+ * Compile: cc -O2 -o test_duplex test_duplex.c -L. -lsoliton_core -lcrypto
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <openssl/evp.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_LEN (4096 + 48)
+
+typedef struct {
+    uint8_t buf[CTX_SIZE] __attribute__((aligned(64)));
+} ctx_storage;
+
+static uint8_t tx_key[32], rx_key[32], tx_iv[12], rx_iv[12], aad[20];
+static uint8_t tx_pt[MAX_LEN], rx_ct[MAX_LEN], rx_tag[16];
+static uint8_t d_ct[MAX_LEN], d_pt[MAX_LEN], s_ct[MAX_LEN], s_pt[MAX_LEN];
+
+static soliton_aesgcm_ctx* open_ctx(ctx_storage* s, const uint8_t* key, const uint8_t* iv) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)s->buf;
+    soliton_aesgcm_init(ctx, key, iv, 12);
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    return ctx;
+}
+
+/* The RX stream's message: sealed with the ordinary encrypt path */
+static void seal_rx(size_t len) {
+    ctx_storage s;
+    soliton_aesgcm_ctx* ctx = open_ctx(&s, rx_key, rx_iv);
+    uint8_t pt[MAX_LEN];
+
+    fill(pt, len, (uint32_t)len + 77);
+    soliton_aesgcm_encrypt_update(ctx, pt, rx_ct, len);
+    soliton_aesgcm_encrypt_final(ctx, rx_tag);
+    soliton_aesgcm_context_wipe(ctx);
+}
+
+/* Duplex vs separate updates for one (tx_len, rx_len) pair */
+static int duplex_matches(size_t tx_len, size_t rx_len, int in_place) {
+    ctx_storage a, b, c, d;
+    soliton_aesgcm_ctx* dtx = open_ctx(&a, tx_key, tx_iv);
+    soliton_aesgcm_ctx* drx = open_ctx(&b, rx_key, rx_iv);
+    soliton_aesgcm_ctx* stx = open_ctx(&c, tx_key, tx_iv);
+    soliton_aesgcm_ctx* srx = open_ctx(&d, rx_key, rx_iv);
+    uint8_t d_tag[16], s_tag[16];
+    int ok = 1;
+
+    seal_rx(rx_len);
+
+    if (in_place) {
+        memcpy(d_ct, tx_pt, tx_len);
+        memcpy(d_pt, rx_ct, rx_len);
+    }
+    soliton_span tx = { in_place ? d_ct : tx_pt, d_ct, tx_len };
+    soliton_span rx = { in_place ? d_pt : rx_ct, d_pt, rx_len };
+
+    ok &= soliton_aesgcm_duplex_update(dtx, &tx, drx, &rx) == SOLITON_OK;
+    ok &= soliton_aesgcm_encrypt_final(dtx, d_tag) == SOLITON_OK;
+    soliton_aesgcm_context_wipe(drx);
+
+    soliton_aesgcm_encrypt_update(stx, tx_pt, s_ct, tx_len);
+    soliton_aesgcm_encrypt_final(stx, s_tag);
+    soliton_aesgcm_decrypt_update(srx, rx_ct, s_pt, rx_len);
+    soliton_aesgcm_context_wipe(srx);
+
+    ok &= memcmp(d_ct, s_ct, tx_len) == 0;
+    ok &= memcmp(d_tag, s_tag, 16) == 0;
+    ok &= memcmp(d_pt, s_pt, rx_len) == 0;
+    return ok;
+}
+
+static void test_equivalence(void) {
+    static const size_t lens[] = { 0, 1, 15, 16, 127, 128, 129, 255, 256, 300, 1024, 1500, 4096 + 48 };
+    const size_t n = sizeof(lens) / sizeof(lens[0]);
+    int ok = 1, ok_ip = 1;
+
+    printf("\nDuplex vs separate encrypt_update/decrypt_update:\n");
+    fill(tx_pt, MAX_LEN, 3);
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            ok &= duplex_matches(lens[i], lens[j], 0);
+            ok_ip &= duplex_matches(lens[i], lens[j], 1);
+        }
+    }
+    check(ok, "13x13 length pairs: TX ct/tag and RX pt identical");
+    check(ok_ip, "same with in-place spans");
+
+    ok = 1;
+    for (size_t len = 0; len <= 600; len += 8) {
+        ok &= duplex_matches(len, 600 - len, 0);
+        ok &= duplex_matches(len + 1, len, 0);
+    }
+    check(ok, "sliding TX/RX split 0..600 bytes");
+}
+
+static void test_open(void) {
+    ctx_storage a, b;
+    const size_t len = 1024;
+    uint8_t tag[16];
+
+    printf("\nRX authentication:\n");
+    seal_rx(len);
+
+    soliton_aesgcm_ctx* tx = open_ctx(&a, tx_key, tx_iv);
+    soliton_aesgcm_ctx* rx = open_ctx(&b, rx_key, rx_iv);
+    soliton_span ts = { tx_pt, d_ct, len };
+    soliton_span rs = { rx_ct, d_pt, len };
+    soliton_aesgcm_duplex_update(tx, &ts, rx, &rs);
+    soliton_aesgcm_encrypt_final(tx, tag);
+    check(soliton_aesgcm_decrypt_final(rx, rx_tag) == SOLITON_OK, "opens a message sealed by encrypt_update");
+
+    rx_ct[300] ^= 0x01;
+    tx = open_ctx(&a, tx_key, tx_iv);
+    rx = open_ctx(&b, rx_key, rx_iv);
+    soliton_aesgcm_duplex_update(tx, &ts, rx, &rs);
+    check(soliton_aesgcm_decrypt_final(rx, rx_tag) == SOLITON_AUTH_FAIL, "flipped ciphertext bit rejected");
+}
+
+static void test_invalid(void) {
+    ctx_storage a, b;
+    soliton_aesgcm_ctx* tx = open_ctx(&a, tx_key, tx_iv);
+    soliton_aesgcm_ctx* rx = open_ctx(&b, rx_key, rx_iv);
+    soliton_span ok_span = { tx_pt, d_ct, 64 };
+    soliton_span null_in = { NULL, d_ct, 64 };
+    soliton_span empty = { NULL, NULL, 0 };
+    uint8_t tag[16];
+
+    printf("\nArgument validation:\n");
+    check(soliton_aesgcm_duplex_update(NULL, &ok_span, rx, &ok_span) == SOLITON_INVALID_INPUT, "NULL tx_ctx");
+    check(soliton_aesgcm_duplex_update(tx, &ok_span, rx, NULL) == SOLITON_INVALID_INPUT, "NULL rx span");
+    check(soliton_aesgcm_duplex_update(tx, &ok_span, tx, &ok_span) == SOLITON_INVALID_INPUT, "tx_ctx == rx_ctx");
+    check(soliton_aesgcm_duplex_update(tx, &null_in, rx, &empty) == SOLITON_INVALID_INPUT, "NULL input with length");
+    check(soliton_aesgcm_duplex_update(tx, &empty, rx, &empty) == SOLITON_OK, "two empty spans");
+
+    soliton_aesgcm_encrypt_final(tx, tag);
+    check(soliton_aesgcm_duplex_update(tx, &empty, rx, &empty) == SOLITON_INVALID_INPUT, "finalized tx_ctx");
+}
+
+/* OpenSSL AES-256-GCM seal with the test AAD */
+static void evp_seal(const uint8_t* key, const uint8_t* iv, const uint8_t* pt, size_t len,
+                     uint8_t* ct, uint8_t tag[16]) {
+    EVP_CIPHER_CTX* evp = EVP_CIPHER_CTX_new();
+    int outl = 0;
+
+    EVP_EncryptInit_ex(evp, EVP_aes_256_gcm(), NULL, NULL, NULL);
+    EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_SET_IVLEN, 12, NULL);
+    EVP_EncryptInit_ex(evp, NULL, NULL, key, iv);
+    EVP_EncryptUpdate(evp, NULL, &outl, aad, sizeof(aad));
+    EVP_EncryptUpdate(evp, ct, &outl, pt, (int)len);
+    EVP_EncryptFinal_ex(evp, ct + outl, &outl);
+    EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_GET_TAG, 16, tag);
+    EVP_CIPHER_CTX_free(evp);
+}
+
+static void test_openssl(void) {
+    static const size_t lens[] = { 128, 1000, 4096 + 48 };
+    int tx_ok = 1, rx_ok = 1;
+
+    printf("\nTX and RX vs OpenSSL:\n");
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+        ctx_storage a, b;
+        soliton_aesgcm_ctx* tx = open_ctx(&a, tx_key, tx_iv);
+        soliton_aesgcm_ctx* rx = open_ctx(&b, rx_key, rx_iv);
+        uint8_t ref[MAX_LEN], tag[16], ref_tag[16], rx_ref[MAX_LEN], rx_ref_tag[16];
+
+        /* RX opens a message sealed by OpenSSL */
+        fill(d_pt, lens[i], (uint32_t)lens[i] + 91);
+        evp_seal(rx_key, rx_iv, d_pt, lens[i], rx_ref, rx_ref_tag);
+        memcpy(s_pt, d_pt, lens[i]);
+        evp_seal(tx_key, tx_iv, tx_pt, lens[i], ref, ref_tag);
+
+        soliton_span ts = { tx_pt, d_ct, lens[i] };
+        soliton_span rs = { rx_ref, d_pt, lens[i] };
+        soliton_aesgcm_duplex_update(tx, &ts, rx, &rs);
+        soliton_aesgcm_encrypt_final(tx, tag);
+
+        tx_ok &= memcmp(d_ct, ref, lens[i]) == 0 && memcmp(tag, ref_tag, 16) == 0;
+        rx_ok &= soliton_aesgcm_decrypt_final(rx, rx_ref_tag) == SOLITON_OK;
+        rx_ok &= memcmp(d_pt, s_pt, lens[i]) == 0;
+    }
+    check(tx_ok, "TX ciphertext and tag, 128 / 1000 / 4144 bytes");
+    check(rx_ok, "RX accepts OpenSSL's tag and recovers the plaintext");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("Duplex AES-GCM Validation\n");
+    printf("==========================================\n");
+
+    fill(tx_key, sizeof(tx_key), 1);
+    fill(rx_key, sizeof(rx_key), 2);
+    fill(tx_iv, sizeof(tx_iv), 3);
+    fill(rx_iv, sizeof(rx_iv), 4);
+    fill(aad, sizeof(aad), 5);
+
+    test_equivalence();
+    test_open();
+    test_invalid();
+    test_openssl();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL DUPLEX TESTS PASSED\n");
+    } else {
+        printf("✗ %d DUPLEX TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+/*
+ * test_fast.c - Unchecked inline AES-GCM entry points (soliton_fast.h)
+ *
+ * PROOF OBLIGATIONS:
+ *   1. For every length 0..600 and bulk sizes, with and without AAD, the
+ *      fast calls produce the same ciphertext and tag as the checked API,
+ *      and both match OpenSSL
+ *   2. Fast decrypt recovers the plaintext and accepts the checked API's
+ *      tag, and rejects a modified tag with SOLITON_AUTH_FAIL
+ *   3. Fast and checked calls interoperate on one context (reset on one
+ *      side, updates on the other)
+ *   4. In debug builds a precondition violation traps (update after final)
+ *
+ * Every comparison uses the same update split on both sides; splits fall
+ * on 16-byte boundaries as the streaming API requires.
+ *
+ * Compile: cc -O2 -o test_fast test_fast.c -L. -lsoliton_core -lcrypto
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <openssl/evp.h>
+
+#include "../include/soliton_fast.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_LEN 4200
+
+static uint8_t ref_buf[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t fast_buf[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t key[32], iv[12], aad[40];
+static uint8_t pt[MAX_LEN], ref_ct[MAX_LEN], fast_ct[MAX_LEN], ossl_ct[MAX_LEN], out[MAX_LEN];
+
+/* Checked-API reference seal, split into two updates at split */
+static void ref_seal(size_t len, size_t aad_len, size_t split, uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ref = (soliton_aesgcm_ctx*)ref_buf;
+
+    soliton_aesgcm_reset(ref, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ref, aad, aad_len);
+    soliton_aesgcm_encrypt_update(ref, pt, ref_ct, split);
+    soliton_aesgcm_encrypt_update(ref, pt + split, ref_ct + split, len - split);
+    soliton_aesgcm_encrypt_final(ref, tag);
+}
+
+static soliton_status ref_open(size_t len, size_t aad_len, const uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ref = (soliton_aesgcm_ctx*)ref_buf;
+
+    soliton_aesgcm_reset(ref, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ref, aad, aad_len);
+    soliton_aesgcm_decrypt_update(ref, ref_ct, out, len);
+    return soliton_aesgcm_decrypt_final(ref, tag);
+}
+
+/* Fast seal, optionally split into two updates at split */
+static void fast_seal(size_t len, size_t aad_len, size_t split, uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)fast_buf;
+
+    soliton_fast_aesgcm_reset(ctx, iv);
+    if (aad_len > 0) {
+        soliton_fast_aesgcm_aad_update(ctx, aad, aad_len);
+    }
+    soliton_fast_aesgcm_encrypt_update(ctx, pt, fast_ct, split);
+    soliton_fast_aesgcm_encrypt_update(ctx, pt + split, fast_ct + split, len - split);
+    soliton_fast_aesgcm_encrypt_final(ctx, tag);
+}
+
+static soliton_status fast_open(size_t len, size_t aad_len, const uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)fast_buf;
+
+    soliton_fast_aesgcm_reset(ctx, iv);
+    soliton_fast_aesgcm_aad_update(ctx, aad, aad_len);
+    soliton_fast_aesgcm_decrypt_update(ctx, ref_ct, out, len);
+    return soliton_fast_aesgcm_decrypt_final(ctx, tag);
+}
+
+static void openssl_seal(size_t len, size_t aad_len, uint8_t tag[16]) {
+    int outl = 0;
+    EVP_CIPHER_CTX* evp = EVP_CIPHER_CTX_new();
+    EVP_EncryptInit_ex(evp, EVP_aes_256_gcm(), NULL, NULL, NULL);
+    EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_SET_IVLEN, 12, NULL);
+    EVP_EncryptInit_ex(evp, NULL, NULL, key, iv);
+    if (aad_len > 0) {
+        EVP_EncryptUpdate(evp, NULL, &outl, aad, (int)aad_len);
+    }
+    EVP_EncryptUpdate(evp, ossl_ct, &outl, pt, (int)len);
+    EVP_EncryptFinal_ex(evp, ossl_ct + outl, &outl);
+    EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_GET_TAG, 16, tag);
+    EVP_CIPHER_CTX_free(evp);
+}
+
+static void test_equivalence(void) {
+    static const size_t bulk[] = { 1024, 1500, 2048, 4096, 4111, MAX_LEN };
+    uint8_t ref_tag[16], fast_tag[16], ossl_tag[16];
+    int seal_ok = 1, open_ok = 1, split_ok = 1, ossl_ok = 1;
+    char what[96];
+
+    printf("\nFast vs checked API:\n");
+
+    for (size_t len = 0; len <= 600 + sizeof(bulk) / sizeof(bulk[0]); len++) {
+        const size_t n = len <= 600 ? len : bulk[len - 601];
+        for (size_t aad_len = 0; aad_len <= sizeof(aad); aad_len += 20) {
+            fill(iv, sizeof(iv), (uint32_t)(n * 3 + aad_len));
+
+            /* Split across the small/bulk tier boundary */
+            const size_t split = (n / 3) & ~(size_t)15;
+            ref_seal(n, aad_len, split, ref_tag);
+            fast_seal(n, aad_len, split, fast_tag);
+            split_ok &= memcmp(fast_ct, ref_ct, n) == 0 && memcmp(fast_tag, ref_tag, 16) == 0;
+
+            ref_seal(n, aad_len, 0, ref_tag);
+            fast_seal(n, aad_len, 0, fast_tag);
+            seal_ok &= memcmp(fast_ct, ref_ct, n) == 0 && memcmp(fast_tag, ref_tag, 16) == 0;
+
+            openssl_seal(n, aad_len, ossl_tag);
+            ossl_ok &= memcmp(fast_ct, ossl_ct, n) == 0 && memcmp(fast_tag, ossl_tag, 16) == 0;
+
+            open_ok &= ref_open(n, aad_len, ref_tag) == SOLITON_OK;
+            open_ok &= fast_open(n, aad_len, ref_tag) == SOLITON_OK && memcmp(out, pt, n) == 0;
+        }
+    }
+
+    snprintf(what, sizeof(what), "seal matches for lengths 0..600 + %zu bulk sizes, AAD 0/20/40",
+             sizeof(bulk) / sizeof(bulk[0]));
+    check(seal_ok, what);
+    check(split_ok, "two-update seal matches (split near len/3)");
+    check(ossl_ok, "ciphertext and tag match OpenSSL");
+    check(open_ok, "fast open recovers plaintext and accepts the tag");
+}
+
+static void test_auth_fail(void) {
+    uint8_t tag[16];
+
+    printf("\nAuthentication:\n");
+
+    fill(iv, sizeof(iv), 99);
+    ref_seal(100, 20, 0, tag);
+    check(fast_open(100, 20, tag) == SOLITON_OK, "unmodified tag accepted");
+    tag[5] ^= 0x01;
+    check(fast_open(100, 20, tag) == SOLITON_AUTH_FAIL, "modified tag returns SOLITON_AUTH_FAIL");
+}
+
+static void test_mixed(void) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)fast_buf;
+    uint8_t ref_tag[16], tag[16];
+
+    printf("\nMixed checked/fast calls:\n");
+
+    fill(iv, sizeof(iv), 123);
+    ref_seal(777, 40, 496, ref_tag);
+
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_fast_aesgcm_aad_update(ctx, aad, 40);
+    soliton_aesgcm_encrypt_update(ctx, pt, fast_ct, 496);
+    soliton_fast_aesgcm_encrypt_update(ctx, pt + 496, fast_ct + 496, 281);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+    check(memcmp(fast_ct, ref_ct, 777) == 0 && memcmp(tag, ref_tag, 16) == 0, "checked reset + mixed updates");
+
+    soliton_fast_aesgcm_reset(ctx, iv);
+    soliton_aesgcm_aad_update(ctx, aad, 40);
+    soliton_fast_aesgcm_decrypt_update(ctx, ref_ct, out, 777);
+    check(soliton_aesgcm_decrypt_final(ctx, ref_tag) == SOLITON_OK && memcmp(out, pt, 777) == 0,
+          "fast reset + checked final");
+}
+
+static void test_debug_trap(void) {
+    printf("\nDebug precondition checks:\n");
+
+#if !defined(NDEBUG) && !defined(SOLITON_FAST_NO_CHECKS)
+    pid_t pid = fork();
+    if (pid == 0) {
+        soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)fast_buf;
+        uint8_t tag[16];
+        soliton_fast_aesgcm_reset(ctx, iv);
+        soliton_fast_aesgcm_encrypt_final(ctx, tag);
+        soliton_fast_aesgcm_encrypt_update(ctx, pt, fast_ct, 64);  /* after final: traps */
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    check(WIFSIGNALED(status), "update after final traps");
+#else
+    printf("  - checks compiled out (NDEBUG)\n");
+#endif
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("soliton_fast.h Validation\n");
+    printf("==========================================\n");
+
+    fill(key, sizeof(key), 1);
+    fill(aad, sizeof(aad), 2);
+    fill(pt, sizeof(pt), 3);
+    soliton_aesgcm_init((soliton_aesgcm_ctx*)ref_buf, key, iv, sizeof(iv));
+    soliton_aesgcm_init((soliton_aesgcm_ctx*)fast_buf, key, iv, sizeof(iv));
+    soliton_fast_init();
+
+    test_equivalence();
+    test_auth_fail();
+    test_mixed();
+    test_debug_trap();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL FAST PATH TESTS PASSED\n");
+    } else {
+        printf("✗ %d FAST PATH TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
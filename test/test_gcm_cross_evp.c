@@ -8,7 +8,7 @@
  * GATE C REQUIREMENTS:
  *   - 10,000 random test cases
  *   - Variable lengths: PT [0, 4096], AAD [0, 256]
- *   - 96-bit IVs (standard GCM)
+ *   - 96-bit IVs (standard GCM); every 8th case a random 1..64-byte IV
  *   - AES-256-GCM mode
  *   - 100% match rate (10000/10000)
  *
@@ -30,6 +30,7 @@
 #define MAX_PT_LEN 4096
 #define MAX_AAD_LEN 256
 #define IV_LEN 12  /* Standard 96-bit IV */
+#define MAX_IV_LEN 64
 
 static int tests_passed = 0;
 static int tests_failed = 0;
@@ -37,7 +38,7 @@ static int tests_failed = 0;
 /* OpenSSL AES-256-GCM encrypt */
 static int openssl_gcm_encrypt(
     const uint8_t key[32],
-    const uint8_t iv[12],
+    const uint8_t* iv, size_t iv_len,
     const uint8_t* aad, size_t aad_len,
     const uint8_t* pt, size_t pt_len,
     uint8_t* ct,
@@ -54,8 +55,8 @@ static int openssl_gcm_encrypt(
         return -1;
     }
 
-    /* Set IV length (96 bits) */
-    if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, 12, NULL) != 1) {
+    /* Set IV length */
+    if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, (int)iv_len, NULL) != 1) {
         EVP_CIPHER_CTX_free(ctx);
         return -1;
     }
@@ -103,7 +104,7 @@ static int openssl_gcm_encrypt(
 /* Soliton AES-256-GCM encrypt */
 static void soliton_gcm_encrypt(
     const uint8_t key[32],
-    const uint8_t iv[12],
+    const uint8_t* iv, size_t iv_len,
     const uint8_t* aad, size_t aad_len,
     const uint8_t* pt, size_t pt_len,
     uint8_t* ct,
@@ -112,7 +113,7 @@ static void soliton_gcm_encrypt(
     uint8_t ctx_buffer[2048];
     soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)ctx_buffer;
 
-    soliton_aesgcm_init(ctx, key, iv, 12);
+    soliton_aesgcm_init(ctx, key, iv, iv_len);
 
     if (aad_len > 0) {
         soliton_aesgcm_aad_update(ctx, aad, aad_len);
@@ -126,8 +127,8 @@ static void soliton_gcm_encrypt(
 }
 
 /* Compare results */
-static int run_test(int test_num, size_t pt_len, size_t aad_len) {
-    uint8_t key[32], iv[12];
+static int run_test(int test_num, size_t pt_len, size_t aad_len, size_t iv_len) {
+    uint8_t key[32], iv[MAX_IV_LEN];
     uint8_t* pt = NULL;
     uint8_t* aad = NULL;
     uint8_t* ct_openssl = NULL;
@@ -150,12 +151,12 @@ static int run_test(int test_num, size_t pt_len, size_t aad_len) {
 
     /* Generate random inputs */
     RAND_bytes(key, 32);
-    RAND_bytes(iv, 12);
+    RAND_bytes(iv, (int)iv_len);
     if (pt_len > 0) RAND_bytes(pt, pt_len);
     if (aad_len > 0) RAND_bytes(aad, aad_len);
 
     /* Run OpenSSL */
-    int ssl_result = openssl_gcm_encrypt(key, iv, aad, aad_len, pt, pt_len,
+    int ssl_result = openssl_gcm_encrypt(key, iv, iv_len, aad, aad_len, pt, pt_len,
                                           ct_openssl, tag_openssl);
     if (ssl_result < 0) {
         fprintf(stderr, "Test %d: OpenSSL failed\n", test_num);
@@ -163,21 +164,21 @@ static int run_test(int test_num, size_t pt_len, size_t aad_len) {
     }
 
     /* Run Soliton */
-    soliton_gcm_encrypt(key, iv, aad, aad_len, pt, pt_len,
+    soliton_gcm_encrypt(key, iv, iv_len, aad, aad_len, pt, pt_len,
                         ct_soliton, tag_soliton);
 
     /* Compare ciphertext */
     if (pt_len > 0 && memcmp(ct_openssl, ct_soliton, pt_len) != 0) {
-        fprintf(stderr, "Test %d FAILED: CT mismatch (PT=%zu, AAD=%zu)\n",
-                test_num, pt_len, aad_len);
+        fprintf(stderr, "Test %d FAILED: CT mismatch (PT=%zu, AAD=%zu, IV=%zu)\n",
+                test_num, pt_len, aad_len, iv_len);
         result = -1;
         goto cleanup;
     }
 
     /* Compare tag */
     if (memcmp(tag_openssl, tag_soliton, 16) != 0) {
-        fprintf(stderr, "Test %d FAILED: Tag mismatch (PT=%zu, AAD=%zu)\n",
-                test_num, pt_len, aad_len);
+        fprintf(stderr, "Test %d FAILED: Tag mismatch (PT=%zu, AAD=%zu, IV=%zu)\n",
+                test_num, pt_len, aad_len, iv_len);
         fprintf(stderr, "  OpenSSL tag: ");
         for (int i = 0; i < 16; i++) fprintf(stderr, "%02x", tag_openssl[i]);
         fprintf(stderr, "\n");
@@ -216,9 +217,10 @@ int main(void) {
         /* Random lengths */
         size_t pt_len = rand() % (MAX_PT_LEN + 1);
         size_t aad_len = rand() % (MAX_AAD_LEN + 1);
+        size_t iv_len = (i % 8 == 7) ? 1 + rand() % MAX_IV_LEN : IV_LEN;
 
         /* Run test */
-        if (run_test(i + 1, pt_len, aad_len) == 0) {
+        if (run_test(i + 1, pt_len, aad_len, iv_len) == 0) {
             tests_passed++;
         } else {
             tests_failed++;
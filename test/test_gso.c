@@ -0,0 +1,312 @@
+/*
+ * test_gso.c — soliton_aesgcm_seal_gso (datagram batches for UDP GSO)
+ *
+ * PROOF OBLIGATIONS:
+ *   1. Every datagram in the GSO buffer equals hdr || ct || tag from
+ *      reset/aad/update/final with the per-packet nonce iv ^ be64(pn),
+ *      for counts across the tag-mask batch boundary and payload sizes
+ *      from 0 to several bulk batches
+ *   2. A short last datagram is accepted; a short datagram before the
+ *      last, one over segment_size, one past out_cap and a wiped context
+ *      are rejected
+ *   3. Payloads already at their ciphertext position (in-place) and a
+ *      bound AAD prefix give the same bytes as the separate calls
+ *   4. Each datagram opens with decrypt_update/final under its nonce
+ *   5. Datagrams match OpenSSL with the nonce derived independently
+ *
+ * Compile: cc -O2 -o test_gso test_gso.c -L. -lsoliton_core -lcrypto
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <openssl/evp.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_DGRAMS 40
+#define MAX_SEG 2048
+#define HDR_LEN 13
+
+typedef struct {
+    uint8_t buf[CTX_SIZE] __attribute__((aligned(64)));
+} ctx_storage;
+
+static uint8_t key[32], iv[12], prefix[32];
+static uint8_t hdrs[MAX_DGRAMS][HDR_LEN];
+static uint8_t payloads[MAX_DGRAMS][MAX_SEG];
+static uint8_t gso[MAX_DGRAMS * MAX_SEG + 1], ref[MAX_DGRAMS * MAX_SEG];
+
+static soliton_aesgcm_ctx* open_ctx(ctx_storage* s, int bind_prefix) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)s->buf;
+    soliton_aesgcm_init(ctx, key, iv, 12);
+    if (bind_prefix) {
+        soliton_aesgcm_aad_prefix_bind(ctx, prefix, sizeof(prefix));
+    }
+    return ctx;
+}
+
+static void packet_nonce(uint8_t nonce[12], uint64_t pn) {
+    memcpy(nonce, iv, 12);
+    for (int i = 0; i < 8; i++) {
+        nonce[4 + i] ^= (uint8_t)(pn >> (56 - 8 * i));
+    }
+}
+
+/* count datagrams of segment_size, the last last_len bytes of payload */
+static void make_dgrams(soliton_datagram* d, size_t count, size_t segment_size, size_t last_len) {
+    const size_t len = segment_size - HDR_LEN - 16;
+    for (size_t i = 0; i < count; i++) {
+        d[i].hdr = hdrs[i];
+        d[i].hdr_len = HDR_LEN;
+        d[i].payload = payloads[i];
+        d[i].len = i + 1 == count ? last_len : len;
+    }
+}
+
+/* The same datagrams sealed one at a time with the stream API */
+static size_t seal_separately(const soliton_datagram* d, size_t count, uint64_t pn, int bind_prefix) {
+    ctx_storage s;
+    soliton_aesgcm_ctx* ctx = open_ctx(&s, bind_prefix);
+    uint8_t* p = ref;
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t nonce[12];
+        packet_nonce(nonce, pn + i);
+        soliton_aesgcm_reset(ctx, nonce, 12);
+        memcpy(p, d[i].hdr, d[i].hdr_len);
+        soliton_aesgcm_aad_update(ctx, d[i].hdr, d[i].hdr_len);
+        soliton_aesgcm_encrypt_update(ctx, d[i].payload, p + d[i].hdr_len, d[i].len);
+        soliton_aesgcm_encrypt_final(ctx, p + d[i].hdr_len + d[i].len);
+        p += d[i].hdr_len + d[i].len + 16;
+    }
+    soliton_aesgcm_context_wipe(ctx);
+    return (size_t)(p - ref);
+}
+
+static int gso_matches(size_t count, size_t segment_size, size_t last_len, uint64_t pn, int bind_prefix) {
+    ctx_storage s;
+    soliton_aesgcm_ctx* ctx = open_ctx(&s, bind_prefix);
+    soliton_datagram d[MAX_DGRAMS];
+    size_t out_len = 0;
+    int ok = 1;
+
+    make_dgrams(d, count, segment_size, last_len);
+    const size_t ref_len = seal_separately(d, count, pn, bind_prefix);
+
+    memset(gso, 0xa5, sizeof(gso));
+    ok &= soliton_aesgcm_seal_gso(ctx, iv, pn, d, count, segment_size, gso, sizeof(gso), &out_len) == SOLITON_OK;
+    ok &= out_len == ref_len && memcmp(gso, ref, ref_len) == 0;
+    ok &= gso[out_len] == 0xa5;
+    soliton_aesgcm_context_wipe(ctx);
+    return ok;
+}
+
+static void test_equivalence(void) {
+    static const size_t segs[] = { 29, 30, 45, 100, 157, 1200, 1280, 1472, MAX_SEG };
+    static const size_t counts[] = { 1, 2, 7, 8, 9, 16, 17, MAX_DGRAMS };
+    int ok = 1;
+
+    printf("\nGSO buffer vs reset/aad/update/final per datagram:\n");
+    for (size_t i = 0; i < sizeof(segs) / sizeof(segs[0]); i++) {
+        for (size_t j = 0; j < sizeof(counts) / sizeof(counts[0]); j++) {
+            ok &= gso_matches(counts[j], segs[i], segs[i] - HDR_LEN - 16, 1000 + i, 0);
+        }
+    }
+    check(ok, "9 segment sizes x 8 counts (1..40 datagrams)");
+
+    ok = 1;
+    for (size_t last = 0; last <= 1200 - HDR_LEN - 16; last += 37) {
+        ok &= gso_matches(11, 1200, last, 7, 0);
+    }
+    check(ok, "short last datagram, 0..1171 payload bytes");
+
+    ok = gso_matches(9, 1200, 1200 - HDR_LEN - 16, 0xfffffffffffffff9ull, 0);
+    check(ok, "packet numbers wrapping past 2^64 - 1");
+
+    ok = gso_matches(MAX_DGRAMS, 1472, 700, 42, 1);
+    check(ok, "bound AAD prefix hashed ahead of every header");
+}
+
+static void test_in_place(void) {
+    ctx_storage s;
+    soliton_aesgcm_ctx* ctx = open_ctx(&s, 0);
+    soliton_datagram d[MAX_DGRAMS];
+    const size_t count = 20, seg = 1280;
+    size_t out_len = 0;
+
+    printf("\nIn-place datagrams:\n");
+    make_dgrams(d, count, seg, 500);
+    const size_t ref_len = seal_separately(d, count, 5, 0);
+
+    /* Headers and payloads staged at their final positions in the buffer */
+    for (size_t i = 0; i < count; i++) {
+        memcpy(gso + i * seg, hdrs[i], HDR_LEN);
+        memcpy(gso + i * seg + HDR_LEN, payloads[i], d[i].len);
+        d[i].hdr = gso + i * seg;
+        d[i].payload = gso + i * seg + HDR_LEN;
+    }
+    check(soliton_aesgcm_seal_gso(ctx, iv, 5, d, count, seg, gso, sizeof(gso), &out_len) == SOLITON_OK,
+          "in-place seal accepted");
+    check(out_len == ref_len && memcmp(gso, ref, ref_len) == 0, "same bytes as separate calls");
+    soliton_aesgcm_context_wipe(ctx);
+}
+
+static void test_open(void) {
+    ctx_storage a, b;
+    soliton_aesgcm_ctx* ctx = open_ctx(&a, 0);
+    soliton_aesgcm_ctx* rx = open_ctx(&b, 0);
+    soliton_datagram d[MAX_DGRAMS];
+    const size_t count = 12, seg = 1350;
+    uint8_t pt[MAX_SEG];
+    size_t out_len = 0;
+    int ok = 1;
+
+    printf("\nOpening the datagrams:\n");
+    make_dgrams(d, count, seg, 77);
+    soliton_aesgcm_seal_gso(ctx, iv, 300, d, count, seg, gso, sizeof(gso), &out_len);
+
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* p = gso + i * seg;
+        uint8_t nonce[12];
+        packet_nonce(nonce, 300 + i);
+        soliton_aesgcm_reset(rx, nonce, 12);
+        soliton_aesgcm_aad_update(rx, p, HDR_LEN);
+        soliton_aesgcm_decrypt_update(rx, p + HDR_LEN, pt, d[i].len);
+        ok &= soliton_aesgcm_decrypt_final(rx, p + HDR_LEN + d[i].len) == SOLITON_OK;
+        ok &= memcmp(pt, payloads[i], d[i].len) == 0;
+    }
+    check(ok, "every datagram opens and round-trips");
+
+    gso[3 * seg + 1] ^= 0x40;   /* header byte of datagram 3 */
+    uint8_t nonce[12];
+    packet_nonce(nonce, 303);
+    soliton_aesgcm_reset(rx, nonce, 12);
+    soliton_aesgcm_aad_update(rx, gso + 3 * seg, HDR_LEN);
+    soliton_aesgcm_decrypt_update(rx, gso + 3 * seg + HDR_LEN, pt, d[3].len);
+    check(soliton_aesgcm_decrypt_final(rx, gso + 3 * seg + HDR_LEN + d[3].len) == SOLITON_AUTH_FAIL,
+          "flipped header bit rejected");
+
+    soliton_aesgcm_context_wipe(ctx);
+    soliton_aesgcm_context_wipe(rx);
+}
+
+static void test_invalid(void) {
+    ctx_storage s;
+    soliton_aesgcm_ctx* ctx = open_ctx(&s, 0);
+    soliton_datagram d[MAX_DGRAMS];
+    const size_t seg = 200;
+    size_t out_len = 0;
+
+    printf("\nArgument validation:\n");
+    make_dgrams(d, 4, seg, seg - HDR_LEN - 16);
+
+    check(soliton_aesgcm_seal_gso(NULL, iv, 0, d, 4, seg, gso, sizeof(gso), &out_len) == SOLITON_INVALID_INPUT,
+          "NULL context");
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 4, seg, NULL, sizeof(gso), &out_len) == SOLITON_INVALID_INPUT,
+          "NULL output");
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 4, seg, gso, sizeof(gso), NULL) == SOLITON_INVALID_INPUT,
+          "NULL out_len");
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 4, seg, gso, 4 * seg - 1, &out_len) == SOLITON_INVALID_INPUT,
+          "buffer one byte short");
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 4, seg, gso, 4 * seg, &out_len) == SOLITON_OK &&
+          out_len == 4 * seg, "buffer exactly count * segment_size");
+
+    d[1].len--;
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 4, seg, gso, sizeof(gso), &out_len) == SOLITON_INVALID_INPUT,
+          "short datagram before the last");
+    d[1].len++;
+    d[3].len++;
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 4, seg, gso, sizeof(gso), &out_len) == SOLITON_INVALID_INPUT,
+          "last datagram over segment_size");
+    d[3].len = 0;
+    d[3].hdr_len = 0;
+    d[3].hdr = NULL;
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 4, seg, gso, sizeof(gso), &out_len) == SOLITON_OK &&
+          out_len == 3 * seg + 16, "tag-only last datagram");
+    d[2].payload = NULL;
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 4, seg, gso, sizeof(gso), &out_len) == SOLITON_INVALID_INPUT,
+          "NULL payload with length");
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 1, 15, gso, sizeof(gso), &out_len) == SOLITON_INVALID_INPUT,
+          "segment smaller than a tag");
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, NULL, 0, seg, NULL, 0, &out_len) == SOLITON_OK && out_len == 0,
+          "empty batch");
+
+    soliton_aesgcm_context_wipe(ctx);
+    make_dgrams(d, 4, seg, seg - HDR_LEN - 16);
+    check(soliton_aesgcm_seal_gso(ctx, iv, 0, d, 4, seg, gso, sizeof(gso), &out_len) == SOLITON_INVALID_INPUT,
+          "wiped context");
+}
+
+static void test_openssl(void) {
+    ctx_storage s;
+    soliton_aesgcm_ctx* ctx = open_ctx(&s, 0);
+    soliton_datagram d[MAX_DGRAMS];
+    const size_t count = 10, seg = 1252;
+    size_t out_len = 0;
+    int ok = 1;
+
+    printf("\nDatagrams vs OpenSSL:\n");
+    make_dgrams(d, count, seg, 333);
+    soliton_aesgcm_seal_gso(ctx, iv, 0x1234567890ull, d, count, seg, gso, sizeof(gso), &out_len);
+
+    for (size_t i = 0; i < count; i++) {
+        /* Nonce built as a big-endian 96-bit XOR, independently of packet_nonce */
+        uint8_t nonce[12] = {0}, ct[MAX_SEG], tag[16];
+        uint64_t pn = 0x1234567890ull + i;
+        for (int b = 11; b >= 4; b--, pn >>= 8) {
+            nonce[b] = (uint8_t)pn;
+        }
+        for (int b = 0; b < 12; b++) {
+            nonce[b] ^= iv[b];
+        }
+
+        int outl = 0;
+        EVP_CIPHER_CTX* evp = EVP_CIPHER_CTX_new();
+        EVP_EncryptInit_ex(evp, EVP_aes_256_gcm(), NULL, NULL, NULL);
+        EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_SET_IVLEN, 12, NULL);
+        EVP_EncryptInit_ex(evp, NULL, NULL, key, nonce);
+        EVP_EncryptUpdate(evp, NULL, &outl, hdrs[i], HDR_LEN);
+        EVP_EncryptUpdate(evp, ct, &outl, payloads[i], (int)d[i].len);
+        EVP_EncryptFinal_ex(evp, ct + outl, &outl);
+        EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_GET_TAG, 16, tag);
+        EVP_CIPHER_CTX_free(evp);
+
+        const uint8_t* p = gso + i * seg;
+        ok &= memcmp(p, hdrs[i], HDR_LEN) == 0;
+        ok &= memcmp(p + HDR_LEN, ct, d[i].len) == 0;
+        ok &= memcmp(p + HDR_LEN + d[i].len, tag, 16) == 0;
+    }
+    check(ok, "10 datagrams of 1252 bytes, short last");
+    soliton_aesgcm_context_wipe(ctx);
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("AES-GCM GSO Datagram Batch Validation\n");
+    printf("==========================================\n");
+
+    fill(key, sizeof(key), 1);
+    fill(iv, sizeof(iv), 2);
+    fill(prefix, sizeof(prefix), 3);
+    fill(&hdrs[0][0], sizeof(hdrs), 4);
+    fill(&payloads[0][0], sizeof(payloads), 5);
+
+    test_equivalence();
+    test_in_place();
+    test_open();
+    test_invalid();
+    test_openssl();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL GSO TESTS PASSED\n");
+    } else {
+        printf("✗ %d GSO TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
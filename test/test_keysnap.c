@@ -0,0 +1,242 @@
+/*
+ * test_keysnap.c — AES-GCM Key Snapshot / Restore
+ *
+ * PROOF OBLIGATIONS:
+ *   1. Contexts restored in place from a snapshot (reset + encrypt) produce
+ *      byte-identical ciphertext and tags to freshly initialized contexts
+ *   2. Any modified payload/tag byte or a wrong wrap key returns AUTH_FAIL,
+ *      wipes the payload and leaves no context reachable
+ *   3. Version, CPU feature and backend mismatches return UNSUPPORTED before
+ *      the payload is touched; double open and misalignment are rejected
+ *   4. Hosted save + mmap load round-trips through a file
+ *
+ * Compile: cc -O2 -o test_keysnap test_keysnap.c -L. -lsoliton_hosted -lsoliton_core
+ */
+
+#define _DEFAULT_SOURCE  /* mkstemp */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../include/soliton.h"
+#include "../include/soliton_hosted.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define NCTX 8
+#define MSG_LEN 300
+
+static uint8_t keys[NCTX][32];
+static uint8_t ctx_buffers[NCTX][CTX_SIZE] __attribute__((aligned(64)));
+static const soliton_aesgcm_ctx* ctxs[NCTX];
+static uint8_t wrap_key[32];
+
+static void seal_msg(soliton_aesgcm_ctx* ctx, uint32_t seed, uint8_t* ct, uint8_t tag[16]) {
+    uint8_t iv[12], aad[20], pt[MSG_LEN];
+    fill(iv, sizeof(iv), seed);
+    fill(aad, sizeof(aad), seed + 1);
+    fill(pt, sizeof(pt), seed + 2);
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, sizeof(pt));
+    soliton_aesgcm_encrypt_final(ctx, tag);
+}
+
+/* Compare every restored context against a fresh init with the same key */
+static int restored_matches(uint8_t* snap, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint8_t ref_buf[CTX_SIZE] __attribute__((aligned(64)));
+        soliton_aesgcm_ctx* ref = (soliton_aesgcm_ctx*)ref_buf;
+        soliton_aesgcm_ctx* got = soliton_keysnap_ctx(snap, i);
+        uint8_t iv[12], ct0[MSG_LEN], ct1[MSG_LEN], tag0[16], tag1[16];
+
+        fill(iv, sizeof(iv), 100 + (uint32_t)i);
+        if (!got) return 0;
+        if (soliton_aesgcm_init(ref, keys[i], iv, sizeof(iv)) != SOLITON_OK) return 0;
+        if (soliton_aesgcm_reset(got, iv, sizeof(iv)) != SOLITON_OK) return 0;
+
+        seal_msg(ref, 100 + (uint32_t)i, ct0, tag0);
+        seal_msg(got, 100 + (uint32_t)i, ct1, tag1);
+        soliton_aesgcm_context_wipe(ref);
+
+        if (memcmp(ct0, ct1, MSG_LEN) != 0 || memcmp(tag0, tag1, 16) != 0) return 0;
+    }
+    return 1;
+}
+
+static uint8_t* make_snapshot(size_t* len) {
+    uint8_t nonce[12];
+    fill(nonce, sizeof(nonce), 77);
+    *len = soliton_keysnap_bytes(NCTX);
+    uint8_t* snap = aligned_alloc(64, (*len + 63) & ~(size_t)63);
+    if (!snap) abort();
+    if (soliton_keysnap_export(ctxs, NCTX, wrap_key, nonce, snap, *len) != SOLITON_OK) {
+        free(snap);
+        return NULL;
+    }
+    return snap;
+}
+
+static void test_roundtrip(void) {
+    printf("\n[1] Export / open / use in place\n");
+
+    size_t len, count = 0;
+    uint8_t* snap = make_snapshot(&len);
+    check(snap != NULL, "export succeeds");
+    if (!snap) return;
+
+    check(soliton_keysnap_ctx(snap, 0) == NULL, "contexts unreachable before open");
+    check(soliton_keysnap_open(snap, len, wrap_key, &count) == SOLITON_OK && count == NCTX,
+          "open succeeds, count preserved");
+    check(restored_matches(snap, count), "restored contexts == fresh init (ct + tag)");
+    check(soliton_keysnap_ctx(snap, NCTX) == NULL, "out-of-range index returns NULL");
+    check(soliton_keysnap_open(snap, len, wrap_key, &count) == SOLITON_INVALID_INPUT,
+          "second open rejected");
+    free(snap);
+
+    uint8_t nonce[12] = {0}, small[64] __attribute__((aligned(64)));
+    check(soliton_keysnap_export(ctxs, NCTX, wrap_key, nonce, small, sizeof(small))
+          == SOLITON_INVALID_INPUT, "short output buffer rejected");
+}
+
+static void test_tamper(void) {
+    printf("\n[2] Integrity\n");
+
+    size_t len, count;
+    uint8_t* snap = make_snapshot(&len);
+    if (!snap) { check(0, "export"); return; }
+    const size_t offsets[] = { 64, 64 + 777, len - 17, len - 1 };
+
+    for (size_t k = 0; k < sizeof(offsets) / sizeof(offsets[0]); k++) {
+        uint8_t* copy = aligned_alloc(64, (len + 63) & ~(size_t)63);
+        memcpy(copy, snap, len);
+        copy[offsets[k]] ^= 0x01;
+
+        char what[80];
+        soliton_status st = soliton_keysnap_open(copy, len, wrap_key, &count);
+        int wiped = 1;
+        for (size_t b = 64; b < len - 16; b++) wiped &= copy[b] == 0;
+        snprintf(what, sizeof(what), "flipped byte at %zu -> AUTH_FAIL, payload wiped", offsets[k]);
+        check(st == SOLITON_AUTH_FAIL && wiped && soliton_keysnap_ctx(copy, 0) == NULL, what);
+        free(copy);
+    }
+
+    /* Header bytes outside the checked fields are still bound as AAD */
+    uint8_t* copy = aligned_alloc(64, (len + 63) & ~(size_t)63);
+    memcpy(copy, snap, len);
+    copy[32] ^= 0x80;  /* nonce */
+    check(soliton_keysnap_open(copy, len, wrap_key, &count) == SOLITON_AUTH_FAIL,
+          "modified nonce -> AUTH_FAIL");
+
+    uint8_t bad_key[32];
+    memcpy(copy, snap, len);
+    memcpy(bad_key, wrap_key, 32);
+    bad_key[31] ^= 1;
+    check(soliton_keysnap_open(copy, len, bad_key, &count) == SOLITON_AUTH_FAIL,
+          "wrong wrap key -> AUTH_FAIL");
+
+    memcpy(copy, snap, len);
+    check(soliton_keysnap_open(copy, len - 1, wrap_key, &count) == SOLITON_INVALID_INPUT,
+          "truncated snapshot rejected");
+
+    free(copy);
+    free(snap);
+}
+
+static void test_compat(void) {
+    printf("\n[3] Compatibility tagging\n");
+
+    size_t len, count;
+    uint8_t* snap = make_snapshot(&len);
+    if (!snap) { check(0, "export"); return; }
+    uint8_t* copy = aligned_alloc(64, (len + 64 + 63) & ~(size_t)63);
+
+    memcpy(copy, snap, len);
+    copy[4] ^= 0x02;  /* version */
+    check(soliton_keysnap_open(copy, len, wrap_key, &count) == SOLITON_UNSUPPORTED,
+          "version mismatch -> UNSUPPORTED");
+
+    memcpy(copy, snap, len);
+    copy[8] ^= 0x40;  /* record size */
+    check(soliton_keysnap_open(copy, len, wrap_key, &count) == SOLITON_UNSUPPORTED,
+          "context layout mismatch -> UNSUPPORTED");
+
+    memcpy(copy, snap, len);
+    copy[23] |= 0x80;  /* CPU feature bit 63 (never set by this CPU) */
+    check(soliton_keysnap_open(copy, len, wrap_key, &count) == SOLITON_UNSUPPORTED,
+          "missing CPU feature -> UNSUPPORTED");
+
+    memcpy(copy, snap, len);
+    copy[44] ^= 0x20;  /* backend name */
+    check(soliton_keysnap_open(copy, len, wrap_key, &count) == SOLITON_UNSUPPORTED,
+          "backend mismatch -> UNSUPPORTED");
+
+    memcpy(copy, snap, len);
+    copy[0] = 'X';
+    check(soliton_keysnap_open(copy, len, wrap_key, &count) == SOLITON_INVALID_INPUT,
+          "bad magic rejected");
+
+    memcpy(copy + 8, snap, len);
+    check(soliton_keysnap_open(copy + 8, len, wrap_key, &count) == SOLITON_INVALID_INPUT,
+          "unaligned buffer rejected");
+
+    free(copy);
+    free(snap);
+}
+
+static void test_hosted(void) {
+    printf("\n[4] Hosted save / mmap load\n");
+
+    char path[] = "/tmp/soliton_keysnap_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) { check(0, "mkstemp"); return; }
+    close(fd);
+
+    soliton_keysnap_map map;
+    check(soliton_keysnap_save(path, ctxs, NCTX, wrap_key) == SOLITON_OK, "save to file");
+    check(soliton_keysnap_load(path, wrap_key, &map) == SOLITON_OK && map.count == NCTX,
+          "mmap load");
+    check(map.base && restored_matches(map.base, map.count), "mapped contexts == fresh init");
+    soliton_keysnap_unload(&map);
+    check(map.base == NULL, "unload clears map");
+
+    uint8_t bad_key[32] = {0};
+    check(soliton_keysnap_load(path, bad_key, &map) == SOLITON_AUTH_FAIL && map.base == NULL,
+          "mmap load with wrong key -> AUTH_FAIL");
+
+    unlink(path);
+    check(soliton_keysnap_load(path, wrap_key, &map) == SOLITON_INTERNAL_ERROR,
+          "missing file -> INTERNAL_ERROR");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("AES-GCM Key Snapshot Validation\n");
+    printf("==========================================\n");
+
+    fill(wrap_key, sizeof(wrap_key), 9);
+    for (int i = 0; i < NCTX; i++) {
+        uint8_t iv[12];
+        fill(keys[i], 32, 1000 + (uint32_t)i);
+        fill(iv, sizeof(iv), 2000 + (uint32_t)i);
+        soliton_aesgcm_init((soliton_aesgcm_ctx*)ctx_buffers[i], keys[i], iv, sizeof(iv));
+        ctxs[i] = (const soliton_aesgcm_ctx*)ctx_buffers[i];
+    }
+
+    test_roundtrip();
+    test_tamper();
+    test_compat();
+    test_hosted();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL KEY SNAPSHOT TESTS PASSED\n");
+    } else {
+        printf("✗ %d KEY SNAPSHOT TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
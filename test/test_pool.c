@@ -0,0 +1,326 @@
+/*
+ * test_pool.c — soliton_aesgcm_seal_many / open_many on the work-stealing pool
+ *
+ * PROOF OBLIGATIONS:
+ *   1. seal_many ciphertext and tags equal one context sealing the same
+ *      messages in order, for pools of 1..8 workers and for pool == NULL,
+ *      over a mix of 0..64 KiB messages with and without AAD
+ *   2. open_many round-trips; a corrupted tag fails only its own message
+ *      (SOLITON_AUTH_FAIL, output zeroed) and the call returns the status
+ *      of the first failed message
+ *   3. A message with NULL buffers and a length gets SOLITON_INVALID_INPUT
+ *      without disturbing its neighbours
+ *   4. A skewed job (one large message among thousands of small ones) is
+ *      processed exactly once: per-worker message and byte totals add up
+ *   5. A pool survives hundreds of back-to-back jobs and two threads
+ *      submitting to it at once
+ *   6. NULL key / messages and out-of-range worker stats are rejected
+ *
+ * Compile: cc -O2 -o test_pool test_pool.c -L. -lsoliton_hosted -lsoliton_core -pthread
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/soliton_hosted.h"
+#include "test_util.h"
+
+#define N_MSG 1500
+#define MAX_LEN 65536
+#define BIG_LEN (4u << 20)
+
+static uint8_t key[32], aad[64];
+
+typedef struct {
+    soliton_gcm_msg msgs[N_MSG];
+    uint8_t*        pt[N_MSG];
+    uint8_t*        ct[N_MSG];
+    uint8_t*        back[N_MSG];
+    soliton_status  status[N_MSG];
+    size_t          count;
+} job;
+
+static job* job_new(size_t count, uint32_t seed) {
+    job* j = calloc(1, sizeof(*j));
+    j->count = count;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        /* Mostly medium, some tiny and some up to 64 KiB */
+        size_t len = (seed >> 8) % 8192;
+        if (i % 17 == 0) len = (seed >> 4) % MAX_LEN;
+        if (i % 29 == 0) len = i % 16;
+
+        j->pt[i] = malloc(len + 1);
+        j->ct[i] = malloc(len + 1);
+        j->back[i] = malloc(len + 1);
+        fill(j->pt[i], len, seed);
+        fill(j->msgs[i].iv, 12, seed ^ 0x5a5a);
+        j->msgs[i].aad = i % 3 ? aad : NULL;
+        j->msgs[i].aad_len = i % 3 ? (i % 64) : 0;
+        j->msgs[i].in = j->pt[i];
+        j->msgs[i].out = j->ct[i];
+        j->msgs[i].len = len;
+    }
+    return j;
+}
+
+static void job_free(job* j) {
+    for (size_t i = 0; i < j->count; i++) {
+        free(j->pt[i]);
+        free(j->ct[i]);
+        free(j->back[i]);
+    }
+    free(j);
+}
+
+/* Reference: one context, messages in order */
+static int serial_matches(const job* j) {
+    uint8_t buf[SOLITON_AESGCM_CTX_BYTES] __attribute__((aligned(64)));
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)buf;
+    size_t max = 0;
+    uint8_t tag[16];
+    int ok = 1;
+
+    for (size_t i = 0; i < j->count; i++) {
+        max = j->msgs[i].len > max ? j->msgs[i].len : max;
+    }
+    uint8_t* out = malloc(max + 1);
+
+    soliton_aesgcm_init(ctx, key, j->msgs[0].iv, 12);
+    for (size_t i = 0; i < j->count; i++) {
+        const soliton_gcm_msg* m = &j->msgs[i];
+        soliton_aesgcm_reset(ctx, m->iv, 12);
+        soliton_aesgcm_aad_update(ctx, m->aad, m->aad_len);
+        soliton_aesgcm_encrypt_update(ctx, j->pt[i], out, m->len);
+        soliton_aesgcm_encrypt_final(ctx, tag);
+        ok &= memcmp(out, j->ct[i], m->len) == 0 && memcmp(tag, m->tag, 16) == 0;
+    }
+    soliton_aesgcm_context_wipe(ctx);
+    free(out);
+    return ok;
+}
+
+static int seal_open(soliton_gcm_pool* pool, job* j) {
+    int ok = soliton_aesgcm_seal_many(pool, key, j->msgs, j->count, j->status) == SOLITON_OK;
+    for (size_t i = 0; i < j->count; i++) {
+        ok &= j->status[i] == SOLITON_OK;
+    }
+    ok &= serial_matches(j);
+
+    for (size_t i = 0; i < j->count; i++) {
+        j->msgs[i].in = j->ct[i];
+        j->msgs[i].out = j->back[i];
+    }
+    ok &= soliton_aesgcm_open_many(pool, key, j->msgs, j->count, j->status) == SOLITON_OK;
+    for (size_t i = 0; i < j->count; i++) {
+        ok &= j->status[i] == SOLITON_OK && memcmp(j->back[i], j->pt[i], j->msgs[i].len) == 0;
+        j->msgs[i].in = j->pt[i];
+        j->msgs[i].out = j->ct[i];
+    }
+    return ok;
+}
+
+static void test_equivalence(void) {
+    static const unsigned sizes[] = { 1, 2, 3, 4, 8 };
+    char what[96];
+
+    printf("\nseal_many/open_many vs one context in order:\n");
+    job* j = job_new(N_MSG, 11);
+    check(seal_open(NULL, j), "pool == NULL (calling thread)");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        soliton_gcm_pool* pool = NULL;
+        int ok = soliton_gcm_pool_create(sizes[s], 0, &pool) == SOLITON_OK;
+        ok &= soliton_gcm_pool_size(pool) == sizes[s];
+        memset(j->status, 0xff, sizeof(j->status));
+        ok &= seal_open(pool, j);
+        snprintf(what, sizeof(what), "%u worker(s): %d messages, tags and round trip", sizes[s], N_MSG);
+        check(ok, what);
+        soliton_gcm_pool_destroy(pool);
+    }
+
+    soliton_gcm_pool* pool = NULL;
+    soliton_gcm_pool_create(0, 1, &pool);
+    snprintf(what, sizeof(what), "one pinned worker per CPU (%u)", soliton_gcm_pool_size(pool));
+    check(seal_open(pool, j), what);
+    soliton_gcm_pool_destroy(pool);
+    job_free(j);
+}
+
+static void test_failures(void) {
+    soliton_gcm_pool* pool = NULL;
+    job* j = job_new(400, 23);
+    int ok = 1;
+
+    printf("\nPer-message status:\n");
+    soliton_gcm_pool_create(4, 0, &pool);
+    soliton_aesgcm_seal_many(pool, key, j->msgs, j->count, j->status);
+
+    for (size_t i = 0; i < j->count; i++) {
+        j->msgs[i].in = j->ct[i];
+        j->msgs[i].out = j->back[i];
+    }
+    j->msgs[123].tag[0] ^= 1;
+    j->msgs[77].tag[15] ^= 0x80;
+    const soliton_status st = soliton_aesgcm_open_many(pool, key, j->msgs, j->count, j->status);
+    check(st == SOLITON_AUTH_FAIL, "returns the first failure's status");
+
+    for (size_t i = 0; i < j->count; i++) {
+        if (i == 77 || i == 123) {
+            ok &= j->status[i] == SOLITON_AUTH_FAIL;
+            for (size_t b = 0; b < j->msgs[i].len; b++) {
+                ok &= j->back[i][b] == 0;
+            }
+        } else {
+            ok &= j->status[i] == SOLITON_OK && memcmp(j->back[i], j->pt[i], j->msgs[i].len) == 0;
+        }
+    }
+    check(ok, "corrupted tags fail alone, their output zeroed");
+
+    /* NULL input with a length before the tag failures */
+    j->msgs[77].tag[15] ^= 0x80;
+    j->msgs[123].tag[0] ^= 1;
+    const size_t len40 = j->msgs[40].len;
+    j->msgs[40].len = 100;
+    j->msgs[40].in = NULL;
+    check(soliton_aesgcm_open_many(pool, key, j->msgs, j->count, j->status) == SOLITON_INVALID_INPUT,
+          "invalid message reported as the first failure");
+    ok = j->status[40] == SOLITON_INVALID_INPUT;
+    for (size_t i = 0; i < j->count; i++) {
+        ok &= i == 40 || j->status[i] == SOLITON_OK;
+    }
+    check(ok, "NULL buffer with a length fails only its message");
+    j->msgs[40].len = len40;
+    j->msgs[40].in = j->ct[40];
+
+    check(soliton_aesgcm_open_many(pool, key, j->msgs, j->count, NULL) == SOLITON_OK,
+          "status array is optional");
+
+    soliton_gcm_pool_destroy(pool);
+    job_free(j);
+}
+
+static void test_skew(void) {
+    soliton_gcm_pool* pool = NULL;
+    job* j = job_new(N_MSG, 31);
+    uint64_t msgs = 0, bytes = 0, expect_bytes = 0, steals = 0;
+
+    printf("\nSkewed job:\n");
+    /* One 4 MiB message in the middle of the small ones */
+    free(j->pt[700]);
+    free(j->ct[700]);
+    free(j->back[700]);
+    j->pt[700] = malloc(BIG_LEN);
+    j->ct[700] = malloc(BIG_LEN);
+    j->back[700] = malloc(BIG_LEN);
+    fill(j->pt[700], BIG_LEN, 99);
+    j->msgs[700].in = j->pt[700];
+    j->msgs[700].out = j->ct[700];
+    j->msgs[700].len = BIG_LEN;
+
+    soliton_gcm_pool_create(4, 0, &pool);
+    check(seal_open(pool, j), "4 MiB message among 1499 small ones");
+
+    for (unsigned w = 0; w < soliton_gcm_pool_size(pool); w++) {
+        soliton_gcm_pool_stats s;
+        soliton_gcm_pool_stats_get(pool, w, &s);
+        msgs += s.messages;
+        bytes += s.bytes;
+        steals += s.steals;
+    }
+    for (size_t i = 0; i < j->count; i++) {
+        expect_bytes += j->msgs[i].len + j->msgs[i].aad_len;
+    }
+    check(msgs == 2 * (uint64_t)N_MSG && bytes == 2 * expect_bytes, "every message counted exactly once per job");
+    printf("    (%llu runs stolen across both jobs)\n", (unsigned long long)steals);
+
+    soliton_gcm_pool_destroy(pool);
+    job_free(j);
+}
+
+typedef struct {
+    soliton_gcm_pool* pool;
+    job*              j;
+    int               ok;
+} submitter;
+
+static void* submit_loop(void* arg) {
+    submitter* s = arg;
+    s->ok = 1;
+    for (int r = 0; r < 20; r++) {
+        s->ok &= seal_open(s->pool, s->j);
+    }
+    return NULL;
+}
+
+static void test_reuse(void) {
+    soliton_gcm_pool* pool = NULL;
+    job* small = job_new(64, 41);
+    int ok = 1;
+
+    printf("\nPool reuse:\n");
+    soliton_gcm_pool_create(3, 0, &pool);
+    for (int r = 0; r < 300; r++) {
+        ok &= soliton_aesgcm_seal_many(pool, key, small->msgs, small->count, small->status) == SOLITON_OK;
+    }
+    ok &= serial_matches(small);
+    check(ok, "300 back-to-back jobs on one pool");
+
+    submitter a = { pool, job_new(300, 43), 0 };
+    submitter b = { pool, job_new(300, 47), 0 };
+    pthread_t ta, tb;
+    pthread_create(&ta, NULL, submit_loop, &a);
+    pthread_create(&tb, NULL, submit_loop, &b);
+    pthread_join(ta, NULL);
+    pthread_join(tb, NULL);
+    check(a.ok && b.ok, "two threads submitting to one pool");
+
+    soliton_gcm_pool_destroy(pool);
+    job_free(a.j);
+    job_free(b.j);
+    job_free(small);
+}
+
+static void test_invalid(void) {
+    soliton_gcm_pool* pool = NULL;
+    soliton_gcm_pool_stats s;
+    soliton_gcm_msg m = {0};
+
+    printf("\nArgument validation:\n");
+    soliton_gcm_pool_create(2, 0, &pool);
+    check(soliton_aesgcm_seal_many(pool, NULL, &m, 1, NULL) == SOLITON_INVALID_INPUT, "NULL key");
+    check(soliton_aesgcm_seal_many(pool, key, NULL, 1, NULL) == SOLITON_INVALID_INPUT, "NULL messages");
+    check(soliton_aesgcm_open_many(pool, key, NULL, 0, NULL) == SOLITON_OK, "empty job");
+    check(soliton_gcm_pool_stats_get(pool, 2, &s) == SOLITON_INVALID_INPUT, "worker out of range");
+    check(soliton_gcm_pool_create(2, 0, NULL) == SOLITON_INVALID_INPUT, "NULL pool out");
+    soliton_gcm_pool_destroy(pool);
+    soliton_gcm_pool_destroy(NULL);
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("AES-GCM seal_many / open_many Pool Validation\n");
+    printf("==========================================\n");
+
+    fill(key, sizeof(key), 1);
+    fill(aad, sizeof(aad), 2);
+
+    test_equivalence();
+    test_failures();
+    test_skew();
+    test_reuse();
+    test_invalid();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL POOL TESTS PASSED\n");
+    } else {
+        printf("✗ %d POOL TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+/*
+ * test_rekey.c — Double-buffered AES-GCM key rotation (soliton_aesgcm_keyring)
+ *
+ * PROOF OBLIGATIONS:
+ *   1. The active context seals exactly like soliton_aesgcm_init with the
+ *      same key, before and after every commit
+ *   2. prepare and prepare_begin + prepare_step produce the same key
+ *   3. Keyring contexts reject updates until soliton_aesgcm_reset
+ *   4. commit without a prepared key, and prepare over an uncommitted
+ *      key, are rejected and leave the active key in place
+ *   5. retire wipes the old slot to zero
+ *   6. With a helper thread preparing/retiring and the data path sealing
+ *      and committing, every message matches its key generation
+ *   7. commit carries cost counters and sampling, the plan variant and the
+ *      A/B arm of an enrolled context over to the new key
+ *
+ * Compile: cc -O2 -pthread -o test_rekey test_rekey.c -L. -lsoliton_core
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MSG_LEN 300
+#define GENERATIONS 200
+
+static void key_for(uint8_t key[32], uint32_t gen) {
+    fill(key, 32, 1000 + gen);
+}
+
+static uint8_t slot_a[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t slot_b[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t msg[MSG_LEN];
+
+/* Seal msg under ctx with a message-specific IV */
+static void seal(soliton_aesgcm_ctx* ctx, uint32_t seq, uint8_t ct[MSG_LEN], uint8_t tag[16]) {
+    uint8_t iv[12];
+
+    fill(iv, sizeof(iv), seq);
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_encrypt_update(ctx, msg, ct, MSG_LEN);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+}
+
+/* The same message through a freshly initialized context */
+static int seal_matches(soliton_aesgcm_ctx* ctx, uint32_t gen, uint32_t seq) {
+    uint8_t ref_buf[CTX_SIZE] __attribute__((aligned(64)));
+    soliton_aesgcm_ctx* ref = (soliton_aesgcm_ctx*)ref_buf;
+    uint8_t key[32], iv[12];
+    uint8_t ct[MSG_LEN], tag[16], ref_ct[MSG_LEN], ref_tag[16];
+
+    key_for(key, gen);
+    fill(iv, sizeof(iv), seq);
+    soliton_aesgcm_init(ref, key, iv, sizeof(iv));
+    soliton_aesgcm_encrypt_update(ref, msg, ref_ct, MSG_LEN);
+    soliton_aesgcm_encrypt_final(ref, ref_tag);
+    soliton_aesgcm_context_wipe(ref);
+
+    seal(ctx, seq, ct, tag);
+    return memcmp(ct, ref_ct, MSG_LEN) == 0 && memcmp(tag, ref_tag, 16) == 0;
+}
+
+static int all_zero(const uint8_t* p, size_t len) {
+    uint8_t acc = 0;
+    for (size_t i = 0; i < len; i++) {
+        acc |= p[i];
+    }
+    return acc == 0;
+}
+
+static void test_sequence(void) {
+    soliton_aesgcm_keyring kr;
+    soliton_aesgcm_ctx* a = (soliton_aesgcm_ctx*)slot_a;
+    soliton_aesgcm_ctx* b = (soliton_aesgcm_ctx*)slot_b;
+    uint8_t key[32], ct[MSG_LEN];
+
+    printf("\nKeyring state machine:\n");
+
+    key_for(key, 0);
+    check(soliton_aesgcm_keyring_init(&kr, a, a, key) == SOLITON_INVALID_INPUT, "init rejects ctx0 == ctx1");
+    check(soliton_aesgcm_keyring_init(&kr, a, b, key) == SOLITON_OK, "init");
+    check(soliton_aesgcm_keyring_active(&kr) == a, "slot 0 active");
+    check(soliton_aesgcm_encrypt_update(a, msg, ct, MSG_LEN) == SOLITON_INVALID_INPUT,
+          "update before reset rejected");
+    check(seal_matches(soliton_aesgcm_keyring_active(&kr), 0, 1), "generation 0 seals like init");
+
+    check(soliton_aesgcm_keyring_commit(&kr) == SOLITON_INVALID_INPUT, "commit with nothing prepared rejected");
+    check(soliton_aesgcm_keyring_active(&kr) == a, "active key unchanged");
+
+    key_for(key, 1);
+    check(soliton_aesgcm_keyring_prepare(&kr, key) == SOLITON_OK, "prepare generation 1");
+    check(soliton_aesgcm_keyring_prepare(&kr, key) == SOLITON_INVALID_INPUT, "prepare over uncommitted key rejected");
+    check(seal_matches(soliton_aesgcm_keyring_active(&kr), 0, 2), "generation 0 still active before commit");
+    check(soliton_aesgcm_keyring_commit(&kr) == SOLITON_OK, "commit");
+    check(soliton_aesgcm_keyring_active(&kr) == b, "slot 1 active");
+    check(seal_matches(soliton_aesgcm_keyring_active(&kr), 1, 3), "generation 1 seals like init");
+
+    check(!all_zero(slot_a, 512), "old key present until retire");
+    soliton_aesgcm_keyring_retire(&kr);
+    check(all_zero(slot_a, 512), "retire wipes the old slot");
+
+    key_for(key, 2);
+    check(soliton_aesgcm_keyring_prepare_step(&kr) == SOLITON_INVALID_INPUT, "step before begin rejected");
+    check(soliton_aesgcm_keyring_prepare_begin(&kr, key) == SOLITON_OK, "prepare_begin generation 2");
+    check(soliton_aesgcm_keyring_commit(&kr) == SOLITON_INVALID_INPUT, "commit of half-built key rejected");
+    check(soliton_aesgcm_keyring_prepare_step(&kr) == SOLITON_OK, "prepare_step");
+    check(soliton_aesgcm_keyring_commit(&kr) == SOLITON_OK, "commit");
+    check(seal_matches(soliton_aesgcm_keyring_active(&kr), 2, 4), "sliced prepare seals like init");
+
+    /* Commit without retire: the next prepare wipes and reuses the slot */
+    key_for(key, 3);
+    check(soliton_aesgcm_keyring_prepare(&kr, key) == SOLITON_OK &&
+          soliton_aesgcm_keyring_commit(&kr) == SOLITON_OK &&
+          seal_matches(soliton_aesgcm_keyring_active(&kr), 3, 5), "prepare over a retired slot");
+
+    soliton_aesgcm_keyring_wipe(&kr);
+    check(all_zero(slot_a, 512) && all_zero(slot_b, 512), "keyring_wipe clears both slots");
+}
+
+static soliton_stats_block stats_block;
+static soliton_ab_samples ab_block;
+
+static uint64_t ab_calls(unsigned arm) {
+    uint64_t n = 0;
+    for (int c = 0; c < SOLITON_AB_CLASSES; c++) {
+        n += ab_block.calls[arm][c];
+    }
+    return n;
+}
+
+static void test_carry(void) {
+    soliton_aesgcm_keyring kr;
+    soliton_aesgcm_ctx* ctx;
+    soliton_aesgcm_cost before, after;
+    soliton_stats st;
+    uint8_t key[32], ct[MSG_LEN], tag[16];
+
+    printf("\nCommit of an enrolled, cost-enabled context:\n");
+
+    key_for(key, 0);
+    soliton_aesgcm_keyring_init(&kr, (soliton_aesgcm_ctx*)slot_a, (soliton_aesgcm_ctx*)slot_b, key);
+    ctx = soliton_aesgcm_keyring_active(&kr);
+    check(soliton_aesgcm_cost_enable(ctx, 4) == SOLITON_OK && soliton_aesgcm_set_ab_arm(ctx, 1) == SOLITON_OK,
+          "cost sampling every 4 calls, A/B arm 1");
+    const int variant = soliton_aesgcm_set_plan(ctx, SOLITON_GCM_PLAN_PIPELINED16) == SOLITON_OK;
+    for (uint32_t seq = 1; seq <= 3; seq++) {
+        seal(ctx, seq, ct, tag);
+    }
+    soliton_aesgcm_cost_read(ctx, &before);
+
+    key_for(key, 1);
+    check(soliton_aesgcm_keyring_prepare(&kr, key) == SOLITON_OK &&
+          soliton_aesgcm_keyring_commit(&kr) == SOLITON_OK, "prepare + commit generation 1");
+    ctx = soliton_aesgcm_keyring_active(&kr);
+    soliton_aesgcm_cost_read(ctx, &after);
+    check(before.enc_messages == 3 && memcmp(&before, &after, sizeof(before)) == 0,
+          "new key starts from the old key's cost counters");
+
+    memset(&stats_block, 0, sizeof(stats_block));
+    memset(&ab_block, 0, sizeof(ab_block));
+    soliton_stats_attach(&stats_block);
+    soliton_ab_samples_attach(&ab_block, 1);
+    const int match = seal_matches(ctx, 1, 4) & seal_matches(ctx, 1, 5);
+    soliton_ab_samples_attach(NULL, 0);
+    soliton_stats_attach(NULL);
+    soliton_stats_sum(&stats_block, &st);
+
+    check(match, "generation 1 seals like init");
+    soliton_aesgcm_cost_read(ctx, &after);
+    check(after.enc_messages == 5 && after.sampled_calls == after.calls / 4,
+          "cost counting and the 1-in-4 sampling continue across the commit");
+    check(ab_calls(1) == 2 && ab_calls(0) == 0, "A/B arm kept: both updates sampled into arm 1");
+    if (variant) {
+        check(st.kernel_calls[SOLITON_KERNEL_PIPELINED16] == 2, "plan variant kept: PIPELINED16 kernel");
+    } else {
+        printf("  - plan variants unsupported on this backend\n");
+    }
+
+    soliton_aesgcm_keyring_wipe(&kr);
+}
+
+static soliton_aesgcm_keyring shared;
+
+/* Helper: build generations 1..N as soon as the previous one is taken */
+static void* helper(void* arg) {
+    (void)arg;
+    for (uint32_t gen = 1; gen <= GENERATIONS; gen++) {
+        uint8_t key[32];
+        key_for(key, gen);
+        for (;;) {
+            soliton_aesgcm_keyring_retire(&shared);
+            if (soliton_aesgcm_keyring_prepare_begin(&shared, key) == SOLITON_OK) {
+                break;
+            }
+            sched_yield();
+        }
+        soliton_aesgcm_keyring_prepare_step(&shared);
+    }
+    return NULL;
+}
+
+static void test_threaded(void) {
+    pthread_t th;
+    uint8_t key[32];
+    uint32_t gen = 0, seq = 0;
+    int ok = 1;
+
+    printf("\nHelper thread + data path:\n");
+
+    key_for(key, 0);
+    soliton_aesgcm_keyring_init(&shared, (soliton_aesgcm_ctx*)slot_a, (soliton_aesgcm_ctx*)slot_b, key);
+    pthread_create(&th, NULL, helper, NULL);
+
+    while (gen < GENERATIONS) {
+        if (soliton_aesgcm_keyring_commit(&shared) == SOLITON_OK) {
+            gen++;
+        }
+        ok &= seal_matches(soliton_aesgcm_keyring_active(&shared), gen, ++seq);
+    }
+    pthread_join(th, NULL);
+    soliton_aesgcm_keyring_retire(&shared);
+    soliton_aesgcm_keyring_wipe(&shared);
+
+    char what[96];
+    snprintf(what, sizeof(what), "%u generations over %u messages match their key", GENERATIONS, seq);
+    check(ok, what);
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("AES-GCM Key Rotation Validation\n");
+    printf("==========================================\n");
+
+    fill(msg, sizeof(msg), 7);
+
+    test_sequence();
+    test_carry();
+    test_threaded();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL KEY ROTATION TESTS PASSED\n");
+    } else {
+        printf("✗ %d KEY ROTATION TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
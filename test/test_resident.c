@@ -0,0 +1,153 @@
+/*
+ * test_resident.c - Whole-span resident GCM kernels (gcm_resident_vaes_clmul.c)
+ *
+ * PROOF OBLIGATIONS:
+ *   1. A single encrypt_update over n bytes (resident kernel) gives the same
+ *      ciphertext and tag as 128-byte updates (one per-batch fused call
+ *      each), for n from one batch to 64KB + odd tails, with AAD
+ *   2. The ciphertext and tag match OpenSSL
+ *   3. A single decrypt_update accepts the tag of a single encrypt_update
+ *      and recovers the plaintext, out of place and in place, under both
+ *      vector-width policies
+ *   4. A flipped bit in the middle batch is rejected
+ *
+ * Compile: cc -O2 -o test_resident test_resident.c -L. -lsoliton_core -lcrypto
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <openssl/evp.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_LEN (65536 + 47)
+
+static const size_t lens[] = {
+    128, 129, 255, 256, 300, 1000, 1024, 1500, 4096, 4111, 16384, 16400, 65536, MAX_LEN
+};
+#define NLENS (sizeof(lens) / sizeof(lens[0]))
+
+static uint8_t ctx_buf[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t key[32], iv[12], aad[24];
+static uint8_t pt[MAX_LEN], ct[MAX_LEN], ct_split[MAX_LEN], ref[MAX_LEN], out[MAX_LEN];
+
+/* Seal in updates of at most chunk bytes (chunk == 0: one update) */
+static void seal(size_t len, size_t chunk, uint8_t* dst, uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)ctx_buf;
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    if (chunk == 0) {
+        chunk = len;
+    }
+    for (size_t off = 0; off < len; off += chunk) {
+        const size_t n = len - off < chunk ? len - off : chunk;
+        soliton_aesgcm_encrypt_update(ctx, pt + off, dst + off, n);
+    }
+    soliton_aesgcm_encrypt_final(ctx, tag);
+    soliton_aesgcm_context_wipe(ctx);
+}
+
+static soliton_status open_msg(const uint8_t* in, uint8_t* dst, size_t len, const uint8_t tag[16]) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)ctx_buf;
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_decrypt_update(ctx, in, dst, len);
+    soliton_status st = soliton_aesgcm_decrypt_final(ctx, tag);
+    soliton_aesgcm_context_wipe(ctx);
+    return st;
+}
+
+static void openssl_seal(size_t len, uint8_t* dst, uint8_t tag[16]) {
+    int outl = 0;
+    EVP_CIPHER_CTX* evp = EVP_CIPHER_CTX_new();
+    EVP_EncryptInit_ex(evp, EVP_aes_256_gcm(), NULL, NULL, NULL);
+    EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_SET_IVLEN, 12, NULL);
+    EVP_EncryptInit_ex(evp, NULL, NULL, key, iv);
+    EVP_EncryptUpdate(evp, NULL, &outl, aad, sizeof(aad));
+    EVP_EncryptUpdate(evp, dst, &outl, pt, (int)len);
+    EVP_EncryptFinal_ex(evp, dst + outl, &outl);
+    EVP_CIPHER_CTX_ctrl(evp, EVP_CTRL_GCM_GET_TAG, 16, tag);
+    EVP_CIPHER_CTX_free(evp);
+}
+
+static void test_encrypt(void) {
+    uint8_t tag[16], tag_split[16], tag_ref[16];
+    int same = 1, ossl = 1;
+
+    printf("\nResident encrypt vs per-batch updates:\n");
+
+    for (size_t i = 0; i < NLENS; i++) {
+        fill(iv, sizeof(iv), (uint32_t)lens[i]);
+        seal(lens[i], 0, ct, tag);
+        seal(lens[i], 128, ct_split, tag_split);
+        same &= memcmp(ct, ct_split, lens[i]) == 0 && memcmp(tag, tag_split, 16) == 0;
+
+        openssl_seal(lens[i], ref, tag_ref);
+        ossl &= memcmp(ct, ref, lens[i]) == 0 && memcmp(tag, tag_ref, 16) == 0;
+    }
+
+    char what[96];
+    snprintf(what, sizeof(what), "ciphertext and tag identical for %zu lengths (128..%u)",
+             NLENS, (unsigned)MAX_LEN);
+    check(same, what);
+    check(ossl, "ciphertext and tag match OpenSSL");
+}
+
+static void test_decrypt(void) {
+    static const soliton_vwidth_policy policies[] = { SOLITON_VWIDTH_PREFER_YMM, SOLITON_VWIDTH_ALWAYS_ZMM };
+    uint8_t tag[16];
+    int ok = 1, in_place = 1;
+
+    printf("\nResident decrypt:\n");
+
+    for (size_t p = 0; p < 2; p++) {
+        soliton_set_vwidth_policy(policies[p], 0);
+        for (size_t i = 0; i < NLENS; i++) {
+            fill(iv, sizeof(iv), (uint32_t)lens[i]);
+            seal(lens[i], 0, ct, tag);
+
+            memset(out, 0, lens[i]);
+            ok &= open_msg(ct, out, lens[i], tag) == SOLITON_OK && memcmp(out, pt, lens[i]) == 0;
+
+            memcpy(out, ct, lens[i]);
+            in_place &= open_msg(out, out, lens[i], tag) == SOLITON_OK && memcmp(out, pt, lens[i]) == 0;
+        }
+    }
+    soliton_set_vwidth_policy(SOLITON_VWIDTH_AUTO, 0);
+
+    check(ok, "opens single-update seals under PREFER_YMM and ALWAYS_ZMM");
+    check(in_place, "in-place open");
+
+    fill(iv, sizeof(iv), 4096);
+    seal(4096, 0, ct, tag);
+    ct[2048 + 5] ^= 0x10;
+    check(open_msg(ct, out, 4096, tag) == SOLITON_AUTH_FAIL, "flipped bit in the middle batch rejected");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("Resident GCM Kernel Validation\n");
+    printf("==========================================\n");
+
+    fill(key, sizeof(key), 1);
+    fill(aad, sizeof(aad), 2);
+    fill(pt, sizeof(pt), 3);
+
+    test_encrypt();
+    test_decrypt();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL RESIDENT KERNEL TESTS PASSED\n");
+    } else {
+        printf("✗ %d RESIDENT KERNEL TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
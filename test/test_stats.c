@@ -0,0 +1,315 @@
+/*
+ * test_stats.c - Live stats block + seqlock shared-memory page (soliton-top)
+ *
+ * PROOF OBLIGATIONS:
+ *   1. With a block attached, checked-API updates land in the exact size
+ *      buckets and tail counters, finals count messages and auth failures,
+ *      policy changes count plan switches, cost-sampled calls fill the
+ *      latency histogram and bulk kernels report their bytes
+ *   2. Nothing is counted into the page until a snapshot is published; a
+ *      monitor mapping the page by PID reads the same snapshot
+ *   3. A reader racing a writer never returns a torn snapshot
+ *   4. The background publisher refreshes the page, soliton-top can attach
+ *      to it, and stop removes the page
+ *   5. Only one publisher runs at a time; a restarted one counts from zero
+ *   6. The page is created owner-only, replacing a stale symlink at its
+ *      path without writing through it
+ *   7. Counts from more threads than there are per-thread slots all reach
+ *      the published totals, none lost in the shared overflow slot
+ *
+ * Compile: cc -O2 -pthread -o test_stats test_stats.c -L. -lsoliton_hosted -lsoliton_core
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../include/soliton_hosted.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MSG_LEN 1000
+#define TORTURE_WRITES 200000
+#define COUNT_THREADS (SOLITON_STATS_SLOTS + 16)
+#define COUNT_SEALS 50
+
+static uint8_t ctx_buf[CTX_SIZE] __attribute__((aligned(64)));
+static uint8_t key[32], iv[12], aad[20];
+static uint8_t pt[MSG_LEN], ct[MSG_LEN], out[MSG_LEN];
+
+/* Encrypt updates of 16 and MSG_LEN - 16 bytes */
+static void seal(soliton_aesgcm_ctx* ctx, uint8_t tag[16]) {
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, 16);
+    soliton_aesgcm_encrypt_update(ctx, pt + 16, ct + 16, MSG_LEN - 16);
+    soliton_aesgcm_encrypt_final(ctx, tag);
+}
+
+/* One decrypt update of MSG_LEN bytes */
+static soliton_status open_msg(soliton_aesgcm_ctx* ctx, const uint8_t tag[16]) {
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_aad_update(ctx, aad, sizeof(aad));
+    soliton_aesgcm_decrypt_update(ctx, ct, out, MSG_LEN);
+    return soliton_aesgcm_decrypt_final(ctx, tag);
+}
+
+static uint64_t sum(const uint64_t* v, size_t n) {
+    uint64_t s = 0;
+    for (size_t i = 0; i < n; i++) {
+        s += v[i];
+    }
+    return s;
+}
+
+static void test_counters(void) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)ctx_buf;
+    soliton_stats_publisher* pub = NULL;
+    soliton_stats_view view;
+    soliton_stats s, v;
+    soliton_aesgcm_cost c;
+    uint64_t ns = 0;
+    uint8_t tag[16], bad[16];
+
+    printf("\nCounters:\n");
+
+    soliton_set_vwidth_policy(SOLITON_VWIDTH_PREFER_YMM, 0);
+    check(soliton_stats_publish_start(0, &pub) == SOLITON_OK && pub, "publish_start (no thread)");
+    soliton_stats_publisher* dup = NULL;
+    check(soliton_stats_publish_start(0, &dup) == SOLITON_INVALID_INPUT && !dup,
+          "second publisher rejected while one runs");
+    check(soliton_stats_view_open((uint32_t)getpid(), &view) == SOLITON_OK, "view_open by own PID");
+    check(view.page->magic == SOLITON_STATS_PAGE_MAGIC && view.page->version == SOLITON_STATS_PAGE_VERSION &&
+          view.page->pid == (uint32_t)getpid(), "page header (magic, version, pid)");
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    soliton_aesgcm_cost_enable(ctx, 1);
+
+    seal(ctx, tag);
+    memcpy(bad, tag, 16);
+    bad[0] ^= 1;
+    soliton_status ok = open_msg(ctx, tag);
+    soliton_status fail = open_msg(ctx, bad);
+    check(ok == SOLITON_OK && fail == SOLITON_AUTH_FAIL, "seal, open, tampered open");
+
+    soliton_set_vwidth_policy(SOLITON_VWIDTH_ALWAYS_ZMM, 0);
+    soliton_set_vwidth_policy(SOLITON_VWIDTH_ALWAYS_ZMM, 0);
+    soliton_set_vwidth_policy(SOLITON_VWIDTH_PREFER_YMM, 0);
+
+    check(soliton_stats_page_read(view.page, &s, NULL) == SOLITON_OK && s.enc_messages == 0,
+          "page unchanged before publish");
+
+    soliton_stats_publish(pub);
+    check(soliton_stats_page_read(view.page, &s, &ns) == SOLITON_OK && ns != 0, "published snapshot reads back");
+
+    /* 16 B (1 block), 984 B and 2 x 1000 B (61/62 blocks, partial tail) */
+    check(s.update_bytes[5] == 1 && s.update_bytes[10] == 3 &&
+          sum(s.update_bytes, SOLITON_STATS_BUCKETS) == 4, "update sizes: 1 in [16,32), 3 in [512,1024)");
+    check(s.tail_blocks == 4, "4 updates leave 1..7 whole blocks");
+    check(s.tail_partial == 3, "3 updates end in a partial block");
+    check(s.enc_messages == 1 && s.dec_messages == 2, "1 encrypt, 2 decrypt messages");
+    check(s.auth_failures == 1, "1 auth failure");
+    check(s.plan_switches == 2, "2 effective plan switches (repeat set not counted)");
+
+    soliton_aesgcm_cost_read(ctx, &c);
+    check(c.sampled_calls > 0 && sum(s.latency, SOLITON_STATS_BUCKETS) == c.sampled_calls,
+          "latency histogram holds every sampled call");
+    const uint64_t kbytes = sum(s.kernel_bytes, SOLITON_STATS_KERNELS);
+    check(kbytes > 0 && kbytes <= 3 * MSG_LEN && sum(s.kernel_calls, SOLITON_STATS_KERNELS) > 0,
+          "bulk kernels report calls and bytes");
+
+    check(soliton_stats_page_read(view.page, &v, NULL) == SOLITON_OK && memcmp(&v, &s, sizeof(s)) == 0,
+          "monitor view reads the same snapshot");
+
+    soliton_aesgcm_context_wipe(ctx);
+    soliton_stats_view_close(&view);
+    soliton_stats_publish_stop(pub);
+    soliton_set_vwidth_policy(SOLITON_VWIDTH_AUTO, 0);
+}
+
+static uint8_t thread_ctx[COUNT_THREADS][CTX_SIZE] __attribute__((aligned(64)));
+
+/* COUNT_SEALS two-update messages on the thread's own context */
+static void* count_thread(void* arg) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)arg;
+    uint8_t tag[16];
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    for (int i = 0; i < COUNT_SEALS; i++) {
+        seal(ctx, tag);
+    }
+    soliton_aesgcm_context_wipe(ctx);
+    return NULL;
+}
+
+static void test_threads(void) {
+    pthread_t t[COUNT_THREADS];
+    soliton_stats_publisher* pub = NULL;
+    soliton_stats_view view;
+    soliton_stats s;
+    int started = 1;
+
+    printf("\nPer-thread slots:\n");
+
+    check(soliton_stats_publish_start(0, &pub) == SOLITON_OK, "publish_start (no thread)");
+    for (int i = 0; i < COUNT_THREADS; i++) {
+        started &= pthread_create(&t[i], NULL, count_thread, thread_ctx[i]) == 0;
+    }
+    for (int i = 0; i < COUNT_THREADS; i++) {
+        pthread_join(t[i], NULL);
+    }
+    check(started, "threads started");
+
+    soliton_stats_publish(pub);
+    check(soliton_stats_view_open((uint32_t)getpid(), &view) == SOLITON_OK &&
+          soliton_stats_page_read(view.page, &s, NULL) == SOLITON_OK, "published snapshot reads back");
+
+    char what[128];
+    snprintf(what, sizeof(what), "%d threads x %d seals: every message counted",
+             COUNT_THREADS, COUNT_SEALS);
+    check(s.enc_messages == (uint64_t)COUNT_THREADS * COUNT_SEALS, what);
+    check(sum(s.update_bytes, SOLITON_STATS_BUCKETS) == 2u * COUNT_THREADS * COUNT_SEALS,
+          "every update counted");
+
+    soliton_stats_view_close(&view);
+    soliton_stats_publish_stop(pub);
+}
+
+static soliton_stats_page torture_page __attribute__((aligned(64)));
+static volatile int torture_done = 0;
+
+/* Every word of snapshot k is k, and publish_ns is k */
+static void* torture_writer(void* arg) {
+    soliton_stats snap;
+    (void)arg;
+    for (uint64_t k = 1; k <= TORTURE_WRITES; k++) {
+        uint64_t* w = (uint64_t*)&snap;
+        for (size_t i = 0; i < sizeof(snap) / sizeof(uint64_t); i++) {
+            w[i] = k;
+        }
+        soliton_stats_page_write(&torture_page, &snap, k);
+    }
+    __atomic_store_n(&torture_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void test_seqlock(void) {
+    pthread_t writer;
+    soliton_stats snap;
+    uint64_t reads = 0, torn = 0, last = 0, backwards = 0;
+
+    printf("\nSeqlock:\n");
+
+    torture_page.magic = SOLITON_STATS_PAGE_MAGIC;
+    torture_page.version = SOLITON_STATS_PAGE_VERSION;
+    torture_page.size = sizeof(soliton_stats_page);
+
+    pthread_create(&writer, NULL, torture_writer, NULL);
+    while (!__atomic_load_n(&torture_done, __ATOMIC_ACQUIRE)) {
+        uint64_t ns = 0;
+        if (soliton_stats_page_read(&torture_page, &snap, &ns) != SOLITON_OK) {
+            continue;   /* Writer held the page for every retry */
+        }
+        const uint64_t* w = (const uint64_t*)&snap;
+        for (size_t i = 0; i < sizeof(snap) / sizeof(uint64_t); i++) {
+            if (w[i] != ns) {
+                torn++;
+                break;
+            }
+        }
+        backwards += ns < last;
+        last = ns;
+        reads++;
+    }
+    pthread_join(writer, NULL);
+
+    char what[128];
+    snprintf(what, sizeof(what), "%llu reads racing %d writes, none torn",
+             (unsigned long long)reads, TORTURE_WRITES);
+    check(reads > 0 && torn == 0, what);
+    check(backwards == 0, "snapshots never go backwards");
+
+    check(soliton_stats_page_read(&torture_page, &snap, NULL) == SOLITON_OK &&
+          snap.enc_messages == TORTURE_WRITES && torture_page.publishes == TORTURE_WRITES,
+          "final snapshot is the last write");
+
+    torture_page.version = SOLITON_STATS_PAGE_VERSION + 1;
+    check(soliton_stats_page_read(&torture_page, &snap, NULL) == SOLITON_UNSUPPORTED,
+          "foreign version rejected");
+}
+
+static void test_publisher(void) {
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)ctx_buf;
+    soliton_stats_publisher* pub = NULL;
+    soliton_stats_view view;
+    soliton_stats s;
+    char path[128], cmd[160], decoy[] = "/tmp/soliton-stats-decoy.XXXXXX";
+    struct stat st;
+    uint8_t tag[16];
+
+    printf("\nBackground publisher + soliton-top:\n");
+
+    /* Stale symlink at the page path */
+    int dfd = mkstemp(decoy);
+    close(dfd);
+    soliton_stats_page_path((uint32_t)getpid(), path, sizeof(path));
+    symlink(decoy, path);
+
+    check(soliton_stats_publish_start(10, &pub) == SOLITON_OK, "publish_start every 10 ms");
+    check(lstat(path, &st) == 0 && S_ISREG(st.st_mode) && (st.st_mode & 0777) == SOLITON_STATS_PAGE_MODE,
+          "page is a new owner-only file, not the stale symlink");
+    check(stat(decoy, &st) == 0 && st.st_size == 0, "symlink target untouched");
+    unlink(decoy);
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    seal(ctx, tag);
+
+    check(soliton_stats_view_open((uint32_t)getpid(), &view) == SOLITON_OK, "view_open");
+    int seen = 0;
+    for (int i = 0; i < 200 && !seen; i++) {
+        usleep(5000);
+        seen = soliton_stats_page_read(view.page, &s, NULL) == SOLITON_OK && s.enc_messages == 1;
+    }
+    check(seen && view.page->publishes >= 2, "thread publishes without an explicit call (from zero)");
+    soliton_stats_view_close(&view);
+
+    snprintf(cmd, sizeof(cmd), "./soliton-top -n 1 %u > /dev/null", (unsigned)getpid());
+    check(system(cmd) == 0, "soliton-top -n 1 <pid> attaches and exits 0");
+
+    soliton_stats_publish_stop(pub);
+    check(access(path, F_OK) != 0, "publish_stop removes the page");
+    check(soliton_stats_view_open((uint32_t)getpid(), &view) == SOLITON_INTERNAL_ERROR,
+          "view_open fails once the page is gone");
+
+    /* Detached: nothing more is added to the block */
+    seal(ctx, tag);
+    soliton_aesgcm_context_wipe(ctx);
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("Live Stats Page Validation\n");
+    printf("==========================================\n");
+
+    for (size_t i = 0; i < sizeof(key); i++) key[i] = (uint8_t)(i * 7 + 1);
+    for (size_t i = 0; i < sizeof(pt); i++) pt[i] = (uint8_t)i;
+
+    test_counters();
+    test_threads();
+    test_seqlock();
+    test_publisher();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL LIVE STATS TESTS PASSED\n");
+    } else {
+        printf("✗ %d LIVE STATS TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+/*
+ * test_usdt.c - USDT static tracepoints (core/usdt.h, make usdt)
+ *
+ * PROOF OBLIGATIONS:
+ *   1. The linked binary carries .note.stapsdt records under provider
+ *      "soliton" for the entry/return probes of the AES-GCM, ChaCha20-
+ *      Poly1305, AEGIS, XTS and batch APIs, gcm_kernel and backend_select
+ *   2. Every record points at a nop in an executable section and gives
+ *      one 8-byte argument per documented probe argument
+ *   3. The instrumented library still computes NIST SP 800-38D test case
+ *      14 and opens it
+ *
+ * Reads its own executable from /proc/self/exe; no tracer is needed.
+ *
+ * Compile: cc -O2 -o test_usdt test_usdt.c -L. -lsoliton_core_usdt
+ */
+
+#include <elf.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_PROBES 512
+
+typedef struct {
+    char name[64];
+    int  nargs;
+    int  on_nop;
+} probe_info;
+
+static probe_info probes[MAX_PROBES];
+static size_t nprobes = 0;
+
+static uint8_t* read_file(const char* path, size_t* len) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t* buf = n > 0 ? malloc((size_t)n) : NULL;
+    if (buf && fread(buf, 1, (size_t)n, f) != (size_t)n) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    *len = (size_t)n;
+    return buf;
+}
+
+/* File bytes at a link-time address inside an executable section */
+static const uint8_t* exec_bytes_at(const uint8_t* img, const Elf64_Shdr* sh, size_t shnum, uint64_t addr) {
+    for (size_t i = 0; i < shnum; i++) {
+        if ((sh[i].sh_flags & SHF_EXECINSTR) && sh[i].sh_type == SHT_PROGBITS &&
+            addr >= sh[i].sh_addr && addr + 4 <= sh[i].sh_addr + sh[i].sh_size) {
+            return img + sh[i].sh_offset + (addr - sh[i].sh_addr);
+        }
+    }
+    return NULL;
+}
+
+static int is_nop(const uint8_t* p) {
+#if defined(__x86_64__)
+    return p[0] == 0x90;
+#elif defined(__aarch64__)
+    return p[0] == 0x1f && p[1] == 0x20 && p[2] == 0x03 && p[3] == 0xd5;
+#else
+    (void)p;
+    return 0;
+#endif
+}
+
+static int collect_probes(void) {
+    size_t len = 0;
+    uint8_t* img = read_file("/proc/self/exe", &len);
+    if (!img || len < sizeof(Elf64_Ehdr)) {
+        free(img);
+        return -1;
+    }
+
+    const Elf64_Ehdr* eh = (const Elf64_Ehdr*)img;
+    const Elf64_Shdr* sh = (const Elf64_Shdr*)(img + eh->e_shoff);
+    const char* shstr = (const char*)img + sh[eh->e_shstrndx].sh_offset;
+
+    for (size_t i = 0; i < eh->e_shnum; i++) {
+        if (sh[i].sh_type != SHT_NOTE || strcmp(shstr + sh[i].sh_name, ".note.stapsdt") != 0) {
+            continue;
+        }
+        const uint8_t* p = img + sh[i].sh_offset;
+        const uint8_t* end = p + sh[i].sh_size;
+        while (p + sizeof(Elf64_Nhdr) <= end) {
+            const Elf64_Nhdr* nh = (const Elf64_Nhdr*)p;
+            const char* owner = (const char*)(p + sizeof(*nh));
+            const uint8_t* desc = p + sizeof(*nh) + ((nh->n_namesz + 3) & ~3u);
+            p = desc + ((nh->n_descsz + 3) & ~3u);
+
+            if (nh->n_type != 3 || strcmp(owner, "stapsdt") != 0) {
+                continue;
+            }
+            uint64_t pc;
+            memcpy(&pc, desc, 8);
+            const char* provider = (const char*)desc + 24;
+            const char* name = provider + strlen(provider) + 1;
+            const char* args = name + strlen(name) + 1;
+            if (strcmp(provider, "soliton") != 0 || nprobes == MAX_PROBES) {
+                continue;
+            }
+
+            probe_info* pi = &probes[nprobes++];
+            snprintf(pi->name, sizeof(pi->name), "%s", name);
+            for (const char* a = args; (a = strstr(a, "8@")) != NULL; a += 2) {
+                pi->nargs++;
+            }
+            const uint8_t* site = exec_bytes_at(img, sh, eh->e_shnum, pc);
+            pi->on_nop = site && is_nop(site);
+        }
+    }
+
+    free(img);
+    return 0;
+}
+
+/* Sites for name (inlining can duplicate one), or -1 if any site has the
+ * wrong shape */
+static int probe_sites(const char* name, int nargs) {
+    int n = 0;
+    for (size_t i = 0; i < nprobes; i++) {
+        if (strcmp(probes[i].name, name) == 0) {
+            if (probes[i].nargs != nargs || !probes[i].on_nop) {
+                return -1;
+            }
+            n++;
+        }
+    }
+    return n;
+}
+
+static void test_notes(void) {
+    static const char* const apis[] = {
+        "aesgcm_init", "aesgcm_reset", "aesgcm_aad_prefix_bind", "aesgcm_aad_update",
+        "aesgcm_encrypt_update", "aesgcm_encrypt_final", "aesgcm_decrypt_update",
+        "aesgcm_decrypt_final", "aesgcm_encrypt_update_crc", "aesgcm_decrypt_update_crc",
+        "aesgcm_duplex_update", "aesgcm_seal_gso", "chacha_stream_xor", "chacha_init_variant",
+        "chacha_aad_update", "chacha_encrypt_update", "chacha_encrypt_final",
+        "chacha_decrypt_update", "chacha_decrypt_final", "aegis_init", "aegis_encrypt",
+        "aegis_decrypt", "xts_encrypt", "xts_decrypt", "xts_encrypt_sectors",
+        "aesgcm_batch_update", "chacha_batch_update", "aegis_batch_update",
+    };
+    char name[80], what[128];
+    int entries = 1, returns = 1;
+
+    printf("\nProbe notes:\n");
+
+    check(collect_probes() == 0, "read /proc/self/exe");
+    snprintf(what, sizeof(what), "%zu soliton probe sites", nprobes);
+    check(nprobes > 0, what);
+
+    int all_nop = 1;
+    for (size_t i = 0; i < nprobes; i++) {
+        all_nop &= probes[i].on_nop;
+    }
+    check(all_nop, "every site is a nop in an executable section");
+
+    for (size_t i = 0; i < sizeof(apis) / sizeof(apis[0]); i++) {
+        snprintf(name, sizeof(name), "%s_entry", apis[i]);
+        if (probe_sites(name, 2) < 1) {
+            printf("    missing or malformed: %s\n", name);
+            entries = 0;
+        }
+        snprintf(name, sizeof(name), "%s_return", apis[i]);
+        if (probe_sites(name, 3) < 1) {
+            printf("    missing or malformed: %s\n", name);
+            returns = 0;
+        }
+    }
+    snprintf(what, sizeof(what), "%zu APIs have entry probes (ctx, len)", sizeof(apis) / sizeof(apis[0]));
+    check(entries, what);
+    check(returns, "and return probes (ctx, len, status)");
+    check(probe_sites("gcm_kernel", 3) > 0, "gcm_kernel (ctx, kernel, bytes)");
+    check(probe_sites("backend_select", 2) == 5, "backend_select (name, family) for 5 families");
+}
+
+static void test_vector(void) {
+    static uint8_t ctx_buf[CTX_SIZE] __attribute__((aligned(64)));
+    soliton_aesgcm_ctx* ctx = (soliton_aesgcm_ctx*)ctx_buf;
+    static const uint8_t expect_ct[16] = {
+        0xce, 0xa7, 0x40, 0x3d, 0x4d, 0x60, 0x6b, 0x6e, 0x07, 0x4e, 0xc5, 0xd3, 0xba, 0xf3, 0x9d, 0x18
+    };
+    static const uint8_t expect_tag[16] = {
+        0xd0, 0xd1, 0xc8, 0xa7, 0x99, 0x99, 0x6b, 0xf0, 0x26, 0x5b, 0x98, 0xb5, 0xd4, 0x8a, 0xb9, 0x19
+    };
+    uint8_t key[32] = { 0 }, iv[12] = { 0 }, pt[16] = { 0 }, ct[16], out[16], tag[16];
+
+    printf("\nInstrumented library:\n");
+
+    soliton_aesgcm_init(ctx, key, iv, sizeof(iv));
+    soliton_aesgcm_encrypt_update(ctx, pt, ct, sizeof(pt));
+    soliton_aesgcm_encrypt_final(ctx, tag);
+    check(memcmp(ct, expect_ct, 16) == 0 && memcmp(tag, expect_tag, 16) == 0, "NIST GCM test case 14 seal");
+
+    soliton_aesgcm_reset(ctx, iv, sizeof(iv));
+    soliton_aesgcm_decrypt_update(ctx, ct, out, sizeof(ct));
+    check(soliton_aesgcm_decrypt_final(ctx, tag) == SOLITON_OK && memcmp(out, pt, 16) == 0,
+          "NIST GCM test case 14 open");
+    soliton_aesgcm_context_wipe(ctx);
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("USDT Probe Validation\n");
+    printf("==========================================\n");
+
+    test_notes();
+    test_vector();
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL USDT PROBE TESTS PASSED\n");
+    } else {
+        printf("✗ %d USDT PROBE TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+/*
+ * test_util.h - Helpers shared by the feature tests
+ *
+ * check() prints one ✓/✗ line and counts failures for main's summary,
+ * fill() is the deterministic LCG filler behind every equivalence test and
+ * hex_to_bytes() decodes known-answer vectors.
+ */
+
+#ifndef SOLITON_TEST_UTIL_H
+#define SOLITON_TEST_UTIL_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+static int failures = 0;
+
+static inline void check(int ok, const char* what) {
+    printf("  %s %s\n", ok ? "✓" : "✗", what);
+    if (!ok) failures++;
+}
+
+/* Deterministic filler */
+static inline void fill(uint8_t* buf, size_t len, uint32_t seed) {
+    for (size_t i = 0; i < len; i++) {
+        seed = seed * 1103515245u + 12345u;
+        buf[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+/* Hex string to bytes; returns the byte count, or -1 for odd length or a
+ * bad digit */
+static inline int hex_to_bytes(uint8_t* out, const char* hex) {
+    size_t len = strlen(hex);
+    if (len % 2 != 0) return -1;
+    for (size_t i = 0; i < len / 2; i++) {
+        if (sscanf(hex + i * 2, "%2hhx", &out[i]) != 1) return -1;
+    }
+    return (int)(len / 2);
+}
+
+#endif /* SOLITON_TEST_UTIL_H */
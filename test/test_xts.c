@@ -0,0 +1,292 @@
+/*
+ * test_xts.c — AES-256-XTS (IEEE 1619)
+ *
+ * PROOF OBLIGATIONS:
+ *   1. IEEE 1619 vector 10 (512-byte data unit) and ciphertext-stealing
+ *      lengths 16/17/31/100 match OpenSSL EVP_aes_256_xts output
+ *   2. Decrypt inverts encrypt for every length 16..600, out-of-place and
+ *      in-place
+ *   3. Sector batches equal per-sector calls with little-endian sector
+ *      number tweaks, including a batch that spans several tweak passes
+ *   4. AES-NI / VAES block kernels and decryption key schedules match the
+ *      scalar reference for 0..40 blocks (skipped when absent)
+ *   5. Key1 == Key2, short and oversized data units are rejected
+ *
+ * Compile: cc -O2 -o test_xts test_xts.c -L. -lsoliton_core
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../include/soliton.h"
+#include "test_util.h"
+
+#define CTX_SIZE 1024
+#define MAX_LEN 4096
+
+/* Kernels under test (weak: absent when the toolchain lacks AES-NI/VAES) */
+typedef void (*xts_kernel_fn)(const uint32_t*, uint8_t*, const uint8_t*, uint8_t*, size_t);
+
+extern void aes256_key_expand_scalar(const uint8_t*, uint32_t*);
+extern void aes256_key_expand_dec_scalar(const uint32_t*, uint32_t*);
+extern void aes256_xts_encrypt_blocks_scalar(const uint32_t*, uint8_t*, const uint8_t*, uint8_t*, size_t);
+extern void aes256_xts_decrypt_blocks_scalar(const uint32_t*, uint8_t*, const uint8_t*, uint8_t*, size_t);
+extern void aes256_key_expand_dec_aesni(const uint32_t*, uint32_t*) __attribute__((weak));
+extern void aes256_xts_encrypt_blocks_aesni(const uint32_t*, uint8_t*, const uint8_t*, uint8_t*, size_t) __attribute__((weak));
+extern void aes256_xts_decrypt_blocks_aesni(const uint32_t*, uint8_t*, const uint8_t*, uint8_t*, size_t) __attribute__((weak));
+extern void aes256_xts_encrypt_blocks_vaes(const uint32_t*, uint8_t*, const uint8_t*, uint8_t*, size_t) __attribute__((weak));
+extern void aes256_xts_decrypt_blocks_vaes(const uint32_t*, uint8_t*, const uint8_t*, uint8_t*, size_t) __attribute__((weak));
+
+static void hex2bin(const char* hex, uint8_t* out, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        unsigned int v;
+        sscanf(hex + 2 * i, "%02x", &v);
+        out[i] = (uint8_t)v;
+    }
+}
+
+/* IEEE 1619 vector 10 keys: Key1 = e digits, Key2 = pi digits */
+static const char* KEY_HEX =
+    "2718281828459045235360287471352662497757247093699959574966967627"
+    "3141592653589793238462643383279502884197169399375105820974944592";
+
+/* Data unit 0xff, plaintext bytes 00 01 02 .. ; expected from EVP_aes_256_xts */
+static const struct {
+    size_t len;
+    const char* ct;
+} kats[] = {
+    { 16, "1c3b3a102f770386e4836c99e370cf9b" },
+    { 17, "990b3d5708499ecacac51584606f5d761c" },
+    { 31, "b7a469d9a0a8237d178ad4323b2746321c3b3a102f770386e4836c99e370cf" },
+    { 100,
+      "1c3b3a102f770386e4836c99e370cf9bea00803f5e482357a4ae12d414a3e63b"
+      "5d31e276f8fe4a8d66b317f9ac683f44680a86ac35adfc3345befecb4bb188fd"
+      "5776926c49a3095eb108fd1098baec7042c9b5b4ac29dbf6d59b2c12ded9b654"
+      "aaa66999" },
+    { 512,
+      "1c3b3a102f770386e4836c99e370cf9bea00803f5e482357a4ae12d414a3e63b"
+      "5d31e276f8fe4a8d66b317f9ac683f44680a86ac35adfc3345befecb4bb188fd"
+      "5776926c49a3095eb108fd1098baec70aaa66999a72a82f27d848b21d4a741b0"
+      "c5cd4d5fff9dac89aeba122961d03a757123e9870f8acf1000020887891429ca"
+      "2a3e7a7d7df7b10355165c8b9a6d0a7de8b062c4500dc4cd120c0f7418dae3d0"
+      "b5781c34803fa75421c790dfe1de1834f280d7667b327f6c8cd7557e12ac3a0f"
+      "93ec05c52e0493ef31a12d3d9260f79a289d6a379bc70c50841473d1a8cc81ec"
+      "583e9645e07b8d9670655ba5bbcfecc6dc3966380ad8fecb17b6ba02469a020a"
+      "84e18e8f84252070c13e9f1f289be54fbc481457778f616015e1327a02b140f1"
+      "505eb309326d68378f8374595c849d84f4c333ec4423885143cb47bd71c5edae"
+      "9be69a2ffeceb1bec9de244fbe15992b11b77c040f12bd8f6a975a44a0f90c29"
+      "a9abc3d4d893927284c58754cce294529f8614dcd2aba991925fedc4ae74ffac"
+      "6e333b93eb4aff0479da9a410e4450e0dd7ae4c6e2910900575da401fc07059f"
+      "645e8b7e9bfdef33943054ff84011493c27b3429eaedb4ed5376441a77ed4385"
+      "1ad77f16f541dfd269d50d6a5f14fb0aab1cbb4c1550be97f7ab4066193c4caa"
+      "773dad38014bd2092fa755c824bb5e54c4f36ffda9fcea70b9c6e693e148c151" },
+};
+
+static uint8_t key[64];
+static uint8_t pt[MAX_LEN], ct[MAX_LEN], out[MAX_LEN], ref[MAX_LEN];
+static uint8_t ctx_buf[CTX_SIZE] __attribute__((aligned(64)));
+static soliton_xts_ctx* ctx = (soliton_xts_ctx*)ctx_buf;
+
+static void test_vectors(void) {
+    uint8_t tweak[16] = { 0xff };
+    uint8_t expect[512];
+    char what[64];
+
+    printf("\nIEEE 1619 / OpenSSL vectors:\n");
+    for (size_t i = 0; i < 512; i++) {
+        pt[i] = (uint8_t)i;
+    }
+
+    for (size_t k = 0; k < sizeof(kats) / sizeof(kats[0]); k++) {
+        size_t len = kats[k].len;
+        hex2bin(kats[k].ct, expect, len);
+
+        soliton_status st = soliton_xts_encrypt(ctx, tweak, pt, ct, len);
+        snprintf(what, sizeof(what), "encrypt %zu bytes", len);
+        check(st == SOLITON_OK && memcmp(ct, expect, len) == 0, what);
+
+        st = soliton_xts_decrypt(ctx, tweak, ct, out, len);
+        snprintf(what, sizeof(what), "decrypt %zu bytes", len);
+        check(st == SOLITON_OK && memcmp(out, pt, len) == 0, what);
+    }
+}
+
+static void test_roundtrip(void) {
+    uint8_t tweak[16];
+    int ok = 1;
+
+    printf("\nRound trip:\n");
+    fill(tweak, sizeof(tweak), 7);
+    fill(pt, 600, 8);
+
+    for (size_t len = 16; len <= 600; len++) {
+        soliton_xts_encrypt(ctx, tweak, pt, ct, len);
+        soliton_xts_decrypt(ctx, tweak, ct, out, len);
+        ok &= memcmp(out, pt, len) == 0;
+
+        /* In place must give the same ciphertext */
+        memcpy(out, pt, len);
+        soliton_xts_encrypt(ctx, tweak, out, out, len);
+        ok &= memcmp(out, ct, len) == 0;
+        soliton_xts_decrypt(ctx, tweak, out, out, len);
+        ok &= memcmp(out, pt, len) == 0;
+    }
+    check(ok, "16..600 bytes, out-of-place and in-place");
+}
+
+static void test_sectors(void) {
+    static const size_t sizes[] = { 512, 520, 4096 };
+    const uint64_t first = 0x123456789aull;
+    int ok = 1;
+
+    printf("\nSector batches:\n");
+
+    /* Sector number as tweak, checked against EVP_aes_256_xts */
+    uint8_t expect[48];
+    hex2bin("50ea7b0e72da7912892bcd0c7496baa4b346523120af299dac5b9960aed521fb"
+            "369169dcb0c7d652a3af8bd85e97b61c", expect, sizeof(expect));
+    for (size_t i = 0; i < 48; i++) {
+        pt[i] = (uint8_t)i;
+    }
+    soliton_xts_encrypt_sectors(ctx, first, 48, pt, ct, 1);
+    check(memcmp(ct, expect, sizeof(expect)) == 0, "sector 0x123456789a matches EVP");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t sector_size = sizes[s];
+        size_t count = MAX_LEN / sector_size;
+        if (sector_size == 512) {
+            count = 8;
+        }
+        fill(pt, sector_size * count, (uint32_t)sector_size);
+
+        for (size_t i = 0; i < count; i++) {
+            uint8_t tweak[16] = { 0 };
+            uint64_t n = first + i;
+            for (int b = 0; b < 8; b++) {
+                tweak[b] = (uint8_t)(n >> (8 * b));
+            }
+            soliton_xts_encrypt(ctx, tweak, pt + i * sector_size, ref + i * sector_size, sector_size);
+        }
+
+        ok &= soliton_xts_encrypt_sectors(ctx, first, sector_size, pt, ct, count) == SOLITON_OK;
+        ok &= memcmp(ct, ref, sector_size * count) == 0;
+        ok &= soliton_xts_decrypt_sectors(ctx, first, sector_size, ct, out, count) == SOLITON_OK;
+        ok &= memcmp(out, pt, sector_size * count) == 0;
+    }
+
+    /* 40 x 96-byte sectors: three tweak passes, last one partial */
+    fill(pt, 40 * 96, 99);
+    for (size_t i = 0; i < 40; i++) {
+        uint8_t tweak[16] = { 0 };
+        tweak[0] = (uint8_t)(250 + i);
+        tweak[1] = (uint8_t)((250 + i) >> 8);
+        soliton_xts_encrypt(ctx, tweak, pt + i * 96, ref + i * 96, 96);
+    }
+    soliton_xts_encrypt_sectors(ctx, 250, 96, pt, ct, 40);
+    ok &= memcmp(ct, ref, 40 * 96) == 0;
+    check(ok, "batches equal per-sector calls (512/520/4096/96-byte sectors)");
+}
+
+static void test_kernels(void) {
+    uint32_t rk[60], dk[60], dk_ref[60];
+    soliton_caps caps;
+    const struct {
+        const char* name;
+        xts_kernel_fn enc, dec;
+        uint32_t feat;
+    } kernels[] = {
+        { "AES-NI", aes256_xts_encrypt_blocks_aesni, aes256_xts_decrypt_blocks_aesni, SOLITON_FEAT_AESNI },
+        { "VAES", aes256_xts_encrypt_blocks_vaes, aes256_xts_decrypt_blocks_vaes, SOLITON_FEAT_VAES },
+    };
+
+    printf("\nBlock kernels (vs scalar):\n");
+    soliton_query_caps(&caps);
+    aes256_key_expand_scalar(key, rk);
+    aes256_key_expand_dec_scalar(rk, dk_ref);
+    fill(pt, 40 * 16, 11);
+
+    if (aes256_key_expand_dec_aesni && (caps.bits & SOLITON_FEAT_AESNI)) {
+        aes256_key_expand_dec_aesni(rk, dk);
+        check(memcmp(dk, dk_ref, sizeof(dk)) == 0, "AESIMC decryption schedule");
+    }
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        char what[64];
+        int ok = 1;
+
+        if (!kernels[k].enc || !(caps.bits & kernels[k].feat)) {
+            printf("  - %s kernels not available, skipped\n", kernels[k].name);
+            continue;
+        }
+
+        for (size_t blocks = 0; blocks <= 40; blocks++) {
+            uint8_t t_ref[16], t[16];
+            fill(t_ref, 16, (uint32_t)blocks);
+            memcpy(t, t_ref, 16);
+
+            aes256_xts_encrypt_blocks_scalar(rk, t_ref, pt, ref, blocks);
+            kernels[k].enc(rk, t, pt, ct, blocks);
+            ok &= memcmp(ct, ref, blocks * 16) == 0 && memcmp(t, t_ref, 16) == 0;
+
+            fill(t_ref, 16, (uint32_t)blocks);
+            memcpy(t, t_ref, 16);
+            aes256_xts_decrypt_blocks_scalar(dk_ref, t_ref, ref, out, blocks);
+            ok &= memcmp(out, pt, blocks * 16) == 0;
+            kernels[k].dec(dk_ref, t, ref, out, blocks);
+            ok &= memcmp(out, pt, blocks * 16) == 0 && memcmp(t, t_ref, 16) == 0;
+        }
+        snprintf(what, sizeof(what), "%s encrypt/decrypt + tweak 0..40 blocks", kernels[k].name);
+        check(ok, what);
+    }
+}
+
+static void test_invalid(void) {
+    uint8_t bad_key[64];
+    uint8_t tweak[16] = { 0 };
+    uint8_t tmp_buf[CTX_SIZE] __attribute__((aligned(64)));
+    soliton_xts_ctx* tmp = (soliton_xts_ctx*)tmp_buf;
+
+    printf("\nInvalid input:\n");
+    memcpy(bad_key, key, 32);
+    memcpy(bad_key + 32, key, 32);
+    check(soliton_xts_init(tmp, bad_key) == SOLITON_INVALID_INPUT, "Key1 == Key2 rejected");
+    check(soliton_xts_encrypt(ctx, tweak, pt, ct, 15) == SOLITON_INVALID_INPUT,
+          "data unit < 16 bytes rejected");
+    check(soliton_xts_decrypt(ctx, tweak, pt, ct, 0) == SOLITON_INVALID_INPUT,
+          "empty data unit rejected");
+    check(soliton_xts_encrypt(ctx, tweak, pt, ct, SOLITON_XTS_MAX_BYTES + 1) == SOLITON_INVALID_INPUT,
+          "data unit > 2^20 blocks rejected");
+    check(soliton_xts_encrypt_sectors(ctx, 0, 8, pt, ct, 1) == SOLITON_INVALID_INPUT,
+          "8-byte sectors rejected");
+}
+
+int main(void) {
+    printf("==========================================\n");
+    printf("AES-256-XTS Validation\n");
+    printf("==========================================\n");
+
+    hex2bin(KEY_HEX, key, sizeof(key));
+    if (soliton_xts_init(ctx, key) != SOLITON_OK) {
+        printf("✗ soliton_xts_init failed\n");
+        return 1;
+    }
+
+    test_vectors();
+    test_roundtrip();
+    test_sectors();
+    test_kernels();
+    test_invalid();
+
+    soliton_xts_context_wipe(ctx);
+
+    printf("\n==========================================\n");
+    if (failures == 0) {
+        printf("✓ ALL XTS TESTS PASSED\n");
+    } else {
+        printf("✗ %d XTS TEST(S) FAILED\n", failures);
+    }
+    printf("==========================================\n");
+
+    return failures == 0 ? 0 : 1;
+}
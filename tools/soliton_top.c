@@ -0,0 +1,180 @@
+/*
+ * soliton_top.c - Live view of a process's soliton stats page
+ *
+ * Maps /dev/shm/soliton-stats.<pid> read-only (hosted/stats_page.c) and
+ * prints rates between two snapshots: per-kernel calls/s and MB/s, the
+ * update size distribution, tail rates, latency percentiles from the
+ * cost-sampled histogram, messages/s, auth failures and plan switches.
+ * The monitored process makes no syscalls for it and is never signalled.
+ *
+ * Usage: soliton-top <pid> [-i interval_s] [-n iterations]
+ *   -i  seconds between refreshes (default 1)
+ *   -n  stop after this many refreshes (default: until interrupted)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../include/soliton_hosted.h"
+
+static const char* const kernel_names[SOLITON_STATS_KERNELS] = {
+    [SOLITON_KERNEL_GENERIC]      = "generic",
+    [SOLITON_KERNEL_CLMUL8]       = "clmul8",
+    [SOLITON_KERNEL_FUSED8]       = "fused8",
+    [SOLITON_KERNEL_FUSED16]      = "fused16",
+    [SOLITON_KERNEL_PIPELINED16]  = "pipelined16",
+    [SOLITON_KERNEL_RESIDENT]     = "resident",
+    [SOLITON_KERNEL_STITCHED]     = "stitched",
+    [SOLITON_KERNEL_RESIDENT_CRC] = "resident_crc",
+    [SOLITON_KERNEL_DUPLEX]       = "duplex",
+    [SOLITON_KERNEL_CTR512]       = "ctr512",
+};
+
+static void usage(void) {
+    fprintf(stderr, "Usage: soliton-top <pid> [-i interval_s] [-n iterations]\n");
+}
+
+/* Lower bound of histogram bucket b */
+static uint64_t bucket_floor(int b) {
+    return b == 0 ? 0 : (uint64_t)1 << (b - 1);
+}
+
+/* Bucket holding percentile p of the counts (lower bound), 0 if empty */
+static uint64_t percentile(const uint64_t* hist, double p) {
+    uint64_t total = 0;
+    for (int b = 0; b < SOLITON_STATS_BUCKETS; b++) {
+        total += hist[b];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t want = (uint64_t)(p * (double)total + 0.5), seen = 0;
+    if (want == 0) {
+        want = 1;
+    }
+    for (int b = 0; b < SOLITON_STATS_BUCKETS; b++) {
+        seen += hist[b];
+        if (seen >= want) {
+            return bucket_floor(b);
+        }
+    }
+    return bucket_floor(SOLITON_STATS_BUCKETS - 1);
+}
+
+static void show(uint32_t pid, const soliton_stats_page* page, const soliton_stats* prev,
+                 const soliton_stats* cur, double secs) {
+    soliton_stats d;
+    const uint64_t* a = (const uint64_t*)prev;
+    const uint64_t* b = (const uint64_t*)cur;
+    uint64_t* out = (uint64_t*)&d;
+    for (size_t i = 0; i < sizeof(d) / sizeof(uint64_t); i++) {
+        out[i] = b[i] - a[i];
+    }
+    if (secs <= 0) {
+        secs = 1;
+    }
+
+    printf("soliton-top  pid %u  publishes %llu  window %.2fs\n\n", pid,
+           (unsigned long long)page->publishes, secs);
+
+    printf("%-14s %12s %12s %14s\n", "kernel", "calls/s", "MB/s", "total calls");
+    for (int k = 0; k < SOLITON_STATS_KERNELS; k++) {
+        if (cur->kernel_calls[k] == 0) {
+            continue;
+        }
+        char unknown[16];
+        const char* name = kernel_names[k];
+        if (!name) {
+            snprintf(unknown, sizeof(unknown), "kernel%d", k);
+            name = unknown;
+        }
+        printf("%-14s %12.0f %12.1f %14llu\n", name, d.kernel_calls[k] / secs,
+               d.kernel_bytes[k] / secs / 1e6, (unsigned long long)cur->kernel_calls[k]);
+    }
+
+    uint64_t updates = 0;
+    for (int i = 0; i < SOLITON_STATS_BUCKETS; i++) {
+        updates += d.update_bytes[i];
+    }
+    printf("\nupdates/s %.0f   tail blocks %.1f%%   partial tail %.1f%%\n", updates / secs,
+           updates ? 100.0 * d.tail_blocks / updates : 0.0,
+           updates ? 100.0 * d.tail_partial / updates : 0.0);
+    for (int i = 0; i < SOLITON_STATS_BUCKETS; i++) {
+        if (d.update_bytes[i] == 0) {
+            continue;
+        }
+        printf("  %10llu+ B  %6.1f%%\n", (unsigned long long)bucket_floor(i),
+               100.0 * d.update_bytes[i] / updates);
+    }
+
+    printf("\nlatency (sampled)  p50 >= %llu cycles   p99 >= %llu cycles\n",
+           (unsigned long long)percentile(d.latency, 0.50),
+           (unsigned long long)percentile(d.latency, 0.99));
+    printf("messages/s  enc %.0f  dec %.0f   auth failures %llu (+%llu)   plan switches %llu (+%llu)\n",
+           d.enc_messages / secs, d.dec_messages / secs,
+           (unsigned long long)cur->auth_failures, (unsigned long long)d.auth_failures,
+           (unsigned long long)cur->plan_switches, (unsigned long long)d.plan_switches);
+    fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    unsigned interval_s = 1;
+    long iterations = -1;
+    uint32_t pid = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            interval_s = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = strtol(argv[++i], NULL, 10);
+        } else if (argv[i][0] != '-' && pid == 0) {
+            pid = (uint32_t)strtoul(argv[i], NULL, 10);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (pid == 0 || interval_s == 0) {
+        usage();
+        return 2;
+    }
+
+    soliton_stats_view view;
+    if (soliton_stats_view_open(pid, &view) != SOLITON_OK) {
+        fprintf(stderr, "soliton-top: no stats page for pid %u (soliton_stats_publish_start)\n", pid);
+        return 1;
+    }
+
+    soliton_stats prev, cur;
+    uint64_t prev_ns = 0, cur_ns = 0;
+    soliton_status st = soliton_stats_page_read(view.page, &prev, &prev_ns);
+    if (st != SOLITON_OK) {
+        fprintf(stderr, "soliton-top: unreadable stats page (%s)\n",
+                st == SOLITON_UNSUPPORTED ? "version mismatch" : "writer busy");
+        soliton_stats_view_close(&view);
+        return 1;
+    }
+
+    const int tty = isatty(STDOUT_FILENO);
+    for (long n = 0; iterations < 0 || n < iterations; n++) {
+        sleep(interval_s);
+        if (soliton_stats_page_read(view.page, &cur, &cur_ns) != SOLITON_OK) {
+            continue;
+        }
+        if (tty) {
+            printf("\033[H\033[2J");
+        }
+        show(pid, view.page, &prev, &cur, (cur_ns - prev_ns) / 1e9);
+        prev = cur;
+        prev_ns = cur_ns;
+    }
+
+    soliton_stats_view_close(&view);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+variant_gains.py - Per-size comparison of library build variants
+
+Reads bench/aead_matrix --csv output for the default build and one or more
+variants (LTO, PGO, ...) and prints cycles/message with the gain of each
+variant over the default build, per AEAD and message size.
+
+Usage:
+    python tools/variant_gains.py results/variants/base.csv \
+        lto=results/variants/lto.csv pgo=results/variants/pgo.csv
+"""
+
+import csv
+import sys
+from typing import Dict, List, Tuple
+
+Key = Tuple[str, int]
+
+
+def load(path: str) -> Dict[Key, float]:
+    """Map (aead, size) -> cycles per message."""
+    rows = {}
+    with open(path, 'r') as f:
+        for row in csv.DictReader(f):
+            try:
+                rows[(row['aead'], int(row['size']))] = float(row['cycles_per_msg'])
+            except (ValueError, KeyError):
+                continue
+    return rows
+
+
+def main(argv: List[str]) -> int:
+    if len(argv) < 3:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    base = load(argv[1])
+    variants = []
+    for arg in argv[2:]:
+        name, _, path = arg.partition('=')
+        if not path:
+            name, path = arg, arg
+        variants.append((name, load(path)))
+
+    header = f"{'aead':<18} {'size':>7} {'base':>12}"
+    for name, _ in variants:
+        header += f" {name:>12} {'gain':>8}"
+    print(header)
+    print('-' * len(header))
+
+    for key in sorted(base, key=lambda k: (k[0], k[1])):
+        line = f"{key[0]:<18} {key[1]:>7} {base[key]:>12.1f}"
+        for _, rows in variants:
+            if key in rows and rows[key] > 0:
+                gain = (base[key] / rows[key] - 1.0) * 100.0
+                line += f" {rows[key]:>12.1f} {gain:>+7.1f}%"
+            else:
+                line += f" {'-':>12} {'-':>8}"
+        print(line)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))